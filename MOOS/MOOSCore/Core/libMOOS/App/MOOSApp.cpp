@@ -135,6 +135,8 @@ CMOOSApp::CMOOSApp()
     m_nCommsFreq=DEFAULT_MOOS_APP_COMMS_FREQ;
     m_dfMaxAppTick = DEFAULT_MOOS_APP_FREQ; //we can respond to mail very quickly but by default we are cautious
     m_IterationMode = REGULAR_ITERATE_AND_MAIL;
+    m_bIterateOnRequest = false;
+    m_bIterateRequested = false;
     m_nIterateCount = 0;
     m_nMailCount = 0;
     m_bServerSet = false;
@@ -150,8 +152,17 @@ CMOOSApp::CMOOSApp()
 	m_bAppError = false;
     m_bQuitOnIterateFail = false;
 	m_bQuitRequested = false;
+    m_bLockStep = false;
+    m_bLockStepTickPending = false;
+    m_bHeadless = false;
+    m_dfLockStepTick = -1;
+    m_dfLockStepLastIterate = -1;
+    m_dfLockStepLastAck = -1;
     
     SetMOOSTimeWarp(1.0);
+
+    //the comms threads record into the same ring as we do
+    m_Comms.SetTraceRing(&m_TraceRing);
     
 #ifdef ASYNCHRONOUS_CLIENT
     m_pMailEvent = new Poco::Event;
@@ -163,6 +174,13 @@ CMOOSApp::CMOOSApp()
 
 CMOOSApp::~CMOOSApp()
 {
+    //let any dump in progress finish before the ring goes
+    if(m_TraceDumpThread.IsThreadRunning())
+    {
+        m_TraceDumpQueue.Push("");
+        m_TraceDumpThread.Stop();
+    }
+
 #ifdef ASYNCHRONOUS_CLIENT
     delete m_pMailEvent;
 #endif
@@ -208,6 +226,8 @@ void CMOOSApp::PrintDefaultCommandLineSwitches()
     std::cout<<"  --moos_suicide_channel=<str>: suicide monitoring channel (IP address) \n";
     std::cout<<"  --moos_suicide_port=<int>   : suicide monitoring port  \n";
     std::cout<<"  --moos_suicide_phrase=<str> : suicide pass phrase  \n";
+    std::cout<<"  --moos_trace_file=<string>  : file trace is written to (.bin for binary) \n";
+    std::cout<<"  --moos_trace_capacity=<int> : number of trace events kept \n";
 
 	std::cout<<"\nflags:\n";
 	std::cout<<"  --moos_iterate_no_comms     : enable iterate without comms \n";
@@ -219,6 +239,8 @@ void CMOOSApp::PrintDefaultCommandLineSwitches()
 	std::cout<<"  --moos_no_colour            : disable colour printing \n";
     std::cout<<"  --moos_suicide_disable      : disable suicide monitoring \n";
     std::cout<<"  --moos_suicide_print        : print suicide conditions \n";
+    std::cout<<"  --moos_trace                : record timing of each cycle \n";
+    std::cout<<"  --moos_latency_trace        : stamp posts so end to end latency is measured \n";
 
 
 
@@ -425,6 +447,96 @@ bool CMOOSApp::Run( const std::string & sName,
 }
 
 
+bool CMOOSApp::StartHeadless(const std::string & sName,
+                             const std::string & sMissionFile,
+                             double dfStartTime)
+{
+    m_sAppName = sName;
+    m_sMissionFile = sMissionFile;
+    m_MissionReader.SetAppName(m_sAppName);
+
+    if(m_sMOOSName.empty())
+        m_sMOOSName = m_sAppName;
+
+    m_bHeadless = true;
+
+    if(!Configure())
+    {
+        std::cerr<<"configure returned false. Quitting\n";
+        return false;
+    }
+
+    //the driver is the clock - there is no MOOSDB to step with
+    m_bLockStep = false;
+    EnableMOOSVirtualTime(true);
+    SetMOOSVirtualTime(dfStartTime);
+
+    m_dfAppStartTime = MOOSTime();
+
+    //connecting is immediate and calls OnConnectToServer()
+    m_Comms.SetOnConnectCallBack(MOOSAPP_OnConnect,this);
+    m_Comms.SetOnDisconnectCallBack(MOOSAPP_OnDisconnect,this);
+    m_Comms.RunHeadless(m_sMOOSName);
+
+    if(!OnStartUpPrepare())
+        return MOOSFail("Derived OnStartUpPrepare() returned false... Quitting\n");
+
+    if(!OnStartUp())
+        return MOOSFail("Derived OnStartUp() returned false... Quitting\n");
+
+    if(!OnStartUpComplete())
+        return MOOSFail("Derived OnStartUpComplete() returned false... Quitting\n");
+
+    return true;
+}
+
+bool CMOOSApp::HeadlessStep(double dfTime,MOOSMSG_LIST & Mail,bool bIterate)
+{
+    if(!m_bHeadless)
+        return MOOSFail("CMOOSApp::HeadlessStep() called on an app not started headless");
+
+    SetMOOSVirtualTime(dfTime);
+    m_dfLastRunTime = MOOSLocalTime();
+
+    if(!Mail.empty())
+    {
+        if(m_bSortMailByTime)
+            Mail.sort(MOOSMsgTimeSorter);
+
+        OnNewMailPrivate(Mail);
+        OnNewMail(Mail);
+        m_nMailCount++;
+    }
+
+    IteratePrivate();
+
+    if(bIterate)
+    {
+        bool bOK = OnIteratePrepare();
+        if(m_bQuitOnIterateFail && !bOK)
+            return false;
+
+        bOK = Iterate();
+        if(m_bQuitOnIterateFail && !bOK)
+            return false;
+
+        bOK = OnIterateComplete();
+        if(m_bQuitOnIterateFail && !bOK)
+            return false;
+    }
+
+    m_nIterateCount++;
+
+    return !m_bQuitRequested;
+}
+
+double CMOOSApp::GetHeadlessPeriod()
+{
+    //an app asking to iterate as fast as mail arrives steps at the default rate
+    double dfFreq = m_dfFreq>0 ? m_dfFreq : DEFAULT_MOOS_APP_FREQ;
+    return 1.0/dfFreq;
+}
+
 bool CMOOSApp::GetFlagFromCommandLineOrConfigurationFile(std::string sOption,bool bPrependMinusMinusForCommandLine)
 {
     bool bC,bF,bFlag;
@@ -498,8 +610,8 @@ bool CMOOSApp::Configure()
         std::cerr<<" phrase   \""<<m_SuicidalSleeper.GetPassPhrase()<<"\"\n";
     }
 
-    //are we being told to disable suicide?
-    if(!GetFlagFromCommandLineOrConfigurationFile("moos_suicide_disable"))
+    //are we being told to disable suicide? (nobody can reach a headless app)
+    if(!m_bHeadless && !GetFlagFromCommandLineOrConfigurationFile("moos_suicide_disable"))
     {
 
         //no - then allow it....
@@ -517,6 +629,24 @@ bool CMOOSApp::Configure()
 		SetMOOSTimeWarp(dfTimeWarp);
 	}
 
+    //are we being asked to run in lockstep with the MOOSDB's virtual clock?
+    bool bLockStep = false;
+    m_MissionReader.GetValue("MOOSLockStep", bLockStep);
+    if(GetFlagFromCommandLineOrConfigurationFile("moos_lockstep"))
+        bLockStep = true;
+
+    if(bLockStep)
+    {
+#ifdef ASYNCHRONOUS_CLIENT
+        m_bLockStep = true;
+        EnableMOOSVirtualTime(true);
+#else
+        std::cerr<<MOOS::ConsoleColours::Red();
+        std::cerr<<"ERROR: lockstep mode requires asynchronous comms - ignoring\n";
+        std::cerr<<MOOS::ConsoleColours::reset();
+#endif
+    }
+
     double dfTimeWarpCommsFactor = 0.0;
     if(GetParameterFromCommandLineOrConfigurationFile("moos_tw_delay_factor",dfTimeWarpCommsFactor))
     {
@@ -591,6 +721,34 @@ bool CMOOSApp::Configure()
     m_MissionReader.GetConfigurationParam("CatchCommandMessages",m_bCommandMessageFiltering);
 
 
+    //are we being asked to record the timing of each cycle?
+    m_sTraceFile = GetAppName()+"_trace.json";
+    GetParameterFromCommandLineOrConfigurationFile("moos_trace_file",m_sTraceFile);
+    //alternative
+    m_MissionReader.GetConfigurationParam("TraceFile",m_sTraceFile);
+
+    unsigned int nTraceCapacity = 0;
+    if(GetParameterFromCommandLineOrConfigurationFile("moos_trace_capacity",nTraceCapacity) ||
+            m_MissionReader.GetConfigurationParam("TraceCapacity",nTraceCapacity))
+    {
+        m_TraceRing.SetCapacity(nTraceCapacity);
+    }
+
+    //are we being asked to stamp what we post so latency can be followed?
+    bool bLatencyTrace = GetFlagFromCommandLineOrConfigurationFile("moos_latency_trace");
+    //alternative
+    m_MissionReader.GetConfigurationParam("LatencyTracing",bLatencyTrace);
+    m_Comms.EnableLatencyTracing(bLatencyTrace);
+
+    bool bTrace = GetFlagFromCommandLineOrConfigurationFile("moos_trace");
+    //alternative
+    m_MissionReader.GetConfigurationParam("TraceEvents",bTrace);
+    if(bTrace)
+    {
+        EnableTracing(true);
+    }
+
+
 	return IsConfigOK();
 
 }
@@ -646,6 +804,8 @@ void CMOOSApp::DoBanner()
 		{
 		case REGULAR_ITERATE_AND_MAIL:
 			std::cout<<" -Iterate Mode 0 :\n   |-Regular iterate and message delivery at "<<m_dfFreq<<" Hz\n";
+			if(m_bIterateOnRequest)
+				std::cout<<"   |-Iterate on request at up to "<<m_dfMaxAppTick<<" Hz\n";
 			break;
 		case COMMS_DRIVEN_ITERATE_AND_MAIL:
 			std::cout<<" |--Iterate Mode 1 :\n   |-Dynamic iterate speed driven by message delivery ";
@@ -660,6 +820,8 @@ void CMOOSApp::DoBanner()
 				std::cout<<"at an unlimited rate\n";
 			else
 				std::cout<<"at up to "<<m_dfMaxAppTick<<"Hz\n";
+			if(m_bIterateOnRequest)
+				std::cout<<"   |-Iterate on request at up to "<<m_dfMaxAppTick<<" Hz\n";
 
 			break;
 		}
@@ -670,7 +832,9 @@ void CMOOSApp::DoBanner()
 		MOOSTrace(" |\t Baseline CommsTick @ %d Hz\n",m_nCommsFreq);
 	}
 
-	if(GetMOOSTimeWarp()!=1.0)
+	if(m_bLockStep)
+		MOOSTrace(" |-Lockstep with MOOSDB virtual clock\n");
+	else if(GetMOOSTimeWarp()!=1.0)
 		MOOSTrace("\t|-Time Warp @ %.1f \n",GetMOOSTimeWarp());
 	if(m_Comms.GetCommsControlTimeWarpScaleFactor()>0.0  && GetMOOSTimeWarp()>1.0)
 	    MOOSTrace("\t|-Time Warp delay @ %.1f ms \n",m_Comms.GetCommsControlTimeWarpScaleFactor()*GetMOOSTimeWarp());
@@ -690,11 +854,19 @@ bool CMOOSApp::RequestQuit()
 
 bool CMOOSApp::DoRunWork()
 {
+	if(m_bLockStep)
+		return DoLockStepWork();
 
 	bool bIterateRequired = true;
 
+	//phases of the cycle are timed only if tracing
+	double dfCycleStart = m_TraceRing.IsEnabled() ? MOOS::TraceRing::Now() : 0.0;
+	double dfMark = dfCycleStart;
+
 	SleepAsRequired(bIterateRequired);
 
+	TraceMark("Sleep",dfMark);
+
 	//std::cerr<<"bIterate:"<<bIterateRequired<<"\n";
 
     //store for derived class use the last time iterate was called;
@@ -706,6 +878,8 @@ bool CMOOSApp::DoRunWork()
     {
         if( m_Comms.Fetch(MailIn))
         {
+            TraceMark("Fetch",dfMark,static_cast<int>(MailIn.size()));
+
             /////////////////////////////
             //   process mail
             if(m_bSortMailByTime)
@@ -718,6 +892,8 @@ bool CMOOSApp::DoRunWork()
             //classes will have their own personal versions of this
             OnNewMail(MailIn);
             
+            TraceMark("OnNewMail",dfMark,static_cast<int>(MailIn.size()));
+
             m_nMailCount++;
         }
         
@@ -726,6 +902,8 @@ bool CMOOSApp::DoRunWork()
         {
             //do private work
             IteratePrivate();
+
+            TraceMark("IteratePrivate",dfMark);
             
             if(bIterateRequired)
             {
@@ -735,14 +913,17 @@ bool CMOOSApp::DoRunWork()
                 /** called just after Iterate has finished - another place to overload*/
             	bool bOK = true;
             	bOK = OnIteratePrepare();
+            	TraceMark("OnIteratePrepare",dfMark);
             	if(m_bQuitOnIterateFail && !bOK)
             		return false;
 
 				bOK = Iterate();
+				TraceMark("Iterate",dfMark);
 				if(m_bQuitOnIterateFail && !bOK)
 					return false;
 
 				bOK = OnIterateComplete();
+				TraceMark("OnIterateComplete",dfMark);
             	if(m_bQuitOnIterateFail && !bOK)
             		return false;
 
@@ -763,6 +944,8 @@ bool CMOOSApp::DoRunWork()
 			//  do application specific processing
 			bool bOK = Iterate();
 
+			TraceMark("Iterate",dfMark);
+
 			if(m_bQuitOnIterateFail && !bOK)
 				return false;
         }
@@ -770,14 +953,125 @@ bool CMOOSApp::DoRunWork()
         m_nIterateCount++;
     }
     
-
-    
+    //and the whole cycle, sleep included
+    TraceMark("Cycle",dfCycleStart);
 
 
     return true;
     
 }
 
+bool CMOOSApp::DoLockStepWork()
+{
+	double dfCycleStart = m_TraceRing.IsEnabled() ? MOOS::TraceRing::Now() : 0.0;
+	double dfMark = dfCycleStart;
+
+#ifdef ASYNCHRONOUS_CLIENT
+	//we never sleep to pace ourselves - the MOOSDB clock does that. We
+	//just wait (briefly so as to still notice a quit request) for mail
+	if(!m_Comms.GetNumberOfUnreadMessages())
+		m_pMailEvent->tryWait(100);
+#endif
+
+	TraceMark("Wait",dfMark);
+
+	m_dfLastRunTime = MOOSLocalTime();
+
+	MOOSMSG_LIST MailIn;
+	if(m_Comms.Fetch(MailIn))
+	{
+		TraceMark("Fetch",dfMark,static_cast<int>(MailIn.size()));
+
+		if(m_bSortMailByTime)
+			MailIn.sort(MOOSMsgTimeSorter);
+
+		//this will advance the virtual clock if a tick has arrived
+		OnNewMailPrivate(MailIn);
+
+		OnNewMail(MailIn);
+
+		TraceMark("OnNewMail",dfMark,static_cast<int>(MailIn.size()));
+
+		m_nMailCount++;
+	}
+
+	//nothing more to do until the next tick arrives
+	if(!m_bLockStepTickPending || !m_Comms.IsConnected())
+	{
+		//but once in a while repeat our last acknowledgement - the DB
+		//hands out held mail (perhaps our tick) when a client writes
+		if(m_dfLockStepTick>=0 && m_Comms.IsConnected() &&
+		   MOOSLocalTime()-m_dfLockStepLastAck>1.0)
+		{
+			m_Comms.Notify(MOOS_LOCKSTEP_ACK,m_dfLockStepTick);
+			m_dfLockStepLastAck = MOOSLocalTime();
+		}
+		return true;
+	}
+
+	m_bLockStepTickPending = false;
+
+	IteratePrivate();
+
+	TraceMark("IteratePrivate",dfMark);
+
+	//is Iterate due at this time? (allow for rounding in the tick period)
+	double dfPeriod = m_dfFreq>0.0 ? 1.0/m_dfFreq : 0.0;
+	double dfNow = MOOSTime();
+	if(m_dfLockStepLastIterate<0 || dfNow-m_dfLockStepLastIterate >= dfPeriod-1e-6)
+	{
+		m_dfLockStepLastIterate = dfNow;
+
+		bool bOK = OnIteratePrepare();
+		TraceMark("OnIteratePrepare",dfMark);
+		if(m_bQuitOnIterateFail && !bOK)
+			return false;
+
+		bOK = Iterate();
+		TraceMark("Iterate",dfMark);
+		if(m_bQuitOnIterateFail && !bOK)
+			return false;
+
+		bOK = OnIterateComplete();
+		TraceMark("OnIterateComplete",dfMark);
+		if(m_bQuitOnIterateFail && !bOK)
+			return false;
+	}
+
+	m_nIterateCount++;
+
+	TraceMark("Cycle",dfCycleStart);
+
+	//tell the DB we are done with this tick - this is queued behind
+	//everything we published while handling it
+	m_Comms.Notify(MOOS_LOCKSTEP_ACK,m_dfLockStepTick);
+	m_dfLockStepLastAck = MOOSLocalTime();
+
+	return true;
+}
+
+void CMOOSApp::HandleLockStepTick(MOOSMSG_LIST & Mail)
+{
+	MOOSMSG_LIST::iterator p = Mail.begin();
+	while(p!=Mail.end())
+	{
+		if(p->IsName(MOOS_LOCKSTEP_TICK))
+		{
+			if(p->GetDouble()>m_dfLockStepTick)
+			{
+				m_dfLockStepTick = p->GetDouble();
+				SetMOOSVirtualTime(m_dfLockStepTick);
+				m_bLockStepTickPending = true;
+			}
+			p = Mail.erase(p);
+		}
+		else
+		{
+			p++;
+		}
+	}
+}
+
 bool CMOOSApp::SetIterateMode(IterateMode Mode)
 {
 	if(!m_Comms.IsAsynchronous() && Mode!=REGULAR_ITERATE_AND_MAIL)
@@ -794,6 +1088,54 @@ bool CMOOSApp::SetIterateMode(IterateMode Mode)
 
 }
 
+void CMOOSApp::EnableIterateOnRequest(bool bEnable)
+{
+	m_bIterateOnRequest = bEnable;
+}
+
+void CMOOSApp::RequestIterate()
+{
+	if(!m_bIterateOnRequest)
+		return;
+
+	m_bIterateRequested = true;
+#ifdef ASYNCHRONOUS_CLIENT
+	//wake the main thread - it checks the flag to see why it woke
+	m_pMailEvent->set();
+#endif
+}
+
+bool CMOOSApp::WaitForIterateRequest(int nSleep)
+{
+#ifdef ASYNCHRONOUS_CLIENT
+	//the mail event is also set by every arrival of mail so keep
+	//waiting until we are asked to iterate or run out of time
+	double dfWakeTime = MOOSLocalTime()+nSleep/1000.0;
+	while(!m_bIterateRequested)
+	{
+		int nRemaining = static_cast<int> (1000.0*(dfWakeTime-MOOSLocalTime()));
+		if(nRemaining<1)
+			return false;
+		m_pMailEvent->tryWait(nRemaining);
+	}
+	m_bIterateRequested = false;
+
+	//but we don't iterate faster than we are allowed to
+	double dfTimeSinceRun = MOOSLocalTime()-m_dfLastRunTime;
+	double dfMinPeriod = m_dfMaxAppTick> 0.0 ? 1.0/m_dfMaxAppTick : 0.0;
+	if(dfTimeSinceRun<dfMinPeriod)
+	{
+		int nGap = static_cast<int> (1000*(dfMinPeriod-dfTimeSinceRun));
+		if(nGap>0)
+			MOOSPause(nGap);
+	}
+	return true;
+#else
+	MOOSPause(nSleep);
+	return false;
+#endif
+}
+
 void CMOOSApp::SleepAsRequired(bool &  bIterateShouldRun)
 {
 
@@ -841,15 +1183,25 @@ void CMOOSApp::SleepAsRequired(bool &  bIterateShouldRun)
 	{
 	case  REGULAR_ITERATE_AND_MAIL:
 		//we always to sleep - this behaves like old MOOS did - AppTick governs it all
+		//unless we have been told we may be woken early
 		//std::cerr<<"sleeping for "<<nSleep<<"\n";
-		MOOSPause(nSleep);
+		if(m_bIterateOnRequest)
+			WaitForIterateRequest(nSleep);
+		else
+			MOOSPause(nSleep);
 		break;
 	case  REGULAR_ITERATE_AND_COMMS_DRIVEN_MAIL:
 		//On NewMail is called as often as is needed but iterate is only called
-		//at AppTick rates.
+		//at AppTick rates (or sooner if it has been requested)
 		if(m_Comms.GetNumberOfUnreadMessages() || m_pMailEvent->tryWait(nSleep))
 		{
-			if(MOOSLocalTime()-m_dfLastRunTime<1.0/m_dfFreq)
+			double dfTimeSinceRun = MOOSLocalTime()-m_dfLastRunTime;
+			double dfMinPeriod = m_dfMaxAppTick> 0.0 ? 1.0/m_dfMaxAppTick : 0.0;
+			if(m_bIterateRequested && dfTimeSinceRun>=dfMinPeriod)
+			{
+				m_bIterateRequested = false;
+			}
+			else if(dfTimeSinceRun<1.0/m_dfFreq)
 			{
 				//we have mail but we are in a mode where we don't have
 				//to call Iterate
@@ -1155,6 +1507,10 @@ bool CMOOSApp::ConfigureComms()
     //and one for the disconnect callback
     m_Comms.SetOnDisconnectCallBack(MOOSAPP_OnDisconnect,this);
 
+    //lockstep is a rapid exchange of small packets - don't let nagle hold them
+    if(m_bLockStep)
+        m_Comms.SetTCPNoDelay(true);
+
     //start the comms client....
     if(m_sMOOSName.empty())
         m_sMOOSName = m_sAppName;
@@ -1425,6 +1781,93 @@ CMOOSVariable * CMOOSApp::GetMOOSVar(string sName)
 }
 
 
+void CMOOSApp::EnableTracing(bool bEnable)
+{
+    m_TraceRing.Enable(bEnable);
+    if(bEnable && !m_TraceDumpThread.IsThreadRunning())
+    {
+        m_TraceDumpThread.Initialise(TraceDumpDispatch,this);
+        m_TraceDumpThread.Start();
+    }
+    if(bEnable && m_Comms.IsConnected())
+    {
+        m_Comms.Register(GetTraceDumpKey(),0);
+    }
+}
+
+bool CMOOSApp::WriteTrace(std::string sFile)
+{
+    if(sFile.empty())
+        sFile = m_sTraceFile;
+    if(sFile.empty())
+        sFile = GetAppName()+"_trace.json";
+
+    bool bOK;
+    if(sFile.size()>4 && MOOSStrCmp(sFile.substr(sFile.size()-4),".bin"))
+        bOK = m_TraceRing.WriteBinary(sFile);
+    else
+        bOK = m_TraceRing.WriteChromeTrace(sFile,GetAppName());
+
+    if(!bOK)
+        MOOSTrace("failed to write trace to \"%s\"\n",sFile.c_str());
+
+    return bOK;
+}
+
+std::string CMOOSApp::GetTraceDumpKey()
+{
+    std::string sKey = GetAppName()+"_TRACE_DUMP";
+    MOOSToUpper(sKey);
+    return sKey;
+}
+
+void CMOOSApp::LookForTraceDump(MOOSMSG_LIST & NewMail)
+{
+    MOOSMSG_LIST::iterator q;
+    for(q=NewMail.begin();q!=NewMail.end();q++)
+    {
+        if(MOOSStrCmp(q->GetKey(),GetTraceDumpKey()))
+        {
+            //an empty string (or a double) means the configured file
+            std::string sFile = q->IsString() ? q->GetString() : "";
+            MOOSTrimWhiteSpace(sFile);
+            if(sFile.empty())
+                sFile = m_sTraceFile;
+            if(sFile.empty())
+                sFile = GetAppName()+"_trace.json";
+
+            //writing a large ring takes a while so it is done off the
+            //Run loop (an empty name is reserved for stopping the thread)
+            m_TraceDumpQueue.Push(sFile);
+        }
+    }
+}
+
+bool CMOOSApp::TraceDumpDispatch(void * pParam)
+{
+    CMOOSApp* pMe = static_cast<CMOOSApp*> (pParam);
+    return pMe->TraceDumpLoop();
+}
+
+bool CMOOSApp::TraceDumpLoop()
+{
+    while(!m_TraceDumpThread.IsQuitRequested())
+    {
+        while(m_TraceDumpQueue.IsEmpty())
+        {
+            m_TraceDumpQueue.WaitForPush(1000);
+        }
+
+        std::string sFile;
+        m_TraceDumpQueue.Pull(sFile);
+        if(sFile.empty())
+            return true;
+
+        WriteTrace(sFile);
+    }
+    return true;
+}
+
 std::string CMOOSApp::GetCommandKey()
 {
     std::string sCommandKey = GetAppName()+"_CMD";
@@ -1521,14 +1964,35 @@ void CMOOSApp::OnConnectToServerPrivate()
     {
         m_Comms.Register(GetCommandKey(),0);
     }
+
+    if(m_TraceRing.IsEnabled())
+    {
+        m_Comms.Register(GetTraceDumpKey(),0);
+    }
+
+    if(m_bLockStep)
+    {
+        //register for ticks before announcing ourselves so we
+        //cannot miss the first one
+        m_Comms.Register(MOOS_LOCKSTEP_TICK,0);
+        m_Comms.Notify(MOOS_LOCKSTEP_JOIN,GetAppName());
+    }
 }
 
 /** here we do our private mail processing*/
 void CMOOSApp::OnNewMailPrivate(MOOSMSG_LIST & Mail)
 {
+    //in lockstep the clock moves before anyone looks at the mail
+    if(m_bLockStep)
+        HandleLockStepTick(Mail);
+
     //look to handle a command string
     if(m_bCommandMessageFiltering)
         LookForAndHandleAppCommand(Mail);
+
+    //are we being asked to write out our trace?
+    if(m_TraceRing.IsEnabled())
+        LookForTraceDump(Mail);
 }
 
 void CMOOSApp::IteratePrivate()
@@ -1538,6 +2002,12 @@ void CMOOSApp::IteratePrivate()
         std::string sStatus = MOOSToUpper(GetAppName())+"_STATUS";
         MOOSToUpper(sStatus);
         m_Comms.Notify(sStatus,MakeStatusString());
+
+        //and if traced mail has been arriving say how late it was
+        std::string sLatency;
+        if(m_Comms.GetLatencySummary(sLatency))
+            m_Comms.Notify(MOOSToUpper(GetAppName())+"_LATENCY",sLatency);
+
         m_dfLastStatusTime = MOOSTime();
     }
 }
@@ -36,6 +36,9 @@
 #include "MOOS/libMOOS/Utils/CommandLineParser.h"
 #include "MOOS/libMOOS/Utils/ProcInfo.h"
 #include "MOOS/libMOOS/Utils/Macros.h"
+#include "MOOS/libMOOS/Utils/TraceRing.h"
+#include "MOOS/libMOOS/Utils/SafeList.h"
+#include "MOOS/libMOOS/Utils/MOOSThread.h"
 
 
 #include "MOOS/libMOOS/Comms/MOOSCommClient.h"
@@ -103,6 +106,35 @@ public:
 	/** requests the MOOSApp to quit (i.e return from Run)*/
 	bool RequestQuit();
 
+    /**start the application without a MOOSDB so that another program can
+    drive it one step at a time with HeadlessStep(). The mission file is read
+    and OnConnectToServer() and OnStartUp() are called as by Run() but no
+    threads are started and the MOOS clock is virtual, beginning at dfStartTime
+    @param sName The name of this application
+    @param the name of the mission file
+    @param the (virtual) time at which the application starts*/
+    bool StartHeadless(const std::string & sName,const std::string & sMissionFile,double dfStartTime);
+
+    /**run one cycle of a headless application at virtual time dfTime: hand it
+    Mail (if any) and then, if bIterate, call Iterate()
+    @return false if the application asks to quit*/
+    bool HeadlessStep(double dfTime,MOOSMSG_LIST & Mail,bool bIterate=true);
+
+    /**the (virtual) time between steps of a headless application: 1/AppTick*/
+    double GetHeadlessPeriod();
+
+    /**collect (and clear) the mail posted by a headless application*/
+    bool FetchHeadlessOutput(MOOSMSG_LIST & MsgList){return m_Comms.FetchHeadless(MsgList);};
+
+    /**would a MOOSDB deliver this variable from this source to a headless application?*/
+    bool WantsHeadlessMail(const std::string & sVar,const std::string & sSrc){return m_Comms.WantsHeadlessMail(sVar,sSrc);};
+
+    /**changes whenever a headless application registers or unregisters for mail*/
+    unsigned int GetHeadlessRegistrationCount(){return m_Comms.GetHeadlessRegistrationCount();};
+
+    /** returns true if the app is being driven without a MOOSDB*/
+    bool IsHeadless(){return m_bHeadless;};
+
 	 /**
 	 * pass in a copy of any command line parameters so options can be
 	 * queried later
@@ -402,6 +434,10 @@ protected:
 
 
 
+    /** timing of the Run loop and comms threads (declared before m_Comms
+     * so it outlives the comms threads which write to it)*/
+    MOOS::TraceRing m_TraceRing;
+
     /** The MOOSComms node. All communications happens by way of this object.*/
 #ifdef ASYNCHRONOUS_CLIENT
     MOOS::MOOSAsyncCommClient m_Comms;
@@ -435,6 +471,16 @@ protected:
 	//set up the iteration mode of the app
 	bool SetIterateMode(IterateMode Mode);
 
+    /** allow RequestIterate() to cut short the sleep between iterations.
+     * Iterate will then run as soon as it is requested, but never faster
+     * than the max app tick allows, and at the AppTick otherwise*/
+    void EnableIterateOnRequest(bool bEnable = true);
+
+    /** ask for Iterate to be called as soon as possible. Can be called from
+     * any thread (typically an active queue callback) and has no effect
+     * unless EnableIterateOnRequest() has been called*/
+    void RequestIterate();
+
     /** return the boot time of the App */
     double GetAppStartTime();
 
@@ -443,6 +489,9 @@ protected:
 
 	/** A function which Run eventually calls which itself  calls on NewMail and Iterate*/
     bool DoRunWork();
+
+    /** returns true if the app is running in lockstep with the MOOSDB's virtual clock*/
+    bool IsLockStep(){return m_bLockStep;};
     
     /** sets the error state of the app and a comment  - this is published as a field in <PROCNAME>_STATUS */
     void SetAppError(bool bFlag, const std::string & sReason);
@@ -450,6 +499,29 @@ protected:
     /** make the whole application print not many things */
 	bool SetQuiet(bool bQuiet);
 
+    /** start or stop recording how long each phase of the Run loop (and
+     * the comms threads) takes. Can also be turned on with --moos_trace or
+     * TraceEvents=true in the configuration block. When tracing is enabled
+     * writing a file name to <APPNAME>_TRACE_DUMP writes out the trace.
+     * The comms threads are only traced when the app is built with the
+     * asynchronous client (MOOSAsyncCommClient) - with the older
+     * synchronous client just the Run loop phases are recorded*/
+    void EnableTracing(bool bEnable=true);
+
+    /** true if the Run loop is being traced*/
+    bool IsTracing(){return m_TraceRing.IsEnabled();};
+
+    /** the ring in which trace events are recorded - derived classes
+     * may add their own spans to it*/
+    MOOS::TraceRing & GetTraceRing(){return m_TraceRing;};
+
+    /** write out the trace. Files ending in .bin are written in binary,
+     * anything else as Chrome trace JSON. This blocks while the file is
+     * written - requests made through <APPNAME>_TRACE_DUMP are instead
+     * handed to a worker thread so the Run loop is not held up.
+     * @param sFile file name - if empty the TraceFile configuration is used*/
+    bool WriteTrace(std::string sFile="");
+
 	
 
     /////////////////////////////////////////////////////////////////////////////////////////////
@@ -706,6 +778,12 @@ private:
     Poco::Event * m_pMailEvent;
 #endif
 
+    /** can RequestIterate() wake us?*/
+    bool m_bIterateOnRequest;
+
+    /** set by RequestIterate() and cleared when we wake because of it*/
+    volatile bool m_bIterateRequested;
+
 
     /** Number of times Application has cycled */
     int m_nIterateCount;
@@ -722,6 +800,69 @@ private:
 
     /** controls the rate at which application runs */
     void SleepAsRequired(bool & bIterateShouldRun);
+
+    /** sleep for up to nSleep ms returning early (but no sooner than the
+     max app tick allows) if RequestIterate() is called
+     @return true if woken by a request*/
+    bool WaitForIterateRequest(int nSleep);
+
+    /** replaces DoRunWork() when in lockstep mode - never sleeps, waits for
+     the MOOSDB to issue the next tick of its virtual clock, iterates if
+     AppTick says it is due at that time and then acknowledges the tick*/
+    bool DoLockStepWork();
+
+    /** pull any lockstep tick out of the mail and advance the virtual clock*/
+    void HandleLockStepTick(MOOSMSG_LIST & NewMail);
+
+    /** the name of the variable which asks us to write out our trace*/
+    std::string GetTraceDumpKey();
+
+    /** look for a request to write out the trace and queue it for the
+     * dump thread*/
+    void LookForTraceDump(MOOSMSG_LIST & NewMail);
+
+    /** the dump thread's loop - writes each queued file until it pulls
+     * an empty name*/
+    bool TraceDumpLoop();
+    static bool TraceDumpDispatch(void * pParam);
+
+    /** record a span from dfStart to now and move dfStart on to now*/
+    void TraceMark(const char * sName, double & dfStart, int nValue=-1)
+    {
+        if(m_TraceRing.IsEnabled())
+        {
+            double dfNow = MOOS::TraceRing::Now();
+            m_TraceRing.Span(sName,dfStart,dfNow,nValue);
+            dfStart = dfNow;
+        }
+    }
+
+    /** default file the trace is written to*/
+    std::string m_sTraceFile;
+
+    /** files waiting to be written by the dump thread*/
+    MOOS::SafeList<std::string> m_TraceDumpQueue;
+
+    /** writes out the trace so a big ring does not stall the Run loop*/
+    CMOOSThread m_TraceDumpThread;
+
+    /** true if running in lockstep with the MOOSDB*/
+    bool m_bLockStep;
+
+    /** true if being driven without a MOOSDB (see StartHeadless())*/
+    bool m_bHeadless;
+
+    /** true if a tick has arrived which has not yet been acknowledged*/
+    bool m_bLockStepTickPending;
+
+    /** the time of the last tick received from the MOOSDB*/
+    double m_dfLockStepTick;
+
+    /** the (virtual) time at which Iterate was last called in lockstep*/
+    double m_dfLockStepLastIterate;
+
+    /** the (local) time at which we last acknowledged a tick*/
+    double m_dfLockStepLastAck;
 	
 	/** ::Run continues forever or until this variable is false*/
 	bool m_bQuitRequested;
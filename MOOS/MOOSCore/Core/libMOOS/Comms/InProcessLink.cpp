@@ -0,0 +1,166 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//   This file is part of the MOOS project
+//
+//   MOOS : Mission Oriented Operating Suite A suit of 
+//   Applications and Libraries for Mobile Robotics Research 
+//   Copyright (C) Paul Newman
+//    
+//   This file was written by MOOS contributors 
+//   
+//   email: pnewman@robots.ox.ac.uk. 
+//              
+//   This source code and the accompanying materials
+//   are made available under the terms of the GNU Lesser Public License v2.1
+//   which accompanies this distribution, and is available at
+//   http://www.gnu.org/licenses/lgpl.txt distributed in the hope that it will be useful, 
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of 
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. 
+//
+////////////////////////////////////////////////////////////////////////////
+
+
+/*
+ * InProcessLink.cpp
+ *
+ *  A link between a MOOSAsyncCommClient and a ThreadedCommServer which
+ *  live in the same process.
+ */
+
+#include <map>
+
+#include "MOOS/libMOOS/Utils/MOOSUtilityFunctions.h"
+#include "MOOS/libMOOS/Utils/MOOSScopedLock.h"
+#include "MOOS/libMOOS/Comms/InProcessLink.h"
+#include "MOOS/libMOOS/Comms/ThreadedCommServer.h"
+#include "MOOS/libMOOS/Comms/MOOSAsyncCommClient.h"
+
+namespace MOOS
+{
+
+//the servers which clients in this process can reach without a socket
+//indexed by the port on which they listen
+static std::map<long,ThreadedCommServer*> gInProcessServers;
+static CMOOSLock gInProcessServersLock;
+
+//we will only short circuit connections which were destined for this machine
+static bool IsLocalHost(const std::string & sHost)
+{
+    return MOOSStrCmp(sHost,"localhost") ||
+           sHost=="127.0.0.1" ||
+           MOOSStrCmp(sHost,CMOOSCommObject::GetLocalIPAddress());
+}
+
+InProcessLink::InProcessLink(const std::string & sClientName,
+                             MOOSAsyncCommClient* pClient,
+                             ThreadedCommServer* pServer):
+    m_sClientName(sClientName),
+    m_pClient(pClient),
+    m_pServer(pServer)
+{
+}
+
+bool InProcessLink::SendToServer(MOOSMsgListPtr pMsgs)
+{
+    MOOS::ScopedLock L(m_Lock);
+
+    if(m_pServer==NULL)
+        return false;
+
+    return m_pServer->OnInProcessPkt(m_sClientName,pMsgs);
+}
+
+bool InProcessLink::SendToClient(MOOSMsgListPtr pMsgs)
+{
+    MOOS::ScopedLock L(m_Lock);
+
+    if(m_pClient==NULL)
+        return false;
+
+    //this only queues the mail - the client delivers it on its own thread
+    return m_pClient->OnInProcessMail(pMsgs);
+}
+
+void InProcessLink::DetachClient()
+{
+    MOOS::ScopedLock L(m_Lock);
+
+    //let the server know we are leaving - it will tidy up in its own time
+    if(m_pServer!=NULL)
+        m_pServer->OnInProcessClose(m_sClientName);
+
+    m_pClient = NULL;
+}
+
+void InProcessLink::DetachServer()
+{
+    MOOS::ScopedLock L(m_Lock);
+    m_pServer = NULL;
+}
+
+bool InProcessLink::IsOpen()
+{
+    MOOS::ScopedLock L(m_Lock);
+    return m_pServer!=NULL && m_pClient!=NULL;
+}
+
+bool InProcessLink::AddServer(long lPort, ThreadedCommServer* pServer)
+{
+    MOOS::ScopedLock L(gInProcessServersLock);
+
+    if(gInProcessServers.find(lPort)!=gInProcessServers.end())
+        return false;
+
+    gInProcessServers[lPort] = pServer;
+    return true;
+}
+
+bool InProcessLink::RemoveServer(long lPort, ThreadedCommServer* pServer)
+{
+    MOOS::ScopedLock L(gInProcessServersLock);
+
+    std::map<long,ThreadedCommServer*>::iterator q = gInProcessServers.find(lPort);
+    if(q==gInProcessServers.end() || q->second!=pServer)
+        return false;
+
+    gInProcessServers.erase(q);
+    return true;
+}
+
+bool InProcessLink::HasServer(const std::string & sHost, long lPort)
+{
+    if(!IsLocalHost(sHost))
+        return false;
+
+    MOOS::ScopedLock L(gInProcessServersLock);
+    return gInProcessServers.find(lPort)!=gInProcessServers.end();
+}
+
+Poco::SharedPtr<InProcessLink> InProcessLink::Connect(const std::string & sHost,
+                                                      long lPort,
+                                                      const std::string & sClientName,
+                                                      MOOSAsyncCommClient* pClient,
+                                                      std::string & sCommunity,
+                                                      std::string & sWhyNot)
+{
+    Poco::SharedPtr<InProcessLink> pLink;
+
+    if(!IsLocalHost(sHost))
+        return pLink;
+
+    //hold the registry while we connect so the server cannot vanish beneath us
+    MOOS::ScopedLock L(gInProcessServersLock);
+
+    std::map<long,ThreadedCommServer*>::iterator q = gInProcessServers.find(lPort);
+    if(q==gInProcessServers.end())
+        return pLink;
+
+    pLink = new InProcessLink(sClientName,pClient,q->second);
+
+    if(!q->second->AddInProcessClient(pLink,sCommunity,sWhyNot))
+        pLink = NULL;
+
+    return pLink;
+}
+
+}
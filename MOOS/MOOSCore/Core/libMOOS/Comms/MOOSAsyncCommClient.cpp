@@ -71,6 +71,7 @@ MOOSAsyncCommClient::MOOSAsyncCommClient() {
     m_dfLastTimingMessage = 0.0;
     m_dfOutGoingDelay = 0.0;
     m_bPostNewestToFront = false;
+    m_bInProcess = false;
 
 //    SetCommsControlTimeWarpScaleFactor(0.0);
 }
@@ -134,6 +135,10 @@ bool MOOSAsyncCommClient::Post(CMOOSMsg & Msg, bool bKeepMsgSourceName) {
     if(!BASE::Post(Msg, bKeepMsgSourceName))
         return false;
 
+    //headless mail is kept by the base class
+    if(IsHeadless())
+        return true;
+
     m_OutLock.Lock();
     {
         if (OutGoingQueue_.Size() > OUTBOX_PENDING_LIMIT) {
@@ -154,7 +159,32 @@ bool MOOSAsyncCommClient::Post(CMOOSMsg & Msg, bool bKeepMsgSourceName) {
 }
 
 bool MOOSAsyncCommClient::OnCloseConnection() {
-    return BASE::OnCloseConnection();
+
+    if(!m_bInProcess)
+        return BASE::OnCloseConnection();
+
+    //there is no socket to close - just tell the DB we are going
+    m_bConnected = false;
+    m_bInProcess = false;
+
+    m_pInProcessLink->DetachClient();
+    m_pInProcessLink = NULL;
+    InProcessMailQueue_.Clear();
+
+    ClearResources();
+
+    bool bUserResult = true;
+    if(m_pfnDisconnectCallBack!=NULL)
+    {
+        //invoke user defined callback
+        bUserResult = (*m_pfnDisconnectCallBack)(m_pDisconnectCallBackParam);
+    }
+
+    return bUserResult;
+}
+
+bool MOOSAsyncCommClient::IsInProcess() {
+    return m_bInProcess;
 }
 
 bool MOOSAsyncCommClient::IsAsynchronous() {
@@ -178,6 +208,47 @@ bool MOOSAsyncCommClient::WritingLoop() {
 
     while (!WritingThread_.IsQuitRequested())
     {
+        //is the DB we want being served from within this very process?
+        //if so there is no need for a socket at all
+        if (InProcessLink::HasServer(m_sDBHost, m_lPort))
+        {
+            if (!ConnectInProcess())
+            {
+                //as for a failed handshake - we are not welcome
+                break;
+            }
+
+            if (IsConnected())
+            {
+                ApplyRecurrentSubscriptions();
+
+                m_nMsgsSent = 0;
+
+                while (!WritingThread_.IsQuitRequested() && IsConnected())
+                {
+                    if (OutGoingQueue_.Size()==0)
+                    {
+                        OutGoingQueue_.WaitForPush(333);
+                    }
+
+                    if (!DoWriting())
+                    {
+                        OnCloseConnection();
+                    }
+                }
+
+                //if we are quitting make sure the DB can no longer reach us
+                if (m_bInProcess)
+                {
+                    m_bConnected = false;
+                    m_bInProcess = false;
+                    m_pInProcessLink->DetachClient();
+                    m_pInProcessLink = NULL;
+                    InProcessMailQueue_.Clear();
+                }
+            }
+            continue;
+        }
 
         //this is the connect loop...
         m_pSocket = new XPCTcpSocket(m_lPort);
@@ -261,8 +332,20 @@ bool MOOSAsyncCommClient::DoWriting() {
 
         MOOSMSG_LIST StuffToSend;
 
+        bool bTrace = IsTracing();
+        double dfStart = 0.0;
+        if (bTrace)
+        {
+            dfStart = MOOS::TraceRing::Now();
+            m_pTraceRing->Count("OutBox",
+                                static_cast<int>(OutGoingQueue_.Size()),
+                                MOOS::TraceRing::TRACK_COMMS_WRITER);
+        }
+
         OutGoingQueue_.AppendToOtherInConstantTime(StuffToSend);
 
+        int nToSend = static_cast<int>(StuffToSend.size());
+
         for (MOOSMSG_LIST::iterator q = StuffToSend.begin(); q
                 != StuffToSend.end(); q++)
         {
@@ -274,6 +357,33 @@ bool MOOSAsyncCommClient::DoWriting() {
             m_nMsgsSent++;
         }
 
+        if (m_bInProcess)
+        {
+            //a DB in this process shares our clock so there is no need
+            //for timing messages - simply hand over the list
+            if (!m_pInProcessLink->IsOpen())
+                return false;
+
+            if (StuffToSend.empty())
+                return true;
+
+            MOOSMsgListPtr pMsgs(new MOOSMSG_LIST);
+            pMsgs->swap(StuffToSend);
+
+            if (!m_pInProcessLink->SendToServer(pMsgs))
+                return false;
+
+            if (bTrace)
+            {
+                m_pTraceRing->Span("Write", dfStart, MOOS::TraceRing::Now(),
+                                   nToSend, MOOS::TraceRing::TRACK_COMMS_WRITER);
+            }
+
+            MonitorAndLimitWriteSpeed();
+
+            return true;
+        }
+
         //and once in a while we shall send a timing
         //message (this is the new style of timing
         if ((MOOSLocalTime(false) - m_dfLastTimingMessage) > TIMING_MESSAGE_PERIOD)
@@ -306,6 +416,12 @@ bool MOOSAsyncCommClient::DoWriting() {
         //finally the send....
         SendPkt(m_pSocket, PktTx);
 
+        if (bTrace)
+        {
+            m_pTraceRing->Span("Write", dfStart, MOOS::TraceRing::Now(),
+                               nToSend, MOOS::TraceRing::TRACK_COMMS_WRITER);
+        }
+
         MonitorAndLimitWriteSpeed();
 
     } catch (const CMOOSException & e) {
@@ -354,7 +470,7 @@ bool MOOSAsyncCommClient::ReadingLoop() {
 
     while (!ReadingThread_.IsQuitRequested())
     {
-        if (IsConnected())
+        if (IsConnected() && !m_bInProcess)
         {
             if (!DoReading())
             {
@@ -371,8 +487,12 @@ bool MOOSAsyncCommClient::ReadingLoop() {
         }
         else
         {
-            //we arent connected so do nothing...
-            MOOSPause(100);
+            //we arent connected (or mail arrives via an in process link)
+            //so just wait for anything an in process DB hands over
+            if (InProcessMailQueue_.IsEmpty())
+                InProcessMailQueue_.WaitForPush(100);
+
+            DoInProcessReading();
         }
     }
     //std::cerr<<"READING LOOP quiting...\n";
@@ -384,6 +504,148 @@ bool MOOSAsyncCommClient::IsRunning() {
     return WritingThread_.IsThreadRunning() || ReadingThread_.IsThreadRunning();
 }
 
+bool MOOSAsyncCommClient::ConnectInProcess()
+{
+    if(!m_bQuiet)
+    {
+        MOOSTrace("\n-------------- moos connect ----------------------\n");
+        MOOSTrace("  contacting a MOOS server %s:%d -  in this process\n",m_sDBHost.c_str(),m_lPort);
+        std::cout<<"\n";
+        std::cout<<std::left<<std::setw(40)<<("  Handshaking as "+m_sMyName);
+    }
+
+    std::string sCommunity,sWhyNot;
+    MOOSInProcessLinkPtr pLink = InProcessLink::Connect(m_sDBHost,
+                                                        m_lPort,
+                                                        m_sMyName,
+                                                        this,
+                                                        sCommunity,
+                                                        sWhyNot);
+    if(pLink.isNull())
+    {
+        if(!sWhyNot.empty())
+        {
+            if(!m_bQuiet)
+            {
+                std::cerr<<MOOS::ConsoleColours::Red()<<"[fail]\n";
+                std::cerr<<"    \""<<sWhyNot<<"\"\n";
+                std::cerr<<MOOS::ConsoleColours::reset();
+                MOOSTrace("--------------------------------------------------\n\n");
+            }
+            m_bQuit = true;
+            return false;
+        }
+
+        //the server went away as we called - try again later
+        if(!m_bQuiet)
+            MOOSTrace("\n");
+        MOOSPause(100);
+        return true;
+    }
+
+    if(!m_bQuiet)
+    {
+        std::cout<<MOOS::ConsoleColours::Green()<<"[ok]\n";
+        std::cout<<MOOS::ConsoleColours::reset();
+        std::cout<<std::left<<std::setw(40);
+        std::cout<<"  Transport is ";
+        std::cout<<MOOS::ConsoleColours::Green()<<"[in-process]\n";
+        std::cout<<MOOS::ConsoleColours::reset();
+        MOOSTrace("--------------------------------------------------\n\n");
+    }
+
+    //we share a clock with the DB
+    if(m_bDoLocalTimeCorrection)
+        SetMOOSSkew(0);
+    DoLocalTimeCorrection(false);
+
+    m_sCommunityName = sCommunity;
+    m_bDBIsAsynchronous = true;
+    m_dfOutGoingDelay = 0.0;
+
+    m_pInProcessLink = pLink;
+    m_bInProcess = true;
+    m_bConnected = true;
+
+    if(m_pfnConnectCallBack!=NULL)
+    {
+        //invoke user defined callback
+        bool bUserResult = (*m_pfnConnectCallBack)(m_pConnectCallBackParam);
+        if(!bUserResult)
+        {
+            if(!m_bQuiet)
+                MOOSTrace("  Invoking User OnConnect() callback...FAIL");
+        }
+    }
+
+    //look to turn on status monitoring
+    ControlClientCommsStatusMonitoring(m_bMonitorClientCommsStatus);
+
+    return true;
+}
+
+bool MOOSAsyncCommClient::OnInProcessMail(MOOSMsgListPtr pMail)
+{
+    //we are on the DB's thread - don't hold it up with our work
+    InProcessMailQueue_.Push(pMail);
+    return true;
+}
+
+bool MOOSAsyncCommClient::DoInProcessReading()
+{
+    MOOSMSG_LIST Mail;
+    MOOSMsgListPtr pMail;
+    while (InProcessMailQueue_.Pull(pMail))
+        Mail.splice(Mail.end(),*pMail);
+
+    if (Mail.empty())
+        return false;
+
+    bool bTrace = IsTracing();
+    double dfStart = bTrace ? MOOS::TraceRing::Now() : 0.0;
+    int nDelivered = static_cast<int>(Mail.size());
+    int nInBox = 0;
+
+    m_InLock.Lock();
+    {
+        if(m_InBox.size()>m_nInPendingLimit)
+        {
+            MOOSTrace("Too many unread incoming messages [%d] : purging\n",m_InBox.size());
+            MOOSTrace("The user must read mail occasionally");
+            m_InBox.clear();
+        }
+
+        m_nPktsReceived++;
+        m_nMsgsReceived+=Mail.size();
+
+        m_InBox.splice(m_InBox.end(),Mail);
+
+        DispatchInBoxToActiveThreads();
+
+        m_bMailPresent = !m_InBox.empty();
+        nInBox = static_cast<int>(m_InBox.size());
+    }
+    m_InLock.UnLock();
+
+    if(bTrace)
+    {
+        m_pTraceRing->Span("Deliver",dfStart,MOOS::TraceRing::Now(),
+                           nDelivered,MOOS::TraceRing::TRACK_COMMS_READER);
+        m_pTraceRing->Count("InBox",nInBox,MOOS::TraceRing::TRACK_COMMS_READER);
+    }
+
+    //and here we can optionally give users an indication
+    //that mail has arrived...
+    if(m_pfnMailCallBack!=NULL && m_bMailPresent)
+    {
+        bool bUserResult = (*m_pfnMailCallBack)(m_pMailCallBackParam);
+        if(!bUserResult)
+            MOOSTrace("user mail callback returned false..is all ok?\n");
+    }
+
+    return true;
+}
+
 bool MOOSAsyncCommClient::DoReading()
 {
 
@@ -397,6 +659,11 @@ bool MOOSAsyncCommClient::DoReading()
 
 		m_nBytesReceived+=PktRx.GetStreamLength();
 
+		//time from the packet arriving to the mail being in the inbox
+		bool bTrace = IsTracing();
+		double dfStart = bTrace ? MOOS::TraceRing::Now() : 0.0;
+		uint64_t nReceivedBefore = m_nMsgsReceived;
+		int nInBox = 0;
 
 		double dfLocalRxTime =MOOSLocalTime();
 
@@ -482,10 +749,19 @@ bool MOOSAsyncCommClient::DoReading()
 
 			m_bMailPresent = !m_InBox.empty();
 
+			nInBox = static_cast<int>(m_InBox.size());
 
 		}
 		m_InLock.UnLock();
 
+		if(bTrace)
+		{
+			int nNewMail = static_cast<int>(m_nMsgsReceived-nReceivedBefore);
+			m_pTraceRing->Span("Read",dfStart,MOOS::TraceRing::Now(),
+					nNewMail,MOOS::TraceRing::TRACK_COMMS_READER);
+			m_pTraceRing->Count("InBox",nInBox,MOOS::TraceRing::TRACK_COMMS_READER);
+		}
+
 		//and here we can optionally give users an indication
 		//that mail has arrived...
 		if(m_pfnMailCallBack!=NULL && m_bMailPresent)
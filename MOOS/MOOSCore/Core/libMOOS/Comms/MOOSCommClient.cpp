@@ -108,8 +108,13 @@ CMOOSCommClient::CMOOSCommClient()
 	m_nNextMsgID=0;
 	m_bFakeSource = false;
     m_bQuiet= false;
+    m_pTraceRing = NULL;
+    m_bLatencyTracing = false;
     m_bMonitorClientCommsStatus = false;
 
+    m_bHeadless = false;
+    m_nHeadlessRegistrations = 0;
+
     m_nMsgsReceived = 0;
     m_nMsgsSent = 0;
     m_nPktsReceived = 0;
@@ -825,8 +830,9 @@ bool CMOOSCommClient::DispatchInBoxToActiveThreads()
 			    {
 			        //wildcard queues are not interested
 			        //no standard queue is interested
-			        //nothing to do....
-			        return true;
+			        //leave it in the inbox and look at the next one
+			        ++t;
+			        continue;
 			    }
 			}
 		}
@@ -1009,6 +1015,11 @@ bool CMOOSCommClient::Post(CMOOSMsg &Msg, bool bKeepMsgSourceName)
 	}
 	
 
+	if(m_bLatencyTracing && Msg.IsType(MOOS_NOTIFY))
+	{
+		Msg.SetTraceStamp(CMOOSMsg::TRACE_CLIENT_SEND);
+	}
+
 	if(Msg.IsType(MOOS_SERVER_REQUEST))
 	{
 		Msg.m_nID=MOOS_SERVER_REQUEST_ID;	
@@ -1019,6 +1030,14 @@ bool CMOOSCommClient::Post(CMOOSMsg &Msg, bool bKeepMsgSourceName)
 		Msg.m_nID=m_nNextMsgID++;
 	}
 
+	//with no MOOSDB there is nowhere to send it
+	if(m_bHeadless)
+	{
+		HeadlessPost(Msg);
+		m_OutLock.UnLock();
+		return true;
+	}
+
 
 	if(m_bPostNewestToFront)
 		m_OutBox.push_front(Msg);
@@ -1076,9 +1095,70 @@ bool CMOOSCommClient::Fetch(MOOSMSG_LIST &MsgList)
 
 	m_InLock.UnLock();
 
+	RecordLatency(MsgList);
+
 	return !MsgList.empty();
 }
 
+void CMOOSCommClient::RecordLatency(MOOSMSG_LIST & MsgList)
+{
+	double dfNow = -1;
+	MOOSMSG_LIST::iterator q;
+	for(q = MsgList.begin();q!=MsgList.end();q++)
+	{
+		if(!q->IsTraced())
+			continue;
+
+		if(dfNow<0)
+		{
+			dfNow = CMOOSMsg::GetTraceTime();
+			m_LatencyLock.Lock();
+		}
+
+		q->SetTraceStamp(CMOOSMsg::TRACE_CLIENT_DISPATCH,dfNow);
+
+		double dfStamp;
+		if(q->GetTraceStamp(CMOOSMsg::TRACE_CLIENT_SEND,dfStamp))
+			m_TotalLatency[q->GetKey()].Add(dfNow-dfStamp);
+		if(q->GetTraceStamp(CMOOSMsg::TRACE_DB_ENQUEUE,dfStamp))
+			m_DeliveryLatency[q->GetKey()].Add(dfNow-dfStamp);
+	}
+
+	if(dfNow>=0)
+		m_LatencyLock.UnLock();
+}
+
+bool CMOOSCommClient::GetLatencySummary(std::string & sSummary)
+{
+	sSummary.clear();
+
+	m_LatencyLock.Lock();
+	std::map<std::string,MOOS::LatencyHistogram>::iterator q;
+	for(q = m_TotalLatency.begin();q!=m_TotalLatency.end();q++)
+	{
+		if(!sSummary.empty())
+			sSummary+=";";
+		sSummary+="var="+q->first+",leg=total,"+q->second.GetSummary();
+	}
+	for(q = m_DeliveryLatency.begin();q!=m_DeliveryLatency.end();q++)
+	{
+		if(!sSummary.empty())
+			sSummary+=";";
+		sSummary+="var="+q->first+",leg=delivery,"+q->second.GetSummary();
+	}
+	m_LatencyLock.UnLock();
+
+	return !sSummary.empty();
+}
+
+void CMOOSCommClient::ClearLatencyStatistics()
+{
+	m_LatencyLock.Lock();
+	m_TotalLatency.clear();
+	m_DeliveryLatency.clear();
+	m_LatencyLock.UnLock();
+}
+
 std::string CMOOSCommClient::HandShakeKey()
 {
 	//old MOOS Clients return empty string
@@ -1627,6 +1707,72 @@ bool CMOOSCommClient::Close(bool  )
 	return true;
 }
 
+bool CMOOSCommClient::RunHeadless(const std::string & sMyName)
+{
+	m_sMyName = sMyName;
+	m_bHeadless = true;
+	m_bConnected = true;
+
+	//this is where a MOOSDB would have welcomed us
+	if(m_pfnConnectCallBack!=NULL)
+		(*m_pfnConnectCallBack)(m_pConnectCallBackParam);
+
+	return true;
+}
+
+void CMOOSCommClient::HeadlessPost(CMOOSMsg & Msg)
+{
+	switch(Msg.GetType())
+	{
+	case MOOS_NOTIFY:
+		m_HeadlessOutBox.push_back(Msg);
+		break;
+	case MOOS_REGISTER:
+	case MOOS_UNREGISTER:
+		//the set of names is kept by (Un)Register() itself
+		m_nHeadlessRegistrations++;
+		break;
+	case MOOS_WILDCARD_REGISTER:
+	case MOOS_WILDCARD_UNREGISTER:
+	{
+		std::string sVarPattern,sAppPattern;
+		MOOSValFromString(sVarPattern,Msg.GetString(),"VarPattern");
+		MOOSValFromString(sAppPattern,Msg.GetString(),"AppPattern");
+		std::pair<std::string,std::string> P(sVarPattern,sAppPattern);
+		m_HeadlessWildcards.remove(P);
+		if(Msg.IsType(MOOS_WILDCARD_REGISTER))
+			m_HeadlessWildcards.push_back(P);
+		m_nHeadlessRegistrations++;
+		break;
+	}
+	default:
+		break;
+	}
+}
+
+bool CMOOSCommClient::FetchHeadless(MOOSMSG_LIST & MsgList)
+{
+	m_OutLock.Lock();
+	MsgList.splice(MsgList.end(),m_HeadlessOutBox);
+	m_OutLock.UnLock();
+
+	return !MsgList.empty();
+}
+
+bool CMOOSCommClient::WantsHeadlessMail(const std::string & sVar, const std::string & sSrc)
+{
+	if(m_Registered.find(sVar)!=m_Registered.end())
+		return true;
+
+	std::list<std::pair<std::string,std::string> >::iterator q;
+	for(q=m_HeadlessWildcards.begin();q!=m_HeadlessWildcards.end();++q)
+	{
+		if(MOOSWildCmp(q->first,sVar) && (sSrc.empty() || MOOSWildCmp(q->second,sSrc)))
+			return true;
+	}
+	return false;
+}
+
 bool CMOOSCommClient::FakeSource(bool bFake)
 {
 	m_bFakeSource = bFake;
@@ -132,6 +132,7 @@ CMOOSCommServer::CMOOSCommServer()
     m_bQuiet  = false;
 	m_bDisableNameLookUp = true;
 	m_bQuit = false;
+	m_lListenPort = 0;
 
 	m_bBoostIOThreads= false;
 
@@ -474,6 +475,9 @@ bool CMOOSCommServer::ListenLoop()
 			{
 				pNewSocket->vSetRecieveBuf(m_nReceiveBufferSizeKB*1024);
 				pNewSocket->vSetSendBuf(m_nSendBufferSizeKB*1024);
+
+				if(m_bDisableNagle)
+					pNewSocket->vSetNoDelay(1);
 			}
 			catch(  XPCException & e)
 			{
@@ -57,6 +57,7 @@ CMOOSMsg::CMOOSMsg()
     m_dfVal = -1;
     m_dfVal2 = -1;
     m_nID = -1;
+    m_nTraceStamps = 0;
 	m_sSrc = "";
 	m_sSrcAux = "";
 }
@@ -75,6 +76,7 @@ CMOOSMsg::CMOOSMsg(char cMsgType,const std::string  & sKey,double dfVal,double d
     m_sKey = sKey;
     m_dfTime = -1;
     m_nID = -1;
+    m_nTraceStamps = 0;
 
     if(dfTime==-1)
     {
@@ -97,6 +99,7 @@ CMOOSMsg::CMOOSMsg(char cMsgType,const std::string & sKey,const std::string &sVa
     m_sVal = sVal;
     m_dfTime = -1;
     m_nID = -1;
+    m_nTraceStamps = 0;
 
     if(dfTime==-1)
     {
@@ -119,6 +122,7 @@ CMOOSMsg::CMOOSMsg(char cMsgType,const std::string &sKey,  unsigned int nDataSiz
     m_sVal.assign((char *)Data,nDataSize);
     m_dfTime = -1;
     m_nID = -1;
+    m_nTraceStamps = 0;
 
     if(dfTime==-1)
     {
@@ -352,7 +356,17 @@ unsigned int CMOOSMsg::GetSizeInBytesWhenSerialised() const
 
     unsigned int nDouble = 3*sizeof(double);
 
-    return nInt+nChar+nString+nDouble;
+    //trace stamps are a marker, a mask and the stamps themselves
+    unsigned int nTrace = 0;
+    if(m_nTraceStamps!=0)
+    {
+        nTrace = 2*sizeof(char);
+        for(int i = 0;i<TRACE_NUM_STAMPS;i++)
+            if(m_nTraceStamps & (1<<i))
+                nTrace+=sizeof(double);
+    }
+
+    return nInt+nChar+nString+nDouble+nTrace;
 
 }
 
@@ -409,6 +423,19 @@ int CMOOSMsg::Serialize(unsigned char *pBuffer, int nLen, bool bToStream)
             //string data
             (*this)<<m_sVal;
 
+            //optional trace stamps go at the end - a reader which does
+            //not know about them skips them as it honours our length
+            if(m_nTraceStamps!=0)
+            {
+                char cMarker = MOOS_TRACE_MARKER;
+                (*this)<<cMarker;
+                char cMask = static_cast<char>(m_nTraceStamps);
+                (*this)<<cMask;
+                for(int i = 0;i<TRACE_NUM_STAMPS;i++)
+                    if(m_nTraceStamps & (1<<i))
+                        (*this)<<m_dfTraceStamps[i];
+            }
+
             //how many bytes in total have we written (this includes an int at the start)?
             m_nLength = m_pSerializeBuffer-m_pSerializeBufferStart;
 
@@ -476,6 +503,25 @@ int CMOOSMsg::Serialize(unsigned char *pBuffer, int nLen, bool bToStream)
             //string data
             (*this)>>m_sVal;
 
+            //is there anything after the payload? If it is not trace
+            //stamps it is from a newer writer and we leave it be
+            m_nTraceStamps = 0;
+            if(m_pSerializeBuffer-m_pSerializeBufferStart<m_nLength)
+            {
+                char cMarker;
+                (*this)>>cMarker;
+                if(cMarker==MOOS_TRACE_MARKER)
+                {
+                    char cMask;
+                    (*this)>>cMask;
+                    unsigned char nMask = static_cast<unsigned char>(cMask);
+                    for(int i = 0;i<TRACE_NUM_STAMPS;i++)
+                        if(nMask & (1<<i))
+                            (*this)>>m_dfTraceStamps[i];
+                    m_nTraceStamps = nMask & ((1<<TRACE_NUM_STAMPS)-1);
+                }
+            }
+
         }
         catch(CMOOSException e)
         {
@@ -489,6 +535,29 @@ int CMOOSMsg::Serialize(unsigned char *pBuffer, int nLen, bool bToStream)
 
 }
 
+void CMOOSMsg::SetTraceStamp(TraceStamp eStamp, double dfTime)
+{
+    if(eStamp<0 || eStamp>=TRACE_NUM_STAMPS)
+        return;
+    m_dfTraceStamps[eStamp] = dfTime;
+    m_nTraceStamps |= (1<<eStamp);
+}
+
+bool CMOOSMsg::GetTraceStamp(TraceStamp eStamp, double & dfTime) const
+{
+    if(eStamp<0 || eStamp>=TRACE_NUM_STAMPS || !(m_nTraceStamps & (1<<eStamp)))
+        return false;
+    dfTime = m_dfTraceStamps[eStamp];
+    return true;
+}
+
+double CMOOSMsg::GetTraceTime()
+{
+    //not corrected by the MOOS skew estimate - that is biased by the
+    //DB holding its timing replies and is only good to tens of ms
+    return MOOSLocalTime(false);
+}
+
 int CMOOSMsg::GetLength()
 {
     return m_nLength;
@@ -41,6 +41,7 @@
 #include "MOOS/libMOOS/Utils/ConsoleColours.h"
 #include "MOOS/libMOOS/Utils/ThreadPrint.h"
 #include "MOOS/libMOOS/Utils/ThreadPriority.h"
+#include "MOOS/libMOOS/Utils/MOOSScopedLock.h"
 #include <iomanip>
 #include <iterator>
 #include <algorithm>
@@ -67,7 +68,7 @@ ThreadPrint gPrinter(std::cout);
 
 ThreadedCommServer::ThreadedCommServer()
 {
-    // TODO Auto-generated constructor stub
+    m_nNextInProcessID = -1;
 }
 
 ThreadedCommServer::~ThreadedCommServer()
@@ -76,8 +77,36 @@ ThreadedCommServer::~ThreadedCommServer()
     Stop();
 
 }
+bool ThreadedCommServer::Run(long lPort,const std::string  & sCommunityName, bool bDisableNameLookUp, unsigned int nAuditPort)
+{
+    if(!BASE::Run(lPort,sCommunityName,bDisableNameLookUp,nAuditPort))
+        return false;
+
+    //clients in this process can now talk to us without a socket
+    if(!InProcessLink::AddServer(lPort,this))
+    {
+        std::cerr<<MOOS::ConsoleColours::yellow()<<"warning : another server in this process already serves port "
+                <<lPort<<" - in-process clients will not reach this one\n"<<MOOS::ConsoleColours::reset();
+    }
+
+    return true;
+}
+
 bool ThreadedCommServer::Stop()
 {
+    //no more in-process clients can find us
+    InProcessLink::RemoveServer(m_lListenPort,this);
+
+    //and those that have will be refused from now on
+    m_InProcessLock.Lock();
+    {
+        std::map<std::string,MOOSInProcessLinkPtr>::iterator p;
+        for(p=m_InProcessClients.begin();p!=m_InProcessClients.end();p++)
+            p->second->DetachServer();
+        m_InProcessClients.clear();
+    }
+    m_InProcessLock.UnLock();
+
 
     //kill this first because we have to prevent client from reconnecting
     //because we are going to pull the plug on them
@@ -279,14 +308,21 @@ bool ThreadedCommServer::ProcessClient(ClientThreadSharedData &SDFromClient,MOOS
 
             std::string sWho = SDFromClient._sClientName;
 
-            //first find the client object
+            //first find the client object - it may be a thread looking after
+            //a socket or a link to a client in this very process
+            ClientThread* pClient = NULL;
+            MOOSInProcessLinkPtr pLink;
 			std::map<std::string,ClientThread*>::iterator q = m_ClientThreads.find(sWho);
-			if(q == m_ClientThreads.end())
+			if(q != m_ClientThreads.end())
 			{
-			   return MOOSFail("logical error - FIX ME!");
+				pClient = q->second;
+			}
+			else
+			{
+				pLink = GetInProcessLink(sWho);
+				if(pLink.isNull())
+					return MOOSFail("logical error - FIX ME!");
 			}
-
-			ClientThread* pClient = q->second;
 
             if(m_bQuiet)
                 InhibitMOOSTraceInThisThread(false);
@@ -295,10 +331,19 @@ bool ThreadedCommServer::ProcessClient(ClientThreadSharedData &SDFromClient,MOOS
 
             MOOSMSG_LIST MsgLstRx,MsgLstTx;
 
-            //convert to list of messages
-            SDFromClient._pPkt->Serialize(MsgLstRx,false);
+            //convert to list of messages (unless it already is one)
+            unsigned int nBytesRx = 0;
+            if(!SDFromClient._pMsgs.isNull())
+            {
+            	MsgLstRx.swap(*SDFromClient._pMsgs);
+            }
+            else
+            {
+            	SDFromClient._pPkt->Serialize(MsgLstRx,false);
+            	nBytesRx = SDFromClient._pPkt->GetStreamLength();
+            }
 
-            Auditor.AddStatistic(sWho,SDFromClient._pPkt->GetStreamLength(),MsgLstRx.size(),dfTNow,true);
+            Auditor.AddStatistic(sWho,nBytesRx,MsgLstRx.size(),dfTNow,true);
 
 			if(MsgLstRx.empty())
 			{
@@ -326,7 +371,7 @@ bool ThreadedCommServer::ProcessClient(ClientThreadSharedData &SDFromClient,MOOS
             //is this a timing message from V10 client?
             bool bTimingPresent = false;
             CMOOSMsg TimingMsg;
-            if(MsgLstRx.front().IsType(MOOS_TIMING))
+            if(pClient!=NULL && MsgLstRx.front().IsType(MOOS_TIMING))
             {
             	bTimingPresent = true;
             	TimingMsg =MsgLstRx.front();
@@ -357,7 +402,7 @@ bool ThreadedCommServer::ProcessClient(ClientThreadSharedData &SDFromClient,MOOS
 			}
 
 
-            if(pClient->IsSynchronous())
+            if(pClient!=NULL && pClient->IsSynchronous())
             {
 				//every packet will no begin with a NULL message the double val
 
@@ -376,7 +421,18 @@ bool ThreadedCommServer::ProcessClient(ClientThreadSharedData &SDFromClient,MOOS
             //send packet back to client...
             ClientThreadSharedData SDDownStream(sWho,ClientThreadSharedData::PKT_WRITE);
 
-            if(!MsgLstTx.empty())
+            if(!MsgLstTx.empty() && !pLink.isNull())
+            {
+            	//a client in this process simply takes the list
+            	unsigned int nMessages = MsgLstTx.size();
+            	MOOSMsgListPtr pMsgsTx(new MOOSMSG_LIST);
+            	pMsgsTx->swap(MsgLstTx);
+
+            	Auditor.AddStatistic(sWho,0,nMessages,MOOS::Time(),false);
+
+            	pLink->SendToClient(pMsgsTx);
+            }
+            else if(!MsgLstTx.empty())
             {
             	unsigned int nMessages = MsgLstTx.size();
 				//stuff reply message into a packet
@@ -437,6 +493,30 @@ bool ThreadedCommServer::ProcessClient(ClientThreadSharedData &SDFromClient,MOOS
             	}
             }
 
+            //and clients in this process are always asynchronous
+            if(m_pfnFetchAllMailCallBack!=NULL)
+            {
+            	MOOS::ScopedLock L(m_InProcessLock);
+            	std::map<std::string,MOOSInProcessLinkPtr>::iterator r;
+            	for(r=m_InProcessClients.begin();r!=m_InProcessClients.end();r++)
+            	{
+            		MsgLstTx.clear();
+            		if(!(*m_pfnFetchAllMailCallBack)(r->first,MsgLstTx,m_pFetchAllMailCallBackParam))
+            			continue;
+
+            		if(MsgLstTx.empty())
+            			continue;
+
+            		unsigned int nMessages = MsgLstTx.size();
+            		MOOSMsgListPtr pMsgsTx(new MOOSMSG_LIST);
+            		pMsgsTx->swap(MsgLstTx);
+
+            		Auditor.AddStatistic(r->first,0,nMessages,MOOS::Time(),false);
+
+            		r->second->SendToClient(pMsgsTx);
+            	}
+            }
+
 
         }
     }
@@ -458,6 +538,11 @@ bool ThreadedCommServer::ProcessClient()
 
 bool ThreadedCommServer::OnClientDisconnect(ClientThreadSharedData &SD)
 {
+    //clients in this process have no thread or socket to clean up
+    if(m_ClientThreads.find(SD._sClientName)==m_ClientThreads.end())
+    {
+        return OnInProcessClientDisconnect(SD._sClientName);
+    }
 
 
     //lock the base socket list
@@ -523,6 +608,130 @@ bool ThreadedCommServer::StopAndCleanUpClientThread(std::string sName)
     return true;
 }
 
+bool ThreadedCommServer::AddInProcessClient(MOOSInProcessLinkPtr pLink, std::string & sCommunity, std::string & sWhyNot)
+{
+    std::string sName = pLink->GetClientName();
+
+    if(!m_bQuiet)
+        std::cout<<"\n------------"<<MOOS::ConsoleColours::Green()<<"CONNECT"<<MOOS::ConsoleColours::reset()<<"-------------\n";
+
+    //this is the in-process equivalent of handshaking
+    m_SocketListLock.Lock();
+    {
+        if(!IsUniqueName(sName))
+        {
+            m_SocketListLock.UnLock();
+
+            sWhyNot = MOOSFormat("A client of this name (\"%s\") already exists",sName.c_str());
+            if(!m_bQuiet)
+            {
+                std::cerr<<"  Handshaking   :  "<<MOOS::ConsoleColours::Red()<<"FAIL\n"<<MOOS::ConsoleColours::reset();
+                MOOSTrace("--------------------------------\n");
+            }
+            return false;
+        }
+
+        m_Socket2ClientMap[m_nNextInProcessID--] = sName;
+        m_AsynchronousClientSet.insert(sName);
+    }
+    m_SocketListLock.UnLock();
+
+    m_InProcessLock.Lock();
+        m_InProcessClients[sName] = pLink;
+    m_InProcessLock.UnLock();
+
+    sCommunity = m_sCommunityName;
+
+    if(m_pfnConnectCallBack!=NULL)
+    {
+        if(!(*m_pfnConnectCallBack)(sName,m_pConnectCallBackParam))
+        {
+            if(!m_bQuiet)
+                std::cerr<<"user defined connect callback returns false\n";
+        }
+    }
+
+    if(!m_bQuiet)
+    {
+        std::cout<<"  Handshaking   :  "<<MOOS::ConsoleColours::green()<<"OK\n"<<MOOS::ConsoleColours::reset();
+        std::cout<<"  Client's name :  "<<MOOS::ConsoleColours::green()<<sName<<MOOS::ConsoleColours::reset()<<"\n";
+        std::cout<<"  Type          :  "<<MOOS::ConsoleColours::Yellow()<<"Asynchronous (in-process)"<<MOOS::ConsoleColours::reset()<<"\n";
+        std::cout<<"  Total Clients :  "<<MOOS::ConsoleColours::green()<<m_Socket2ClientMap.size()<<MOOS::ConsoleColours::reset()<<"\n";
+        MOOSTrace("--------------------------------\n");
+    }
+
+    return true;
+}
+
+bool ThreadedCommServer::OnInProcessPkt(const std::string & sClient, MOOSMsgListPtr pMsgs)
+{
+    //join the queue with everyone else
+    m_SharedDataListFromClient.Push(ClientThreadSharedData(sClient,pMsgs));
+    return true;
+}
+
+bool ThreadedCommServer::OnInProcessClose(const std::string & sClient)
+{
+    m_SharedDataListFromClient.Push(ClientThreadSharedData(sClient,ClientThreadSharedData::CONNECTION_CLOSED));
+    return true;
+}
+
+MOOSInProcessLinkPtr ThreadedCommServer::GetInProcessLink(const std::string & sClient)
+{
+    MOOS::ScopedLock L(m_InProcessLock);
+
+    std::map<std::string,MOOSInProcessLinkPtr>::iterator q = m_InProcessClients.find(sClient);
+    if(q==m_InProcessClients.end())
+        return MOOSInProcessLinkPtr();
+
+    return q->second;
+}
+
+bool ThreadedCommServer::OnInProcessClientDisconnect(const std::string & sClient)
+{
+    m_InProcessLock.Lock();
+    {
+        std::map<std::string,MOOSInProcessLinkPtr>::iterator q = m_InProcessClients.find(sClient);
+        if(q==m_InProcessClients.end())
+        {
+            m_InProcessLock.UnLock();
+            return false;
+        }
+        q->second->DetachServer();
+        m_InProcessClients.erase(q);
+    }
+    m_InProcessLock.UnLock();
+
+    if(!m_bQuiet)
+        std::cout<<"\n----------"<<MOOS::ConsoleColours::Yellow()<<"DISCONNECT"<<MOOS::ConsoleColours::reset()<<"------------\n";
+
+    m_SocketListLock.Lock();
+    {
+        SOCKETFD_2_CLIENT_NAME_MAP::iterator p;
+        for(p = m_Socket2ClientMap.begin();p!=m_Socket2ClientMap.end();p++)
+        {
+            if(p->first<0 && p->second==sClient)
+            {
+                m_Socket2ClientMap.erase(p);
+                break;
+            }
+        }
+        m_AsynchronousClientSet.erase(sClient);
+    }
+    m_SocketListLock.UnLock();
+
+    if(m_pfnDisconnectCallBack!=NULL)
+    {
+        std::string sWho = sClient;
+        (*m_pfnDisconnectCallBack)(sWho,m_pDisconnectCallBackParam);
+    }
+
+    if(!m_bQuiet)
+        MOOSTrace("--------------------------------\n");
+
+    return true;
+}
+
 bool ThreadedCommServer::SupportsAsynchronousClients()
 {
 	return true;
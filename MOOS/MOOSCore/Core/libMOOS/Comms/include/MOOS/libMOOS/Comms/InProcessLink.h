@@ -0,0 +1,128 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//   This file is part of the MOOS project
+//
+//   MOOS : Mission Oriented Operating Suite A suit of 
+//   Applications and Libraries for Mobile Robotics Research 
+//   Copyright (C) Paul Newman
+//    
+//   This file was written by MOOS contributors 
+//   
+//   email: pnewman@robots.ox.ac.uk. 
+//              
+//   This source code and the accompanying materials
+//   are made available under the terms of the GNU Lesser Public License v2.1
+//   which accompanies this distribution, and is available at
+//   http://www.gnu.org/licenses/lgpl.txt distributed in the hope that it will be useful, 
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of 
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. 
+//
+////////////////////////////////////////////////////////////////////////////
+/*
+ * InProcessLink.h
+ *
+ *  A link between a MOOSAsyncCommClient and a ThreadedCommServer which
+ *  live in the same process.
+ */
+
+#ifndef INPROCESSLINK_H_
+#define INPROCESSLINK_H_
+
+#include <string>
+#include "MOOS/libMOOS/Comms/CommsTypes.h"
+#include "MOOS/libMOOS/Utils/MOOSLock.h"
+#include "MOOS/libMOOS/Thirdparty/PocoBits/SharedPtr.h"
+
+namespace MOOS
+{
+
+class ThreadedCommServer;
+class MOOSAsyncCommClient;
+
+/** a list of messages handed between threads without copying or serialising*/
+typedef Poco::SharedPtr<MOOSMSG_LIST> MOOSMsgListPtr;
+
+/**
+ * @brief Joins a client to a DB running in the same process.
+ *
+ * When a MOOSAsyncCommClient finds that the DB it wants to talk to is
+ * being served from within its own process it does not open a socket.
+ * Instead it is handed one of these links and whole lists of messages
+ * are passed across by shared pointer - no packets are built and
+ * nothing is serialised. To the DB the client looks like any other
+ * asynchronous client so clients connected over the network see no
+ * difference at all.
+ *
+ * Either end may detach at any time after which the link quietly
+ * refuses all traffic.
+ * @ingroup Comms
+ */
+class InProcessLink
+{
+public:
+    InProcessLink(const std::string & sClientName,
+                  MOOSAsyncCommClient* pClient,
+                  ThreadedCommServer* pServer);
+
+    /** client to server: hand over a list of outgoing messages
+     * @return false if the server has gone*/
+    bool SendToServer(MOOSMsgListPtr pMsgs);
+
+    /** server to client: hand over a list of mail. The mail is queued
+     * for the client's own thread so no client code runs on the caller's
+     * @return false if the client has gone*/
+    bool SendToClient(MOOSMsgListPtr pMsgs);
+
+    /** called by the client when it closes - tells the server we are leaving*/
+    void DetachClient();
+
+    /** called by the server when it stops*/
+    void DetachServer();
+
+    /** true if both ends are still attached*/
+    bool IsOpen();
+
+    std::string GetClientName() const {return m_sClientName;};
+
+    /** make a server reachable by clients in this process
+     * @param lPort the port the server is listening on
+     * @param pServer the server itself
+     * @return false if a server is already registered on this port*/
+    static bool AddServer(long lPort, ThreadedCommServer* pServer);
+
+    /** stop a server being reachable by clients in this process*/
+    static bool RemoveServer(long lPort, ThreadedCommServer* pServer);
+
+    /** is there a server in this process which a client asking for
+     * sHost:lPort would reach?*/
+    static bool HasServer(const std::string & sHost, long lPort);
+
+    /**
+     * connect a client to a server in this process
+     * @param sHost host the client was asked to connect to
+     * @param lPort port the client was asked to connect to
+     * @param sClientName name of the client
+     * @param pClient the client
+     * @param sCommunity filled in with the community name of the DB
+     * @param sWhyNot filled in if the server refuses the client
+     * @return a link (or a null pointer if there was no connection)
+     */
+    static Poco::SharedPtr<InProcessLink> Connect(const std::string & sHost,
+                                                  long lPort,
+                                                  const std::string & sClientName,
+                                                  MOOSAsyncCommClient* pClient,
+                                                  std::string & sCommunity,
+                                                  std::string & sWhyNot);
+
+private:
+    std::string m_sClientName;
+    MOOSAsyncCommClient* m_pClient;
+    ThreadedCommServer* m_pServer;
+    CMOOSLock m_Lock;
+};
+
+typedef Poco::SharedPtr<InProcessLink> MOOSInProcessLinkPtr;
+
+}
+
+#endif /* INPROCESSLINK_H_ */
@@ -28,6 +28,7 @@
 #include "MOOS/libMOOS/Comms/MOOSCommClient.h"
 #include "MOOS/libMOOS/Utils/MOOSThread.h"
 #include "MOOS/libMOOS/Utils/SafeList.h"
+#include "MOOS/libMOOS/Comms/InProcessLink.h"
 
 namespace MOOS
 {
@@ -91,6 +92,21 @@ namespace MOOS
 	    bool ReadingLoop();
 	    bool WritingLoop();
 
+	    /**
+	     * called by an InProcessLink when a DB in this process has mail for us.
+	     * This runs on the DB's thread so the mail is only queued here - it
+	     * is delivered (and any mail callback invoked) by our reading thread
+	     * @param pMail the new mail
+	     * @return true on success
+	     */
+	    bool OnInProcessMail(MOOSMsgListPtr pMail);
+
+	    /**
+	     * Is this client talking to a DB in the same process (rather than over a socket)?
+	     * @return true if it is
+	     */
+	    bool IsInProcess();
+
 
 	protected:
 
@@ -124,12 +140,24 @@ namespace MOOS
 	     */
 	    bool DoReading();
 
+	    /**
+	     * move mail queued by an in process DB into the inbox
+	     * @return true if there was any
+	     */
+	    bool DoInProcessReading();
+
 	    /**
 	     * perform the management of the outgoing data
 	     * @return
 	     */
 	    bool DoWriting();
 
+	    /**
+	     * connect to a DB being served from within this process
+	     * @return false if the DB refused us
+	     */
+	    bool ConnectInProcess();
+
 
 	    //data members below here
 	    CMOOSThread WritingThread_; //handles writing
@@ -142,6 +170,10 @@ namespace MOOS
 
 	    MOOS::SafeList<CMOOSMsg> OutGoingQueue_; //queue of outgoing mail
 
+	    MOOSInProcessLinkPtr m_pInProcessLink; //link to a DB in this process
+	    bool m_bInProcess; //true if we are talking over m_pInProcessLink
+	    MOOS::SafeList<MOOSMsgListPtr> InProcessMailQueue_; //mail handed over by an in process DB
+
 
 
 	};
@@ -40,6 +40,8 @@
 #include "MOOS/libMOOS/Utils/MOOSLock.h"
 #include "MOOS/libMOOS/Utils/MOOSThread.h"
 #include "MOOS/libMOOS/Utils/Macros.h"
+#include "MOOS/libMOOS/Utils/TraceRing.h"
+#include "MOOS/libMOOS/Utils/LatencyHistogram.h"
 #include "MOOS/libMOOS/Comms/MOOSCommObject.h"
 #include "MOOS/libMOOS/Comms/ActiveMailQueue.h"
 #include "MOOS/libMOOS/Comms/ClientCommsStatus.h"
@@ -236,6 +238,31 @@ public:
     /** how much incoming mail is pending?*/
     unsigned int GetNumberOfUnreadMessages();
 
+    /** run without a MOOSDB. No threads are started and the client counts
+    as connected at once (the OnConnect callback is invoked from this call).
+    Registrations are recorded but go nowhere, and mail posted is kept to be
+    collected with FetchHeadless(). This lets a program drive an application
+    directly - replaying a log into it for example
+    @param sMyName name by which this client publishes*/
+    bool RunHeadless(const std::string & sMyName);
+
+    /** true if running without a MOOSDB*/
+    bool IsHeadless(){return m_bHeadless;};
+
+    /** when headless, collect (and clear) all notifications posted since the
+    last call
+    @return true if there were any*/
+    bool FetchHeadless(MOOSMSG_LIST & MsgList);
+
+    /** when headless, would a MOOSDB deliver this variable to us? That is,
+    are we registered for it or for a wildcard pattern matching it. The
+    source is only checked against wildcard patterns if it is not empty*/
+    bool WantsHeadlessMail(const std::string & sVar, const std::string & sSrc);
+
+    /** the number of registrations made while headless - lets a driver see
+    that the set of variables wanted has changed*/
+    unsigned int GetHeadlessRegistrationCount(){return m_nHeadlessRegistrations;};
+
     /** how much outgoing mail is pending?*/
     unsigned int GetNumberOfUnsentMessages();
 
@@ -264,6 +291,32 @@ public:
     /** used to control how verbose the connection process is */
     void SetQuiet(bool bQ){m_bQuiet = bQ;};
 
+    /** give the client somewhere to record timing of its threads (NULL for none).
+     * The ring is not owned by the client and must outlive it. Only
+     * MOOSAsyncCommClient records anything - its writer and reader threads
+     * time each write and read and sample the outbox and inbox depths. The
+     * synchronous CMOOSCommClient ignores the ring*/
+    void SetTraceRing(MOOS::TraceRing* pTraceRing){m_pTraceRing = pTraceRing;};
+
+    /** if enabled every notification posted is stamped with the time it
+     * was sent. The MOOSDB and subscribers add their own stamps so the
+     * latency of each leg of the journey can be measured*/
+    void EnableLatencyTracing(bool bEnable=true){m_bLatencyTracing = bEnable;};
+
+    /** true if notifications posted are being stamped*/
+    bool IsLatencyTracing(){return m_bLatencyTracing;};
+
+    /** a summary of the latency of traced mail fetched so far, one entry
+     * per variable and leg separated by ';' :
+     * var=X,leg=total,n=..,mean=..,p50=..,p90=..,p99=..,max=.. (times in ms).
+     * Leg "total" is from the publisher posting to us fetching and leg
+     * "delivery" from the MOOSDB queueing the mail for us to us fetching
+     * @return false if no traced mail has been received*/
+    bool GetLatencySummary(std::string & sSummary);
+
+    /** forget latency measured so far*/
+    void ClearLatencyStatistics();
+
     /** used to control whether local clock skew (used by MOOSTime())  is se via the server at the other
      end of this connection */
     void DoLocalTimeCorrection(bool b){m_bDoLocalTimeCorrection = b;};
@@ -563,6 +616,38 @@ protected:
 
     /** controls how verbose connectionn is*/
     bool m_bQuiet;
+
+    /** where timing of the comms threads is recorded (may be NULL)*/
+    MOOS::TraceRing* m_pTraceRing;
+
+    /** true if there is a trace ring and it is recording*/
+    bool IsTracing() const {return m_pTraceRing!=NULL && m_pTraceRing->IsEnabled();}
+
+    /** stamp outgoing notifications?*/
+    bool m_bLatencyTracing;
+
+    /** true if running without a MOOSDB*/
+    bool m_bHeadless;
+
+    /** notifications posted while headless*/
+    MOOSMSG_LIST m_HeadlessOutBox;
+
+    /** wildcard (variable,source) patterns registered while headless*/
+    std::list<std::pair<std::string,std::string> > m_HeadlessWildcards;
+
+    /** count of registrations made while headless*/
+    unsigned int m_nHeadlessRegistrations;
+
+    /** record a message posted while headless*/
+    void HeadlessPost(CMOOSMsg & Msg);
+
+    /** stamp traced mail as dispatched and add it to the statistics*/
+    void RecordLatency(MOOSMSG_LIST & MsgList);
+
+    /** per variable latency from publisher to us and from the MOOSDB to us*/
+    std::map<std::string,MOOS::LatencyHistogram> m_TotalLatency;
+    std::map<std::string,MOOS::LatencyHistogram> m_DeliveryLatency;
+    CMOOSLock m_LatencyLock;
     
     /** controls verbose debugging printing */
     bool m_bVerboseDebug;
@@ -59,9 +59,20 @@
 #define MOOS_STRING    'S'
 #define MOOS_BINARY_STRING 'B'
 
+//marks the optional block of trace stamps at the end of a serialised message
+#define MOOS_TRACE_MARKER 'L'
+
 //5 seconds time difference between client clock and MOOSDB clock will be allowed
 #define SKEW_TOLERANCE 5
 
+//variables used between the MOOSDB and clients in lockstep (virtual time) mode
+#define MOOS_LOCKSTEP_TICK "MOOS_LOCKSTEP_TICK"
+#define MOOS_LOCKSTEP_JOIN "MOOS_LOCKSTEP_JOIN"
+#define MOOS_LOCKSTEP_ACK  "MOOS_LOCKSTEP_ACK"
+
+//server request for per variable latency statistics held by the MOOSDB
+#define MOOS_LATENCY_SUMMARY "LATENCY_SUMMARY"
+
 /** @brief MOOS Comms Messaging class.
 This is a class encapsulating the data which the MOOS Comms API shuttles
 between the MOOSDB and other clients. It is the fundamental datatype of
@@ -170,6 +181,39 @@ public:
     void SetDouble(double dfD){m_dfVal = dfD;}
     void SetDoubleAux(double dfD){m_dfVal2 = dfD;}
 
+    /** the points on the way from publisher to subscriber at which
+     a traced message is stamped with the time*/
+    enum TraceStamp
+    {
+        TRACE_CLIENT_SEND = 0,     /**< posted by the publishing client*/
+        TRACE_DB_RECEIVE = 1,      /**< arrived at the MOOSDB*/
+        TRACE_DB_ENQUEUE = 2,      /**< queued by the MOOSDB for a subscriber*/
+        TRACE_CLIENT_DISPATCH = 3, /**< handed to the subscribing application*/
+        TRACE_NUM_STAMPS = 4
+    };
+
+    /** stamp the message with the time it passed a point on its journey.
+     Stamped messages carry their stamps when serialised (old clients and
+     DBs simply skip them) so latency can be followed end to end*/
+    void SetTraceStamp(TraceStamp eStamp, double dfTime);
+
+    /** stamp with now as given by GetTraceTime()*/
+    void SetTraceStamp(TraceStamp eStamp){SetTraceStamp(eStamp,GetTraceTime());}
+
+    /** get a stamp - returns false if the message was not stamped there*/
+    bool GetTraceStamp(TraceStamp eStamp, double & dfTime) const;
+
+    /** true if the message carries any trace stamps*/
+    bool IsTraced() const {return m_nTraceStamps!=0;}
+
+    /** remove all trace stamps*/
+    void ClearTraceStamps(){m_nTraceStamps = 0;}
+
+    /** the clock trace stamps are made with: real (unwarped) local time.
+     Stamps made on different machines are only comparable if their
+     clocks are disciplined (by NTP say)*/
+    static double GetTraceTime();
+
     /**what type of message is this? Notification,Command,Register etc*/
     char m_cMsgType;
     
@@ -203,6 +247,10 @@ public:
     //what community did it originate in?
     std::string m_sOriginatingCommunity;
 
+    //optional trace stamps (bit i of m_nTraceStamps set if stamp i is valid)
+    unsigned char m_nTraceStamps;
+    double m_dfTraceStamps[TRACE_NUM_STAMPS];
+
     //serialise this message into/outof a character buffer
     int Serialize(unsigned char *  pBuffer,int  nLen,bool bToStream=true);
 
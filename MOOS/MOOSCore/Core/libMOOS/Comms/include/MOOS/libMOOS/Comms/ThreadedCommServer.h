@@ -35,6 +35,7 @@
 #include "MOOS/libMOOS/Comms/MOOSCommServer.h"
 #include "MOOS/libMOOS/Utils/SafeList.h"
 #include "MOOS/libMOOS/Thirdparty/PocoBits/SharedPtr.h"
+#include "MOOS/libMOOS/Comms/InProcessLink.h"
 
 namespace MOOS
 {
@@ -49,6 +50,9 @@ struct ClientThreadSharedData
 	//payload
 	Poco::SharedPtr<CMOOSCommPkt> _pPkt;
 
+	//payload from a client in this process - already a list of messages
+	MOOSMsgListPtr _pMsgs;
+
 	//little bit of status
 	enum Status
 	{
@@ -66,6 +70,11 @@ struct ClientThreadSharedData
 		_pPkt = new CMOOSCommPkt;
 	};
 
+	ClientThreadSharedData(const std::string & sN,MOOSMsgListPtr pMsgs):
+	_sClientName(sN),_pMsgs(pMsgs),_Status(PKT_READ)
+	{
+	};
+
 	ClientThreadSharedData(){_Status =NOT_INITIALISED; };
 
 };
@@ -79,6 +88,26 @@ public:
     ThreadedCommServer();
     virtual ~ThreadedCommServer();
 
+    /** Initialise the server. As well as listening on lPort the server makes
+    itself reachable by clients living in this process
+    @see InProcessLink */
+    virtual bool Run(long lPort,const std::string  & sCommunityName, bool bDisableNameLookUp = false, unsigned int nAuditPort = 9020);
+
+    /**
+     * accept a client which lives in this process (called via InProcessLink::Connect)
+     * @param pLink the link the client will talk over
+     * @param sCommunity filled in with the community we serve
+     * @param sWhyNot filled in with a reason if the client is refused
+     * @return true if the client is accepted
+     */
+    bool AddInProcessClient(MOOSInProcessLinkPtr pLink, std::string & sCommunity, std::string & sWhyNot);
+
+    /** called by a link when a client in this process sends some messages*/
+    bool OnInProcessPkt(const std::string & sClient, MOOSMsgListPtr pMsgs);
+
+    /** called by a link when a client in this process goes away*/
+    bool OnInProcessClose(const std::string & sClient);
+
 private:
     typedef CMOOSCommServer BASE;
 
@@ -228,6 +257,12 @@ protected:
 
     virtual bool Stop();
 
+    /** return the link to a named client in this process (null if there is none)*/
+    MOOSInProcessLinkPtr GetInProcessLink(const std::string & sClient);
+
+    /** forget a client in this process which has left*/
+    bool OnInProcessClientDisconnect(const std::string & sClient);
+
     protected:
 
 		//all connected clients will push the received Pkts into this list....
@@ -235,6 +270,14 @@ protected:
 
 		std::map<std::string,ClientThread*> m_ClientThreads;
 
+		//clients living in this process talk to us over one of these
+		std::map<std::string,MOOSInProcessLinkPtr> m_InProcessClients;
+		CMOOSLock m_InProcessLock;
+
+		//clients in this process have no socket so they are given
+		//a negative pretend file descriptor in m_Socket2ClientMap
+		int m_nNextInProcessID;
+
 
 };
 
@@ -100,6 +100,13 @@ CMOOSDB::CMOOSDB()
     
     m_bQuiet = false;
 
+    m_bLockStep = false;
+    m_dfLockStepPeriod = 0.1;
+    m_nLockStepClients = 1;
+    m_dfLockStepTimeout = 10.0;
+    m_bLockStepStarted = false;
+    m_dfLockStepTickIssued = 0.0;
+
     //make our own variable called DB_TIME
     {
         CMOOSDBVar NewVar("DB_TIME");
@@ -210,6 +217,7 @@ void PrintHelpAndExit()
 	std::cout<<"--moos_file=<string>               specify mission file name (default mission.moos)\n";
 	std::cout<<"--moos_port=<positive_integer>     specify server port number (default 9000)\n";
 	std::cout<<"--moos_time_warp=<positive_float>  specify time warp\n";
+	std::cout<<"--moos_lockstep                    run clients in lockstep on a virtual clock\n";
 	std::cout<<"--moos_community=<string>          specify community name\n";
     std::cout<<"--moos_print_version               print build and version details\n";
     std::cout<<"--moos_suicide_channel=<str>       suicide monitoring channel (IP address) \n";
@@ -231,6 +239,9 @@ void PrintHelpAndExit()
 	std::cout<<"--response=<string-list>           specify tolerable client latencies in ms\n";
 	std::cout<<"--warning_latency=<positive_float>    specify latency above which warning is issued in ms\n";
 	std::cout<<"--tcpnodelay                       disable nagle algorithm \n";
+	std::cout<<"--lockstep_period=<positive_float> virtual seconds per lockstep tick (default 0.1)\n";
+	std::cout<<"--lockstep_clients=<unsigned int>  clients to wait for before lockstep starts (default 1)\n";
+	std::cout<<"--lockstep_timeout=<float>         wall seconds to wait for a tick ack before dropping a client (default 10, 0 waits forever)\n";
 	std::cout<<"--audit_port=<unsigned int>        specify port on which to transmit statistics\n";
     std::cout<<"--event_log=<file name>            specify file in which to record events\n";
 
@@ -291,6 +302,28 @@ bool CMOOSDB::Run(int argc,  char * argv[] )
     if(dfWarp>0.0)
         SetMOOSTimeWarp(dfWarp);
 
+    ///////////////////////////////////////////////////////////
+    //are we to own a virtual clock and step clients in lockstep?
+    bool bLockStep = false;
+    m_MissionReader.GetValue("MOOSLockStep",bLockStep);
+    if(P.GetFlag("--moos_lockstep"))
+        bLockStep = true;
+
+    double dfLockStepPeriod = m_dfLockStepPeriod;
+    m_MissionReader.GetValue("LockStepPeriod",dfLockStepPeriod);
+    P.GetVariable("--lockstep_period",dfLockStepPeriod);
+
+    unsigned int nLockStepClients = m_nLockStepClients;
+    m_MissionReader.GetValue("LockStepClients",nLockStepClients);
+    P.GetVariable("--lockstep_clients",nLockStepClients);
+
+    double dfLockStepTimeout = m_dfLockStepTimeout;
+    m_MissionReader.GetValue("LockStepTimeout",dfLockStepTimeout);
+    P.GetVariable("--lockstep_timeout",dfLockStepTimeout);
+
+    if(bLockStep)
+        SetLockStep(dfLockStepPeriod,nLockStepClients,dfLockStepTimeout);
+
 
     ///////////////////////////////////////////////////////////
     //is there a network - default  - true
@@ -350,6 +383,10 @@ bool CMOOSDB::Run(int argc,  char * argv[] )
     if(P.GetFlag("--tcpnodelay"))
     	bTCPNoDelay = true;
 
+    //lockstep is a rapid exchange of small packets - don't let nagle hold them
+    if(m_bLockStep)
+        bTCPNoDelay = true;
+
 
 
     ///////////////////////////////////////////////////////////
@@ -579,10 +616,27 @@ bool CMOOSDB::OnRxPkt(const std::string & sClient,MOOSMSG_LIST & MsgListRx,MOOSM
 
     MOOSMSG_LIST::iterator p;
     
+    //traced mail is stamped with when it arrived (all of a packet
+    //arrives together)
+    double dfRxTime = -1;
+    for(p = MsgListRx.begin();p!=MsgListRx.end();p++)
+    {
+        if(p->IsTraced())
+        {
+            if(dfRxTime<0)
+                dfRxTime = CMOOSMsg::GetTraceTime();
+            p->SetTraceStamp(CMOOSMsg::TRACE_DB_RECEIVE,dfRxTime);
+        }
+    }
+
     for(p = MsgListRx.begin();p!=MsgListRx.end();p++)
     {
         ProcessMsg(*p,MsgListTx);
     }
+
+    //any client calling in lets us notice one which has stopped ticking
+    if(m_bLockStep)
+        LockStepCheckTimeout();
     
 
     double dfNow = MOOS::Time();
@@ -672,6 +726,17 @@ bool CMOOSDB::ProcessMsg(CMOOSMsg &MsgRx,MOOSMSG_LIST & MsgListTx)
     switch(MsgRx.m_cMsgType)
     {
     case MOOS_NOTIFY:    //NOTIFICATION
+        if(m_bLockStep && (MsgRx.IsName(MOOS_LOCKSTEP_ACK) || MsgRx.IsName(MOOS_LOCKSTEP_JOIN)))
+            return OnLockStepMsg(MsgRx);
+        if(m_bLockStep && m_bLockStepStarted &&
+           m_LockStepClients.find(MsgRx.m_sSrc)!=m_LockStepClients.end())
+        {
+            //mail from a lockstep client is held until the tick is over
+            //so it can be delivered in order - everyone else is not
+            //stepping with the clock so their mail goes straight through
+            m_LockStepMail.push_back(MsgRx);
+            return true;
+        }
         return OnNotify(MsgRx);
         break;
     case MOOS_WILDCARD_UNREGISTER:
@@ -798,6 +863,20 @@ bool CMOOSDB::OnNotify(CMOOSMsg &Msg)
             rVar.m_Stats.m_dfLastStatsTime = dfTimeNow;
         }
         
+        //how long did a traced notification take to get here?
+        if(Msg.IsTraced())
+        {
+            double dfSent,dfReceived;
+            if(Msg.GetTraceStamp(CMOOSMsg::TRACE_CLIENT_SEND,dfSent) &&
+               Msg.GetTraceStamp(CMOOSMsg::TRACE_DB_RECEIVE,dfReceived))
+            {
+                rVar.m_UpstreamLatency.Add(dfReceived-dfSent);
+            }
+
+            //and every subscriber's copy is queued from now
+            Msg.SetTraceStamp(CMOOSMsg::TRACE_DB_ENQUEUE);
+        }
+
         //now comes the intersting part...
         //which clients have asked to be informed
         //of changes in this variable?
@@ -1116,6 +1195,14 @@ bool CMOOSDB::OnDisconnect(string &sClient)
     }
     
     m_HeldMailMap.erase(sClient);
+
+    //don't let the lockstep clock wait on a client which has gone
+    m_LockStepEvicted.erase(sClient);
+    if(m_LockStepClients.erase(sClient))
+    {
+        m_LockStepAcked.erase(sClient);
+        LockStepAdvance();
+    }
     
     if(!m_bQuiet)
         std::cout<<MOOS::ConsoleColours::Green()<<"[OK]\n"<<MOOS::ConsoleColours::reset();
@@ -1132,6 +1219,134 @@ bool CMOOSDB::OnDisconnect(string &sClient)
     return true;
 }
 
+/** lockstep mail is delivered by sender and then in the order sent*/
+static bool LockStepMailOrder(const CMOOSMsg & A, const CMOOSMsg & B)
+{
+    if(A.m_sSrc!=B.m_sSrc)
+        return A.m_sSrc<B.m_sSrc;
+    return A.m_nID<B.m_nID;
+}
+
+void CMOOSDB::SetLockStep(double dfPeriod, unsigned int nClients, double dfTimeout)
+{
+    m_bLockStep = true;
+    m_dfLockStepPeriod = dfPeriod>0.0 ? dfPeriod : 0.1;
+    m_nLockStepClients = nClients;
+    m_dfLockStepTimeout = dfTimeout;
+
+    EnableMOOSVirtualTime(true);
+}
+
+bool CMOOSDB::OnLockStepMsg(CMOOSMsg &Msg)
+{
+    const std::string & sClient = Msg.m_sSrc;
+
+    if(m_LockStepEvicted.erase(sClient))
+    {
+        //a client dropped for being slow is back - it rejoins at the next tick
+        std::cerr<<MOOS::ConsoleColours::yellow();
+        std::cerr<<"lockstep client \""<<sClient<<"\" is back\n";
+        std::cerr<<MOOS::ConsoleColours::reset();
+        m_LockStepClients.insert(sClient);
+        m_LockStepAcked.insert(sClient);
+    }
+    else if(Msg.IsName(MOOS_LOCKSTEP_JOIN))
+    {
+        if(!m_bQuiet)
+            std::cout<<"+ lockstep client \""<<sClient<<"\"\n";
+
+        m_LockStepClients.insert(sClient);
+
+        //a client joining mid-tick will pick up the next one
+        if(m_bLockStepStarted)
+            m_LockStepAcked.insert(sClient);
+    }
+    else if(Msg.GetDouble()==MOOSTime())
+    {
+        //acknowledgement of the current tick (late ones are ignored)
+        m_LockStepAcked.insert(sClient);
+    }
+
+    LockStepAdvance();
+
+    return true;
+}
+
+void CMOOSDB::LockStepCheckTimeout()
+{
+    if(!m_bLockStepStarted || m_dfLockStepTimeout<=0.0)
+        return;
+
+    if(MOOSLocalTime(false)-m_dfLockStepTickIssued<m_dfLockStepTimeout)
+        return;
+
+    //a client which has hung or is stuck must not stop the clock for everyone
+    std::set<std::string>::iterator p = m_LockStepClients.begin();
+    while(p!=m_LockStepClients.end())
+    {
+        if(m_LockStepAcked.find(*p)!=m_LockStepAcked.end())
+        {
+            p++;
+            continue;
+        }
+
+        std::cerr<<MOOS::ConsoleColours::Red();
+        std::cerr<<"lockstep client \""<<*p<<"\" has not acknowledged tick ";
+        std::cerr<<std::fixed<<MOOSTime()<<" in "<<m_dfLockStepTimeout;
+        std::cerr<<"s - dropped from lockstep until it acknowledges again\n";
+        std::cerr<<MOOS::ConsoleColours::reset();
+
+        m_EventLogger.AddEvent("lockstep",*p,"client dropped for not acknowledging a tick");
+
+        m_LockStepEvicted.insert(*p);
+        m_LockStepClients.erase(p++);
+    }
+
+    LockStepAdvance();
+}
+
+void CMOOSDB::LockStepAdvance()
+{
+    if(!m_bLockStep || m_LockStepClients.empty())
+        return;
+
+    if(!m_bLockStepStarted)
+    {
+        //wait until all the expected clients are here
+        if(m_LockStepClients.size()<m_nLockStepClients)
+            return;
+
+        m_bLockStepStarted = true;
+    }
+    else
+    {
+        std::set<std::string>::iterator p;
+        for(p=m_LockStepClients.begin();p!=m_LockStepClients.end();p++)
+        {
+            if(m_LockStepAcked.find(*p)==m_LockStepAcked.end())
+                return;
+        }
+
+        //everything posted during the tick is now in - deliver it in an
+        //order which does not depend on when each packet happened to arrive
+        m_LockStepMail.sort(LockStepMailOrder);
+        MOOSMSG_LIST::iterator q;
+        for(q=m_LockStepMail.begin();q!=m_LockStepMail.end();q++)
+            OnNotify(*q);
+        m_LockStepMail.clear();
+
+        SetMOOSVirtualTime(MOOSTime()+m_dfLockStepPeriod);
+    }
+
+    m_LockStepAcked.clear();
+    m_dfLockStepTickIssued = MOOSLocalTime(false);
+
+    CMOOSMsg Tick(MOOS_NOTIFY,MOOS_LOCKSTEP_TICK,MOOSTime());
+    Tick.m_sOriginatingCommunity = m_sCommunityName;
+    Tick.m_sSrc = m_sDBName;
+    OnNotify(Tick);
+}
+
 bool CMOOSDB::DoServerRequest(CMOOSMsg &Msg, MOOSMSG_LIST &MsgTxList)
 {
     //explictly requesting the server to do something...
@@ -1148,6 +1363,10 @@ bool CMOOSDB::DoServerRequest(CMOOSMsg &Msg, MOOSMSG_LIST &MsgTxList)
     {
         return OnVarSummaryRequested(Msg, MsgTxList);
     }
+    else if(Msg.m_sKey.find(MOOS_LATENCY_SUMMARY)!=string::npos)
+    {
+        return OnLatencySummaryRequested(Msg,MsgTxList);
+    }
     else if(Msg.m_sKey.find("DB_CLEAR")!=string::npos)
     {
         return OnClearRequested(Msg,MsgTxList);
@@ -1367,6 +1586,41 @@ bool CMOOSDB::OnVarSummaryRequested(CMOOSMsg &Msg, MOOSMSG_LIST &MsgTxList)
 
 
 
+bool CMOOSDB::OnLatencySummaryRequested(CMOOSMsg &Msg, MOOSMSG_LIST &MsgTxList)
+{
+    //one reply for each variable which has seen traced notifications
+    //(or a single empty one so the client is not left waiting)
+    CMOOSMsg Reply;
+    Reply.m_nID = Msg.m_nID;
+    Reply.m_cMsgType = MOOS_NOTIFY;
+    Reply.m_cDataType = MOOS_STRING;
+    Reply.m_dfTime = MOOSTime();
+    Reply.m_sSrc = m_sDBName;
+    Reply.m_sKey = MOOS_LATENCY_SUMMARY;
+    Reply.m_dfVal = -1;
+
+    bool bAny = false;
+    DBVAR_MAP::iterator p;
+    for(p = m_VarMap.begin(); p != m_VarMap.end(); p++)
+    {
+        CMOOSDBVar & rVar = p->second;
+        if(rVar.m_UpstreamLatency.GetCount()==0)
+            continue;
+
+        Reply.m_sVal = "var="+rVar.m_sName+",leg=upstream,"+rVar.m_UpstreamLatency.GetSummary();
+        MsgTxList.push_front(Reply);
+        bAny = true;
+    }
+
+    if(!bAny)
+    {
+        Reply.m_sVal = "";
+        MsgTxList.push_front(Reply);
+    }
+
+    return true;
+}
+
 bool CMOOSDB::OnClearRequested(CMOOSMsg &Msg, MOOSMSG_LIST &MsgTxList)
 {
 	MOOS::DeliberatelyNotUsed(Msg);
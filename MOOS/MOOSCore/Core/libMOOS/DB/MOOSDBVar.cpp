@@ -135,6 +135,7 @@ bool CMOOSDBVar::Reset()
     m_dfWrittenTime = -1;
     m_nWrittenTo = 0;
     m_dfWriteFreq = 0;
+    m_UpstreamLatency.Clear();
 
     return true;
 }
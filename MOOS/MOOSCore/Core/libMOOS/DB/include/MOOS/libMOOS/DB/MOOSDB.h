@@ -100,6 +100,17 @@ public:
 
     bool IsRunning();
 
+    /** own a virtual clock and step clients in lockstep with it. The clock
+    moves on dfPeriod seconds once every client has acknowledged the current
+    tick, starting when nClients have joined. A client which has not
+    acknowledged a tick within dfTimeout wall seconds (if positive) is
+    dropped from the barrier until it next acknowledges. Mail posted during
+    a tick by a lockstep client is held and delivered before the next tick,
+    ordered by sender and then by message id. Mail from clients which have
+    not joined is passed on as it arrives. Run() calls this when
+    MOOSLockStep is set*/
+    void SetLockStep(double dfPeriod, unsigned int nClients, double dfTimeout);
+
     /** returns the port on which this DB is listening */
     long GetDBPort(){return m_nPort;};
 
@@ -127,6 +138,7 @@ protected:
     bool OnServerAllRequested(CMOOSMsg & Msg, MOOSMSG_LIST & MsgTxList);
     bool OnProcessSummaryRequested(CMOOSMsg &Msg, MOOSMSG_LIST &MsgTxList);
     bool OnVarSummaryRequested(CMOOSMsg &Msg, MOOSMSG_LIST &MsgTxList);
+    bool OnLatencySummaryRequested(CMOOSMsg &Msg, MOOSMSG_LIST &MsgTxList);
 
     void UpdateDBTimeVars();
     void UpdateDBClientsVar();
@@ -143,6 +155,14 @@ protected:
     double GetStartTime(){return m_dfStartTime;}
     void OnPrintVersionAndExit();
 
+    /** handle a lockstep join or tick acknowledgement from a client*/
+    bool OnLockStepMsg(CMOOSMsg & Msg);
+    /** if every lockstep client has acknowledged the current tick move
+    the virtual clock on one period and publish the next tick*/
+    void LockStepAdvance();
+    /** drop lockstep clients which are overdue acknowledging the current tick*/
+    void LockStepCheckTimeout();
+
 private:
     std::string m_sDBName;
     std::string m_sCommunityName;
@@ -172,6 +192,25 @@ private:
 
     MOOS::SuicidalSleeper m_SuicidalSleeper;
 
+    /** true if the DB owns a virtual clock and steps clients in lockstep*/
+    bool m_bLockStep;
+    /** virtual seconds the clock moves on at each tick*/
+    double m_dfLockStepPeriod;
+    /** number of clients which must join before the clock starts*/
+    unsigned int m_nLockStepClients;
+    /** wall seconds a client may take to acknowledge a tick*/
+    double m_dfLockStepTimeout;
+    bool m_bLockStepStarted;
+    /** the (wall) time at which the current tick was published*/
+    double m_dfLockStepTickIssued;
+    /** clients taking part in lockstep and those done with this tick*/
+    std::set<std::string> m_LockStepClients;
+    std::set<std::string> m_LockStepAcked;
+    /** clients dropped for not acknowledging a tick in time*/
+    std::set<std::string> m_LockStepEvicted;
+    /** mail posted during the current tick*/
+    MOOSMSG_LIST m_LockStepMail;
+
 
 private:
     void LogStartTime();
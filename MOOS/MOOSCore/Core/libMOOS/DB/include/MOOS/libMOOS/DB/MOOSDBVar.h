@@ -42,6 +42,7 @@ using namespace std;
 typedef set<string> STRING_SET;
 
 #include "MOOSRegisterInfo.h"
+#include "MOOS/libMOOS/Utils/LatencyHistogram.h"
 
 
 typedef map<string,CMOOSRegisterInfo> REGISTER_INFO_MAP;
@@ -82,6 +83,9 @@ public:
 	//number of times written to
     int     m_nWrittenTo;
 
+    //time taken by traced notifications to get from their publisher to us
+    MOOS::LatencyHistogram m_UpstreamLatency;
+
 
     REGISTER_INFO_MAP m_Subscribers;
     STRING_SET m_Writers;
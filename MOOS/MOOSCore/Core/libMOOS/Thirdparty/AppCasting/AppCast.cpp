@@ -35,6 +35,8 @@
 
 using namespace std;
 
+static vector<string> splitAppCastString(const string&);
+
 //----------------------------------------------------------------
 // Constructor(s)
 
@@ -199,6 +201,52 @@ string AppCast::getAppCastString() const
 	return (ss.str());
 }
 
+//----------------------------------------------------------------
+// Procedure: getAppCastDelta
+//   Purpose: Express this appcast as a line-level change to a previously
+//            posted appcast string, prev_str, which had iteration prev_iter.
+//            Both strings are split at the inner separator and only the
+//            lines which differ by position are sent.
+//   Example: str = "proc=uProc!@#node=henry!@#iter=124!@#delta_base=123!@#
+//                   delta_size=48!@#delta=2:iter=124!@17:  Speed: 1.9"
+//
+//      Note: Since the outer separator contains the inner separator the
+//            lines include the section boundaries, so the whole string
+//            is rebuilt by joining the lines again.
+
+string AppCast::getAppCastDelta(const string& prev_str,
+		unsigned int prev_iter) const
+{
+	string osep = "!@#"; // outer separator
+	string isep = "!@"; // inner separator
+
+	vector<string> prev_lines = splitAppCastString(prev_str);
+	vector<string> curr_lines = splitAppCastString(getAppCastString());
+
+	stringstream ss;
+	ss << "proc=" << m_proc_name << osep;
+	if (m_node_name != "")
+		ss << "node=" << m_node_name << osep;
+	ss << "iter=" << m_iteration << osep;
+	ss << "delta_base=" << prev_iter << osep;
+	ss << "delta_size=" << curr_lines.size() << osep;
+	ss << "delta=";
+
+	bool first = true;
+	unsigned int i, vsize = curr_lines.size();
+	for (i = 0; i < vsize; i++)
+	{
+		if ((i < prev_lines.size()) && (prev_lines[i] == curr_lines[i]))
+			continue;
+		if (!first)
+			ss << isep;
+		ss << i << ":" << curr_lines[i];
+		first = false;
+	}
+
+	return (ss.str());
+}
+
 //----------------------------------------------------------------
 // Procedure: getFormattedString
 
@@ -371,3 +419,137 @@ AppCast string2AppCast(const std::string& str)
 
 	return (ac);
 }
+
+//----------------------------------------------------------------
+// Procedure: isAppCastDelta
+//   Returns: true if the given string was made by getAppCastDelta()
+//            rather than being a full appcast.
+
+bool isAppCastDelta(const std::string& str)
+{
+	return (str.find("!@#delta_base=") != string::npos);
+}
+
+//----------------------------------------------------------------
+// Procedure: getAppCastDeltaInfo
+//   Purpose: Pull out the node and proc an appcast delta is from and
+//            the iteration of the appcast it must be applied to.
+
+bool getAppCastDeltaInfo(const std::string& delta, std::string& node,
+		std::string& proc, unsigned int& base_iter)
+{
+	string osep = "!@#"; // outer separator
+
+	bool base_found = false;
+	string str = delta;
+	while (str != "")
+	{
+		string pair = MOOSChomp(str, osep);
+		string param = MOOSChomp(pair, "=");
+		if (param == "proc")
+			proc = pair;
+		else if (param == "node")
+			node = pair;
+		else if (param == "delta_base")
+		{
+			base_iter = (unsigned int) (atoi(pair.c_str()));
+			base_found = true;
+		}
+		else if (param == "delta_size")
+			break;
+	}
+
+	return (base_found);
+}
+
+//----------------------------------------------------------------
+// Procedure: applyAppCastDelta
+//   Purpose: Rebuild the full appcast string from a delta and the
+//            appcast string it was taken against.
+//   Returns: false if prev_iter is not the iteration the delta was taken
+//            against, e.g., because one or more appcasts were missed. The
+//            caller should then wait for the next full appcast.
+
+bool applyAppCastDelta(const std::string& delta, const std::string& prev_str,
+		unsigned int prev_iter, std::string& result)
+{
+	string osep = "!@#"; // outer separator
+	string isep = "!@"; // inner separator
+
+	size_t pos_size = delta.find(osep + "delta_size=");
+	size_t pos_diff = delta.find(osep + "delta=");
+	if ((pos_size == string::npos) || (pos_diff == string::npos))
+		return (false);
+
+	string node, proc;
+	unsigned int base_iter = 0;
+	if (!getAppCastDeltaInfo(delta, node, proc, base_iter))
+		return (false);
+	if (base_iter != prev_iter)
+		return (false);
+
+	size_t size_start = pos_size + osep.length() + 11;
+	int new_size = atoi(delta.substr(size_start, pos_diff - size_start).c_str());
+	if (new_size < 0)
+		return (false);
+
+	vector<string> lines = splitAppCastString(prev_str);
+	lines.resize((unsigned int) (new_size));
+
+	string diffs = delta.substr(pos_diff + osep.length() + 6);
+	while (diffs != "")
+	{
+		// Do not use MOOSChomp here, the line may contain leading and
+		// trailing white space which is part of the appcast content.
+		size_t pos = diffs.find(isep);
+		string item = diffs.substr(0, pos);
+		if (pos == string::npos)
+			diffs = "";
+		else
+			diffs = diffs.substr(pos + isep.length());
+
+		size_t colon = item.find(':');
+		if (colon == string::npos)
+			return (false);
+		int ix = atoi(item.substr(0, colon).c_str());
+		if ((ix < 0) || (ix >= new_size))
+			return (false);
+		lines[ix] = item.substr(colon + 1);
+	}
+
+	result = "";
+	unsigned int i, vsize = lines.size();
+	for (i = 0; i < vsize; i++)
+	{
+		if (i > 0)
+			result += isep;
+		result += lines[i];
+	}
+	return (true);
+}
+
+//----------------------------------------------------------------
+// Procedure: splitAppCastString
+//   Purpose: Split an appcast string into lines at every inner separator,
+//            keeping empty lines, so that joining them restores the
+//            string exactly.
+
+static vector<string> splitAppCastString(const string& str)
+{
+	string isep = "!@"; // inner separator
+
+	vector<string> lines;
+	size_t start = 0;
+	while (true)
+	{
+		size_t pos = str.find(isep, start);
+		if (pos == string::npos)
+		{
+			lines.push_back(str.substr(start));
+			break;
+		}
+		lines.push_back(str.substr(start, pos - start));
+		start = pos + isep.length();
+	}
+	return (lines);
+}
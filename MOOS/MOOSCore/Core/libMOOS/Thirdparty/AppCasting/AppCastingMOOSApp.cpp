@@ -51,6 +51,11 @@ AppCastingMOOSApp::AppCastingMOOSApp()
   m_term_reporting  = true;
   m_new_run_warning = false;
   m_new_cfg_warning = false;
+
+  m_last_appcast_iter         = 0;
+  m_appcast_keyframe_interval = 10;
+  m_appcasts_since_keyframe   = 0;
+  m_appcast_keyframe_due      = true;
 }
 
 //----------------------------------------------------------------
@@ -107,6 +112,10 @@ void AppCastingMOOSApp::PostReport(const string& directive)
   else if(directive.find("doterm") != string::npos)
     term_reporting = true;
 
+  // Nobody watches the terminal of an app driven headless
+  if(IsHeadless())
+    term_reporting = false;
+
   if(directive.find("noappcast") != string::npos)
     appcast_allowed = false;
 
@@ -158,10 +167,50 @@ void AppCastingMOOSApp::PostReport(const string& directive)
     m_new_run_warning = false;
     m_new_cfg_warning = false;
     m_last_report_time_appcast = m_curr_time;
-    m_Comms.Notify("APPCAST", m_ac.getAppCastString());
+    postAppCast();
   }
 }
 
+//----------------------------------------------------------------
+// Procedure: postAppCast
+//      Note: Every so often, or whenever a client may not be able to
+//            handle them, a full appcast is posted. In between, if the
+//            change since the last appcast is small, just the changed
+//            lines are posted. Clients rebuild the full appcast from
+//            the delta and the previous appcast. Deltas go out on
+//            APPCAST_DELTA so APPCAST only ever carries full appcasts
+//            for loggers and clients that never asked for deltas.
+
+void AppCastingMOOSApp::postAppCast()
+{
+  string full_appcast = m_ac.getAppCastString();
+  string post = full_appcast;
+
+  bool keyframe = true;
+  if(!m_appcast_keyframe_due && (m_last_appcast != "") &&
+     (m_appcasts_since_keyframe < m_appcast_keyframe_interval) &&
+     appcastDeltasAccepted()) {
+    string delta = m_ac.getAppCastDelta(m_last_appcast, m_last_appcast_iter);
+    if(delta.length() < (full_appcast.length() / 2)) {
+      post = delta;
+      keyframe = false;
+    }
+  }
+
+  if(keyframe)
+    m_appcasts_since_keyframe = 0;
+  else
+    m_appcasts_since_keyframe++;
+
+  m_appcast_keyframe_due = false;
+  m_last_appcast      = full_appcast;
+  m_last_appcast_iter = m_iteration;
+  if(keyframe)
+    m_Comms.Notify("APPCAST", post);
+  else
+    m_Comms.Notify("APPCAST_DELTA", post);
+}
+
 //----------------------------------------------------------------
 // Procedure: OnStartUp
 
@@ -278,6 +327,15 @@ bool AppCastingMOOSApp::OnStartUpDirectives(string directives)
 	cout << "+++++++++++++++++++++++++++++++++++++++++++++++++" << endl;      
       }
     }
+    else if(param == "APPCAST_KEYFRAME_INTERVAL") {
+      if(!MOOSIsNumeric(value))
+	reportConfigWarning("Invalid APPCAST_KEYFRAME_INTERVAL: " + value);
+      else {
+	int interval = atoi(value.c_str());
+	interval = (interval < 0) ? 0 : interval;
+	m_appcast_keyframe_interval = (unsigned int)(interval);
+      }
+    }
     else if(param == "MAX_APPCAST_RUN_WARNINGS") {
       if(!MOOSIsNumeric(value))
 	reportConfigWarning("Invalid MAX_APPCAST_EVENTS: " + value);
@@ -355,13 +413,15 @@ bool AppCastingMOOSApp::OnNewMail(MOOSMSG_LIST &NewMail)
 //                  app=pHostInfo,      (name of this app)
 //                  duration=10,        (lifespan of the request)
 //                  key=uMAC_438,       (name of client requesting)
-//                  thresh=any          (threshold for AC generation)
+//                  thresh=any,         (threshold for AC generation)
+//                  deltas=true         (client can rebuild from deltas)
 
 void AppCastingMOOSApp::handleMailAppCastRequest(const string& str)
 {
   string s_key;
   string s_duration;
   string s_thresh = "any";
+  bool   deltas   = false;
 
   string request = str;
   while(request != "") {
@@ -383,6 +443,8 @@ void AppCastingMOOSApp::handleMailAppCastRequest(const string& str)
       s_duration = value;
     else if(param == "THRESH")
       s_thresh = value;
+    else if(param == "DELTAS")
+      deltas = MOOSStrCmp(value, "true");
     else if(param == "KEY") {
       s_key = value;
     }
@@ -395,7 +457,14 @@ void AppCastingMOOSApp::handleMailAppCastRequest(const string& str)
   d_duration = (d_duration < 0) ? 0 : d_duration;
   d_duration = (d_duration > 30) ? 30 : d_duration;
 
+  // A client new to us, or whose request had lapsed, may not hold the
+  // last appcast and needs a full one to start from.
+  if((m_map_bcast_duration.count(s_key) == 0) ||
+     ((m_curr_time - m_map_bcast_tstart[s_key]) >= m_map_bcast_duration[s_key]))
+    m_appcast_keyframe_due = true;
+
   m_map_bcast_duration[s_key] = d_duration;
+  m_map_bcast_deltas[s_key]   = deltas;
   m_map_bcast_tstart[s_key]   = m_curr_time;
   m_map_bcast_thresh[s_key]   = s_thresh;
 }
@@ -431,6 +500,31 @@ bool AppCastingMOOSApp::appcastRequested()
   return(requested);
 }
 
+//----------------------------------------------------------------
+// Procedure: appcastDeltasAccepted
+//      Note: Deltas are only posted if every client with an un-expired
+//            request has said it can handle them. Older clients which
+//            do not say so get full appcasts just as before.
+
+bool AppCastingMOOSApp::appcastDeltasAccepted()
+{
+  bool accepted = false;
+
+  map<string,double>::iterator p;
+  for(p=m_map_bcast_duration.begin(); p!=m_map_bcast_duration.end(); p++) {
+    string key      = p->first;
+    double duration = p->second;
+    double elapsed  = m_curr_time - m_map_bcast_tstart[key];
+
+    if(elapsed < duration) {
+      if(!m_map_bcast_deltas[key])
+	return(false);
+      accepted = true;
+    }
+  }
+  return(accepted);
+}
+
 //----------------------------------------------------------------
 // Procedure: reportEvent
 
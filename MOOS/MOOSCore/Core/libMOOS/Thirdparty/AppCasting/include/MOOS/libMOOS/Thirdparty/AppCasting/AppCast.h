@@ -61,6 +61,8 @@ class AppCast
   std::string  getNodeName() const           {return(m_node_name);};
 
   std::string  getAppCastString() const;
+  std::string  getAppCastDelta(const std::string& prev_str,
+                               unsigned int prev_iter) const;
   std::string  getFormattedString(bool with_header=true) const;
 
  public: // Used for rebuilding an AppCast from String
@@ -92,4 +94,10 @@ class AppCast
 
 AppCast string2AppCast(const std::string&);
 
+bool isAppCastDelta(const std::string&);
+bool getAppCastDeltaInfo(const std::string& delta, std::string& node,
+                         std::string& proc, unsigned int& base_iter);
+bool applyAppCastDelta(const std::string& delta, const std::string& prev_str,
+                       unsigned int prev_iter, std::string& result);
+
 #endif
@@ -61,6 +61,8 @@ public:
  private:
   void         handleMailAppCastRequest(const std::string&);
   bool         appcastRequested();
+  bool         appcastDeltasAccepted();
+  void         postAppCast();
 
 protected:
   unsigned int m_iteration;
@@ -87,5 +89,13 @@ protected:
   std::map<std::string, double>       m_map_bcast_duration;
   std::map<std::string, double>       m_map_bcast_tstart;
   std::map<std::string, std::string>  m_map_bcast_thresh;  
+  std::map<std::string, bool>         m_map_bcast_deltas;
+
+  // State for posting appcasts as deltas against the previous one
+  std::string  m_last_appcast;
+  unsigned int m_last_appcast_iter;
+  unsigned int m_appcast_keyframe_interval;
+  unsigned int m_appcasts_since_keyframe;
+  bool         m_appcast_keyframe_due;
 };
 #endif
@@ -0,0 +1,124 @@
+/*
+ * LatencyHistogram.cpp
+ *
+ *  A fixed size histogram of delays with logarithmically spaced
+ *  buckets from which percentiles can be read.
+ */
+
+#include "MOOS/libMOOS/Utils/MOOSUtilityFunctions.h"
+#include "MOOS/libMOOS/Utils/LatencyHistogram.h"
+#include <cmath>
+#include <cstring>
+
+namespace MOOS
+{
+
+LatencyHistogram::LatencyHistogram()
+{
+    Clear();
+}
+
+void LatencyHistogram::Clear()
+{
+    memset(m_nBuckets,0,sizeof(m_nBuckets));
+    m_nCount = 0;
+    m_dfSum = 0.0;
+    m_dfMin = 0.0;
+    m_dfMax = 0.0;
+}
+
+void LatencyHistogram::Add(double dfSeconds)
+{
+    //clocks on different machines are only so well aligned so a
+    //small negative delay is possible - it goes in the first bucket
+    double dfMicroSeconds = dfSeconds*1e6;
+
+    int nBucket = 0;
+    if(dfMicroSeconds>=1.0)
+    {
+        int nExp;
+        frexp(dfMicroSeconds,&nExp);
+        nBucket = nExp<NUM_BUCKETS ? nExp : NUM_BUCKETS-1;
+    }
+    m_nBuckets[nBucket]++;
+
+    if(m_nCount==0 || dfSeconds<m_dfMin)
+        m_dfMin = dfSeconds;
+    if(m_nCount==0 || dfSeconds>m_dfMax)
+        m_dfMax = dfSeconds;
+
+    m_dfSum+=dfSeconds;
+    m_nCount++;
+}
+
+void LatencyHistogram::Merge(const LatencyHistogram & Other)
+{
+    if(Other.m_nCount==0)
+        return;
+
+    for(int i = 0;i<NUM_BUCKETS;i++)
+        m_nBuckets[i]+=Other.m_nBuckets[i];
+
+    if(m_nCount==0 || Other.m_dfMin<m_dfMin)
+        m_dfMin = Other.m_dfMin;
+    if(m_nCount==0 || Other.m_dfMax>m_dfMax)
+        m_dfMax = Other.m_dfMax;
+
+    m_dfSum+=Other.m_dfSum;
+    m_nCount+=Other.m_nCount;
+}
+
+double LatencyHistogram::GetMean() const
+{
+    return m_nCount ? m_dfSum/m_nCount : 0.0;
+}
+
+unsigned int LatencyHistogram::GetBucketCount(int nBucket) const
+{
+    if(nBucket<0 || nBucket>=NUM_BUCKETS)
+        return 0;
+    return m_nBuckets[nBucket];
+}
+
+double LatencyHistogram::GetBucketUpperBound(int nBucket)
+{
+    return ldexp(1.0,nBucket)*1e-6;
+}
+
+double LatencyHistogram::GetPercentile(double dfFraction) const
+{
+    if(m_nCount==0)
+        return 0.0;
+
+    double dfWanted = dfFraction*m_nCount;
+    unsigned int nSeen = 0;
+    for(int i = 0;i<NUM_BUCKETS;i++)
+    {
+        nSeen+=m_nBuckets[i];
+        if(nSeen>=dfWanted && nSeen>0)
+        {
+            //report the geometric middle of the bucket but never
+            //something outside what we have actually seen
+            double dfMiddle = GetBucketUpperBound(i)/sqrt(2.0);
+            if(dfMiddle<m_dfMin)
+                dfMiddle = m_dfMin;
+            if(dfMiddle>m_dfMax)
+                dfMiddle = m_dfMax;
+            return dfMiddle;
+        }
+    }
+    return m_dfMax;
+}
+
+std::string LatencyHistogram::GetSummary() const
+{
+    return MOOSFormat("n=%u,mean=%.3f,p50=%.3f,p90=%.3f,p99=%.3f,max=%.3f",
+                      m_nCount,
+                      GetMean()*1e3,
+                      GetPercentile(0.5)*1e3,
+                      GetPercentile(0.9)*1e3,
+                      GetPercentile(0.99)*1e3,
+                      GetMax()*1e3);
+}
+
+}
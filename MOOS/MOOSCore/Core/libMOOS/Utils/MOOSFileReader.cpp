@@ -45,6 +45,7 @@
 #include "MOOS/libMOOS/Utils/MOOSFileReader.h"
 #include "assert.h"
 #include "MOOS/libMOOS/Utils/MOOSLock.h"
+#include "MOOS/libMOOS/Utils/MOOSScopedLock.h"
 
 #define MAXLINESIZE 2000
 using namespace std;
@@ -57,8 +58,10 @@ CMOOSFileReader::CMOOSFileReader()
 {
 	//by default we want to use quotes to allow verbatim
 	//strings
-	EnableVerbatimQuoting(true);
+	m_bEnableVerbatimQuoting = true;
     m_pLock = new CMOOSLock();
+    m_pCacheLock = new CMOOSLock();
+    m_bCacheValid = false;
 }
 
 CMOOSFileReader::~CMOOSFileReader()
@@ -71,6 +74,9 @@ CMOOSFileReader::~CMOOSFileReader()
 	delete m_pLock;
 	m_pLock = NULL;
 
+	delete m_pCacheLock;
+	m_pCacheLock = NULL;
+
 	ClearFileMap();
 }
 
@@ -103,8 +109,73 @@ bool CMOOSFileReader::SetFile(const std::string  & sFile)
     
     BuildLocalShellVars();
 
+    //build the cache now, before any other thread comes looking
+    m_pCacheLock->Lock();
+    BuildCache();
+    m_pCacheLock->UnLock();
+
+    return true;
+
+}
+
+bool CMOOSFileReader::BuildCache()
+{
+    m_CachedLines.clear();
+    m_CachedValues.clear();
+    m_bCacheValid = false;
+
+    if(!IsOpen())
+        return false;
+
+    Reset();
+
+    GetFile()->seekg(std::ios::beg);
+
+    std::string sLine,sVal,sTok;
+    while(!GetFile()->eof())
+    {
+        sLine = GetNextValidLine();
+        m_CachedLines.push_back(sLine);
+
+        if(GetTokenValPair(sLine, sTok, sVal))
+        {
+            //first occurrence in the file wins
+            MOOSToUpper(sTok);
+            if(m_CachedValues.find(sTok)==m_CachedValues.end())
+                m_CachedValues[sTok] = sVal;
+        }
+    }
+
+    Reset();
+
+    m_bCacheValid = true;
     return true;
+}
+
+void CMOOSFileReader::EnableVerbatimQuoting(bool bEnable)
+{
+    MOOS::ScopedLock L(*m_pCacheLock);
+
+    if(bEnable!=m_bEnableVerbatimQuoting)
+        m_bCacheValid = false;
+    m_bEnableVerbatimQuoting = bEnable;
+}
 
+bool CMOOSFileReader::EnsureCache()
+{
+    MOOS::ScopedLock L(*m_pCacheLock);
+
+    if(m_bCacheValid)
+        return true;
+
+    return BuildCache();
+}
+
+std::string CMOOSFileReader::GetCachedLine(size_t nLine) const
+{
+    if(nLine<m_CachedLines.size())
+        return m_CachedLines[nLine];
+    return std::string();
 }
 
 
@@ -246,31 +317,18 @@ bool CMOOSFileReader::GetValue(std::string sName,int  & nResult)
 
 bool CMOOSFileReader::GetValue(std::string sName,std::string & sResult)
 {
+    if(!EnsureCache())
+        return false;
 
-    
-    if(IsOpen())
-    {
-        Reset();
-     
-        GetFile()->seekg(std::ios::beg);
+    MOOSToUpper(sName);
 
-        std::string sLine,sVal,sTok;
-        while(!GetFile()->eof())
-        {
-            sLine = GetNextValidLine();
+    std::map<std::string,std::string>::const_iterator q;
+    q = m_CachedValues.find(sName);
+    if(q==m_CachedValues.end())
+        return false;
 
-            if(GetTokenValPair(sLine, sTok, sVal))
-            {
-                if(MOOSStrCmp(sTok,sName))
-                {
-                    sResult = sVal;
-                    return true;
-                }
-            }       
-        }
-    }
- 
-    return false;
+    sResult = q->second;
+    return true;
 }
 
 
@@ -102,6 +102,38 @@ typedef std::map<pthread_t,bool> THREAD2TRACE_MAP;
 double gdfMOOSTimeWarp = 1.0;
 double gdfMOOSSkew =0.0;
 
+//the virtual clock is set by the comms thread and read by every thread
+//so it is only touched under VirtualTimeLock(). The enabled flag is
+//also written under the lock but is read without it so MOOSTime()
+//only pays for the lock when virtual time is actually in use
+volatile int gnMOOSVirtualTime = 0;
+double gdfMOOSVirtualTime = 0.0;
+
+static CMOOSLock & VirtualTimeLock()
+{
+    static CMOOSLock Lock;
+    return Lock;
+}
+
+static bool VirtualTimeFlag()
+{
+#ifdef _WIN32
+    //MSVC gives volatile reads acquire semantics
+    return gnMOOSVirtualTime!=0;
+#else
+    return __atomic_load_n(&gnMOOSVirtualTime,__ATOMIC_ACQUIRE)!=0;
+#endif
+}
+
+static void SetVirtualTimeFlag(bool bEnable)
+{
+#ifdef _WIN32
+    InterlockedExchange(reinterpret_cast<volatile LONG*>(&gnMOOSVirtualTime),bEnable ? 1 : 0);
+#else
+    __atomic_store_n(&gnMOOSVirtualTime,bEnable ? 1 : 0,__ATOMIC_RELEASE);
+#endif
+}
+
 //NB new V10 functions will be namespaced....
 namespace MOOS
 {
@@ -312,6 +344,14 @@ double HPMOOSTime(bool bApplyTimeWarping)
 
 double MOOSTime(bool bApplyTimeWarping)
 {
+    if(VirtualTimeFlag())
+    {
+        //check again under the lock - it may have been switched off
+        MOOS::ScopedLock L(VirtualTimeLock());
+        if(VirtualTimeFlag())
+            return gdfMOOSVirtualTime;
+    }
+
     return MOOSLocalTime(bApplyTimeWarping)+gdfMOOSSkew;
 }
 
@@ -320,6 +360,28 @@ double GetMOOSTimeWarp()
     return gdfMOOSTimeWarp;
 }
 
+void EnableMOOSVirtualTime(bool bEnable)
+{
+    double dfNow = MOOSLocalTime()+gdfMOOSSkew;
+
+    MOOS::ScopedLock L(VirtualTimeLock());
+    if(bEnable && !VirtualTimeFlag())
+        gdfMOOSVirtualTime = dfNow;
+
+    SetVirtualTimeFlag(bEnable);
+}
+
+bool IsMOOSVirtualTimeEnabled()
+{
+    return VirtualTimeFlag();
+}
+
+void SetMOOSVirtualTime(double dfTime)
+{
+    MOOS::ScopedLock L(VirtualTimeLock());
+    gdfMOOSVirtualTime = dfTime;
+}
+
 bool SetMOOSTimeWarp(double dfWarp)
 {
     if(dfWarp>0 && dfWarp<=MAX_TIME_WARP)
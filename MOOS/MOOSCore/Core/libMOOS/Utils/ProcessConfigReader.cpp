@@ -71,54 +71,54 @@ bool CProcessConfigReader::GetConfigurationAndPreserveSpace(std::string sAppName
 {
 	Params.clear();
 
-	int nBrackets = 0;
-	Params.clear();
+	size_t nLine = 0;
+	if(GetBlockStart(sAppName, nLine))
+		return GetBlockAndPreserveSpace(nLine, Params);
 
-	Reset();
+	return false;
+}
 
-	std::string sKey = "PROCESSCONFIG="+sAppName;
+bool CProcessConfigReader::GetBlockAndPreserveSpace(size_t nLine, STRING_LIST &Params)
+{
+	Params.clear();
 
-	if(GoTo(sKey))
+	std::string sBracket = GetCachedLine(nLine++);
+	if(sBracket.find("{")==0)
 	{
-		std::string sBracket = GetNextValidLine();
-		if(sBracket.find("{")==0)
+		while(nLine<m_CachedLines.size())
 		{
-			nBrackets++;
-			while(!GetFile()->eof())
+			std::string sLine = GetCachedLine(nLine++);
+			MOOSTrimWhiteSpace(sLine);
+
+			if(sLine.find("}")!=0)
 			{
-				std::string sLine = GetNextValidLine();
-				MOOSTrimWhiteSpace(sLine);
+				std::string sVal(sLine);
+				std::string sTok = MOOSChomp(sVal, "=");
+				MOOSTrimWhiteSpace(sTok);
+				MOOSTrimWhiteSpace(sVal);
 
-				if(sLine.find("}")!=0)
+				if (!sTok.empty())
 				{
-					std::string sVal(sLine);
-					std::string sTok = MOOSChomp(sVal, "=");
-					MOOSTrimWhiteSpace(sTok);
-					MOOSTrimWhiteSpace(sVal);
 
-					if (!sTok.empty())
+					if (!sVal.empty())
 					{
-
-						if (!sVal.empty())
-						{
-							Params.push_back(sTok+"="+sVal);
-						}
-						else if(sLine.find("[")!=std::string::npos || sLine.find("]")!=std::string::npos)
-						{
-							Params.push_back(sLine);
-						}
+						Params.push_back(sTok+"="+sVal);
+					}
+					else if(sLine.find("[")!=std::string::npos || sLine.find("]")!=std::string::npos)
+					{
+						Params.push_back(sLine);
 					}
 				}
-				else
-				{
-					return true;
-				}
+			}
+			else
+			{
+				return true;
+			}
 
-				//quick error check - we don't allow nested { on single lines
-				if(sLine.find("{")==0)
-				{
-					MOOSTrace("CProcessConfigReader::GetConfiguration() missing \"}\" syntax error in mission file\n");
-				}
+			//quick error check - we don't allow nested { on single lines
+			if(sLine.find("{")==0)
+			{
+				MOOSTrace("CProcessConfigReader::GetConfiguration() missing \"}\" syntax error in mission file\n");
 			}
 		}
 	}
@@ -133,22 +133,17 @@ bool CProcessConfigReader::GetConfigurationAndPreserveSpace(std::string sAppName
 bool CProcessConfigReader::GetConfiguration(std::string sAppName, STRING_LIST &Params)
 {
     
-    int nBrackets = 0;
     Params.clear();
     
-    Reset();
-    
-    std::string sKey = "PROCESSCONFIG="+sAppName;
-    
-    if(GoTo(sKey))
+    size_t nLine = 0;
+    if(GetBlockStart(sAppName, nLine))
     {
-        std::string sBracket = GetNextValidLine();
+        std::string sBracket = GetCachedLine(nLine++);
         if(sBracket.find("{")==0)
         {
-            nBrackets++;
-            while(!GetFile()->eof())
+            while(nLine<m_CachedLines.size())
             {
-                std::string sLine = GetNextValidLine();
+                std::string sLine = GetCachedLine(nLine++);
                 
                 MOOSRemoveChars(sLine," \t\r");
                 
@@ -302,17 +297,61 @@ bool CProcessConfigReader::GetConfigurationParam(std::string sAppName,std::strin
 ///                               READ STRINGS
 bool CProcessConfigReader::GetConfigurationParam(std::string sAppName,std::string sParam, std::string &sVal)
 {
-    Reset();
-
     //remember all names we were asked for....
     std::string sl = sParam;
     MOOSToLower(sl);
     m_Audit[sAppName].insert(sl);
 
-    STRING_LIST sParams;
-    
-    if(GetConfigurationAndPreserveSpace( sAppName, sParams))
+    if(!EnsureCache())
+        return false;
+
+    std::map<std::string, std::map<std::string, std::string> >::const_iterator p;
+    p = m_BlockParams.find(GetBlockKey(sAppName));
+    if(p==m_BlockParams.end())
+        return false;
+
+    MOOSToUpper(sParam);
+
+    std::map<std::string, std::string>::const_iterator q;
+    q = p->second.find(sParam);
+    if(q==p->second.end())
+        return false;
+
+    sVal = q->second;
+    return true;
+}
+
+bool CProcessConfigReader::BuildCache()
+{
+    m_BlockStarts.clear();
+    m_BlockParams.clear();
+
+    if(!CMOOSFileReader::BuildCache())
+        return false;
+
+    //index the first "ProcessConfig = X" line for each X
+    std::string sHeader = "PROCESSCONFIG=";
+    for(size_t i=0;i<m_CachedLines.size();i++)
     {
+        std::string sLine = m_CachedLines[i];
+        MOOSRemoveChars(sLine," \t\r");
+        MOOSToUpper(sLine);
+        if(sLine.find(sHeader)==0 && m_BlockStarts.find(sLine)==m_BlockStarts.end())
+            m_BlockStarts[sLine] = i+1;
+    }
+
+    //now the parameters of each well formed block. As when searching
+    //the block in order, the first occurrence of a parameter wins and
+    //a line with no value hides everything after it
+    std::map<std::string, size_t>::const_iterator b;
+    for(b=m_BlockStarts.begin();b!=m_BlockStarts.end();b++)
+    {
+        std::string sKey = b->first;
+        STRING_LIST sParams;
+        if(!GetBlockAndPreserveSpace(b->second,sParams))
+            continue;
+
+        std::map<std::string, std::string> & Params = m_BlockParams[sKey];
         STRING_LIST::iterator p;
         for(p = sParams.begin();p!=sParams.end();p++)
         {
@@ -321,18 +360,40 @@ bool CProcessConfigReader::GetConfigurationParam(std::string sAppName,std::strin
             MOOSTrimWhiteSpace(sTok);
 
             if (sTmp.empty())
-                return false;
-            
-            if(MOOSStrCmp(sTok,sParam))
+                break;
+
+            MOOSToUpper(sTok);
+            if(Params.find(sTok)==Params.end())
             {
                 MOOSTrimWhiteSpace(sTmp);
-
-            	sVal=sTmp;
-                return true;
+                Params[sTok] = sTmp;
             }
         }
     }
-    return false;
+
+    return true;
+}
+
+bool CProcessConfigReader::GetBlockStart(const std::string & sAppName, size_t & nLine)
+{
+    if(!EnsureCache())
+        return false;
+
+    std::map<std::string, size_t>::const_iterator p;
+    p = m_BlockStarts.find(GetBlockKey(sAppName));
+    if(p==m_BlockStarts.end())
+        return false;
+
+    nLine = p->second;
+    return true;
+}
+
+std::string CProcessConfigReader::GetBlockKey(const std::string & sAppName)
+{
+    std::string sKey = "PROCESSCONFIG="+sAppName;
+    MOOSRemoveChars(sKey," \t\r");
+    MOOSToUpper(sKey);
+    return sKey;
 }
 
 
@@ -0,0 +1,261 @@
+/*
+ * TraceRing.cpp
+ *
+ *  A fixed size ring of timing events which can be written to from
+ *  any thread without taking a lock and dumped on demand.
+ */
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+#include "MOOS/libMOOS/Utils/MOOSUtilityFunctions.h"
+#include "MOOS/libMOOS/Utils/TraceRing.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+namespace MOOS
+{
+
+namespace
+{
+    /** claim the next slot - returns the value before the increment*/
+    unsigned int AtomicFetchAndIncrement(volatile unsigned int* pValue)
+    {
+#ifdef _WIN32
+        return static_cast<unsigned int>(
+                InterlockedIncrement(reinterpret_cast<volatile LONG*>(pValue)))-1;
+#else
+        return __sync_fetch_and_add(pValue, 1);
+#endif
+    }
+
+    void FullBarrier()
+    {
+#ifdef _WIN32
+        ::MemoryBarrier();
+#else
+        __sync_synchronize();
+#endif
+    }
+
+    const char* TrackName(int nTrack)
+    {
+        switch(nTrack)
+        {
+            case TraceRing::TRACK_APP: return "app";
+            case TraceRing::TRACK_COMMS_WRITER: return "comms writer";
+            case TraceRing::TRACK_COMMS_READER: return "comms reader";
+            default: return "other";
+        }
+    }
+
+    /** event names are literals but make sure they cannot break the JSON*/
+    std::string JSONSafe(const char* sName)
+    {
+        std::string s(sName ? sName : "");
+        for(unsigned int i = 0; i < s.size(); i++)
+        {
+            if(s[i]=='"' || s[i]=='\\' || (unsigned char)s[i] < 0x20)
+                s[i] = '_';
+        }
+        return s;
+    }
+
+    template<class T> void WriteLittleEndian(std::ofstream & out, T Value, int nBytes)
+    {
+        unsigned char Bytes[8];
+        for(int i = 0; i < nBytes; i++)
+            Bytes[i] = static_cast<unsigned char>((Value >> (8*i)) & 0xFF);
+        out.write(reinterpret_cast<char*>(Bytes), nBytes);
+    }
+
+    void WriteDouble(std::ofstream & out, double dfValue)
+    {
+        unsigned long long nBits;
+        memcpy(&nBits, &dfValue, 8);
+        WriteLittleEndian(out, nBits, 8);
+    }
+}
+
+TraceRing::TraceRing(unsigned int nCapacity)
+{
+    m_pEvents = NULL;
+    m_nHead = 0;
+    m_bEnabled = false;
+    m_nCapacity = 0;
+    SetCapacity(nCapacity);
+}
+
+TraceRing::~TraceRing()
+{
+    m_bEnabled = false;
+    delete [] m_pEvents;
+}
+
+void TraceRing::SetCapacity(unsigned int nCapacity)
+{
+    if(m_pEvents != NULL)
+        return;
+
+    //a power of two so the slot is found with a mask
+    m_nCapacity = 1;
+    while(m_nCapacity < nCapacity && m_nCapacity < (1u << 24))
+        m_nCapacity <<= 1;
+}
+
+void TraceRing::Enable(bool bEnable)
+{
+    if(bEnable && m_pEvents == NULL)
+    {
+        m_pEvents = new Event[m_nCapacity];
+        for(unsigned int i = 0; i < m_nCapacity; i++)
+            m_pEvents[i].nSeq = 0;
+        FullBarrier();
+    }
+    m_bEnabled = bEnable;
+}
+
+double TraceRing::Now()
+{
+    return MOOSLocalTime(false);
+}
+
+void TraceRing::Push(char cType, const char* sName, double dfStart,
+                     double dfDuration, int nValue, int nTrack)
+{
+    unsigned int nIndex = AtomicFetchAndIncrement(&m_nHead);
+    Event & E = m_pEvents[nIndex & (m_nCapacity-1)];
+
+    //mark the slot as being written so a reader skips it
+    E.nSeq = 0;
+    FullBarrier();
+
+    E.dfStart = dfStart;
+    E.dfDuration = dfDuration;
+    E.sName = sName;
+    E.nValue = nValue;
+    E.cType = cType;
+    E.nTrack = static_cast<unsigned char>(nTrack);
+
+    FullBarrier();
+    E.nSeq = nIndex+1;
+}
+
+std::vector<TraceRing::Event> TraceRing::Snapshot() const
+{
+    std::vector<Event> Events;
+    if(m_pEvents == NULL)
+        return Events;
+
+    unsigned int nHead = m_nHead;
+    unsigned int nFirst = nHead > m_nCapacity ? nHead-m_nCapacity : 0;
+    Events.reserve(nHead-nFirst);
+
+    for(unsigned int i = nFirst; i < nHead; i++)
+    {
+        const Event & E = m_pEvents[i & (m_nCapacity-1)];
+        if(E.nSeq != i+1)
+            continue;   //being written or already overwritten
+
+        Event Copy;
+        Copy.dfStart = E.dfStart;
+        Copy.dfDuration = E.dfDuration;
+        Copy.sName = E.sName;
+        Copy.nValue = E.nValue;
+        Copy.cType = E.cType;
+        Copy.nTrack = E.nTrack;
+        FullBarrier();
+
+        //check again in case a writer lapped us while copying
+        Copy.nSeq = E.nSeq;
+        if(Copy.nSeq == i+1)
+            Events.push_back(Copy);
+    }
+    return Events;
+}
+
+bool TraceRing::WriteChromeTrace(const std::string & sFile,
+                                 const std::string & sProcessName) const
+{
+    std::ofstream out(sFile.c_str());
+    if(!out.is_open())
+        return false;
+
+    std::vector<Event> Events = Snapshot();
+
+    //times are written in microseconds relative to the first event
+    double dfT0 = Events.empty() ? 0.0 : Events.front().dfStart;
+    for(unsigned int i = 0; i < Events.size(); i++)
+        dfT0 = std::min(dfT0, Events[i].dfStart);
+
+    out<<"{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    out<<"{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,"
+       <<"\"args\":{\"name\":\""<<JSONSafe(sProcessName.c_str())<<"\"}}";
+
+    for(int nTrack = TRACK_APP; nTrack <= TRACK_COMMS_READER; nTrack++)
+    {
+        out<<",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":"<<nTrack
+           <<",\"args\":{\"name\":\""<<TrackName(nTrack)<<"\"}}";
+    }
+
+    for(unsigned int i = 0; i < Events.size(); i++)
+    {
+        const Event & E = Events[i];
+        std::string sName = JSONSafe(E.sName);
+        double dfTS = (E.dfStart-dfT0)*1e6;
+        if(E.cType == 'X')
+        {
+            if(E.nValue >= 0)
+                out<<MOOSFormat(",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,"
+                                "\"ts\":%.1f,\"dur\":%.1f,\"args\":{\"n\":%d}}",
+                                sName.c_str(), E.nTrack, dfTS, E.dfDuration*1e6, E.nValue);
+            else
+                out<<MOOSFormat(",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,"
+                                "\"ts\":%.1f,\"dur\":%.1f}",
+                                sName.c_str(), E.nTrack, dfTS, E.dfDuration*1e6);
+        }
+        else
+        {
+            out<<MOOSFormat(",\n{\"name\":\"%s\",\"ph\":\"C\",\"pid\":1,\"tid\":%d,"
+                            "\"ts\":%.1f,\"args\":{\"%s\":%d}}",
+                            sName.c_str(), E.nTrack, dfTS, sName.c_str(), E.nValue);
+        }
+    }
+    out<<"\n]}\n";
+
+    return out.good();
+}
+
+bool TraceRing::WriteBinary(const std::string & sFile) const
+{
+    std::ofstream out(sFile.c_str(), std::ios::binary);
+    if(!out.is_open())
+        return false;
+
+    std::vector<Event> Events = Snapshot();
+
+    out.write("MOOSTRC1", 8);
+    WriteLittleEndian(out, static_cast<unsigned int>(Events.size()), 4);
+
+    for(unsigned int i = 0; i < Events.size(); i++)
+    {
+        const Event & E = Events[i];
+        WriteDouble(out, E.dfStart);
+        WriteDouble(out, E.dfDuration);
+        WriteLittleEndian(out, static_cast<unsigned int>(E.nValue), 4);
+        out.put(E.cType);
+        out.put(static_cast<char>(E.nTrack));
+
+        unsigned int nLen = E.sName ? static_cast<unsigned int>(strlen(E.sName)) : 0;
+        if(nLen > 0xFFFF)
+            nLen = 0xFFFF;
+        WriteLittleEndian(out, nLen, 2);
+        out.write(E.sName, nLen);
+    }
+
+    return out.good();
+}
+
+}
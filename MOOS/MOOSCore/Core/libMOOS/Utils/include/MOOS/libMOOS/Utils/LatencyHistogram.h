@@ -0,0 +1,78 @@
+/*
+ * LatencyHistogram.h
+ *
+ *  A fixed size histogram of delays with logarithmically spaced
+ *  buckets from which percentiles can be read.
+ */
+
+#ifndef LATENCYHISTOGRAM_H_
+#define LATENCYHISTOGRAM_H_
+
+#include <string>
+
+namespace MOOS
+{
+
+/**
+ * @brief Accumulates delays (in seconds) cheaply and without bound.
+ *
+ * Bucket k holds delays between 2^(k-1) and 2^k microseconds so the
+ * histogram spans a microsecond to over half an hour in a few hundred
+ * bytes. Counts, mean, min and max are exact; percentiles are read from
+ * the buckets and so are good to within a factor of two (the geometric
+ * middle of the bucket is reported).
+ *
+ * Not thread safe - callers must provide their own locking.
+ */
+class LatencyHistogram
+{
+public:
+    enum {NUM_BUCKETS = 32};
+
+    LatencyHistogram();
+
+    /** add a delay in seconds*/
+    void Add(double dfSeconds);
+
+    /** add all the samples held in another histogram*/
+    void Merge(const LatencyHistogram & Other);
+
+    /** forget everything*/
+    void Clear();
+
+    /** number of delays added*/
+    unsigned int GetCount() const {return m_nCount;}
+
+    /** mean delay in seconds (0 if empty)*/
+    double GetMean() const;
+
+    /** smallest delay in seconds (0 if empty)*/
+    double GetMin() const {return m_nCount ? m_dfMin : 0.0;}
+
+    /** largest delay in seconds (0 if empty)*/
+    double GetMax() const {return m_nCount ? m_dfMax : 0.0;}
+
+    /** delay below which dfFraction (0-1) of samples fall, in seconds*/
+    double GetPercentile(double dfFraction) const;
+
+    /** number of samples in bucket nBucket*/
+    unsigned int GetBucketCount(int nBucket) const;
+
+    /** upper edge of bucket nBucket in seconds*/
+    static double GetBucketUpperBound(int nBucket);
+
+    /** a summary of the form n=12,mean=0.81,p50=0.70,p90=1.4,p99=2.8,max=3.1
+     * with all delays in milliseconds*/
+    std::string GetSummary() const;
+
+private:
+    unsigned int m_nBuckets[NUM_BUCKETS];
+    unsigned int m_nCount;
+    double m_dfSum;
+    double m_dfMin;
+    double m_dfMax;
+};
+
+}
+
+#endif /* LATENCYHISTOGRAM_H_ */
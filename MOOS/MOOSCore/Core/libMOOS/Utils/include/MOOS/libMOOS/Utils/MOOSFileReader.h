@@ -39,6 +39,7 @@
 #include <fstream>
 #include <string>
 #include <map>
+#include <vector>
 
 #ifdef _WIN32
     typedef std::map<int,std::ifstream*> THREAD2FILE_MAP;
@@ -102,7 +103,8 @@ public:
     bool DoVariableExpansion(std::string & sVal);
     bool BuildLocalShellVars();
     bool MakeOverloadedCopy(const std::string & sCopyName,std::map<std::string, std::string> & OverLoads);
-	void EnableVerbatimQuoting(bool bEnable=true){m_bEnableVerbatimQuoting = bEnable;};
+	//quoting changes how lines are read so the cache must be rebuilt
+	void EnableVerbatimQuoting(bool bEnable=true);
 
 
 protected:
@@ -119,13 +121,38 @@ protected:
 	}
 	
 	
+    /** parse the whole file once (comments removed and variables
+        expanded) so that lookups need not re-read the file. Called
+        by SetFile() and lazily by lookups if the file was not
+        readable at that time. Derived classes may extend the model
+        but must call this base version first*/
+    virtual bool BuildCache();
+
+    /** build the cache unless it is already valid. Lookups may come
+        from any thread so the check and the build are both made
+        under m_pCacheLock*/
+    bool EnsureCache();
+
+    /** returns the n'th valid line of the cached file or an empty
+        string if beyond the end of the file*/
+    std::string GetCachedLine(size_t nLine) const;
+
     std::ifstream * GetFile();
     CMOOSLock *m_pLock;
+    /** guards building the cache. Separate from m_pLock as GetFile()
+        takes that while the cache is being built*/
+    CMOOSLock *m_pCacheLock;
     static bool    IsComment(std::string & sLine);
     std::string    m_sFileName;
     std::ifstream m_File;
 
     std::map<std::string,std::string> m_LocalShellVariables;
+
+    /** every line GetNextValidLine() yields reading from the start*/
+    std::vector<std::string> m_CachedLines;
+    /** first value of every "tok = val" line keyed by upper case tok*/
+    std::map<std::string,std::string> m_CachedValues;
+    bool m_bCacheValid;
     /** every thread get its own pointer to a stream*/
     THREAD2FILE_MAP m_FileMap;
 
@@ -144,6 +144,18 @@ bool SetMOOSTimeWarp(double dfWarp);
 /** return the current time warp factor */
 double GetMOOSTimeWarp();
 
+/** enable or disable a process wide virtual clock. While enabled MOOSTime()
+ returns the time last set by SetMOOSVirtualTime() and ignores both warp and
+ skew. On enabling the clock starts at the current MOOSTime(). This is
+ used by lockstep simulation where the MOOSDB owns the clock */
+void EnableMOOSVirtualTime(bool bEnable=true);
+
+/** return true if the virtual clock is in use*/
+bool IsMOOSVirtualTimeEnabled();
+
+/** set the time returned by MOOSTime() when the virtual clock is in use*/
+void SetMOOSVirtualTime(double dfTime);
+
 /**pause for nMS milliseconds */
 void MOOSPause(int nMS,bool bApplyTimeWarping = true);
 
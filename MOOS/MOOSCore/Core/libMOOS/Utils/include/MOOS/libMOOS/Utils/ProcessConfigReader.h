@@ -108,6 +108,30 @@ public:
 
     std::list<std::string> GetSearchedParameters(const std::string & sAppName);
 
+protected:
+    /** extends the cached file model with an index of the
+        ProcessConfig blocks and their parameters*/
+    virtual bool BuildCache();
+
+    /** find the cached line following "ProcessConfig = sAppName"*/
+    bool GetBlockStart(const std::string & sAppName, size_t & nLine);
+
+    /** read the block whose "{" is on cached line nLine - as
+        GetConfigurationAndPreserveSpace() but usable while the cache
+        is being built*/
+    bool GetBlockAndPreserveSpace(size_t nLine, STRING_LIST & Params);
+
+    /** key used to index a block - upper case with white space removed*/
+    static std::string GetBlockKey(const std::string & sAppName);
+
+    /** line after the first "ProcessConfig = X" for each block key*/
+    std::map<std::string, size_t> m_BlockStarts;
+
+    /** first value of each parameter of each well formed block, 
+        keyed by block key then upper case parameter name*/
+    std::map<std::string, std::map<std::string, std::string> > m_BlockParams;
+
+public:
 
 
     /** the name of process an instance this class will handle unless told otherwise */ 
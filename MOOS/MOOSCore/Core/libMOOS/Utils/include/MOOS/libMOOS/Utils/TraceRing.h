@@ -0,0 +1,130 @@
+/*
+ * TraceRing.h
+ *
+ *  A fixed size ring of timing events which can be written to from
+ *  any thread without taking a lock and dumped on demand.
+ */
+
+#ifndef TRACERING_H_
+#define TRACERING_H_
+
+#include <string>
+#include <vector>
+
+namespace MOOS
+{
+
+/**
+ * @brief Records where time goes inside a MOOS process.
+ *
+ * Events are spans (a named phase with a start time and a duration)
+ * or counters (a named value sampled at a time, such as a queue
+ * depth). They are written into a ring of fixed size so the most
+ * recent events are always available and memory use is bounded.
+ *
+ * Writers claim a slot with a single atomic increment so any number
+ * of threads can record at once without locking. When the ring is
+ * not enabled recording costs a single test of a flag and no memory
+ * is allocated.
+ *
+ * Event names must be string literals (or otherwise outlive the ring)
+ * as only the pointer is stored.
+ *
+ * The ring can be written out as a Chrome trace (JSON which may be
+ * loaded by chrome://tracing or Perfetto) or as a compact binary dump.
+ */
+class TraceRing
+{
+public:
+
+    /** the threads of a MOOS process events are attributed to*/
+    enum Track
+    {
+        TRACK_APP = 0,
+        TRACK_COMMS_WRITER = 1,
+        TRACK_COMMS_READER = 2
+    };
+
+    /** a single recorded event*/
+    struct Event
+    {
+        double dfStart;
+        double dfDuration;
+        const char* sName;
+        int nValue;
+        char cType;
+        unsigned char nTrack;
+        volatile unsigned int nSeq;
+    };
+
+    /** @param nCapacity number of events held - rounded up to a power of two*/
+    TraceRing(unsigned int nCapacity = 16384);
+    ~TraceRing();
+
+    /** start or stop recording. The ring is allocated on first use*/
+    void Enable(bool bEnable = true);
+
+    /** true if recording*/
+    bool IsEnabled() const {return m_bEnabled;}
+
+    /** set the number of events held - only effective before first Enable()*/
+    void SetCapacity(unsigned int nCapacity);
+
+    /** an unwarped, high resolution time in seconds to time spans with*/
+    static double Now();
+
+    /**
+     * record a phase which started at dfStart and finished at dfEnd
+     * @param sName name of the phase (must be a string literal)
+     * @param nValue optional value such as a mail count, <0 for none
+     * @param nTrack thread the phase ran on
+     */
+    void Span(const char* sName, double dfStart, double dfEnd,
+              int nValue = -1, int nTrack = TRACK_APP)
+    {
+        if(m_bEnabled)
+            Push('X', sName, dfStart, dfEnd-dfStart, nValue, nTrack);
+    }
+
+    /** record the value of a counter (say a queue depth) now*/
+    void Count(const char* sName, int nValue, int nTrack = TRACK_APP)
+    {
+        if(m_bEnabled)
+            Push('C', sName, Now(), 0.0, nValue, nTrack);
+    }
+
+    /** how many events have been recorded in total (including overwritten ones)*/
+    unsigned int GetNumRecorded() const {return m_nHead;}
+
+    /** copy out the events currently held, oldest first*/
+    std::vector<Event> Snapshot() const;
+
+    /** write held events as a Chrome trace
+     * @param sFile file to write
+     * @param sProcessName name the process is given in the trace*/
+    bool WriteChromeTrace(const std::string & sFile,
+                          const std::string & sProcessName) const;
+
+    /** write held events in binary. The format is "MOOSTRC1", a uint32
+     * event count then for each event: double start, double duration,
+     * int32 value, char type, uint8 track, uint16 name length, name.
+     * All little endian.*/
+    bool WriteBinary(const std::string & sFile) const;
+
+private:
+    void Push(char cType, const char* sName, double dfStart,
+              double dfDuration, int nValue, int nTrack);
+
+    /** not copyable*/
+    TraceRing(const TraceRing &);
+    TraceRing & operator=(const TraceRing &);
+
+    Event* m_pEvents;
+    unsigned int m_nCapacity;
+    volatile unsigned int m_nHead;
+    volatile bool m_bEnabled;
+};
+
+}
+
+#endif /* TRACERING_H_ */
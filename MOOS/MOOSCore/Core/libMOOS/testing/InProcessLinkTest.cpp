@@ -0,0 +1,229 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//   This file is part of the MOOS project
+//
+//   MOOS : Mission Oriented Operating Suite A suit of
+//   Applications and Libraries for Mobile Robotics Research
+//   Copyright (C) Paul Newman
+//
+//   This file was written by MOOS contributors
+//
+//   email: pnewman@robots.ox.ac.uk.
+//
+//   This source code and the accompanying materials
+//   are made available under the terms of the GNU Lesser Public License v2.1
+//   which accompanies this distribution, and is available at
+//   http://www.gnu.org/licenses/lgpl.txt distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+////////////////////////////////////////////////////////////////////////////
+
+
+
+
+
+
+/*
+ * InProcessLinkTest.cpp
+ *
+ *  Checks clients talking to a ThreadedCommServer in the same process:
+ *  they connect over an InProcessLink rather than a socket, mail makes
+ *  the round trip, a client stuck in its mail callback does not hold up
+ *  the server, a client which closes is seen to go and clients notice
+ *  when the server stops. Returns 0 if all is well.
+ */
+#include "MOOS/libMOOS/Comms/ThreadedCommServer.h"
+#include "MOOS/libMOOS/Comms/MOOSAsyncCommClient.h"
+#include "MOOS/libMOOS/Utils/MOOSUtilityFunctions.h"
+#include "MOOS/libMOOS/Utils/MOOSScopedLock.h"
+#include <iostream>
+#include <map>
+#include <set>
+
+int gFailures = 0;
+
+void Check(bool bOK, const std::string & sWhat)
+{
+    std::cout<<(bOK ? "[PASS] " : "[FAIL] ")<<sWhat<<"\n";
+    if(!bOK)
+        gFailures++;
+}
+
+/** a very small DB - every notification goes to every client in this process*/
+struct EchoServer
+{
+    CMOOSLock Lock;
+    std::set<std::string> Clients;
+    std::map<std::string,MOOSMSG_LIST> Held;
+    std::map<std::string,int> Received;
+
+    int ReceivedOf(const std::string & sKey)
+    {
+        MOOS::ScopedLock L(Lock);
+        return Received[sKey];
+    }
+
+    bool IsClient(const std::string & sName)
+    {
+        MOOS::ScopedLock L(Lock);
+        return Clients.find(sName)!=Clients.end();
+    }
+};
+
+bool OnRx(const std::string & sClient, MOOSMSG_LIST & Rx, MOOSMSG_LIST & Tx, void * pParam)
+{
+    EchoServer* pServer = static_cast<EchoServer*>(pParam);
+    MOOS::ScopedLock L(pServer->Lock);
+
+    MOOSMSG_LIST::iterator p;
+    for(p=Rx.begin();p!=Rx.end();p++)
+    {
+        if(p->GetType()!=MOOS_NOTIFY)
+            continue;
+        pServer->Received[p->GetKey()]++;
+        std::set<std::string>::iterator q;
+        for(q=pServer->Clients.begin();q!=pServer->Clients.end();q++)
+            pServer->Held[*q].push_back(*p);
+    }
+    return true;
+}
+
+bool OnFetchAllMail(const std::string & sClient, MOOSMSG_LIST & Tx, void * pParam)
+{
+    EchoServer* pServer = static_cast<EchoServer*>(pParam);
+    MOOS::ScopedLock L(pServer->Lock);
+    Tx.splice(Tx.end(),pServer->Held[sClient]);
+    return true;
+}
+
+bool OnConnect(std::string & sClient, void * pParam)
+{
+    EchoServer* pServer = static_cast<EchoServer*>(pParam);
+    MOOS::ScopedLock L(pServer->Lock);
+    pServer->Clients.insert(sClient);
+    return true;
+}
+
+bool OnDisconnect(std::string & sClient, void * pParam)
+{
+    EchoServer* pServer = static_cast<EchoServer*>(pParam);
+    MOOS::ScopedLock L(pServer->Lock);
+    pServer->Clients.erase(sClient);
+    pServer->Held.erase(sClient);
+    return true;
+}
+
+//the mail callback of client A can be made to sit and wait
+volatile bool gbHoldMailCallBack = false;
+volatile bool gbInMailCallBack = false;
+
+bool OnMail(void * pParam)
+{
+    gbInMailCallBack = true;
+    while(gbHoldMailCallBack)
+        MOOSPause(10,false);
+    gbInMailCallBack = false;
+    return true;
+}
+
+/** wait (up to a couple of seconds) for a condition to come true*/
+#define WAIT_FOR(condition) \
+    for(int nWait = 0; nWait<200 && !(condition); nWait++) MOOSPause(10,false)
+
+bool HasMail(MOOS::MOOSAsyncCommClient & Client, const std::string & sKey, MOOSMSG_LIST & Mail)
+{
+    MOOSMSG_LIST NewMail;
+    Client.Fetch(NewMail);
+    Mail.splice(Mail.end(),NewMail);
+
+    MOOSMSG_LIST::iterator p;
+    for(p=Mail.begin();p!=Mail.end();p++)
+        if(p->GetKey()==sKey)
+            return true;
+    return false;
+}
+
+int main(int argc, char * argv[])
+{
+    const int nPort = 9713;
+
+    EchoServer Echo;
+    //on the heap as the only way to stop a server is to destroy it
+    MOOS::ThreadedCommServer* pServer = new MOOS::ThreadedCommServer;
+    pServer->SetQuiet(true);
+    pServer->SetOnRxCallBack(OnRx,&Echo);
+    pServer->SetOnFetchAllMailCallBack(OnFetchAllMail,&Echo);
+    pServer->SetOnConnectCallBack(OnConnect,&Echo);
+    pServer->SetOnDisconnectCallBack(OnDisconnect,&Echo);
+    if(!pServer->Run(nPort,"test",true,nPort+1))
+    {
+        std::cout<<"failed to start the server\n";
+        return 1;
+    }
+
+    Check(MOOS::InProcessLink::HasServer("localhost",nPort),"server is reachable from within the process");
+    Check(!MOOS::InProcessLink::HasServer("localhost",nPort+2),"but only on its own port");
+
+    MOOS::MOOSAsyncCommClient A,B;
+    A.SetQuiet(true);
+    B.SetQuiet(true);
+    A.SetOnMailCallBack(OnMail,NULL);
+    A.Run("localhost",nPort,"A");
+    B.Run("localhost",nPort,"B");
+
+    WAIT_FOR(A.IsConnected() && B.IsConnected() && Echo.IsClient("A") && Echo.IsClient("B"));
+    Check(A.IsConnected() && B.IsConnected(),"clients connect");
+    Check(A.IsInProcess() && B.IsInProcess(),"clients connect in-process");
+    Check(Echo.IsClient("A") && Echo.IsClient("B"),"server accepts both clients");
+
+    //a client of the same name is turned away
+    MOOS::MOOSAsyncCommClient Imposter;
+    Imposter.SetQuiet(true);
+    Imposter.Run("localhost",nPort,"A");
+    MOOSPause(300,false);
+    Check(!Imposter.IsConnected(),"a second client with the same name is refused");
+    Imposter.Close();
+
+    //mail goes there and back
+    MOOSMSG_LIST MailA,MailB;
+    A.Notify("X",1.0);
+    WAIT_FOR(HasMail(B,"X",MailB));
+    Check(Echo.ReceivedOf("X")==1,"server receives mail from a client");
+    Check(HasMail(B,"X",MailB),"mail reaches another client");
+    WAIT_FOR(HasMail(A,"X",MailA));
+    Check(HasMail(A,"X",MailA),"mail comes back to its sender");
+
+    //the server carries on while a client is busy in its mail callback
+    gbHoldMailCallBack = true;
+    B.Notify("Y",2.0);
+    WAIT_FOR(gbInMailCallBack);
+    Check(gbInMailCallBack,"mail callback runs when mail arrives");
+    B.Notify("Z",3.0);
+    WAIT_FOR(Echo.ReceivedOf("Z")==1 && HasMail(B,"Z",MailB));
+    Check(Echo.ReceivedOf("Z")==1,"server keeps reading while a client's mail callback is busy");
+    Check(HasMail(B,"Z",MailB),"other clients keep getting mail while a client's mail callback is busy");
+    gbHoldMailCallBack = false;
+    WAIT_FOR(!gbInMailCallBack && HasMail(A,"Z",MailA));
+    Check(HasMail(A,"Y",MailA) && HasMail(A,"Z",MailA),"busy client gets its mail once its callback returns");
+
+    //a client which closes is seen to go
+    A.Close();
+    WAIT_FOR(!Echo.IsClient("A"));
+    Check(!A.IsConnected(),"closed client is not connected");
+    Check(!Echo.IsClient("A"),"server sees a closed client go");
+    B.Notify("W",4.0);
+    WAIT_FOR(HasMail(B,"W",MailB));
+    Check(HasMail(B,"W",MailB),"remaining client is unaffected");
+
+    //and when the server stops its clients notice
+    delete pServer;
+    Check(!MOOS::InProcessLink::HasServer("localhost",nPort),"stopped server is no longer reachable");
+    B.Notify("V",5.0);
+    WAIT_FOR(!B.IsConnected());
+    Check(!B.IsConnected(),"client sees the server stop");
+    B.Close();
+
+    std::cout<<(gFailures ? "in-process link test FAILED\n" : "in-process link test passed\n");
+    return gFailures ? 1 : 0;
+}
@@ -0,0 +1,320 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//   This file is part of the MOOS project
+//
+//   MOOS : Mission Oriented Operating Suite A suit of 
+//   Applications and Libraries for Mobile Robotics Research 
+//   Copyright (C) Paul Newman
+//    
+//   This file was written by MOOS contributors 
+//   
+//   email: pnewman@robots.ox.ac.uk. 
+//              
+//   This source code and the accompanying materials
+//   are made available under the terms of the GNU Lesser Public License v2.1
+//   which accompanies this distribution, and is available at
+//   http://www.gnu.org/licenses/lgpl.txt distributed in the hope that it will be useful, 
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of 
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. 
+//
+////////////////////////////////////////////////////////////////////////////
+
+
+
+
+
+/*
+ * LatencyTraceTest.cpp
+ *
+ *  Checks the latency tracing support without any sockets: the
+ *  optional block of trace stamps a CMOOSMsg carries after its payload
+ *  (round trip with and without stamps, alone and packed with others,
+ *  and that a reader which predates the stamps skips them using the
+ *  length the message declares) and the bucketing and percentiles of
+ *  MOOS::LatencyHistogram. Returns 0 if all is well.
+ */
+#include "MOOS/libMOOS/Comms/MOOSMsg.h"
+#include "MOOS/libMOOS/Comms/MOOSCommPkt.h"
+#include "MOOS/libMOOS/Utils/LatencyHistogram.h"
+#include <iostream>
+#include <vector>
+#include <cstring>
+#include <cmath>
+
+int gFailures = 0;
+
+void Check(bool bOK, const std::string & sWhat)
+{
+    std::cout<<(bOK ? "[PASS] " : "[FAIL] ")<<sWhat<<"\n";
+    if(!bOK)
+        gFailures++;
+}
+
+bool Near(double dfA, double dfB)
+{
+    return fabs(dfA-dfB)<=1e-12*(1.0+fabs(dfA));
+}
+
+/** serialise M into a buffer of exactly the size it claims to need*/
+std::vector<unsigned char> Write(CMOOSMsg & M)
+{
+    std::vector<unsigned char> Buffer(M.GetSizeInBytesWhenSerialised());
+    int nWritten = M.Serialize(&Buffer[0],Buffer.size(),true);
+    if(nWritten!=(int)Buffer.size())
+        Buffer.resize(nWritten<0 ? 0 : nWritten);
+    return Buffer;
+}
+
+/** the same fields and stamps?*/
+bool SameMsg(const CMOOSMsg & A, const CMOOSMsg & B)
+{
+    if(A.GetKey()!=B.GetKey() || A.GetType()!=B.GetType() ||
+       A.m_cDataType!=B.m_cDataType || A.GetSource()!=B.GetSource() ||
+       A.GetString()!=B.GetString() || A.GetDouble()!=B.GetDouble() ||
+       A.GetTime()!=B.GetTime() || A.IsTraced()!=B.IsTraced())
+        return false;
+
+    for(int i = 0;i<CMOOSMsg::TRACE_NUM_STAMPS;i++)
+    {
+        CMOOSMsg::TraceStamp eStamp = static_cast<CMOOSMsg::TraceStamp>(i);
+        double dfA,dfB;
+        bool bA = A.GetTraceStamp(eStamp,dfA);
+        bool bB = B.GetTraceStamp(eStamp,dfB);
+        if(bA!=bB || (bA && dfA!=dfB))
+            return false;
+    }
+    return true;
+}
+
+/** a reader of the message layout as it was before trace stamps:
+ the fields up to the string payload, then a jump to the declared
+ length. Little endian hosts only, as the test compares raw bytes*/
+class OldReader
+{
+public:
+    OldReader(const unsigned char * pBuffer):m_pStart(pBuffer),m_pNext(pBuffer){}
+
+    int Read(CMOOSMsg & M)
+    {
+        int nLength = Int();
+        M.m_nID = Int();
+        M.m_cMsgType = Char();
+        M.m_cDataType = Char();
+        M.m_sSrc = String();
+#ifndef DISABLE_AUX_SOURCE
+        M.m_sSrcAux = String();
+#endif
+        M.m_sOriginatingCommunity = String();
+        M.m_sKey = String();
+        M.m_dfTime = Double();
+        M.m_dfVal = Double();
+        M.m_dfVal2 = Double();
+        M.m_sVal = String();
+        m_nRead = m_pNext-m_pStart;
+        return nLength;
+    }
+
+    /** bytes read by the old layout*/
+    int GetRead() const {return m_nRead;}
+
+private:
+    int Int(){int n; memcpy(&n,m_pNext,sizeof(n)); m_pNext+=sizeof(n); return n;}
+    char Char(){return static_cast<char>(*m_pNext++);}
+    double Double(){double d; memcpy(&d,m_pNext,sizeof(d)); m_pNext+=sizeof(d); return d;}
+    std::string String()
+    {
+        int n = Int();
+        std::string s(reinterpret_cast<const char*>(m_pNext),n);
+        m_pNext+=n;
+        return s;
+    }
+
+    const unsigned char * m_pStart;
+    const unsigned char * m_pNext;
+    int m_nRead;
+};
+
+CMOOSMsg MakeMsg(const std::string & sKey, bool bTraced)
+{
+    CMOOSMsg M(MOOS_NOTIFY,sKey,"payload of "+sKey,1234.5);
+    M.m_sSrc = "publisher";
+    M.m_nID = 7;
+    if(bTraced)
+    {
+        M.SetTraceStamp(CMOOSMsg::TRACE_CLIENT_SEND,100.25);
+        M.SetTraceStamp(CMOOSMsg::TRACE_DB_RECEIVE,100.5);
+        M.SetTraceStamp(CMOOSMsg::TRACE_DB_ENQUEUE,100.75);
+    }
+    return M;
+}
+
+void TestRoundTrip()
+{
+    CMOOSMsg Plain = MakeMsg("PLAIN",false);
+    CMOOSMsg Traced = MakeMsg("TRACED",true);
+
+    std::vector<unsigned char> PlainBytes = Write(Plain);
+    std::vector<unsigned char> TracedBytes = Write(Traced);
+
+    //a marker, a mask and three stamps
+    CMOOSMsg Unstamped = Traced;
+    Unstamped.ClearTraceStamps();
+    std::vector<unsigned char> UnstampedBytes = Write(Unstamped);
+    Check(TracedBytes.size()==UnstampedBytes.size()+2+3*sizeof(double),
+          "stamps add a marker, a mask and one double per stamp");
+
+    CMOOSMsg PlainIn;
+    int nRead = PlainIn.Serialize(&PlainBytes[0],PlainBytes.size(),false);
+    Check(nRead==(int)PlainBytes.size() && SameMsg(Plain,PlainIn),
+          "untraced message round trips without stamps");
+
+    CMOOSMsg TracedIn;
+    nRead = TracedIn.Serialize(&TracedBytes[0],TracedBytes.size(),false);
+    Check(nRead==(int)TracedBytes.size() && SameMsg(Traced,TracedIn),
+          "traced message round trips with its stamps");
+
+    double dfT;
+    Check(!TracedIn.GetTraceStamp(CMOOSMsg::TRACE_CLIENT_DISPATCH,dfT),
+          "a stamp never set is not reported");
+
+    //a stamp added at the far end is carried on again
+    TracedIn.SetTraceStamp(CMOOSMsg::TRACE_CLIENT_DISPATCH,101.0);
+    std::vector<unsigned char> Again = Write(TracedIn);
+    CMOOSMsg AgainIn;
+    AgainIn.Serialize(&Again[0],Again.size(),false);
+    Check(SameMsg(TracedIn,AgainIn) &&
+          AgainIn.GetTraceStamp(CMOOSMsg::TRACE_CLIENT_DISPATCH,dfT) &&
+          dfT==101.0,
+          "all four stamps round trip");
+
+    //a message read over a traced one loses the old stamps
+    nRead = TracedIn.Serialize(&PlainBytes[0],PlainBytes.size(),false);
+    Check(!TracedIn.IsTraced(),"reading an untraced message clears stamps");
+}
+
+void TestPacket()
+{
+    MOOSMSG_LIST Out;
+    Out.push_back(MakeMsg("A",true));
+    Out.push_back(MakeMsg("B",false));
+    Out.push_back(MakeMsg("C",true));
+
+    CMOOSCommPkt OutPkt;
+    Check(OutPkt.Serialize(Out,true),"packet of mixed messages packs");
+
+    CMOOSCommPkt InPkt;
+    InPkt.Fill(OutPkt.Stream(),OutPkt.GetStreamLength());
+    MOOSMSG_LIST In;
+    Check(InPkt.Serialize(In,false),"packet of mixed messages unpacks");
+
+    bool bSame = In.size()==Out.size();
+    MOOSMSG_LIST::iterator p,q;
+    for(p=Out.begin(),q=In.begin();bSame && p!=Out.end();p++,q++)
+        bSame = SameMsg(*p,*q);
+    Check(bSame,"traced and untraced messages survive a packet in order");
+}
+
+void TestOldReader()
+{
+    CMOOSMsg Traced = MakeMsg("TRACED",true);
+    CMOOSMsg Plain = MakeMsg("PLAIN",false);
+    std::vector<unsigned char> Bytes = Write(Traced);
+    std::vector<unsigned char> PlainBytes = Write(Plain);
+    Bytes.insert(Bytes.end(),PlainBytes.begin(),PlainBytes.end());
+
+    //the old reader stops short of the stamps and jumps by the length
+    OldReader Reader(&Bytes[0]);
+    CMOOSMsg First;
+    int nLength = Reader.Read(First);
+    Check(Reader.GetRead()<nLength,"old layout ends before the stamps");
+    Check(First.GetKey()=="TRACED" && First.GetString()==Traced.GetString() &&
+          First.GetTime()==Traced.GetTime() && !First.IsTraced(),
+          "old reader gets the payload of a traced message");
+
+    OldReader Next(&Bytes[nLength]);
+    CMOOSMsg Second;
+    int nSecond = Next.Read(Second);
+    Check(nSecond==(int)PlainBytes.size() && Next.GetRead()==nSecond &&
+          SameMsg(Plain,Second),
+          "old reader skips the stamps to the next message");
+
+    //and trailing data we do not know (from a newer writer) is skipped
+    //by this reader in the same way
+    std::vector<unsigned char> Newer = Write(Traced);
+    size_t nMarker = Newer.size()-(2+3*sizeof(double));
+    Check(Newer[nMarker]==MOOS_TRACE_MARKER,"marker precedes the stamps");
+    Newer[nMarker] = 'Z';
+    CMOOSMsg NewerIn;
+    int nRead = NewerIn.Serialize(&Newer[0],Newer.size(),false);
+    Check(nRead==(int)Newer.size() && !NewerIn.IsTraced() &&
+          NewerIn.GetString()==Traced.GetString(),
+          "unknown trailing block is skipped");
+}
+
+void TestHistogram()
+{
+    MOOS::LatencyHistogram H;
+    Check(H.GetCount()==0 && H.GetPercentile(0.5)==0.0 && H.GetMean()==0.0,
+          "empty histogram reports zeros");
+
+    //bucket k holds [2^(k-1),2^k) microseconds, bucket 0 below 1us
+    H.Add(0.5e-6);
+    H.Add(-1e-6);
+    H.Add(1e-6);
+    H.Add(1.9e-6);
+    H.Add(2e-6);
+    H.Add(1000e-6);
+    H.Add(1e6);
+    Check(H.GetBucketCount(0)==2,"sub-microsecond and negative delays in bucket 0");
+    Check(H.GetBucketCount(1)==2,"1us up to 2us in bucket 1");
+    Check(H.GetBucketCount(2)==1,"2us starts bucket 2");
+    Check(H.GetBucketCount(10)==1,"1ms in bucket 10 (512-1024us)");
+    Check(H.GetBucketCount(MOOS::LatencyHistogram::NUM_BUCKETS-1)==1,
+          "huge delays in the last bucket");
+    Check(H.GetBucketCount(-1)==0 && H.GetBucketCount(99)==0,
+          "out of range buckets are empty");
+    Check(Near(MOOS::LatencyHistogram::GetBucketUpperBound(10),1024e-6),
+          "bucket 10 ends at 1024us");
+    Check(H.GetCount()==7 && Near(H.GetMin(),-1e-6) && Near(H.GetMax(),1e6),
+          "count, min and max are exact");
+
+    //percentiles are the geometric middle of the bucket they fall in
+    MOOS::LatencyHistogram P;
+    for(int i = 0;i<45;i++)
+    {
+        P.Add(70e-6);   //bucket 7: 64-128us
+        P.Add(120e-6);
+    }
+    for(int i = 0;i<10;i++)
+        P.Add(5e-3);    //bucket 13: 4096-8192us
+    Check(Near(P.GetMean(),(45*70e-6+45*120e-6+10*5e-3)/100),"mean is exact");
+    Check(Near(P.GetPercentile(0.5),128e-6/sqrt(2.0)),"p50 from its bucket");
+    Check(Near(P.GetPercentile(0.9),128e-6/sqrt(2.0)),"p90 at a bucket edge");
+    Check(Near(P.GetPercentile(0.99),5e-3),"p99 clamped to the max seen");
+    Check(P.GetPercentile(0.99)<=P.GetMax() && P.GetPercentile(0.0)>=P.GetMin(),
+          "percentiles stay within min and max");
+
+    //merging is the same as adding everything to one
+    MOOS::LatencyHistogram M;
+    M.Merge(H);
+    M.Merge(P);
+    bool bSame = M.GetCount()==H.GetCount()+P.GetCount();
+    for(int i = 0;i<MOOS::LatencyHistogram::NUM_BUCKETS;i++)
+        bSame = bSame && M.GetBucketCount(i)==H.GetBucketCount(i)+P.GetBucketCount(i);
+    Check(bSame && Near(M.GetMin(),H.GetMin()) && Near(M.GetMax(),H.GetMax()),
+          "merge adds buckets and keeps min and max");
+
+    M.Clear();
+    Check(M.GetCount()==0 && M.GetBucketCount(7)==0,"clear empties");
+}
+
+int main(int argc, char * argv[])
+{
+    TestRoundTrip();
+    TestPacket();
+    TestOldReader();
+    TestHistogram();
+
+    std::cout<<(gFailures ? "FAILED" : "all passed")<<"\n";
+    return gFailures ? 1 : 0;
+}
@@ -0,0 +1,201 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//   This file is part of the MOOS project
+//
+//   MOOS : Mission Oriented Operating Suite A suit of 
+//   Applications and Libraries for Mobile Robotics Research 
+//   Copyright (C) Paul Newman
+//    
+//   This file was written by MOOS contributors 
+//   
+//   email: pnewman@robots.ox.ac.uk. 
+//              
+//   This source code and the accompanying materials
+//   are made available under the terms of the GNU Lesser Public License v2.1
+//   which accompanies this distribution, and is available at
+//   http://www.gnu.org/licenses/lgpl.txt distributed in the hope that it will be useful, 
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of 
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. 
+//
+////////////////////////////////////////////////////////////////////////////
+
+
+
+
+
+/*
+ * LockStepTest.cpp
+ *
+ *  Checks the MOOSDB side of lockstep (virtual time) mode without any
+ *  sockets: packets from two clients are handed straight to OnRxPkt.
+ *  Covers the start barrier, the ordering of mail posted within a tick,
+ *  dropping a client which does not acknowledge in time and its return.
+ *  Returns 0 if all is well.
+ */
+#include "MOOS/libMOOS/DB/MOOSDB.h"
+#include "MOOS/libMOOS/Utils/MOOSUtilityFunctions.h"
+#include <iostream>
+#include <cmath>
+
+int gFailures = 0;
+
+void Check(bool bOK, const std::string & sWhat)
+{
+    std::cout<<(bOK ? "[PASS] " : "[FAIL] ")<<sWhat<<"\n";
+    if(!bOK)
+        gFailures++;
+}
+
+/** hand a packet from sClient to the DB and return what it sends back*/
+MOOSMSG_LIST Send(CMOOSDB & DB, const std::string & sClient, MOOSMSG_LIST Rx)
+{
+    //an empty packet is never answered so always say something
+    if(Rx.empty())
+        Rx.push_back(CMOOSMsg(MOOS_NULL_MSG,"",0.0));
+
+    MOOSMSG_LIST::iterator p;
+    for(p=Rx.begin();p!=Rx.end();p++)
+        p->m_sSrc = sClient;
+
+    MOOSMSG_LIST Tx;
+    DB.OnRxPkt(sClient,Rx,Tx);
+    return Tx;
+}
+
+MOOSMSG_LIST Send(CMOOSDB & DB, const std::string & sClient)
+{
+    return Send(DB,sClient,MOOSMSG_LIST());
+}
+
+MOOSMSG_LIST Send(CMOOSDB & DB, const std::string & sClient, const CMOOSMsg & Msg)
+{
+    MOOSMSG_LIST Rx;
+    Rx.push_back(Msg);
+    return Send(DB,sClient,Rx);
+}
+
+CMOOSMsg Notify(const std::string & sKey, double dfVal, int nID)
+{
+    CMOOSMsg Msg(MOOS_NOTIFY,sKey,dfVal);
+    Msg.m_nID = nID;
+    return Msg;
+}
+
+CMOOSMsg Ack(double dfTick)
+{
+    return Notify(MOOS_LOCKSTEP_ACK,dfTick,0);
+}
+
+/** the time of the last tick in the mail or -1*/
+double TickIn(const MOOSMSG_LIST & Mail)
+{
+    double dfTick = -1;
+    MOOSMSG_LIST::const_iterator p;
+    for(p=Mail.begin();p!=Mail.end();p++)
+        if(p->GetKey()==MOOS_LOCKSTEP_TICK)
+            dfTick = p->GetDouble();
+    return dfTick;
+}
+
+/** the values of X in the mail, in the order delivered*/
+std::string XValuesIn(const MOOSMSG_LIST & Mail)
+{
+    std::string s;
+    MOOSMSG_LIST::const_iterator p;
+    for(p=Mail.begin();p!=Mail.end();p++)
+        if(p->GetKey()=="X")
+            s += MOOSFormat("%.0f",p->GetDouble());
+    return s;
+}
+
+bool SameTime(double dfA, double dfB)
+{
+    return fabs(dfA-dfB)<1e-6;
+}
+
+int main(int argc, char * argv[])
+{
+    CMOOSDB DB;
+    DB.SetQuiet(true);
+    DB.SetLockStep(0.1,2,0.5);
+
+    Check(IsMOOSVirtualTimeEnabled(),"lockstep puts the process on a virtual clock");
+    double dfT0 = MOOSTime();
+
+    //both clients subscribe to ticks and to X and then join
+    const char * Clients[] = {"A","B"};
+    MOOSMSG_LIST Joined;
+    for(int i=0;i<2;i++)
+    {
+        MOOSMSG_LIST Rx;
+        Rx.push_back(CMOOSMsg(MOOS_REGISTER,MOOS_LOCKSTEP_TICK,0.0));
+        Rx.push_back(CMOOSMsg(MOOS_REGISTER,"X",0.0));
+        Rx.push_back(CMOOSMsg(MOOS_NOTIFY,MOOS_LOCKSTEP_JOIN,Clients[i]));
+        Joined = Send(DB,Clients[i],Rx);
+        if(i==0)
+            Check(TickIn(Send(DB,"A"))<0,"no tick until all the expected clients have joined");
+    }
+    Check(SameTime(TickIn(Joined),dfT0),"first tick once both have joined");
+    Check(SameTime(TickIn(Send(DB,"A")),dfT0),"every client gets the tick");
+
+    //mail posted within a tick is held and then delivered by sender and id,
+    //whatever order it arrived in
+    Send(DB,"B",Notify("X",1,5));
+    MOOSMSG_LIST Rx;
+    Rx.push_back(Notify("X",2,7));
+    Rx.push_back(Notify("X",3,3));
+    Send(DB,"A",Rx);
+    Check(XValuesIn(Send(DB,"B")).empty(),"mail is held until the tick is over");
+
+    Send(DB,"A",Ack(dfT0));
+    Check(SameTime(MOOSTime(),dfT0),"clock waits for every acknowledgement");
+
+    MOOSMSG_LIST Mail = Send(DB,"B",Ack(dfT0));
+    double dfT1 = dfT0+0.1;
+    Check(SameTime(MOOSTime(),dfT1),"clock moves on one period when all have acknowledged");
+    Check(XValuesIn(Mail)=="321","mail delivered ordered by sender then message id");
+    Check(SameTime(TickIn(Mail),dfT1),"next tick follows the mail of the last");
+    Check(Mail.back().IsName(MOOS_LOCKSTEP_TICK),"tick comes after the mail");
+    Check(XValuesIn(Send(DB,"A"))=="321","same order for every subscriber");
+
+    //a client which never joined is not stepped so its mail is not held
+    Send(DB,"C",Notify("X",9,1));
+    Check(XValuesIn(Send(DB,"A"))=="9","mail from a client outside lockstep goes straight through");
+
+    //B goes quiet - A acknowledges and keeps calling in
+    Send(DB,"A",Ack(dfT1));
+    Check(SameTime(MOOSTime(),dfT1),"clock waits for a slow client");
+    MOOSPause(700,false);
+    Mail = Send(DB,"A");
+    double dfT2 = dfT1+0.1;
+    Check(SameTime(MOOSTime(),dfT2),"client overdue acknowledging is dropped and the clock moves on");
+    Check(SameTime(TickIn(Mail),dfT2),"remaining client gets the next tick");
+
+    //B comes back with its stale acknowledgement and is stepped again
+    //from the next tick
+    Send(DB,"B",Ack(dfT1));
+    Check(SameTime(MOOSTime(),dfT2),"a returning client does not move the clock itself");
+    Send(DB,"A",Ack(dfT2));
+    double dfT3 = dfT2+0.1;
+    Check(SameTime(MOOSTime(),dfT3),"a returning client is not waited on for the current tick");
+    Send(DB,"A",Ack(dfT3));
+    Check(SameTime(MOOSTime(),dfT3),"clock waits for the returned client at the next tick");
+    Send(DB,"B",Ack(dfT3));
+    Check(SameTime(MOOSTime(),dfT3+0.1),"returned client takes part in the barrier");
+
+    //a client which leaves is not waited for
+    std::string sB("B");
+    DB.OnDisconnect(sB);
+    Send(DB,"A",Ack(dfT3+0.1));
+    Check(SameTime(MOOSTime(),dfT3+0.2),"disconnected client is not waited for");
+
+    //the virtual clock itself
+    SetMOOSVirtualTime(1234.5);
+    Check(MOOSTime()==1234.5,"MOOSTime() returns the virtual time set");
+    EnableMOOSVirtualTime(false);
+    Check(!IsMOOSVirtualTimeEnabled(),"virtual time can be switched off");
+    Check(fabs(MOOSTime()-MOOSLocalTime())<1.0,"disabling returns to the local clock");
+
+    std::cout<<(gFailures ? "lockstep test FAILED\n" : "lockstep test passed\n");
+    return gFailures ? 1 : 0;
+}
@@ -0,0 +1,285 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//   This file is part of the MOOS project
+//
+//   MOOS : Mission Oriented Operating Suite A suit of 
+//   Applications and Libraries for Mobile Robotics Research 
+//   Copyright (C) Paul Newman
+//    
+//   This file was written by MOOS contributors 
+//   
+//   email: pnewman@robots.ox.ac.uk. 
+//              
+//   This source code and the accompanying materials
+//   are made available under the terms of the GNU Lesser Public License v2.1
+//   which accompanies this distribution, and is available at
+//   http://www.gnu.org/licenses/lgpl.txt distributed in the hope that it will be useful, 
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of 
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. 
+//
+////////////////////////////////////////////////////////////////////////////
+
+
+
+
+
+
+/*
+ * TraceRingTest.cpp
+ *
+ *  Checks MOOS::TraceRing without an app or a MOOSDB: nothing is
+ *  recorded while disabled, the ring keeps the newest events oldest
+ *  first once it wraps, writers on several threads lose nothing, and
+ *  the Chrome trace JSON and binary dumps hold what was recorded.
+ *  Returns 0 if all is well.
+ */
+#include "MOOS/libMOOS/Utils/TraceRing.h"
+#include "MOOS/libMOOS/Utils/MOOSThread.h"
+#include "MOOS/libMOOS/Utils/MOOSUtilityFunctions.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <cstring>
+#include <cstdio>
+
+int gFailures = 0;
+
+void Check(bool bOK, const std::string & sWhat)
+{
+    std::cout<<(bOK ? "[PASS] " : "[FAIL] ")<<sWhat<<"\n";
+    if(!bOK)
+        gFailures++;
+}
+
+std::string ReadFile(const std::string & sFile)
+{
+    std::ifstream in(sFile.c_str(), std::ios::binary);
+    std::stringstream ss;
+    ss<<in.rdbuf();
+    return ss.str();
+}
+
+unsigned int CountOf(const std::string & sText, const std::string & sWhat)
+{
+    unsigned int n = 0;
+    for(size_t p = sText.find(sWhat); p!=std::string::npos; p = sText.find(sWhat,p+1))
+        n++;
+    return n;
+}
+
+/** brackets and braces balance outside of strings and no string is left open*/
+bool Balanced(const std::string & sText)
+{
+    std::vector<char> Stack;
+    bool bInString = false;
+    for(size_t i = 0;i<sText.size();i++)
+    {
+        char c = sText[i];
+        if(bInString)
+        {
+            if(c=='\\')
+                i++;
+            else if(c=='"')
+                bInString = false;
+            continue;
+        }
+        if(c=='"')
+            bInString = true;
+        else if(c=='{' || c=='[')
+            Stack.push_back(c);
+        else if(c=='}' || c==']')
+        {
+            if(Stack.empty() || Stack.back()!=(c=='}' ? '{' : '['))
+                return false;
+            Stack.pop_back();
+        }
+    }
+    return Stack.empty() && !bInString;
+}
+
+void TestDisabled()
+{
+    MOOS::TraceRing Ring(64);
+    Ring.Span("Iterate",1.0,2.0);
+    Ring.Count("InBox",3);
+    Check(!Ring.IsEnabled(),"a new ring is disabled");
+    Check(Ring.GetNumRecorded()==0,"nothing is recorded while disabled");
+    Check(Ring.Snapshot().empty(),"a ring never enabled snapshots empty");
+
+    Ring.Enable();
+    Ring.Span("Iterate",1.0,2.0);
+    Ring.Enable(false);
+    Ring.Span("Iterate",2.0,3.0);
+    Check(Ring.GetNumRecorded()==1,"recording stops when disabled again");
+    Check(Ring.Snapshot().size()==1,"events held over a disable are kept");
+}
+
+void TestWrap()
+{
+    //100 is rounded up to 128
+    MOOS::TraceRing Ring(100);
+    Ring.Enable();
+    Ring.SetCapacity(1000);
+
+    for(int i = 0;i<200;i++)
+        Ring.Span("Iterate",i,i+0.5,i);
+
+    std::vector<MOOS::TraceRing::Event> Events = Ring.Snapshot();
+    Check(Ring.GetNumRecorded()==200,"every event is counted");
+    Check(Events.size()==128,"capacity rounds up to a power of two and ignores late changes");
+
+    bool bInOrder = !Events.empty();
+    for(unsigned int i = 0;i<Events.size();i++)
+        bInOrder = bInOrder && Events[i].nValue==(int)(72+i);
+    Check(bInOrder,"a wrapped ring holds the newest events oldest first");
+
+    const MOOS::TraceRing::Event & E = Events.back();
+    Check(E.cType=='X' && E.dfStart==199.0 && E.dfDuration==0.5 &&
+          !strcmp(E.sName,"Iterate") && E.nTrack==MOOS::TraceRing::TRACK_APP,
+          "a span keeps its name, start, duration and track");
+
+    Ring.Count("OutBox",7,MOOS::TraceRing::TRACK_COMMS_WRITER);
+    const MOOS::TraceRing::Event & C = Ring.Snapshot().back();
+    Check(C.cType=='C' && C.nValue==7 && C.dfDuration==0.0 &&
+          C.nTrack==MOOS::TraceRing::TRACK_COMMS_WRITER,
+          "a counter keeps its value and track");
+}
+
+const int kThreads = 4;
+const int kPerThread = 20000;
+
+struct Writer
+{
+    MOOS::TraceRing* pRing;
+    int nTrack;
+};
+
+bool WriterLoop(void * pParam)
+{
+    Writer* pW = static_cast<Writer*> (pParam);
+    for(int i = 0;i<kPerThread;i++)
+        pW->pRing->Span("Work",0.0,1.0,i,pW->nTrack);
+    return true;
+}
+
+void TestThreads()
+{
+    MOOS::TraceRing Ring(kThreads*kPerThread);
+    Ring.Enable();
+
+    Writer Writers[kThreads];
+    CMOOSThread Threads[kThreads];
+    for(int i = 0;i<kThreads;i++)
+    {
+        Writers[i].pRing = &Ring;
+        Writers[i].nTrack = i;
+        Threads[i].Initialise(WriterLoop,&Writers[i]);
+    }
+    for(int i = 0;i<kThreads;i++)
+        Threads[i].Start();
+    for(int i = 0;i<kThreads;i++)
+        Threads[i].Stop();
+
+    std::vector<MOOS::TraceRing::Event> Events = Ring.Snapshot();
+    Check(Ring.GetNumRecorded()==(unsigned int)(kThreads*kPerThread),
+          "concurrent writers claim a slot each");
+    Check(Events.size()==(unsigned int)(kThreads*kPerThread),
+          "no event from concurrent writers is lost");
+
+    //each writer's values come out once each and in the order written
+    std::vector<int> Next(kThreads,0);
+    bool bOK = true;
+    for(unsigned int i = 0;i<Events.size();i++)
+    {
+        int nTrack = Events[i].nTrack;
+        if(nTrack>=kThreads || Events[i].nValue!=Next[nTrack])
+        {
+            bOK = false;
+            break;
+        }
+        Next[nTrack]++;
+    }
+    Check(bOK,"each writer's events are whole and in order");
+}
+
+void TestChromeTrace()
+{
+    MOOS::TraceRing Ring(16);
+    Ring.Enable();
+    Ring.Span("Fetch",10.0,10.0015,3);
+    Ring.Span("Iterate",10.002,10.004);
+    Ring.Span("Bad\"Name",10.005,10.006);
+    Ring.Count("InBox",5,MOOS::TraceRing::TRACK_COMMS_READER);
+
+    const std::string sFile = "trace_ring_test.json";
+    Check(Ring.WriteChromeTrace(sFile,"pTest"),"Chrome trace is written");
+    std::string sJSON = ReadFile(sFile);
+    remove(sFile.c_str());
+
+    Check(sJSON.find("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[")==0,
+          "Chrome trace opens with the event array");
+    Check(Balanced(sJSON),"Chrome trace brackets and strings balance");
+    Check(sJSON.find("\"args\":{\"name\":\"pTest\"}")!=std::string::npos,
+          "the process is named");
+    Check(CountOf(sJSON,"\"thread_name\"")==3 &&
+          sJSON.find("\"name\":\"comms reader\"")!=std::string::npos,
+          "each track is named");
+    Check(CountOf(sJSON,"\"ph\":\"X\"")==3 && CountOf(sJSON,"\"ph\":\"C\"")==1,
+          "every span and counter is written");
+    Check(sJSON.find("{\"name\":\"Fetch\",\"ph\":\"X\",\"pid\":1,\"tid\":0,"
+                     "\"ts\":0.0,\"dur\":1500.0,\"args\":{\"n\":3}}")!=std::string::npos,
+          "span times are microseconds from the first event and carry their value");
+    Check(sJSON.find("\"name\":\"Iterate\",\"ph\":\"X\",\"pid\":1,\"tid\":0,"
+                     "\"ts\":2000.0,\"dur\":2000.0}")!=std::string::npos,
+          "a span without a value has no args");
+    Check(sJSON.find("\"name\":\"Bad_Name\"")!=std::string::npos,
+          "a quote in a name cannot break the JSON");
+    Check(sJSON.find("\"tid\":2,\"ts\":")!=std::string::npos &&
+          sJSON.find("\"args\":{\"InBox\":5}")!=std::string::npos,
+          "a counter is written on its track with its value");
+}
+
+void TestBinary()
+{
+    MOOS::TraceRing Ring(16);
+    Ring.Enable();
+    Ring.Span("Read",1.5,2.0,4,MOOS::TraceRing::TRACK_COMMS_READER);
+    Ring.Count("OutBox",9,MOOS::TraceRing::TRACK_COMMS_WRITER);
+
+    const std::string sFile = "trace_ring_test.bin";
+    Check(Ring.WriteBinary(sFile),"binary trace is written");
+    std::string sBin = ReadFile(sFile);
+    remove(sFile.c_str());
+
+    //header, count, then 8+8+4+1+1+2 bytes plus the name per event
+    Check(sBin.size()==8+4+(24+4)+(24+6),"binary trace has the documented size");
+    Check(sBin.compare(0,8,"MOOSTRC1")==0,"binary trace starts with its magic");
+
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(sBin.data());
+    unsigned int nCount = p[8] | (p[9]<<8) | (p[10]<<16) | (p[11]<<24);
+    Check(nCount==2,"binary trace holds the event count");
+
+    const unsigned char* e = p+12;
+    unsigned long long nBits = 0;
+    for(int i = 7;i>=0;i--)
+        nBits = (nBits<<8) | e[i];
+    double dfStart;
+    memcpy(&dfStart,&nBits,8);
+    unsigned int nLen = e[22] | (e[23]<<8);
+    Check(dfStart==1.5 && e[16+4]=='X' && e[21]==MOOS::TraceRing::TRACK_COMMS_READER &&
+          nLen==4 && std::string(reinterpret_cast<const char*>(e+24),4)=="Read",
+          "binary event is little endian with its name after it");
+}
+
+int main(int argc, char * argv[])
+{
+    TestDisabled();
+    TestWrap();
+    TestThreads();
+    TestChromeTrace();
+    TestBinary();
+
+    std::cout<<(gFailures ? "FAILED" : "all passed")<<"\n";
+    return gFailures ? 1 : 0;
+}
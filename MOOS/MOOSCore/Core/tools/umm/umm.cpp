@@ -76,6 +76,8 @@ void PrintHelp()
 
     MOOSTrace("  --num_tx=<integer>     : only send \"integer\" number of messages\n");
     MOOSTrace("  --latency              : show latency (time between posting and receiving)\n");
+    MOOSTrace("  --latency_report       : every few seconds print per variable latency of traced mail\n");
+    MOOSTrace("                           (apps run with --moos_latency_trace) as seen by the DB and subscribers\n");
     MOOSTrace("  --bandwidth            : print bandwidth\n");
     MOOSTrace("  --skew                 : print timing adjustment relative to the MOOSDB\n");
     MOOSTrace("  --verbose              : verbose output\n");
@@ -120,6 +122,7 @@ public:
     {
 
         _bShowLatency =  m_CommandLineParser.GetFlag("-l","--latency");
+        _bLatencyReport = m_CommandLineParser.GetFlag("--latency_report");
         _bVerbose = m_CommandLineParser.GetFlag("-v","--verbose");
         _bShowBandwidth =   m_CommandLineParser.GetFlag("-b","--bandwidth");
         _bShowTimingAdjustment  = m_CommandLineParser.GetFlag("-k","--skew");
@@ -347,6 +350,13 @@ public:
 
         for(q = NewMail.begin();q!=NewMail.end();q++)
         {
+            std::string sKey = q->GetKey();
+            if(_bLatencyReport && sKey.size()>8 && sKey.compare(sKey.size()-8,8,"_LATENCY")==0)
+            {
+                _LatencyReports[q->GetSource()] = q->GetString();
+                continue;
+            }
+
             double dfLatencyMS  = (MOOS::Time()-q->GetTime())*1000;
             _dfMeanLatency = 0.1*dfLatencyMS+0.9*_dfMeanLatency;
 
@@ -442,6 +452,11 @@ public:
 			    std::cout<<MOOS::ConsoleColours::reset();
 			}
 
+			if(_bLatencyReport)
+			{
+			    PrintLatencyReport();
+			}
+
 			if(_bPing )
 			{
 			    if(!_bPingRxd)
@@ -481,9 +496,66 @@ public:
     {
         _sDBIPAddress = MOOS::IPV4Address::GetNumericAddress(m_sServerHost);
         DoSubscriptions();
+
+        //apps measuring latency publish it as <APPNAME>_LATENCY
+        if(_bLatencyReport)
+            m_Comms.Register("*_LATENCY","*",0.0);
+
         return true;
     }
 
+    void PrintLatencyReportLine(const std::string & sWho,const std::string & sEntries)
+    {
+        std::string sAll = sEntries;
+        while(!sAll.empty())
+        {
+            std::string sEntry = MOOSChomp(sAll,";");
+            std::string sVar,sLeg;
+            double n=0,mean=0,p50=0,p90=0,p99=0,max=0;
+            if(!MOOSValFromString(sVar,sEntry,"var") || !MOOSValFromString(sLeg,sEntry,"leg"))
+                continue;
+            MOOSValFromString(n,sEntry,"n");
+            MOOSValFromString(mean,sEntry,"mean");
+            MOOSValFromString(p50,sEntry,"p50");
+            MOOSValFromString(p90,sEntry,"p90");
+            MOOSValFromString(p99,sEntry,"p99");
+            MOOSValFromString(max,sEntry,"max");
+
+            std::cout<<std::left<<std::setw(16)<<sWho;
+            std::cout<<std::left<<std::setw(24)<<sVar;
+            std::cout<<std::left<<std::setw(10)<<sLeg;
+            std::cout<<std::right<<std::setw(8)<<static_cast<long>(n);
+            std::cout<<std::fixed<<std::setprecision(3);
+            std::cout<<std::setw(10)<<mean<<std::setw(10)<<p50<<std::setw(10)<<p90;
+            std::cout<<std::setw(10)<<p99<<std::setw(10)<<max<<"\n";
+            std::cout.unsetf(std::ios::fixed);
+        }
+    }
+
+    void PrintLatencyReport()
+    {
+        std::cout<<MOOS::ConsoleColours::Yellow()<<"\n--Latency-- (ms)\n";
+        std::cout<<std::left<<std::setw(16)<<"seen by"<<std::setw(24)<<"variable"<<std::setw(10)<<"leg";
+        std::cout<<std::right<<std::setw(8)<<"n"<<std::setw(10)<<"mean"<<std::setw(10)<<"p50";
+        std::cout<<std::setw(10)<<"p90"<<std::setw(10)<<"p99"<<std::setw(10)<<"max"<<"\n";
+        std::cout<<MOOS::ConsoleColours::reset();
+
+        //the DB knows how long mail took to reach it (and leave the
+        //rest of our mail alone)
+        MOOSMSG_LIST Replies;
+        if(m_Comms.ServerRequest(MOOS_LATENCY_SUMMARY,Replies,1.0,false))
+        {
+            MOOSMSG_LIST::iterator q;
+            for(q = Replies.begin();q!=Replies.end();q++)
+                PrintLatencyReportLine(q->GetSource(),q->GetString());
+        }
+
+        //and subscribers how long it took to reach them
+        std::map<std::string,std::string>::iterator w;
+        for(w = _LatencyReports.begin();w!=_LatencyReports.end();w++)
+            PrintLatencyReportLine(w->first,w->second);
+    }
+
     bool DoSubscriptions()
     {
         std::vector<std::string>::iterator q;
@@ -621,6 +693,8 @@ private:
     std::string _sDBIPAddress;
     bool _bVerbose;
     bool _bShowLatency;
+    bool _bLatencyReport;
+    std::map<std::string,std::string> _LatencyReports;
     double _dfMeanLatency;
     bool _bShowBandwidth;
     bool _bShowTimingAdjustment;
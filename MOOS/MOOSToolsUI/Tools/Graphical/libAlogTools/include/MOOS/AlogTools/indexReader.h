@@ -28,12 +28,29 @@ class indexReader
         const idxMsgList& GetMsgList() const;
         const idxSrcList& GetSrcList() const;
         const std::vector<idxRec>& GetRecordList() const;
+        const std::vector<idxRec>& GetOtherList() const;
+        const idxHeader& GetHeader() const;
+
+        // Indices into the record list of the records of one message,
+        // in time order. Empty if the message is not in the log.
+        const std::vector<long>& GetMsgRecords( const std::string & msg ) const;
+
+        // Index of the first record at or after the given time, or
+        // the number of records if there is none
+        int GetRecordIndexAtTime( double time ) const;
+
+        // True if the alog still has the size and checksum recorded
+        // when the index was built
+        bool MatchesAlog( const std::string & alogFilename ) const;
         
     private:
         idxHeader m_alogHeader;
         idxMsgList m_alogMsgList;
         idxSrcList m_alogSrcList;
         std::vector<idxRec> m_alogRecords;
+        std::vector<long> m_alogBuckets;
+        idxPostings m_alogPostings;
+        std::vector<idxRec> m_alogOthers;
 
 };
 
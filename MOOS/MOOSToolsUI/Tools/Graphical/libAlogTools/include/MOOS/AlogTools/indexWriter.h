@@ -1,7 +1,9 @@
 #ifndef _indexWriter_h_
 #define _indexWriter_h_
 
+#include <map>
 #include <string>
+#include <vector>
 
 #include "recordTypes.h"
 
@@ -17,10 +19,22 @@ class indexWriter
         idxMsgList m_alogMsgList;
         idxSrcList m_alogSrcList;
         std::vector<idxRec> m_alogRecords;
+        std::vector<long> m_alogBuckets;
+        idxPostings m_alogPostings;
+        std::vector<idxRec> m_alogOthers;
 
-
+        // Throws CannotOpenFileForReadingException
         void parseAlogFile( std::string alogFileName );
+
+        // Throws CannotOpenFileForWritingException
         void writeIndexFile( std::string alogIndexName );
+
+    private:
+        void sortRecords();
+        void buildBuckets();
+
+        // Records of each message, as positions in file order
+        std::map< std::string, std::vector<long> > m_msgRecords;
 };
 
 }  // namespace AlogTools
@@ -17,8 +17,10 @@ class indexedAlogReader
         indexedAlogReader();
         ~indexedAlogReader();
 
+        // Builds alogFilename + ".idx" if it is missing or out of date.
         // Throws CannotOpenFileForReadingException,
-        //        CannotOpenIndexFileForReadingException
+        //        CannotOpenIndexFileForReadingException (if the index
+        //        could not be built)
         void Init( std::string alogFilename );
 
         void GetNextLine(std::string & line);
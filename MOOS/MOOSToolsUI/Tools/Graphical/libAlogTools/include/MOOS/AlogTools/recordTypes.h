@@ -4,11 +4,14 @@
 #include <iostream>
 #include <set>
 #include <string>
+#include <vector>
 
 namespace MOOS {
 namespace AlogTools {
 
-const int FILE_FORMAT_VERSION = 0;
+// Version 1 adds the source alog size and checksum, time buckets,
+// per-message posting lists and the offsets of non-record lines
+const int FILE_FORMAT_VERSION = 1;
 
 class idxRec
 {
@@ -30,7 +33,9 @@ public:
 class idxHeader
 {
 public:
-    idxHeader() : version(FILE_FORMAT_VERSION), recsBegin(0), numRecs(0), startTime(0.0) {}
+    idxHeader() : version(FILE_FORMAT_VERSION), recsBegin(0), numRecs(0), startTime(0.0),
+                  alogSize(0), alogChecksum(0), bucketStart(0.0), bucketWidth(0.0),
+                  numBuckets(0), numOthers(0) {}
 
     void clear()
     {
@@ -38,6 +43,12 @@ public:
         recsBegin = 0;
         numRecs = 0;
         startTime = 0.0;
+        alogSize = 0;
+        alogChecksum = 0;
+        bucketStart = 0.0;
+        bucketWidth = 0.0;
+        numBuckets = 0;
+        numOthers = 0;
     }
 
     friend std::ostream& operator<<(std::ostream& os, const idxHeader & header);
@@ -50,8 +61,33 @@ public:
     long recsBegin;
     long numRecs;
     double startTime;
+
+    // Size and FNV-1a checksum of the alog the index was built from
+    long alogSize;
+    unsigned int alogChecksum;
+
+    // Bucket i holds the first record at or after
+    // bucketStart + i*bucketWidth
+    double bucketStart;
+    double bucketWidth;
+    long numBuckets;
+
+    // Comment, blank and other lines not starting with a timestamp
+    long numOthers;
 };
 
+// For each message in the message list (in list order), the indices
+// of its records in the time sorted record list
+class idxPostings : public std::vector< std::vector<long> >
+{
+    friend std::ostream& operator<<(std::ostream& os, const idxPostings & postings);
+    friend std::istream& operator>>(std::istream& is, idxPostings & postings);
+};
+
+// 32 bit FNV-1a checksum of a whole file. Returns false if the file
+// cannot be read.
+bool FileChecksum(const std::string & filename, long & size, unsigned int & checksum);
+
 class idxMsgList : public std::set< std::string >
 {
     friend std::ostream& operator<<(std::ostream& os, const idxMsgList & msglist);
@@ -17,7 +17,10 @@ indexReader::indexReader():
     m_alogHeader(),
     m_alogMsgList(),
     m_alogSrcList(),
-    m_alogRecords()
+    m_alogRecords(),
+    m_alogBuckets(),
+    m_alogPostings(),
+    m_alogOthers()
 {}
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -31,6 +34,9 @@ void indexReader::clear()
   m_alogMsgList.clear();
   m_alogSrcList.clear();
   m_alogRecords.clear();
+  m_alogBuckets.clear();
+  m_alogPostings.clear();
+  m_alogOthers.clear();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -46,7 +52,7 @@ void indexReader::ReadIndexFile( std::string alogIndexFilename )
 {
     clear();
 
-    std::ifstream idxFileStream( alogIndexFilename.c_str() );
+    std::ifstream idxFileStream( alogIndexFilename.c_str(), ios::in | ios::binary );
 
     if(!idxFileStream.is_open())
     {
@@ -73,6 +79,31 @@ void indexReader::ReadIndexFile( std::string alogIndexFilename )
         m_alogRecords.push_back( alogRecord );
     }
 
+    // Time buckets, posting lists, then the other lines
+    m_alogBuckets.resize(m_alogHeader.numBuckets);
+    for(long i = 0; i < m_alogHeader.numBuckets; ++i)
+    {
+        idxFileStream.read((char*)(&m_alogBuckets[i]), sizeof(long));
+    }
+
+    m_alogPostings.resize(m_alogMsgList.size());
+    idxFileStream >> m_alogPostings;
+
+    m_alogOthers.reserve(m_alogHeader.numOthers);
+    for(long i = 0; i < m_alogHeader.numOthers; ++i)
+    {
+        idxRec otherRecord;
+        idxFileStream >> otherRecord;
+
+        m_alogOthers.push_back( otherRecord );
+    }
+
+    // A truncated index is as good as none
+    if(!idxFileStream)
+    {
+        clear();
+        throw exceptions::CannotOpenFileForReadingException(alogIndexFilename);
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -118,5 +149,62 @@ const std::vector<idxRec>& indexReader::GetRecordList() const
     return m_alogRecords;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+const std::vector<idxRec>& indexReader::GetOtherList() const
+{
+    return m_alogOthers;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+const idxHeader& indexReader::GetHeader() const
+{
+    return m_alogHeader;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+const std::vector<long>& indexReader::GetMsgRecords( const std::string & msg ) const
+{
+    static const std::vector<long> none;
+
+    idxMsgList::const_iterator m = m_alogMsgList.find(msg);
+    if(m == m_alogMsgList.end())
+        return none;
+
+    size_t ix = std::distance(m_alogMsgList.begin(), m);
+    if(ix >= m_alogPostings.size())
+        return none;
+    return m_alogPostings[ix];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int indexReader::GetRecordIndexAtTime( double time ) const
+{
+    int numRecs = m_alogRecords.size();
+    if(numRecs == 0 || m_alogBuckets.empty())
+        return 0;
+
+    // Start from the bucket holding the time and walk forward
+    long b = 0;
+    if(time > m_alogHeader.bucketStart)
+        b = (long)((time - m_alogHeader.bucketStart) / m_alogHeader.bucketWidth);
+    if(b >= (long) m_alogBuckets.size())
+        b = m_alogBuckets.size() - 1;
+
+    int ix = m_alogBuckets[b];
+    while(ix < numRecs && m_alogRecords[ix].time < time)
+        ix++;
+    return ix;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool indexReader::MatchesAlog( const std::string & alogFilename ) const
+{
+    long size = 0;
+    unsigned int checksum = 0;
+    if(!FileChecksum(alogFilename, size, checksum))
+        return false;
+    return (size == m_alogHeader.alogSize) && (checksum == m_alogHeader.alogChecksum);
+}
+
 }  // namespace AlogTools
 }  // namespace MOOS
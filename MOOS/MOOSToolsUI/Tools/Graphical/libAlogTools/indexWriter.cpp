@@ -17,10 +17,8 @@ namespace AlogTools {
 ////////////////////////////////////////////////////////////////////////////////
 void indexWriter::writeIndexFile(string alogIndexName)
 {
-    // sort the lines by timestamp and then write to index file
-    sort(m_alogRecords.begin(), m_alogRecords.end());
-
-    ofstream outfile(alogIndexName.c_str());
+    // the lines were sorted by timestamp when the alog was parsed
+    ofstream outfile(alogIndexName.c_str(), ios::out | ios::binary);
     if (!outfile.is_open())
     {
         throw exceptions::CannotOpenFileForWritingException(alogIndexName);
@@ -47,9 +45,87 @@ void indexWriter::writeIndexFile(string alogIndexName)
         ++it;
     }
 
+    // Time buckets, posting lists, then the other lines
+    for (size_t i = 0; i < m_alogBuckets.size(); i++)
+        outfile.write((char*) &m_alogBuckets[i], sizeof(long));
+
+    outfile << m_alogPostings;
+
+    for (size_t i = 0; i < m_alogOthers.size(); i++)
+        outfile << m_alogOthers[i];
+
     outfile.close();
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void indexWriter::sortRecords()
+{
+    // Stable sort by time, so records with equal times stay in file order
+    vector< pair<double, long> > order(m_alogRecords.size());
+    for (size_t i = 0; i < m_alogRecords.size(); i++)
+        order[i] = make_pair(m_alogRecords[i].time, (long) i);
+    stable_sort(order.begin(), order.end());
+
+    vector<idxRec> sorted(m_alogRecords.size());
+    vector<long> newPos(m_alogRecords.size());
+    for (size_t i = 0; i < order.size(); i++)
+    {
+        sorted[i] = m_alogRecords[order[i].second];
+        newPos[order[i].second] = i;
+    }
+    m_alogRecords.swap(sorted);
+
+    // One posting list per message, in message list order
+    m_alogPostings.clear();
+    m_alogPostings.resize(m_alogMsgList.size());
+    idxMsgList::const_iterator m = m_alogMsgList.begin();
+    for (size_t i = 0; m != m_alogMsgList.end(); ++m, ++i)
+    {
+        const vector<long> &filePos = m_msgRecords[*m];
+        vector<long> &postings = m_alogPostings[i];
+        postings.reserve(filePos.size());
+        for (size_t j = 0; j < filePos.size(); j++)
+            postings.push_back(newPos[filePos[j]]);
+        sort(postings.begin(), postings.end());
+    }
+    m_msgRecords.clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void indexWriter::buildBuckets()
+{
+    m_alogBuckets.clear();
+    if (m_alogRecords.empty())
+    {
+        m_alogHeader.bucketStart = 0.0;
+        m_alogHeader.bucketWidth = 0.0;
+        m_alogHeader.numBuckets = 0;
+        return;
+    }
+
+    // Aim for about a thousand buckets over the duration of the log
+    double tStart = m_alogRecords.front().time;
+    double tEnd = m_alogRecords.back().time;
+    double width = (tEnd - tStart) / 1024.0;
+    if (width < 0.001)
+        width = 0.001;
+    long numBuckets = (long)((tEnd - tStart) / width) + 1;
+
+    long ix = 0;
+    long numRecs = m_alogRecords.size();
+    for (long i = 0; i < numBuckets; i++)
+    {
+        double t = tStart + i * width;
+        while (ix < numRecs && m_alogRecords[ix].time < t)
+            ix++;
+        m_alogBuckets.push_back(ix);
+    }
+
+    m_alogHeader.bucketStart = tStart;
+    m_alogHeader.bucketWidth = width;
+    m_alogHeader.numBuckets = numBuckets;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void indexWriter::parseAlogFile(string alogFileName)
 {
@@ -60,20 +136,32 @@ void indexWriter::parseAlogFile(string alogFileName)
     }
 
     int numRecords = 0;
+    long int nextBegin = 0;
     while (!myfile.eof())
     {
-        // Store byte offset to next line
-        long int lineBegin = (long int) myfile.tellg();
-
         // Read the line in
         string line;
-        getline(myfile, line);
+        if (!getline(myfile, line))
+            break;
+
+        // Byte offsets of this line and the next, counting the newline
+        long int lineBegin = nextBegin;
+        long int lineEnd = lineBegin + line.size() + (myfile.eof() ? 0 : 1);
+        nextBegin = lineEnd;
+
+        idxRec other;
+        other.lineBegin = lineBegin;
+        other.len = lineEnd - lineBegin;
 
         // Check for blank line
         size_t pos = line.find_first_not_of(" \t\r\n");
         bool blankLine = (pos == string::npos);
 
-        if (!blankLine && !line.empty())
+        if (blankLine || line.empty())
+        {
+            m_alogOthers.push_back(other);
+        }
+        else
         {
             // Check for comment
             if (line.at(pos) == '%')
@@ -89,6 +177,7 @@ void indexWriter::parseAlogFile(string alogFileName)
                     }
                 }
 
+                m_alogOthers.push_back(other);
                 continue;
             }
 
@@ -96,6 +185,7 @@ void indexWriter::parseAlogFile(string alogFileName)
             // isdigit checks for [0-9] so will fail on -x.x
             if (isdigit(line.at(pos)) == 0)
             {
+                m_alogOthers.push_back(other);
                 continue;
             }
 
@@ -108,13 +198,18 @@ void indexWriter::parseAlogFile(string alogFileName)
             string srcName;
             stm >> timeStamp >> varName >> srcName;
 
-            // Feed MOOS variable name into message list
-            m_alogMsgList.insert(varName);
+            // Feed MOOS variable name into message list. A line holding
+            // only a timestamp has no name, and an empty name could not
+            // be read back from the list.
+            if (!varName.empty())
+            {
+                m_alogMsgList.insert(varName);
+                m_msgRecords[varName].push_back(m_alogRecords.size());
+            }
 
             // Feed MOOS source name into Source list
-            m_alogSrcList.insert(srcName);
-
-            long int lineEnd = (long int) myfile.tellg();
+            if (!srcName.empty())
+                m_alogSrcList.insert(srcName);
 
             idxRec alogLine;
             alogLine.time = timeStamp;
@@ -130,6 +225,19 @@ void indexWriter::parseAlogFile(string alogFileName)
     myfile.close();
 
     m_alogHeader.numRecs = numRecords;
+    m_alogHeader.numOthers = m_alogOthers.size();
+
+    long alogSize = 0;
+    unsigned int alogChecksum = 0;
+    if (!FileChecksum(alogFileName, alogSize, alogChecksum))
+    {
+        throw exceptions::CannotOpenFileForReadingException(alogFileName);
+    }
+    m_alogHeader.alogSize = alogSize;
+    m_alogHeader.alogChecksum = alogChecksum;
+
+    sortRecords();
+    buildBuckets();
 }
 
 }  // namespace AlogTools
@@ -1,5 +1,6 @@
 #include "MOOS/AlogTools/indexedAlogReader.h"
 #include "MOOS/AlogTools/exceptions.h"
+#include "MOOS/AlogTools/indexWriter.h"
 
 namespace MOOS {
 namespace AlogTools {
@@ -25,13 +26,31 @@ void indexedAlogReader::Init( std::string alogFilename )
 
     std::string alogIndexFilename = alogFilename + ".idx";
 
+    // Use the index next to the alog if it was built from this alog
     try
     {
         m_indexReader.ReadIndexFile( alogIndexFilename );
+        if( m_indexReader.MatchesAlog( alogFilename ) )
+            return;
     }
     catch (exceptions::CannotOpenFileForReadingException& e)
+    {}
+    catch (exceptions::IncorrectAlogIndexVersionException& e)
+    {}
+
+    // Otherwise the index is missing, stale or of an older version, so
+    // build it now and leave it for the next user of the alog
+    try
+    {
+        indexWriter idxWriter;
+        idxWriter.parseAlogFile( alogFilename );
+        idxWriter.writeIndexFile( alogIndexFilename );
+
+        m_indexReader.ReadIndexFile( alogIndexFilename );
+    }
+    catch (exceptions::FileIOException& e)
     {
-        throw exceptions::CannotOpenIndexFileForReadingException(e.FileName());
+        throw exceptions::CannotOpenIndexFileForReadingException(alogIndexFilename);
     }
 }
 
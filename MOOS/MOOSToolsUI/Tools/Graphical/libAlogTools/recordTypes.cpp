@@ -5,6 +5,7 @@
 #include <string>
 #include <vector>
 #include <iostream>
+#include <fstream>
 #include <iterator>
 #include <stdexcept>
 
@@ -41,6 +42,12 @@ std::ostream& operator<<(std::ostream& os, const idxHeader & header)
     os.write((char*) &header.recsBegin, sizeof(header.recsBegin));
     os.write((char*) &header.numRecs, sizeof(header.numRecs));
     os.write((char*) &header.startTime, sizeof(header.startTime));
+    os.write((char*) &header.alogSize, sizeof(header.alogSize));
+    os.write((char*) &header.alogChecksum, sizeof(header.alogChecksum));
+    os.write((char*) &header.bucketStart, sizeof(header.bucketStart));
+    os.write((char*) &header.bucketWidth, sizeof(header.bucketWidth));
+    os.write((char*) &header.numBuckets, sizeof(header.numBuckets));
+    os.write((char*) &header.numOthers, sizeof(header.numOthers));
     return os;
     
 }
@@ -62,14 +69,19 @@ std::istream& operator>>(std::istream& is, idxHeader & header)
     is.read((char*)(&header.recsBegin), sizeof(header.recsBegin));
     is.read((char*)(&header.numRecs), sizeof(header.numRecs));
     is.read((char*)(&header.startTime), sizeof(header.startTime));
+    is.read((char*)(&header.alogSize), sizeof(header.alogSize));
+    is.read((char*)(&header.alogChecksum), sizeof(header.alogChecksum));
+    is.read((char*)(&header.bucketStart), sizeof(header.bucketStart));
+    is.read((char*)(&header.bucketWidth), sizeof(header.bucketWidth));
+    is.read((char*)(&header.numBuckets), sizeof(header.numBuckets));
+    is.read((char*)(&header.numOthers), sizeof(header.numOthers));
     return is;
 }
 
 
 std::ostream& operator<<(std::ostream& os, const idxMsgList & msglist)
 {
-    if (msglist.empty()) return os;
-
+    // An empty list is still written as an empty line
     copy(msglist.begin(), msglist.end(), ostream_iterator<string>(os, ","));
     os << std::endl;
 
@@ -93,8 +105,6 @@ std::istream& operator>>(std::istream& is, idxMsgList & msglist)
 
 std::ostream& operator<<(std::ostream& os, const idxSrcList & srcList)
 {
-    if (srcList.empty()) return os;
-
     copy(srcList.begin(), srcList.end(), ostream_iterator<string>(os, ","));
     os << std::endl;
 
@@ -116,5 +126,60 @@ std::istream& operator>>(std::istream& is, idxSrcList & srcList)
     return is;
 }
 
+std::ostream& operator<<(std::ostream& os, const idxPostings & postings)
+{
+    for (size_t i = 0; i < postings.size(); i++)
+    {
+        long count = postings[i].size();
+        os.write((char*) &count, sizeof(count));
+        if (count > 0)
+            os.write((char*) &postings[i][0], count * sizeof(long));
+    }
+    return os;
+}
+
+// The number of lists must be set by the caller, one per message
+std::istream& operator>>(std::istream& is, idxPostings & postings)
+{
+    for (size_t i = 0; i < postings.size(); i++)
+    {
+        long count = 0;
+        is.read((char*)(&count), sizeof(count));
+        if (!is || count < 0)
+            break;
+        postings[i].resize(count);
+        if (count > 0)
+            is.read((char*)(&postings[i][0]), count * sizeof(long));
+    }
+    return is;
+}
+
+bool FileChecksum(const std::string & filename, long & size, unsigned int & checksum)
+{
+    std::ifstream file(filename.c_str(), std::ios::in | std::ios::binary);
+    if (!file.is_open())
+        return false;
+
+    unsigned int hash = 2166136261u;
+    long total = 0;
+
+    char buff[65536];
+    while (file)
+    {
+        file.read(buff, sizeof(buff));
+        std::streamsize n = file.gcount();
+        for (std::streamsize i = 0; i < n; i++)
+        {
+            hash ^= (unsigned char) buff[i];
+            hash *= 16777619u;
+        }
+        total += n;
+    }
+
+    size = total;
+    checksum = hash;
+    return true;
+}
+
 }  // namespace AlogTools
 }  // namespace MOOS
@@ -0,0 +1,110 @@
+#!/bin/bash
+#-------------------------------------------------------
+#  Shared by the bench.sh scripts which time MOOS apps
+#  against their own MOOSDB. Sourced, not run. A bench
+#  sets DURATION, APPTICK and PORT to its defaults and
+#  may define:
+#    bench_usage   printf lines for its own switches
+#    bench_option  handle one of its own switches, given
+#                  the argument, returning 1 if not known
+#  then calls bench_args "$@". A run is made with
+#  bench_start, bench_launch for each app, bench_measure,
+#  bench_cpu_pct of the pids of interest and bench_stop.
+#  Linux only: CPU times are read from /proc.
+#-------------------------------------------------------
+
+#-------------------------------------------------------
+#  bench_args: the command line of the bench
+#-------------------------------------------------------
+bench_args() {
+    for ARGI; do
+	if [ "${ARGI}" = "--help" -o "${ARGI}" = "-h" ] ; then
+	    printf "%s [SWITCHES]                                  \n" $0
+	    if type bench_usage >& /dev/null; then
+		bench_usage
+	    fi
+	    printf "  --duration=%-10s Seconds per run        \n" $DURATION
+	    printf "  --apptick=%-11s AppTick of the apps    \n" $APPTICK
+	    printf "  --help, -h                                   \n"
+	    exit 0;
+	elif [ "${ARGI:0:11}" = "--duration=" ] ; then
+            DURATION="${ARGI#--duration=*}"
+	elif [ "${ARGI:0:10}" = "--apptick=" ] ; then
+            APPTICK="${ARGI#--apptick=*}"
+	elif type bench_option >& /dev/null && bench_option "${ARGI}"; then
+	    continue
+	else
+	    printf "Bad Argument: %s \n" $ARGI
+	    exit 1
+	fi
+    done
+    TICKS=$(getconf CLK_TCK)
+}
+
+#-------------------------------------------------------
+#  bench_header: the start of a bench mission file
+#-------------------------------------------------------
+bench_header() {
+    printf "ServerHost = localhost\n"
+    printf "ServerPort = %s\n" $PORT
+    printf "Community  = bench\n\n"
+}
+
+#-------------------------------------------------------
+#  bench_start: <moos_file>  Start the MOOSDB of a run
+#-------------------------------------------------------
+bench_start() {
+    BENCH_MOOS=$1
+    BENCH_PIDS=""
+    MOOSDB $BENCH_MOOS >& /dev/null &
+    BENCH_DB_PID=$!
+    sleep 1
+}
+
+#-------------------------------------------------------
+#  bench_launch: <app> [args]  Start an app of the run.
+#  Its pid is left in BENCH_PID.
+#-------------------------------------------------------
+bench_launch() {
+    "$@" >& /dev/null &
+    BENCH_PID=$!
+    BENCH_PIDS="$BENCH_PIDS $BENCH_PID"
+}
+
+#-------------------------------------------------------
+#  bench_measure: let the run go for DURATION seconds
+#-------------------------------------------------------
+bench_measure() {
+    sleep $DURATION
+}
+
+#-------------------------------------------------------
+#  bench_cpu_secs: user+system CPU seconds of the pids
+#-------------------------------------------------------
+bench_cpu_secs() {
+    local TOTAL=0
+    for PID in $@; do
+	if [ -r /proc/$PID/stat ]; then
+	    local STAT=($(sed 's/^.*) //' /proc/$PID/stat))
+	    TOTAL=$((TOTAL + ${STAT[11]} + ${STAT[12]}))
+	fi
+    done
+    awk -v t=$TOTAL -v k=$TICKS 'BEGIN {printf("%.2f", t/k)}'
+}
+
+#-------------------------------------------------------
+#  bench_cpu_pct: CPU of the pids as a percent of the run
+#-------------------------------------------------------
+bench_cpu_pct() {
+    local CPU=$(bench_cpu_secs $@)
+    awk -v c=$CPU -v d=$DURATION 'BEGIN {printf("%.1f", 100*c/d)}'
+}
+
+#-------------------------------------------------------
+#  bench_stop: stop the apps and MOOSDB of the run
+#-------------------------------------------------------
+bench_stop() {
+    kill $BENCH_PIDS $BENCH_DB_PID >& /dev/null
+    wait >& /dev/null
+    rm -f $BENCH_MOOS
+}
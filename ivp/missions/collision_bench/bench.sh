@@ -0,0 +1,83 @@
+#!/bin/bash 
+#-------------------------------------------------------
+#  Measure the per-iterate cost of uFldCollisionDetect
+#  as the fleet grows, with the broad phase (grid pair
+#  culling) on and off. Node reports for each vehicle 
+#  are posted by uTimerScript at random positions and
+#  headings in the region. Linux only: CPU times are 
+#  read from /proc.
+#-------------------------------------------------------
+VEHICLES="10 50 100 200"
+DURATION=20
+APPTICK=4
+PORT=9323
+SIZE=2000
+
+source $(dirname $0)/../bench_lib.sh
+
+bench_usage() {
+    printf "  --vehicles=\"10 50\"    Fleet sizes to run     \n" 
+    printf "  --size=2000           Region width (meters)  \n" 
+}
+
+bench_option() {
+    if [ "${1:0:11}" = "--vehicles=" ] ; then
+        VEHICLES="${1#--vehicles=*}"
+    elif [ "${1:0:7}" = "--size=" ] ; then
+        SIZE="${1#--size=*}"
+    else
+	return 1
+    fi
+}
+
+bench_args "$@"
+
+#-------------------------------------------------------
+#  make_mission: <vehicles> <broad_phase>
+#-------------------------------------------------------
+make_mission() {
+    bench_header
+    printf "ProcessConfig = uFldCollisionDetect\n{\n"
+    printf "  AppTick   = %s\n  CommsTick = %s\n\n" $APPTICK $APPTICK
+    printf "  collision_range     = 10\n"
+    printf "  near_miss_range     = 20\n"
+    printf "  cpa_violation_range = 30\n"
+    printf "  broad_phase         = %s\n}\n\n" $2
+    printf "ProcessConfig = uTimerScript\n{\n"
+    printf "  AppTick   = %s\n  CommsTick = %s\n\n" $APPTICK $APPTICK
+    printf "  reset_max  = nolimit\n  reset_time = all-posted\n\n"
+    printf "  event = var=DEPLOY_ALL, val=true, time=0\n"
+    for I in $(seq 1 $1); do
+	printf "  randvar = varname=X%s, min=0, max=%s, key=at_reset\n" $I $SIZE
+	printf "  randvar = varname=Y%s, min=-%s, max=0, key=at_reset\n" $I $SIZE
+	printf "  randvar = varname=H%s, min=0, max=359, key=at_reset\n" $I
+	printf "  event = var=NODE_REPORT, val=\"NAME=v%s,X=\$(X%s),Y=\$(Y%s),SPD=2,HDG=\$(H%s),TIME=\$(UTCTIME),TYPE=kayak\", time=0.5\n" $I $I $I $I
+    done
+    printf "}\n"
+}
+
+#-------------------------------------------------------
+#  run: <vehicles> <broad_phase>
+#-------------------------------------------------------
+run() {
+    make_mission $1 $2 > bench.moos
+    bench_start bench.moos
+
+    bench_launch uTimerScript bench.moos
+    bench_launch uFldCollisionDetect bench.moos
+    local CD_PID=$BENCH_PID
+
+    bench_measure
+    local CD_CPU=$(bench_cpu_secs $CD_PID)
+    bench_stop
+
+    awk -v c=$CD_CPU -v d=$DURATION -v t=$APPTICK 'BEGIN {printf("%.0f", 1e6*c/(d*t))}'
+}
+
+printf "%s second runs, AppTick=%s, region %sx%s\n" $DURATION $APPTICK $SIZE $SIZE
+printf "%-10s %14s %16s\n" "Vehicles" "Broad us/it" "All-pairs us/it"
+for N in $VEHICLES; do
+    BP=$(run $N true)
+    AP=$(run $N false)
+    printf "%-10s %14s %16s\n" $N $BP $AP
+done
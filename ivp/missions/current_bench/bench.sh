@@ -0,0 +1,59 @@
+#!/bin/bash 
+#-------------------------------------------------------
+#  Compare the current field lookup modes of uSimCurrent
+#  as the number of vectors grows: a scan of all vectors,
+#  the spatial index and the raster. Fields of random 
+#  vectors over a square region are made here, and each
+#  is timed with uSimCurrent --bench. No MOOSDB is used.
+#-------------------------------------------------------
+VECTORS="100 1000 10000 50000"
+QUERIES=100000
+RADIUS=15
+RASTER=""
+SIZE=2000
+
+for ARGI; do
+    if [ "${ARGI}" = "--help" -o "${ARGI}" = "-h" ] ; then
+	printf "%s [SWITCHES]                                  \n" $0
+	printf "  --vectors=\"100 1000\"  Field sizes to run     \n" 
+	printf "  --queries=100000      Queries per mode       \n" 
+	printf "  --radius=15           Field radius           \n" 
+	printf "  --raster=CELL         Raster cell size       \n" 
+	printf "                        (default radius/4)     \n" 
+	printf "  --size=2000           Side of the region     \n" 
+	printf "  --help, -h                                   \n" 
+	exit 0;
+    elif [ "${ARGI:0:10}" = "--vectors=" ] ; then
+        VECTORS="${ARGI#--vectors=*}"
+    elif [ "${ARGI:0:10}" = "--queries=" ] ; then
+        QUERIES="${ARGI#--queries=*}"
+    elif [ "${ARGI:0:9}" = "--radius=" ] ; then
+        RADIUS="${ARGI#--radius=*}"
+    elif [ "${ARGI:0:9}" = "--raster=" ] ; then
+        RASTER="--raster=${ARGI#--raster=*}"
+    elif [ "${ARGI:0:7}" = "--size=" ] ; then
+        SIZE="${ARGI#--size=*}"
+    else 
+	printf "Bad Argument: %s \n" $ARGI
+	exit 1
+    fi
+done
+
+#-------------------------------------------------------
+#  make_field: <vectors>
+#-------------------------------------------------------
+make_field() {
+    awk -v n=$1 -v r=$RADIUS -v s=$SIZE 'BEGIN {
+        srand(1)
+        printf("FieldName: bench\nRadius: %s\n\n", r)
+        for(i=0; i<n; i++)
+            printf("x=%.1f, y=%.1f, mag=%.2f, ang=%.0f\n", rand()*s, 
+                   -rand()*s, 0.5+rand()*2, rand()*360)
+    }'
+}
+
+for N in $VECTORS; do
+    make_field $N > bench_field_$N.cfd
+    uSimCurrent --bench=bench_field_$N.cfd --queries=$QUERIES $RASTER | \
+	sed -n '/^Current Field Benchmark/,$p'
+done
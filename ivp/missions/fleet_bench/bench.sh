@@ -0,0 +1,80 @@
+#!/bin/bash 
+#-------------------------------------------------------
+#  Compare the CPU used to simulate N vehicles with one 
+#  uSimFleet against N uSimMarine processes. Each run has
+#  its own MOOSDB, and the CPU of the MOOSDB is counted.
+#  Linux only: CPU times are read from /proc.
+#-------------------------------------------------------
+VEHICLES="1 10 50 100"
+DURATION=20
+APPTICK=10
+PORT=9321
+
+source $(dirname $0)/../bench_lib.sh
+
+bench_usage() {
+    printf "  --vehicles=\"1 10 50\"  Fleet sizes to run   \n" 
+}
+
+bench_option() {
+    if [ "${1:0:11}" = "--vehicles=" ] ; then
+        VEHICLES="${1#--vehicles=*}"
+    else
+	return 1
+    fi
+}
+
+bench_args "$@"
+
+#-------------------------------------------------------
+#  make_mission: <mode> <vehicles>
+#-------------------------------------------------------
+make_mission() {
+    bench_header
+    printf "LatOrigin  = 43.825300\n"
+    printf "LongOrigin = -70.330400\n\n"
+    if [ "$1" = "fleet" ]; then
+	printf "ProcessConfig = uSimFleet\n{\n"
+	printf "  AppTick   = %s\n  CommsTick = %s\n\n" $APPTICK $APPTICK
+	for I in $(seq 1 $2); do
+	    printf "  vehicle = name=v%s, x=%s, y=0, heading=90\n" $I $((I*10))
+	done
+	printf "}\n\n"
+    else
+	for I in $(seq 1 $2); do
+	    printf "ProcessConfig = uSimMarine_%s\n{\n" $I
+	    printf "  AppTick   = %s\n  CommsTick = %s\n\n" $APPTICK $APPTICK
+	    printf "  start_pos = x=%s, y=0, heading=90\n" $((I*10))
+	    printf "  prefix    = NAV_V%s\n}\n\n" $I
+	done
+    fi
+}
+
+#-------------------------------------------------------
+#  run: <mode> <vehicles>
+#-------------------------------------------------------
+run() {
+    make_mission $1 $2 > bench_$1.moos
+    bench_start bench_$1.moos
+
+    if [ "$1" = "fleet" ]; then
+	bench_launch uSimFleet bench_$1.moos
+    else
+	for I in $(seq 1 $2); do
+	    bench_launch uSimMarine bench_$1.moos uSimMarine_$I
+	done
+    fi
+
+    bench_measure
+    local SIM_PCT=$(bench_cpu_pct $BENCH_PIDS)
+    local DB_PCT=$(bench_cpu_pct $BENCH_DB_PID)
+    bench_stop
+    printf "%-10s %8s %10s %10s\n" $1 $2 $SIM_PCT $DB_PCT
+}
+
+printf "%s second runs, AppTick=%s\n" $DURATION $APPTICK
+printf "%-10s %8s %10s %10s\n" "Simulator" "Vehicles" "Sim CPU%" "DB CPU%"
+for N in $VEHICLES; do
+    run fleet $N
+    run marine $N
+done
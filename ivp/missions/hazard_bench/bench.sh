@@ -0,0 +1,84 @@
+#!/bin/bash 
+#-------------------------------------------------------
+#  Measure the CPU used by uFldHazardSensor as the size
+#  of the hazard field grows. Fields are made with 
+#  gen_hazards. Node reports for each vehicle are posted
+#  by uTimerScript at random positions in the field.
+#  Linux only: CPU times are read from /proc.
+#-------------------------------------------------------
+HAZARDS="1000 10000 100000"
+VEHICLES=10
+DURATION=20
+APPTICK=4
+PORT=9322
+REGION="0,0:4000,0:4000,-4000:0,-4000"
+
+source $(dirname $0)/../bench_lib.sh
+
+bench_usage() {
+    printf "  --hazards=\"1000 10000\" Field sizes to run    \n" 
+    printf "  --vehicles=10         Vehicles sensing       \n" 
+}
+
+bench_option() {
+    if [ "${1:0:10}" = "--hazards=" ] ; then
+        HAZARDS="${1#--hazards=*}"
+    elif [ "${1:0:11}" = "--vehicles=" ] ; then
+        VEHICLES="${1#--vehicles=*}"
+    else
+	return 1
+    fi
+}
+
+bench_args "$@"
+
+#-------------------------------------------------------
+#  make_mission: <hazard_file>
+#-------------------------------------------------------
+make_mission() {
+    bench_header
+    printf "ProcessConfig = uFldHazardSensor\n{\n"
+    printf "  AppTick   = %s\n  CommsTick = %s\n\n" $APPTICK $APPTICK
+    printf "  sensor_config = width=25, exp=4, pclass=0.63\n"
+    printf "  sensor_config = width=50, exp=2, pclass=0.55\n"
+    printf "  hazard_file   = %s\n" $1
+    printf "  show_hazards  = false\n"
+    printf "  seed_random   = false\n}\n\n"
+    printf "ProcessConfig = uTimerScript\n{\n"
+    printf "  AppTick   = %s\n  CommsTick = %s\n\n" $APPTICK $APPTICK
+    printf "  reset_max  = nolimit\n  reset_time = all-posted\n\n"
+    for I in $(seq 1 $VEHICLES); do
+	printf "  randvar = varname=X%s, min=0, max=4000, key=at_reset\n" $I
+	printf "  randvar = varname=Y%s, min=-4000, max=0, key=at_reset\n" $I
+	printf "  event = var=NODE_REPORT, val=\"NAME=v%s,X=\$(X%s),Y=\$(Y%s),SPD=1,HDG=90,TYPE=kayak\", time=0\n" $I $I $I
+	printf "  event = var=UHZ_SENSOR_REQUEST, val=\"vname=v%s\", time=1\n" $I
+    done
+    printf "}\n"
+}
+
+#-------------------------------------------------------
+#  run: <hazards>
+#-------------------------------------------------------
+run() {
+    local HFILE=bench_hazards_$1.txt
+    gen_hazards --polygon=$REGION --objects=$(($1/2)),hazard \
+		--objects=$(($1/2)),benign > $HFILE
+    make_mission $HFILE > bench.moos
+    bench_start bench.moos
+
+    bench_launch uTimerScript bench.moos
+    bench_launch uFldHazardSensor bench.moos
+    local HS_PID=$BENCH_PID
+
+    bench_measure
+    local HS_PCT=$(bench_cpu_pct $HS_PID)
+    bench_stop
+    printf "%-10s %8s %12s\n" $1 $VEHICLES $HS_PCT
+}
+
+printf "%s second runs, AppTick=%s\n" $DURATION $APPTICK
+printf "%-10s %8s %12s\n" "Hazards" "Vehicles" "Sensor CPU%"
+for N in $HAZARDS; do
+    run $N
+done
+rm -f bench_hazards_*.txt
@@ -0,0 +1,4 @@
+#!/bin/bash 
+
+rm -f    *~
+rm -f    bench.moos bench_hazards_*.txt
@@ -0,0 +1,47 @@
+#!/bin/bash 
+#-------------------------------------------------------
+#  Capture alpha.alog, the default input of ../bench.sh,
+#  by running the alpha mission for 40 seconds of mission
+#  time (4 seconds at the time warp of 10).            
+#  Rerun after changing alpha.moos or alpha.bhv.
+#-------------------------------------------------------
+SECS=4
+
+for ARGI; do
+    if [ "${ARGI}" = "--help" -o "${ARGI}" = "-h" ] ; then
+	printf "%s [SWITCHES]                                  \n" $0
+	printf "  --secs=4              Real seconds to run    \n" 
+	printf "  --help, -h                                   \n" 
+	exit 0;
+    elif [ "${ARGI:0:7}" = "--secs=" ] ; then
+        SECS="${ARGI#--secs=*}"
+    else 
+	printf "Bad Argument: %s \n" $ARGI
+	exit 1
+    fi
+done
+
+cd $(dirname $0)
+rm -rf alpha/
+
+MOOSDB alpha.moos >& /dev/null &
+sleep 1
+pLogger      alpha.moos >& /dev/null &
+uSimMarine   alpha.moos >& /dev/null &
+pMarinePID   alpha.moos >& /dev/null &
+uTimerScript alpha.moos >& /dev/null &
+pHelmIvP     alpha.moos >& /dev/null &
+sleep 2
+uPokeDB alpha.moos DEPLOY=true MOOS_MANUAL_OVERRIDE=false >& /dev/null
+sleep $SECS
+
+kill %pHelmIvP %uTimerScript %pMarinePID %uSimMarine >& /dev/null
+sleep 1
+kill %pLogger >& /dev/null
+sleep 1
+kill %MOOSDB >& /dev/null
+wait >& /dev/null
+
+mv alpha/alpha.alog alpha.alog
+rm -rf alpha/
+ls -l alpha.alog
@@ -0,0 +1,69 @@
+#!/bin/bash 
+#-------------------------------------------------------
+#  Run helmbench over one or more captured missions, each
+#  given as a mission file and the alog of a run of it,
+#  and write a report per mission for trend tracking. The
+#  helm is run from the mission's directory so behavior
+#  files named in the mission are found. Missions should
+#  be run with ipf_reporting = true for the IPF figures.
+#  With no missions given, the captured alpha mission in
+#  alpha/ is used. See alpha/capture.sh.
+#-------------------------------------------------------
+REPS=5
+OUTDIR="reports"
+RUNS=""
+
+for ARGI; do
+    if [ "${ARGI}" = "--help" -o "${ARGI}" = "-h" ] ; then
+	printf "%s [SWITCHES] [mission.moos:run.alog ...]      \n" $0
+	printf "  --reps=5              Reps of each suite     \n" 
+	printf "  --outdir=reports      Directory for reports  \n" 
+	printf "  --help, -h                                   \n" 
+	exit 0;
+    elif [ "${ARGI:0:7}" = "--reps=" ] ; then
+        REPS="${ARGI#--reps=*}"
+    elif [ "${ARGI:0:9}" = "--outdir=" ] ; then
+        OUTDIR="${ARGI#--outdir=*}"
+    elif [ "${ARGI%%:*}" != "${ARGI}" ] ; then
+        RUNS="$RUNS $ARGI"
+    else 
+	printf "Bad Argument: %s \n" $ARGI
+	exit 1
+    fi
+done
+
+if [ -z "$RUNS" ]; then
+    HERE=$(cd $(dirname $0) && pwd)
+    RUNS="$HERE/alpha/alpha.moos:$HERE/alpha/alpha.alog"
+fi
+
+mkdir -p $OUTDIR
+OUTDIR=$(cd $OUTDIR && pwd)
+
+FAILS=0
+for RUN in $RUNS; do
+    MISSION="${RUN%%:*}"
+    ALOG="${RUN#*:}"
+    if [ ! -f "$MISSION" -o ! -f "$ALOG" ]; then
+	printf "Not found: %s\n" $RUN
+	FAILS=$((FAILS + 1))
+	continue
+    fi
+    ALOG=$(cd $(dirname $ALOG) && pwd)/$(basename $ALOG)
+    REPORT=$OUTDIR/$(basename $ALOG .alog).txt
+
+    (cd $(dirname $MISSION) && \
+	helmbench $(basename $MISSION) $ALOG --reps=$REPS \
+	--report=$REPORT -q >& /dev/null)
+    if [ $? != 0 ]; then
+	printf "%-40s FAILED\n" $(basename $ALOG)
+	FAILS=$((FAILS + 1))
+	continue
+    fi
+
+    P50=$(grep "^helm.decide_us.p50=" $REPORT | cut -d= -f2)
+    P99=$(grep "^helm.decide_us.p99=" $REPORT | cut -d= -f2)
+    printf "%-40s decide_us p50=%s p99=%s\n" $(basename $ALOG) $P50 $P99
+done
+
+exit $FAILS
@@ -0,0 +1,6 @@
+#!/bin/bash 
+
+rm -f    *~
+rm -rf   reports
+rm -f    .LastOpenedMOOSLogDirectory  alpha/.LastOpenedMOOSLogDirectory
+rm -f    *.alog.idx  alpha/*.alog.idx
@@ -0,0 +1,54 @@
+#!/bin/sh
+
+# This script checks that the .alog index written by the ivp log tools
+# (lib_logutils ALogIndex, used by aloggrep and alogclip) is byte for
+# byte the index written by alogIndexWriter from libAlogTools. The two
+# implement the same <alog>.idx format and must not drift apart.
+#
+# Both aloggrep and alogIndexWriter must be in the PATH. Each given
+# .alog file is copied to a scratch directory and indexed by each tool.
+# With no arguments the test logs of aloggrep and alogclip are used.
+# Exits non-zero if any pair of indexes differ.
+
+SCRIPT_DIR=$(cd $(dirname $0) && pwd)
+
+for TOOL in aloggrep alogIndexWriter
+do
+    if ! command -v ${TOOL} > /dev/null
+    then
+        echo "${TOOL} not found in the PATH"
+        exit 1
+    fi
+done
+
+if [ $# -eq 0 ]
+then
+    set -- ${SCRIPT_DIR}/../src/app_aloggrep/test.alog \
+           ${SCRIPT_DIR}/../src/app_alogclip/test.alog
+fi
+
+TMP_DIR=$(mktemp -d)
+trap "rm -rf ${TMP_DIR}" EXIT
+
+FAILURES=0
+for ALOG in "$@"
+do
+    cp "${ALOG}" ${TMP_DIR}/check.alog
+    rm -f ${TMP_DIR}/check.alog.idx
+
+    # A variable which is not in the log, so only the index is made
+    aloggrep ${TMP_DIR}/check.alog CHECK_ALOG_INDEX_NO_VAR -q --index > /dev/null
+    mv ${TMP_DIR}/check.alog.idx ${TMP_DIR}/ivp.idx 2> /dev/null
+
+    alogIndexWriter ${TMP_DIR}/check.alog > /dev/null
+
+    if cmp -s ${TMP_DIR}/ivp.idx ${TMP_DIR}/check.alog.idx
+    then
+        echo "same:   ${ALOG}"
+    else
+        echo "DIFFER: ${ALOG}"
+        FAILURES=$((FAILURES+1))
+    fi
+done
+
+exit ${FAILURES}
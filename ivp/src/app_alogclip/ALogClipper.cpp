@@ -24,8 +24,11 @@
 #include <cmath>
 #include "MBUtils.h"
 #include "ALogClipper.h"
+#include "ALogIndex.h"
 #include <cstdlib>
 #include <cstdio>
+#include <vector>
+#include <algorithm>
 
 using namespace std;
 
@@ -43,6 +46,9 @@ ALogClipper::ALogClipper()
   m_kept_lines          = 0;
   m_clipped_lines_front = 0;
   m_clipped_lines_back  = 0;
+
+  m_use_index   = true;
+  m_write_index = false;
 }
 
 //--------------------------------------------------------
@@ -51,28 +57,14 @@ ALogClipper::ALogClipper()
 
 unsigned int ALogClipper::clip(double min_time, double max_time)
 {
+  if(m_use_index && clipIndexed(min_time, max_time)) {
+    fclose(m_infile);
+    m_infile = 0;
+  }
+
   while(m_infile) {
     string line = getNextLine();
-
-    string linecopy  = line;    
-    string timestr   = biteString(linecopy, ' ');
-    double timestamp = atof(timestr.c_str());
-    
-    if(timestr[0] == '%')
-      writeNextLine(line);
-    else if(timestamp < min_time) {
-      m_clipped_chars_front += line.length();
-      m_clipped_lines_front += 1;
-    }
-    else if(timestamp > max_time) {
-      m_clipped_chars_back += line.length();
-      m_clipped_lines_back += 1;
-    }
-    else {
-      m_kept_chars += line.length();
-      m_kept_lines += 1;
-      writeNextLine(line);
-    }
+    handleLine(line, min_time, max_time);
   }
 
   if(m_outfile)
@@ -80,6 +72,86 @@ unsigned int ALogClipper::clip(double min_time, double max_time)
   return(m_clipped_lines_front + m_clipped_lines_back);
 }
 
+//--------------------------------------------------------
+// Procedure: clipIndexed
+//     Notes: Records outside the time window are clipped from the
+//            index alone. The records in the window and all other
+//            lines are read and handled in file order as by clip().
+//            Returns false if the alog could not be indexed.
+
+bool ALogClipper::clipIndexed(double min_time, double max_time)
+{
+  ALogIndex index;
+  if(!index.open(m_infile_name, m_write_index))
+    return(false);
+
+  unsigned int rsize = index.size();
+  unsigned int front = index.getIndexByTime(min_time);
+  unsigned int back  = index.getIndexByTime(max_time);
+  while((back < rsize) && (index.getTime(back) <= max_time))
+    back++;
+
+  for(unsigned int i=0; i<front; i++) {
+    m_clipped_chars_front += index.getLineLen(i);
+    m_clipped_lines_front += 1;
+  }
+  for(unsigned int i=back; i<rsize; i++) {
+    m_clipped_chars_back += index.getLineLen(i);
+    m_clipped_lines_back += 1;
+  }
+
+  // Each line to read is noted by its offset in the file and an id,
+  // a record index, or -1 less an index of the other lines
+  vector<pair<long, long> > lines;
+  for(unsigned int i=front; i<back; i++)
+    lines.push_back(make_pair(index.getLineBegin(i), (long)(i)));
+  for(unsigned int i=0; i<index.sizeOthers(); i++)
+    lines.push_back(make_pair(index.getOtherBegin(i), -1 - (long)(i)));
+
+  sort(lines.begin(), lines.end());
+
+  for(unsigned int i=0; i<lines.size(); i++) {
+    long id = lines[i].second;
+    if(id >= 0)
+      handleLine(index.getRecordLine(id), min_time, max_time);
+    else
+      handleLine(index.getOtherLine(-1 - id), min_time, max_time);
+  }
+
+  // Reading line by line finds an empty line after a final newline
+  if((index.getALogSize() == 0) || index.endsWithNewline())
+    handleLine("", min_time, max_time);
+
+  return(true);
+}
+
+//--------------------------------------------------------
+// Procedure: handleLine
+
+void ALogClipper::handleLine(const string& line, double min_time,
+			     double max_time)
+{
+  string linecopy  = line;    
+  string timestr   = biteString(linecopy, ' ');
+  double timestamp = atof(timestr.c_str());
+    
+  if(timestr[0] == '%')
+    writeNextLine(line);
+  else if(timestamp < min_time) {
+    m_clipped_chars_front += line.length();
+    m_clipped_lines_front += 1;
+  }
+  else if(timestamp > max_time) {
+    m_clipped_chars_back += line.length();
+    m_clipped_lines_back += 1;
+  }
+  else {
+    m_kept_chars += line.length();
+    m_kept_lines += 1;
+    writeNextLine(line);
+  }
+}
+
 //--------------------------------------------------------
 // Procedure: getNextLine
 //     Notes: 
@@ -141,8 +213,9 @@ bool ALogClipper::openALogFileRead(string alogfile)
   m_infile = fopen(alogfile.c_str(), "r");
   if(!m_infile)
     return(false);
-  else
-    return(true);
+
+  m_infile_name = alogfile;
+  return(true);
 }
 
 //--------------------------------------------------------
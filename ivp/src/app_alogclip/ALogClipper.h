@@ -38,10 +38,20 @@ class ALogClipper
 
   unsigned int getDetails(const std::string& statevar);
 
+  void setUseIndex(bool v) {m_use_index=v;}
+  void setWriteIndex(bool v) {m_write_index=v;}
+
  protected:
+  bool        clipIndexed(double mintime, double maxtime);
+  void        handleLine(const std::string& line,
+			 double mintime, double maxtime);
   std::string getNextLine();
   bool        writeNextLine(const std::string& output);
 
+  std::string  m_infile_name;
+  bool         m_use_index;
+  bool         m_write_index;
+
   unsigned int m_kept_chars;
   unsigned int m_clipped_chars_front;
   unsigned int m_clipped_chars_back;
@@ -61,13 +61,21 @@ void display_usage()
   cout << "  -v,--version  Display version information.             " << endl;
   cout << "  -f,--force    Overwrite an existing output file.       " << endl;
   cout << "  -q,--quiet    Verbose report suppressed at conclusion. " << endl;
+  cout << "  -ni,--noindex Scan the whole input file rather than    " << endl;
+  cout << "                reading it through its index.            " << endl;
+  cout << "  --index       Write in.alog.idx if it is missing or    " << endl;
+  cout << "                stale, for faster reads next time.       " << endl;
   cout << "                                                         " << endl;
   cout << "Further Notes:                                           " << endl;
   cout << "  (1) The order of arguments may vary. The first alog    " << endl;
   cout << "      file is treated as the input file, and the first   " << endl;
   cout << "      numerical value is treated as the mintime.         " << endl;
   cout << "  (2) Two numerical values, in order, must be given.     " << endl;
-  cout << "  (3) See also: alogscan, alogrm, aloggrep, alogview     " << endl;
+  cout << "  (3) The input is read through in.alog.idx if present, " << endl;
+  cout << "      else an index built in memory. Nothing is written  " << endl;
+  cout << "      beside the input unless --index is given. The index" << endl;
+  cout << "      is the libAlogTools format.                        " << endl;
+  cout << "  (4) See also: alogscan, alogrm, aloggrep, alogview     " << endl;
   cout << endl;
 }
 
@@ -99,6 +107,17 @@ int main(int argc, char *argv[])
   if(scanArgs(argc, argv, "-f", "--force", "-force"))
     force_overwrite = true;
 
+  // Look for the option to scan the whole input file rather than
+  // reading it through its index
+  bool use_index = true;
+  if(scanArgs(argc, argv, "-ni", "--noindex", "-noindex"))
+    use_index = false;
+
+  // Look for the option to save the index beside the input file
+  bool write_index = false;
+  if(scanArgs(argc, argv, "--index", "-index"))
+    write_index = true;
+
   bool   okargs = true;
   double min_time = 0; 
   double max_time = 0;
@@ -144,6 +163,8 @@ int main(int argc, char *argv[])
   }
 
   ALogClipper clipper;
+  clipper.setUseIndex(use_index);
+  clipper.setWriteIndex(write_index);
 
 
   //-----------------------------------------------------------------
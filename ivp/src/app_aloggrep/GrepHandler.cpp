@@ -25,9 +25,11 @@
 #include <cstdlib>
 #include <cstdio>
 #include <cmath>
+#include <algorithm>
 #include "MBUtils.h"
 #include "GrepHandler.h"
 #include "LogUtils.h"
+#include "ALogIndex.h"
 #include "TermUtils.h"
 
 using namespace std;
@@ -53,6 +55,11 @@ GrepHandler::GrepHandler()
   // A "bad" line is a line that is not a comment, and does not begin
   // with a timestamp. As found in entries with CRLF's like DB_VARSUMMARY
   m_badlines_retained = false;
+
+  // Read the alog through its index where the keys allow
+  m_use_index = true;
+  // But leave the directory of the alog alone unless asked
+  m_write_index = false;
 }
 
 //--------------------------------------------------------
@@ -99,75 +106,173 @@ bool GrepHandler::handle(const string& alogfile, const string& new_alogfile)
       m_badlines_retained = true;
   }
   
-  bool done = false;
-  while(!done) {
-    string line_raw = getNextRawLine(m_file_in);
-    
-    // Part 1: Check if the line is a comment and handle or ignore
-    if((line_raw.length() > 0) && (line_raw.at(0) == '%')) {
-      if(m_comments_retained)
-	outputLine(line_raw);
-      continue;
+  if(!m_use_index || m_badlines_retained || !handleIndexed(alogfile)) {
+    bool done = false;
+    while(!done) {
+      string line_raw = getNextRawLine(m_file_in);
+      if(line_raw == "eof") 
+	break;
+      handleLine(line_raw);
     }
+  }
 
-    // Part 2: Check for end of file
-    if(line_raw == "eof") 
-      break;
-
-    // Part 3: Handle lines that do not begin with a number (comment
-    // lines are already handled above)
-    if(!isNumber(line_raw.substr(0,1))) {
-      if(m_badlines_retained)
-	outputLine(line_raw);
-      else
-	ignoreLine(line_raw);
-      continue;
-    }
+  if(m_file_out)
+    fclose(m_file_out);
+  m_file_out = 0;
+
+  if(m_file_in)
+    fclose(m_file_in);
+  m_file_in = 0;
+
+  return(true);
+}
 
-    // Part 4: If there is a condition, see if it has been met
-    string varname = getVarName(line_raw);
-    if((m_var_condition != "") && (varname == m_var_condition)) {
-      string varval = getDataEntry(line_raw);
-      if(tolower(varval) == "true")
-	m_var_condition_met = true;
-      else
-	m_var_condition_met = false;
+//--------------------------------------------------------
+// Procedure: handleIndexed
+//     Notes: Reads only the lines that may be retained: comments and
+//            other lines, and the records of matching variables and
+//            of the condition variable, in file order. All other
+//            records would be ignored, so are only counted.
+//            Returns false, with no lines handled, if a key could
+//            match a source name since records are not indexed by
+//            source.
+
+bool GrepHandler::handleIndexed(const string& alogfile)
+{
+  ALogIndex index;
+  if(!index.open(alogfile, m_write_index))
+    return(false);
+
+  const vector<string>& sources = index.getSources();
+  for(unsigned int j=0; j<sources.size(); j++) {
+    string src = sources[j];
+    string src_no_aux = biteString(src, ':');
+    for(unsigned int i=0; i<m_keys.size(); i++) {
+      if((src_no_aux == m_keys[i]) ||
+	 (m_pmatch[i] && strContains(src_no_aux, m_keys[i])))
+	return(false);
     }
+  }
+
+  // Each line to read is noted by its offset in the file and an id,
+  // a record index, or -1 less an index of the other lines
+  vector<pair<long, long> > lines;
+  vector<bool> selected(index.size(), false);
 
-    if(!m_var_condition_met) {
-      ignoreLine(line_raw, varname);
+  const vector<string>& vars = index.getVarNames();
+  for(unsigned int i=0; i<vars.size(); i++) {
+    if((vars[i] != m_var_condition) && !varMatch(vars[i])) {
+      m_vars_removed.insert(vars[i]);
       continue;
     }
-      
-    // Part 5: Check if this line matches a named var or src
-    string srcname = getSourceNameNoAux(line_raw);
-
-    bool match = false;
-    for(unsigned int i=0; ((i<m_keys.size()) && !match); i++) {
-      if((varname == m_keys[i]) || (srcname == m_keys[i]))
-	match = true;
-      else if(m_pmatch[i] && (strContains(varname, m_keys[i]) ||
-			      strContains(srcname, m_keys[i])))
-	match = true;
+    const vector<long>& recs = index.getVarRecords(vars[i]);
+    for(unsigned int j=0; j<recs.size(); j++) {
+      selected[recs[j]] = true;
+      lines.push_back(make_pair(index.getLineBegin(recs[j]), recs[j]));
     }
+  }
+  for(unsigned int i=0; i<index.sizeOthers(); i++)
+    lines.push_back(make_pair(index.getOtherBegin(i), -1 - (long)(i)));
 
-    // Part 6: Depending whether a match was made, output or ignore the line
-    if(match) 
-      outputLine(line_raw, varname);
+  sort(lines.begin(), lines.end());
+
+  // A last line with no newline is never read by a scan either
+  long alog_size = index.getALogSize();
+  bool partial_last = !index.endsWithNewline();
+
+  for(unsigned int i=0; i<lines.size(); i++) {
+    long id = lines[i].second;
+    string line_raw;
+    if(id >= 0)
+      line_raw = index.getRecordLine(id);
     else
-      ignoreLine(line_raw, varname);
+      line_raw = index.getOtherLine(-1 - id);
+    if(partial_last && (lines[i].first + (long)(line_raw.length()) == alog_size))
+      continue;
+    handleLine(line_raw);
+  }
 
+  for(unsigned int ix=0; ix<index.size(); ix++) {
+    if(selected[ix])
+      continue;
+    long len = index.getLineLen(ix);
+    if(partial_last && (index.getLineBegin(ix) + len == alog_size))
+      continue;
+    m_lines_removed++;
+    m_chars_removed += len;
   }
+  return(true);
+}
 
-  if(m_file_out)
-    fclose(m_file_out);
-  m_file_out = 0;
+//--------------------------------------------------------
+// Procedure: handleLine
 
-  if(m_file_in)
-    fclose(m_file_in);
-  m_file_in = 0;
+void GrepHandler::handleLine(const string& line_raw)
+{
+  // Part 1: Check if the line is a comment and handle or ignore
+  if((line_raw.length() > 0) && (line_raw.at(0) == '%')) {
+    if(m_comments_retained)
+      outputLine(line_raw);
+    return;
+  }
 
-  return(true);
+  // Part 2: Handle lines that do not begin with a number (comment
+  // lines are already handled above)
+  if(!isNumber(line_raw.substr(0,1))) {
+    if(m_badlines_retained)
+      outputLine(line_raw);
+    else
+      ignoreLine(line_raw);
+    return;
+  }
+
+  // Part 3: If there is a condition, see if it has been met
+  string varname = getVarName(line_raw);
+  if((m_var_condition != "") && (varname == m_var_condition)) {
+    string varval = getDataEntry(line_raw);
+    if(tolower(varval) == "true")
+      m_var_condition_met = true;
+    else
+      m_var_condition_met = false;
+  }
+
+  if(!m_var_condition_met) {
+    ignoreLine(line_raw, varname);
+    return;
+  }
+      
+  // Part 4: Check if this line matches a named var or src
+  string srcname = getSourceNameNoAux(line_raw);
+
+  bool match = false;
+  for(unsigned int i=0; ((i<m_keys.size()) && !match); i++) {
+    if((varname == m_keys[i]) || (srcname == m_keys[i]))
+      match = true;
+    else if(m_pmatch[i] && (strContains(varname, m_keys[i]) ||
+			    strContains(srcname, m_keys[i])))
+      match = true;
+  }
+
+  // Part 5: Depending whether a match was made, output or ignore the line
+  if(match) 
+    outputLine(line_raw, varname);
+  else
+    ignoreLine(line_raw, varname);
+}
+
+//--------------------------------------------------------
+// Procedure: varMatch
+//     Notes: True if the variable name alone matches a key
+
+bool GrepHandler::varMatch(const string& varname) const
+{
+  for(unsigned int i=0; i<m_keys.size(); i++) {
+    if(varname == m_keys[i])
+      return(true);
+    if(m_pmatch[i] && strContains(varname, m_keys[i]))
+      return(true);
+  }
+  return(false);
 }
 
 //--------------------------------------------------------
@@ -40,11 +40,17 @@ class GrepHandler
   void setFileOverWrite(bool v)    {m_file_overwrite=v;}
   void setCommentsRetained(bool v) {m_comments_retained=v;}
   void setBadLinesRetained(bool v) {m_badlines_retained=v;}
+  void setUseIndex(bool v)         {m_use_index=v;}
+  void setWriteIndex(bool v)       {m_write_index=v;}
 
  protected:
   std::vector<std::string> getMatchedKeys();
   std::vector<std::string> getUnMatchedKeys();
 
+  bool handleIndexed(const std::string& alogfile);
+  void handleLine(const std::string& line);
+  bool varMatch(const std::string& varname) const;
+
   void outputLine(const std::string& line, const std::string& varname="");
   void ignoreLine(const std::string& line, const std::string& varname="");
   
@@ -63,6 +69,8 @@ class GrepHandler
   bool        m_var_condition_met;
   bool        m_comments_retained;
   bool        m_badlines_retained;
+  bool        m_use_index;
+  bool        m_write_index;
 
   std::set<std::string> m_vars_retained;
   std::set<std::string> m_vars_removed;
@@ -59,6 +59,14 @@ int main(int argc, char *argv[])
   }
     
   
+  bool use_index = true;
+  if(scanArgs(argc, argv, "--noindex", "-ni"))
+    use_index = false;
+  
+  bool write_index = false;
+  if(scanArgs(argc, argv, "--index"))
+    write_index = true;
+  
   bool file_overwrite = false;
   if(scanArgs(argc, argv, "-f", "--force", "-force"))
     file_overwrite = true;
@@ -90,12 +98,21 @@ int main(int argc, char *argv[])
     cout << "                                                           " << endl;
     cout << "  --keep_badlines   Do not disscard lines that don't begin " << endl;
     cout << "  -kb               with a timestamp or comment character. " << endl;
+    cout << "  -ni,--noindex     Scan the whole alog rather than reading" << endl;
+    cout << "                    it through in.alog.idx                 " << endl;
+    cout << "  --index           Write in.alog.idx if it is missing or  " << endl;
+    cout << "                    stale, for faster reads next time      " << endl;
     cout << "                                                           " << endl;
     cout << "Further Notes:                                             " << endl;
     cout << "  (1) The second alog is the output file. Otherwise the    " << endl;
     cout << "      order of arguments is irrelevent.                    " << endl;
     cout << "  (2) VAR* matches any MOOS variable starting with VAR     " << endl;
-    cout << "  (3) See also: alogscan, alogrm, alogclip, alogsplit, alogview " << endl;
+    cout << "  (3) VAR keys are found through the index in.alog.idx if  " << endl;
+    cout << "      present, else one built in memory. SRC keys need a   " << endl;
+    cout << "      scan.                                                " << endl;
+    cout << "  (4) Nothing is written beside the input unless --index   " << endl;
+    cout << "      is given. The index is the libAlogTools format.      " << endl;
+    cout << "  (5) See also: alogscan, alogrm, alogclip, alogsplit, alogview " << endl;
     cout << endl;
     return(0);
   }
@@ -127,6 +144,8 @@ int main(int argc, char *argv[])
   handler.setFileOverWrite(file_overwrite);
   handler.setCommentsRetained(comments_retained);
   handler.setBadLinesRetained(badlines_retained);
+  handler.setUseIndex(use_index);
+  handler.setWriteIndex(write_index);
 
   int ksize = keys.size();
   for(int i=0; i<ksize; i++)
@@ -0,0 +1,299 @@
+/*****************************************************************/
+/*    NAME: MOOS-IvP contributors                                */
+/*    ORGN: Dept of Mechanical Eng / CSAIL, MIT Cambridge MA     */
+/*    FILE: CodecBench.cpp                                       */
+/*    DATE: Oct 19th 2026                                        */
+/*                                                               */
+/* This file is part of MOOS-IvP                                 */
+/*                                                               */
+/* MOOS-IvP is free software: you can redistribute it and/or     */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation, either version  */
+/* 3 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* MOOS-IvP is distributed in the hope that it will be useful,   */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty   */
+/* of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See  */
+/* the GNU General Public License for more details.              */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with MOOS-IvP.  If not, see                     */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+#ifndef _WIN32
+#include <sys/time.h>
+#else
+#include <ctime>
+#endif
+#include <iostream>
+#include <algorithm>
+#include <cmath>
+#include "CodecBench.h"
+#include "FunctionEncoder.h"
+#include "MBUtils.h"
+
+using namespace std;
+
+static const char *format_names[3] = {"text", "binary", "quantized"};
+
+//--------------------------------------------------------
+// Procedure: wallTime
+
+static double wallTime()
+{
+#ifndef _WIN32
+  struct timeval tv;
+  gettimeofday(&tv, 0);
+  return((double)(tv.tv_sec) + ((double)(tv.tv_usec) / 1000000.0));
+#else
+  return((double)(clock()) / CLOCKS_PER_SEC);
+#endif
+}
+
+//--------------------------------------------------------
+// Procedure: percentile
+//      Note: Given values must be sorted.
+
+static double percentile(const vector<double>& vals, double pct)
+{
+  if(vals.size() == 0)
+    return(0);
+  unsigned int ix = (unsigned int)(pct * (double)(vals.size()-1) + 0.5);
+  return(vals[ix]);
+}
+
+//--------------------------------------------------------
+// Procedure: encode
+
+static string encode(IvPFunction *ipf, int format)
+{
+  if(format == 0)
+    return(IvPFunctionToString(ipf));
+  return(IvPFunctionToBinaryString(ipf, (format == 2)));
+}
+
+//--------------------------------------------------------
+// Constructor
+
+CodecBench::CodecBench()
+{
+  m_reps = 1;
+  for(int f=0; f<3; f++) {
+    m_bytes[f]  = 0;
+    m_failed[f] = 0;
+  }
+  m_checked      = 0;
+  m_total_pieces = 0;
+}
+
+//--------------------------------------------------------
+// Procedure: addIPF
+//     Notes: The helm posts functions broken into packets, 
+//            "P,function-id,total,index,...". Whole functions are
+//            kept once all their packets have arrived.
+
+void CodecBench::addIPF(const string& ipf_str)
+{
+  if(strBegins(ipf_str, "P,")) {
+    m_demuxer.addMuxPacket(ipf_str, 0);
+    string demux_str = m_demuxer.getDemuxString();
+    while(demux_str != "") {
+      addIPF(demux_str);
+      demux_str = m_demuxer.getDemuxString();
+    }
+    return;
+  }
+  if(strBegins(ipf_str, "H,"))
+    m_ipfs.push_back(ipf_str);
+}
+
+//--------------------------------------------------------
+// Procedure: checkAll
+
+void CodecBench::checkAll()
+{
+  for(unsigned int i=0; i<m_ipfs.size(); i++) {
+    IvPFunction *ipf = StringToIvPFunction(m_ipfs[i]);
+    if(!ipf)
+      continue;
+    if(ipf->getPDMap() && (ipf->size() > 0))
+      checkFunction(ipf);
+    delete(ipf);
+  }
+}
+
+//--------------------------------------------------------
+// Procedure: checkFunction
+//   Purpose: Encode and decode the function in each format, timing
+//            the best of the configured repetitions, and check what
+//            comes back.
+
+void CodecBench::checkFunction(IvPFunction *ipf)
+{
+  m_checked++;
+  m_total_pieces += ipf->size();
+
+  for(int f=0; f<3; f++) {
+    string str;
+    double best_encode = -1;
+    for(unsigned int r=0; r<m_reps; r++) {
+      double start_time = wallTime();
+      str = encode(ipf, f);
+      double encode_time = wallTime() - start_time;
+      if((best_encode < 0) || (encode_time < best_encode))
+	best_encode = encode_time;
+    }
+
+    IvPFunction *back = 0;
+    double best_decode = -1;
+    for(unsigned int r=0; r<m_reps; r++) {
+      delete(back);
+      double start_time = wallTime();
+      back = StringToIvPFunction(str);
+      double decode_time = wallTime() - start_time;
+      if((best_decode < 0) || (decode_time < best_decode))
+	best_decode = decode_time;
+    }
+
+    m_encode_times[f].push_back(best_encode);
+    m_decode_times[f].push_back(best_decode);
+    m_bytes[f] += (double)(str.length());
+
+    // The text form rounds weights, so it is checked by encoding
+    // what was decoded. The others are checked piece by piece.
+    bool ok = (back != 0);
+    if(ok && (f == 0))
+      ok = (encode(back, 0) == str);
+    else if(ok)
+      ok = samePieces(ipf, back, f);
+    if(!ok) {
+      m_failed[f]++;
+      cout << "Mismatch (" << format_names[f] << "): ";
+      cout << ipf->getContextStr() << endl;
+    }
+    delete(back);
+  }
+}
+
+//--------------------------------------------------------
+// Procedure: samePieces
+//   Purpose: Check a decoded function against the original. Piece
+//            bounds must be exact. Weights must equal the float32
+//            value of the original, or if quantized be within one
+//            step of the 16 bit range of that weight.
+
+bool CodecBench::samePieces(IvPFunction *a, IvPFunction *b, 
+			    int format) const
+{
+  if((a->getContextStr() != b->getContextStr()) ||
+     (a->getDim() != b->getDim()) || (a->size() != b->size()) ||
+     (a->getDegree() != b->getDegree()))
+    return(false);
+
+  PDMap *apd = a->getPDMap();
+  PDMap *bpd = b->getPDMap();
+  if(!apd || !bpd)
+    return(false);
+
+  int i, j, d, pcs = apd->size();
+  int dim = a->getDim();
+  int wtc = apd->bx(0)->getWtc();
+
+  vector<double> step(wtc, 0);
+  if(format == 2) {
+    for(j=0; j<wtc; j++) {
+      double low = apd->bx(0)->wt(j);
+      double hgh = low;
+      for(i=1; i<pcs; i++) {
+	low = min(low, apd->bx(i)->wt(j));
+	hgh = max(hgh, apd->bx(i)->wt(j));
+      }
+      step[j] = ((double)((float)hgh) - (double)((float)low)) / 65535.0;
+    }
+  }
+
+  for(i=0; i<pcs; i++) {
+    IvPBox *abox = apd->bx(i);
+    IvPBox *bbox = bpd->bx(i);
+    for(d=0; d<dim; d++) {
+      if((abox->pt(d,0) != bbox->pt(d,0)) || 
+	 (abox->pt(d,1) != bbox->pt(d,1)) ||
+	 (abox->bd(d,0) != bbox->bd(d,0)) || 
+	 (abox->bd(d,1) != bbox->bd(d,1)))
+	return(false);
+    }
+    for(j=0; j<wtc; j++) {
+      double awt = abox->wt(j);
+      double bwt = bbox->wt(j);
+      if((format == 1) && (bwt != (double)((float)awt)))
+	return(false);
+      // Allow for the float32 rounding of the range ends
+      double tolerance = step[j] + (fabs(awt) * 1e-7);
+      if((format == 2) && (fabs(bwt - awt) > tolerance))
+	return(false);
+    }
+  }
+  return(true);
+}
+
+//--------------------------------------------------------
+// Procedure: passed
+
+bool CodecBench::passed() const
+{
+  for(int f=0; f<3; f++)
+    if(m_failed[f] > 0)
+      return(false);
+  return(true);
+}
+
+//--------------------------------------------------------
+// Procedure: printReport
+
+void CodecBench::printReport() const
+{
+  cout << endl;
+  cout << "IvP functions checked: " << m_checked << endl;
+  if(m_checked == 0) {
+    cout << "  (No BHV_IPF postings found. Is the helm IPF reporting on,";
+    cout << " and BHV_IPF logged?)" << endl;
+    return;
+  }
+  double dfuncs = (double)(m_checked);
+  cout << "Pieces per function:   ";
+  cout << doubleToString(m_total_pieces/dfuncs, 1) << endl << endl;
+
+  cout << "Times (us) best of " << m_reps << ", throughput (MB/s) ";
+  cout << "of the encoded string:" << endl;
+  cout << "  Format      bytes  enc p50  enc p99   enc MB/s  ";
+  cout << "dec p50  dec p99   dec MB/s  failed" << endl;
+  for(int f=0; f<3; f++) {
+    vector<double> etimes = m_encode_times[f];
+    vector<double> dtimes = m_decode_times[f];
+    sort(etimes.begin(), etimes.end());
+    sort(dtimes.begin(), dtimes.end());
+    double etotal = 0;
+    double dtotal = 0;
+    for(unsigned int i=0; i<etimes.size(); i++) {
+      etotal += etimes[i];
+      dtotal += dtimes[i];
+    }
+    double emb = 0;
+    double dmb = 0;
+    if(etotal > 0)
+      emb = (m_bytes[f] / 1000000) / etotal;
+    if(dtotal > 0)
+      dmb = (m_bytes[f] / 1000000) / dtotal;
+
+    cout << "  " << padString(format_names[f], 9, false);
+    cout << padString(doubleToString(m_bytes[f]/dfuncs, 0), 8);
+    cout << padString(doubleToString(percentile(etimes,0.5)*1000000,1), 9);
+    cout << padString(doubleToString(percentile(etimes,0.99)*1000000,1), 9);
+    cout << padString(doubleToString(emb, 1), 11);
+    cout << padString(doubleToString(percentile(dtimes,0.5)*1000000,1), 9);
+    cout << padString(doubleToString(percentile(dtimes,0.99)*1000000,1), 9);
+    cout << padString(doubleToString(dmb, 1), 11);
+    cout << padString(uintToString(m_failed[f]), 8) << endl;
+  }
+}
@@ -0,0 +1,78 @@
+/*****************************************************************/
+/*    NAME: MOOS-IvP contributors                                */
+/*    ORGN: Dept of Mechanical Eng / CSAIL, MIT Cambridge MA     */
+/*    FILE: CodecBench.h                                         */
+/*    DATE: Oct 19th 2026                                        */
+/*                                                               */
+/* This file is part of MOOS-IvP                                 */
+/*                                                               */
+/* MOOS-IvP is free software: you can redistribute it and/or     */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation, either version  */
+/* 3 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* MOOS-IvP is distributed in the hope that it will be useful,   */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty   */
+/* of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See  */
+/* the GNU General Public License for more details.              */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with MOOS-IvP.  If not, see                     */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+#ifndef ALOG_CODEC_BENCH_HEADER
+#define ALOG_CODEC_BENCH_HEADER
+
+#include <vector>
+#include <string>
+#include "IvPFunction.h"
+#include "Demuxer.h"
+
+//--------------------------------------------------------
+// CodecBench checks and times the IvP function string forms on
+// the functions of a logged mission (BHV_IPF). Each function is
+// encoded in the text, binary and quantized forms and decoded 
+// again. The text form must reproduce itself, the binary form 
+// must give back the same pieces with float32 weights, and the
+// quantized form weights within one quantization step.
+
+class CodecBench
+{
+ public:
+  CodecBench();
+  ~CodecBench() {}
+
+  void setReps(unsigned int v)   {if(v>0) m_reps=v;}
+
+  void addIPF(const std::string&);
+  unsigned int size() const      {return(m_ipfs.size());}
+
+  void checkAll();
+  void printReport() const;
+  bool passed() const;
+
+ protected:
+  void checkFunction(IvPFunction*);
+  bool samePieces(IvPFunction*, IvPFunction*, int format) const;
+
+ protected: // Configuration
+  unsigned int m_reps;
+
+ protected: // State
+  Demuxer      m_demuxer;
+
+  // Logged IvP function strings
+  std::vector<std::string> m_ipfs;
+
+  // Results for each format: text, binary, quantized
+  std::vector<double> m_encode_times[3];
+  std::vector<double> m_decode_times[3];
+  double       m_bytes[3];
+  unsigned int m_failed[3];
+
+  unsigned int m_checked;
+  unsigned int m_total_pieces;
+};
+
+#endif 
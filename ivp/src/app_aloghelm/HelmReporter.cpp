@@ -40,6 +40,8 @@ HelmReporter::HelmReporter()
   m_report_life_events  = false;
   m_report_mode_changes = false;
   m_report_bhv_changes  = false;
+  m_report_solvers      = false;
+  m_report_codecs       = false;
 
   m_use_color = true;
   m_var_trunc = true;
@@ -48,6 +50,16 @@ HelmReporter::HelmReporter()
 }
 
 
+//--------------------------------------------------------
+// Procedure: setSolveReps
+//      Note: The repetitions apply to both solving and encoding.
+
+void HelmReporter::setSolveReps(unsigned int reps)
+{
+  m_solver_bench.setReps(reps);
+  m_codec_bench.setReps(reps);
+}
+
 //--------------------------------------------------------
 // Procedure: handle
 //     Notes: 
@@ -116,6 +128,12 @@ bool HelmReporter::handle(const string& alogfile)
 	  m_prev_mode_value = data;
 	}
       }
+      if(m_report_solvers && (varname == "BHV_IPF"))
+	m_solver_bench.addIPF(stripBlankEnds(data));
+      if(m_report_solvers && (varname == "IVPHELM_DOMAIN"))
+	m_solver_bench.setHelmDomain(data);
+      if(m_report_codecs && (varname == "BHV_IPF"))
+	m_codec_bench.addIPF(stripBlankEnds(data));
       if(vectorContains(m_watch_vars, varname)) {
 	if(m_var_trunc)
 	  cout << truncString(line_raw, 80) << endl;
@@ -249,6 +267,14 @@ void HelmReporter::printReport()
     for(i=0; i<vsize; i++)
       cout << report_lines[i] << endl;
   }
+  if(m_report_solvers) {
+    m_solver_bench.solveAll();
+    m_solver_bench.printReport();
+  }
+  if(m_report_codecs) {
+    m_codec_bench.checkAll();
+    m_codec_bench.printReport();
+  }
 }
 
 
@@ -29,6 +29,8 @@
 #include <set>
 #include "LifeEventHistory.h"
 #include "HelmReport.h"
+#include "SolverBench.h"
+#include "CodecBench.h"
 
 class HelmReporter
 {
@@ -46,6 +48,10 @@ class HelmReporter
   void setUseColor(bool v=true)           {m_use_color=v;}
   void setColorActive(bool v)             {m_life_events.setColorActive(v);}
   void setVarTrunc(bool v)                {m_var_trunc=v;}
+  void reportSolvers(bool v=true)         {m_report_solvers=v;}
+  void setSolveReps(unsigned int v);
+  void reportCodecs(bool v=true)          {m_report_codecs=v;}
+  bool codecsPassed() const               {return(m_codec_bench.passed());}
 
   void addWatchVar(std::string);
   
@@ -61,11 +67,16 @@ class HelmReporter
   std::string      m_prev_mode_value;
   std::string      m_mode_var;
 
+  SolverBench      m_solver_bench;
+  CodecBench       m_codec_bench;
+
 
  protected: // Configuration Variables
   bool             m_report_life_events;
   bool             m_report_mode_changes;
   bool             m_report_bhv_changes;
+  bool             m_report_solvers;
+  bool             m_report_codecs;
   bool             m_use_color;
   bool             m_var_trunc;
 
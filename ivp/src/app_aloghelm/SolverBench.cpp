@@ -0,0 +1,339 @@
+/*****************************************************************/
+/*    NAME: MOOS-IvP contributors                                */
+/*    ORGN: Dept of Mechanical Eng / CSAIL, MIT Cambridge MA     */
+/*    FILE: SolverBench.cpp                                      */
+/*    DATE: Oct 18th 2026                                        */
+/*                                                               */
+/* This file is part of MOOS-IvP                                 */
+/*                                                               */
+/* MOOS-IvP is free software: you can redistribute it and/or     */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation, either version  */
+/* 3 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* MOOS-IvP is distributed in the hope that it will be useful,   */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty   */
+/* of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See  */
+/* the GNU General Public License for more details.              */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with MOOS-IvP.  If not, see                     */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+#ifndef _WIN32
+#include <sys/time.h>
+#else
+#include <ctime>
+#endif
+#include <iostream>
+#include <algorithm>
+#include <cstdlib>
+#include <cmath>
+#include "SolverBench.h"
+#include "IvPProblem.h"
+#include "DenseProblem.h"
+#include "FunctionEncoder.h"
+#include "BuildUtils.h"
+#include "MBUtils.h"
+
+using namespace std;
+
+//--------------------------------------------------------
+// Procedure: wallTime
+//      Note: MBTimer only resolves clock ticks, too coarse for
+//            timing a single solve.
+
+static double wallTime()
+{
+#ifndef _WIN32
+  struct timeval tv;
+  gettimeofday(&tv, 0);
+  return((double)(tv.tv_sec) + ((double)(tv.tv_usec) / 1000000.0));
+#else
+  return((double)(clock()) / CLOCKS_PER_SEC);
+#endif
+}
+
+//--------------------------------------------------------
+// Procedure: percentile
+//      Note: Given values must be sorted.
+
+static double percentile(const vector<double>& vals, double pct)
+{
+  if(vals.size() == 0)
+    return(0);
+  unsigned int ix = (unsigned int)(pct * (double)(vals.size()-1) + 0.5);
+  return(vals[ix]);
+}
+
+//--------------------------------------------------------
+// Constructor
+
+SolverBench::SolverBench()
+{
+  m_reps    = 1;
+  m_verbose = false;
+
+  m_total_ofs    = 0;
+  m_total_pieces = 0;
+  m_total_points = 0;
+  m_auto_dense   = 0;
+
+  m_same_point  = 0;
+  m_same_weight = 0;
+  m_differ      = 0;
+}
+
+//--------------------------------------------------------
+// Procedure: addIPF
+//     Notes: The helm posts functions broken into packets, 
+//            "P,function-id,total,index,...". Whole functions are
+//            handled once all their packets have arrived.
+//     Notes: The context string is "iteration:behavior"
+
+void SolverBench::addIPF(const string& ipf_str)
+{
+  if(strBegins(ipf_str, "P,")) {
+    m_demuxer.addMuxPacket(ipf_str, 0);
+    string demux_str = m_demuxer.getDemuxString();
+    while(demux_str != "") {
+      addIPF(demux_str);
+      demux_str = m_demuxer.getDemuxString();
+    }
+    return;
+  }
+
+  if(!strBegins(ipf_str, "H,"))
+    return;
+  string context = StringToIvPContext(ipf_str);
+  string iter_str = biteString(context, ':');
+  if(!isNumber(iter_str))
+    return;
+
+  unsigned int iter = (unsigned int)(atoi(iter_str.c_str()));
+  m_sets[iter].push_back(ipf_str);
+}
+
+//--------------------------------------------------------
+// Procedure: setHelmDomain
+//     Notes: From IVPHELM_DOMAIN, e.g. course,0,359,360:speed,0,4,21
+
+void SolverBench::setHelmDomain(const string& str)
+{
+  m_helm_domain = stringToDomain(str);
+}
+
+//--------------------------------------------------------
+// Procedure: setDomain
+//   Purpose: Determine the domain the helm would have solved the
+//            set over. As in HelmEngine, this is the helm domain
+//            reduced to the variables used by the functions. If 
+//            the helm domain was not logged the domains of the 
+//            functions themselves are used.
+
+IvPDomain SolverBench::setDomain(const vector<string>& ipfs) const
+{
+  IvPDomain set_domain;
+  for(unsigned int i=0; i<ipfs.size(); i++) {
+    IvPDomain ipf_domain = IPFStringToIvPDomain(ipfs[i]);
+    for(unsigned int j=0; j<ipf_domain.size(); j++) {
+      string dname = ipf_domain.getVarName(j);
+      if(set_domain.hasDomain(dname))
+	continue;
+      if(m_helm_domain.hasDomain(dname)) {
+	int ix = m_helm_domain.getIndex(dname);
+	set_domain.addDomain(dname, m_helm_domain.getVarLow(ix), 
+			     m_helm_domain.getVarHigh(ix),
+			     m_helm_domain.getVarPoints(ix));
+      }
+      else
+	set_domain.addDomain(dname, ipf_domain.getVarLow(j), 
+			     ipf_domain.getVarHigh(j),
+			     ipf_domain.getVarPoints(j));
+    }
+  }
+
+  if(set_domain.size() == m_helm_domain.size())
+    return(m_helm_domain);
+  return(set_domain);
+}
+
+//--------------------------------------------------------
+// Procedure: buildProblem
+//      Note: Functions are decoded afresh for each problem since
+//            adding them to a problem applies their weights.
+
+Problem* SolverBench::buildProblem(const vector<string>& ipfs,
+				   const IvPDomain& domain, bool dense) const
+{
+  Problem *problem = 0;
+  if(dense)
+    problem = new DenseProblem;
+  else
+    problem = new IvPProblem;
+
+  for(unsigned int i=0; i<ipfs.size(); i++) {
+    IvPFunction *ipf = StringToIvPFunction(ipfs[i]);
+    if(ipf)
+      problem->addOF(ipf);
+  }
+  problem->setDomain(domain);
+  return(problem);
+}
+
+//--------------------------------------------------------
+// Procedure: solveAll
+
+void SolverBench::solveAll()
+{
+  map<unsigned int, vector<string> >::iterator p;
+  for(p=m_sets.begin(); p!=m_sets.end(); p++)
+    solveSet(p->first, p->second);
+}
+
+//--------------------------------------------------------
+// Procedure: solveSet
+//   Purpose: Solve one set with each solver, timing from the 
+//            alignment of the functions to the solution, and 
+//            compare the decisions. Decisions at different 
+//            points of equal weight are ties, equally correct.
+
+void SolverBench::solveSet(unsigned int iter, const vector<string>& ipfs)
+{
+  IvPDomain domain = setDomain(ipfs);
+  unsigned int dsize = domain.size();
+  if(dsize == 0)
+    return;
+
+  double times[2] = {0, 0};
+  double weight[2] = {0, 0};
+  vector<double> decision[2];
+  bool   solved[2] = {false, false};
+  unsigned int ofs = 0;
+  unsigned int pieces = 0;
+
+  for(int s=0; s<2; s++) {
+    bool dense = (s == 1);
+    double best_time = -1;
+    for(unsigned int r=0; r<m_reps; r++) {
+      Problem *problem = buildProblem(ipfs, domain, dense);
+      double start_time = wallTime();
+      problem->alignOFs();
+      problem->solve();
+      double solve_time = wallTime() - start_time;
+      if((best_time < 0) || (solve_time < best_time))
+	best_time = solve_time;
+
+      if(r == 0) {
+	ofs = problem->getOFNUM();
+	pieces = 0;
+	for(unsigned int i=0; i<ofs; i++)
+	  pieces += problem->getOF(i)->size();
+	solved[s] = (problem->getMaxBox() != 0);
+	for(unsigned int d=0; solved[s] && (d<dsize); d++)
+	  decision[s].push_back(problem->getResult(domain.getVarName(d)));
+	if(solved[s])
+	  weight[s] = problem->getMaxWT();
+      }
+      delete(problem);
+    }
+    times[s] = best_time;
+  }
+  if(ofs == 0)
+    return;
+
+  m_ivp_times.push_back(times[0]);
+  m_dense_times.push_back(times[1]);
+  m_total_ofs    += ofs;
+  m_total_pieces += pieces;
+  m_total_points += DenseProblem::domainPoints(domain);
+  if(DenseProblem::preferred(domain, ofs, pieces)) {
+    m_auto_dense++;
+    m_auto_times.push_back(times[1]);
+  }
+  else
+    m_auto_times.push_back(times[0]);
+
+  bool same_point = (solved[0] == solved[1]);
+  for(unsigned int d=0; same_point && solved[0] && (d<dsize); d++)
+    if(decision[0][d] != decision[1][d])
+      same_point = false;
+
+  double tolerance = 1e-6 * (1 + fabs(weight[0]));
+  if(same_point)
+    m_same_point++;
+  else if(solved[0] && solved[1] && (fabs(weight[0]-weight[1]) <= tolerance))
+    m_same_weight++;
+  else
+    m_differ++;
+
+  if(m_verbose || (!same_point && (fabs(weight[0]-weight[1]) > tolerance))) {
+    cout << "iter " << iter << ": ofs=" << ofs << " pieces=" << pieces;
+    for(int s=0; s<2; s++) {
+      cout << (s==0 ? "  ivp(" : "  dense(");
+      for(unsigned int d=0; d<decision[s].size(); d++) {
+	if(d > 0)
+	  cout << ",";
+	cout << doubleToStringX(decision[s][d], 4);
+      }
+      cout << ")=" << doubleToStringX(weight[s], 6);
+      cout << " " << doubleToString(times[s]*1000000, 1) << "us";
+    }
+    cout << endl;
+  }
+}
+
+//--------------------------------------------------------
+// Procedure: printReport
+
+void SolverBench::printReport() const
+{
+  unsigned int sets = m_ivp_times.size();
+  cout << endl;
+  cout << "IvP problems solved:   " << sets << endl;
+  if(sets == 0) {
+    cout << "  (No BHV_IPF postings found. Is the helm IPF reporting on,";
+    cout << " and BHV_IPF logged?)" << endl;
+    return;
+  }
+  
+  double dsets = (double)(sets);
+  cout << "Functions per problem: " << doubleToString(m_total_ofs/dsets, 1);
+  cout << endl;
+  cout << "Pieces per problem:    " << doubleToString(m_total_pieces/dsets, 1);
+  cout << endl;
+  cout << "Domain points:         " << doubleToString(m_total_points/dsets, 0);
+  cout << endl << endl;
+
+  cout << "Solve time (us), best of " << m_reps << ":" << endl;
+  cout << "  Solver           mean       p50       p99       max" << endl;
+  for(int s=0; s<3; s++) {
+    vector<double> times = m_ivp_times;
+    if(s == 1)
+      times = m_dense_times;
+    else if(s == 2)
+      times = m_auto_times;
+    sort(times.begin(), times.end());
+    double total = 0;
+    for(unsigned int i=0; i<times.size(); i++)
+      total += times[i];
+    string label = "  IvPProblem   ";
+    if(s == 1)
+      label = "  DenseProblem ";
+    else if(s == 2)
+      label = "  auto         ";
+    cout << label;
+    cout << padString(doubleToString(1000000*total/dsets, 1), 10);
+    cout << padString(doubleToString(1000000*percentile(times, 0.5), 1), 10);
+    cout << padString(doubleToString(1000000*percentile(times, 0.99), 1), 10);
+    cout << padString(doubleToString(1000000*times.back(), 1), 10);
+    cout << endl;
+  }
+  cout << endl;
+
+  cout << "Decisions at the same point:     " << m_same_point  << endl;
+  cout << "Decisions tied in weight:        " << m_same_weight << endl;
+  cout << "Decisions differing:             " << m_differ      << endl;
+  cout << "Problems auto solved densely:    " << m_auto_dense  << endl;
+}
@@ -0,0 +1,89 @@
+/*****************************************************************/
+/*    NAME: MOOS-IvP contributors                                */
+/*    ORGN: Dept of Mechanical Eng / CSAIL, MIT Cambridge MA     */
+/*    FILE: SolverBench.h                                        */
+/*    DATE: Oct 18th 2026                                        */
+/*                                                               */
+/* This file is part of MOOS-IvP                                 */
+/*                                                               */
+/* MOOS-IvP is free software: you can redistribute it and/or     */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation, either version  */
+/* 3 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* MOOS-IvP is distributed in the hope that it will be useful,   */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty   */
+/* of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See  */
+/* the GNU General Public License for more details.              */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with MOOS-IvP.  If not, see                     */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+#ifndef ALOG_SOLVER_BENCH_HEADER
+#define ALOG_SOLVER_BENCH_HEADER
+
+#include <vector>
+#include <string>
+#include <map>
+#include "IvPDomain.h"
+#include "Problem.h"
+#include "Demuxer.h"
+
+//--------------------------------------------------------
+// SolverBench re-solves the IvP problems of a logged mission.
+// The IvP functions reported by the helm (BHV_IPF) are grouped 
+// by the helm iteration given in their context string, and each
+// group is solved by both IvPProblem (branch and bound) and
+// DenseProblem. Decisions are compared and solve times reported.
+
+class SolverBench
+{
+ public:
+  SolverBench();
+  ~SolverBench() {}
+
+  void setReps(unsigned int v)   {if(v>0) m_reps=v;}
+  void setVerbose(bool v=true)   {m_verbose=v;}
+
+  void addIPF(const std::string&);
+  void setHelmDomain(const std::string&);
+  unsigned int size() const      {return(m_sets.size());}
+
+  void solveAll();
+  void printReport() const;
+
+ protected:
+  void      solveSet(unsigned int iter, const std::vector<std::string>&);
+  IvPDomain setDomain(const std::vector<std::string>&) const;
+  Problem*  buildProblem(const std::vector<std::string>&, 
+			 const IvPDomain&, bool dense) const;
+
+ protected: // Configuration
+  unsigned int m_reps;
+  bool         m_verbose;
+
+ protected: // State
+  IvPDomain    m_helm_domain;
+  Demuxer      m_demuxer;
+
+  // Logged IvP function strings, keyed on helm iteration
+  std::map<unsigned int, std::vector<std::string> > m_sets;
+
+  // Results, one entry per set solved
+  std::vector<double> m_ivp_times;
+  std::vector<double> m_dense_times;
+  std::vector<double> m_auto_times;
+
+  unsigned int m_total_ofs;
+  unsigned int m_total_pieces;
+  unsigned int m_total_points;
+  unsigned int m_auto_dense;
+
+  unsigned int m_same_point;
+  unsigned int m_same_weight;
+  unsigned int m_differ;
+};
+
+#endif 
@@ -56,6 +56,12 @@ int main(int argc, char *argv[])
     cout << "  -l,--life     Show report on IvP Helm Life Events        " << endl;
     cout << "  -b,--bhvs     Show helm behavior state changes           " << endl;
     cout << "  -m,--modes    Show helm mode changes                     " << endl;
+    cout << "  -s,--solve    Re-solve logged IvP functions (BHV_IPF) with" << endl;
+    cout << "                both IvP solvers, compare and time them    " << endl;
+    cout << "  -c,--codec    Encode and decode logged IvP functions in  " << endl;
+    cout << "                each string form, check the round trip and" << endl;
+    cout << "                time it. Exits non-zero on a mismatch.     " << endl;
+    cout << "  --reps=N      Solve (or encode) N times, report best     " << endl;
     cout << "  --watch=bhv   Watch a particular behavior for state change" << endl;
     cout << "  --nocolor     Turn off use of color coding               " << endl;
     cout << "  --notrunc     Don't truncate MOOSVAR output (on by default)" << endl;
@@ -79,6 +85,9 @@ int main(int argc, char *argv[])
   bool report_bhv_changes  = false;
   bool report_life_events  = false;
   bool report_mode_changes = false;
+  bool report_solvers      = false;
+  bool report_codecs       = false;
+  unsigned int solve_reps  = 1;
 
   bool use_colors = true;
   bool var_trunc  = true;
@@ -91,6 +100,12 @@ int main(int argc, char *argv[])
       report_mode_changes = true;
     else if((argi == "-l") || (argi == "--life"))
       report_life_events = true;
+    else if((argi == "-s") || (argi == "--solve"))
+      report_solvers = true;
+    else if((argi == "-c") || (argi == "--codec"))
+      report_codecs = true;
+    else if(strBegins(argi, "--reps="))
+      solve_reps = atoi(argi.substr(7).c_str());
     else if((argi == "-l") || (argi == "--notrunc"))
       var_trunc = false;
     else if(strBegins(argi, "--watch="))
@@ -115,6 +130,11 @@ int main(int argc, char *argv[])
     hreporter.reportModeChanges();
   if(report_bhv_changes)
     hreporter.reportBehaviorChanges();
+  if(report_solvers)
+    hreporter.reportSolvers();
+  if(report_codecs)
+    hreporter.reportCodecs();
+  hreporter.setSolveReps(solve_reps);
   if(watch_behavior != "")
     hreporter.setWatchBehavior(watch_behavior);
 
@@ -129,6 +149,10 @@ int main(int argc, char *argv[])
   
   if(handled)
     hreporter.printReport();
+
+  if(report_codecs && !hreporter.codecsPassed())
+    return(1);
+  return(0);
 }
 
 
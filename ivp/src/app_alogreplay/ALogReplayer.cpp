@@ -0,0 +1,375 @@
+/*****************************************************************/
+/*    NAME: MOOS-IvP contributors                                */
+/*    ORGN: Dept of Mechanical Eng / CSAIL, MIT Cambridge MA     */
+/*    FILE: ALogReplayer.cpp                                     */
+/*    DATE: Oct 18th 2026                                        */
+/*                                                               */
+/* This file is part of MOOS-IvP                                 */
+/*                                                               */
+/* MOOS-IvP is free software: you can redistribute it and/or     */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation, either version  */
+/* 3 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* MOOS-IvP is distributed in the hope that it will be useful,   */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty   */
+/* of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See  */
+/* the GNU General Public License for more details.              */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with MOOS-IvP.  If not, see                     */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+
+#include <cstdlib>
+#include <iostream>
+#include <algorithm>
+#include "MBUtils.h"
+#include "LogUtils.h"
+#include "ALogReplayer.h"
+#include "USM_MOOSApp.h"
+#include "HelmIvP.h"
+#include "MarinePID.h"
+#include "NodeReporter.h"
+#include "BasicContactMgr.h"
+#include "ProcessWatch.h"
+#include "TS_MOOSApp.h"
+
+using namespace std;
+
+//--------------------------------------------------------
+// Procedure: Constructor
+
+ALogReplayer::ALogReplayer()
+{
+  m_app      = 0;
+  m_outfile  = 0;
+  m_logstart = 0;
+  m_boundary = 0;
+
+  m_registrations = 0;
+
+  m_total_records = 0;
+  m_total_mail    = 0;
+  m_total_steps   = 0;
+  m_total_output  = 0;
+  m_replay_time   = 0;
+  m_wall_time     = 0;
+}
+
+//--------------------------------------------------------
+// Procedure: Destructor
+
+ALogReplayer::~ALogReplayer()
+{
+  delete(m_app);
+  if(m_outfile)
+    fclose(m_outfile);
+}
+
+//--------------------------------------------------------
+// Procedure: setALogFile
+
+bool ALogReplayer::setALogFile(const string& alogfile)
+{
+  FILE *f = fopen(alogfile.c_str(), "r");
+  if(!f)
+    return(false);
+  fclose(f);
+
+  m_alog_file = alogfile;
+  return(true);
+}
+
+//--------------------------------------------------------
+// Procedure: setAppType
+//   Returns: false if the app type is not one that can be hosted
+
+bool ALogReplayer::setAppType(const string& app_type)
+{
+  CMOOSApp *app = newApp(app_type);
+  if(!app)
+    return(false);
+
+  delete(m_app);
+  m_app = app;
+  m_app_type = app_type;
+  return(true);
+}
+
+//--------------------------------------------------------
+// Procedure: setOutFile
+
+bool ALogReplayer::setOutFile(const string& outfile)
+{
+  if(m_outfile)
+    fclose(m_outfile);
+
+  m_outfile = fopen(outfile.c_str(), "w");
+  return(m_outfile != 0);
+}
+
+//--------------------------------------------------------
+// Procedure: newApp
+
+CMOOSApp* ALogReplayer::newApp(const string& app_type) const
+{
+  if(app_type == "uSimMarine")
+    return(new USM_MOOSApp);
+  else if(app_type == "pHelmIvP")
+    return(new HelmIvP);
+  else if(app_type == "pMarinePID")
+    return(new MarinePID);
+  else if(app_type == "pNodeReporter")
+    return(new NodeReporter);
+  else if(app_type == "pBasicContactMgr")
+    return(new BasicContactMgr);
+  else if(app_type == "uProcessWatch")
+    return(new ProcessWatch);
+  else if(app_type == "uTimerScript")
+    return(new TS_MOOSApp);
+
+  return(0);
+}
+
+//--------------------------------------------------------
+// Procedure: replay
+//   Purpose: Start the app at the time of the first record and
+//            step it once per AppTick until the last record.
+
+bool ALogReplayer::replay()
+{
+  if(!m_app || (m_alog_file == ""))
+    return(false);
+
+  if(!m_index.open(m_alog_file)) {
+    cout << "Unable to index the alog file: " << m_alog_file << endl;
+    return(false);
+  }
+
+  if(m_app_name == "")
+    m_app_name = m_app_type;
+
+  m_logstart = m_index.getLogStart();
+
+  unsigned int vsize = m_index.getVarNames().size();
+  m_var_active.assign(vsize, false);
+
+  unsigned int rsize = m_index.size();
+  double start_time = 0;
+  double end_time   = 0;
+  if(rsize > 0) {
+    start_time = m_index.getTime(0);
+    end_time   = m_index.getTime(rsize-1);
+  }
+
+  if(m_outfile) {
+    string bar(59, '%');
+    fprintf(m_outfile, "%s\n", bar.c_str());
+    fprintf(m_outfile, "%%%% REPLAY OF:      %s\n", m_alog_file.c_str());
+    fprintf(m_outfile, "%%%% REPLAYED APP:   %s\n", m_app_name.c_str());
+    fprintf(m_outfile, "%%%% LOGSTART        %20.12g\n", m_logstart);
+    fprintf(m_outfile, "%s\n", bar.c_str());
+  }
+
+  double wall_start = MOOSLocalTime(false);
+
+  if(!m_app->StartHeadless(m_app_name, m_mission_file,
+			   m_logstart + start_time))
+    return(false);
+
+  double period = m_app->GetHeadlessPeriod();
+
+  MOOSMSG_LIST output;
+  m_app->FetchHeadlessOutput(output);
+  handleOutput(output);
+  activateVars();
+
+  bool ok = true;
+  double curr_time = start_time;
+  while(ok && (curr_time <= end_time)) {
+    while((m_boundary < (long)(rsize)) && 
+	  (m_index.getTime(m_boundary) <= curr_time))
+      m_boundary++;
+
+    MOOSMSG_LIST mail;
+    collectMail(mail);
+    m_total_mail += mail.size();
+
+    ok = m_app->HeadlessStep(m_logstart + curr_time, mail, true);
+    m_total_steps++;
+
+    output.clear();
+    m_app->FetchHeadlessOutput(output);
+    handleOutput(output);
+
+    if(m_app->GetHeadlessRegistrationCount() != m_registrations)
+      activateVars();
+
+    // Count steps rather than accumulate the period, to not drift
+    curr_time = start_time + (m_total_steps * period);
+  }
+
+  m_replay_time = curr_time - start_time;
+  m_wall_time   = MOOSLocalTime(false) - wall_start;
+
+  if(m_outfile) {
+    fclose(m_outfile);
+    m_outfile = 0;
+  }
+  return(true);
+}
+
+//--------------------------------------------------------
+// Procedure: activateVars
+//   Purpose: Begin merging the records of any variable the app has
+//            newly registered for. Records already past are skipped
+//            but for the latest one, handed over as a MOOSDB would.
+
+void ALogReplayer::activateVars()
+{
+  m_registrations = m_app->GetHeadlessRegistrationCount();
+
+  const vector<string>& vars = m_index.getVarNames();
+  for(unsigned int i=0; i<vars.size(); i++) {
+    if(m_var_active[i] || !m_app->WantsHeadlessMail(vars[i], ""))
+      continue;
+    m_var_active[i] = true;
+
+    const vector<long>& recs = m_index.getVarRecords(vars[i]);
+    unsigned int pos;
+    pos = lower_bound(recs.begin(), recs.end(), m_boundary) - recs.begin();
+
+    // The latest value not posted by the app itself
+    for(unsigned int j=pos; j>0; j--) {
+      string src = getSourceNameNoAux(m_index.getRecordLine(recs[j-1]));
+      if(src != m_app_name) {
+	addRecordMail(recs[j-1], m_loopback);
+	break;
+      }
+    }
+
+    if(pos < recs.size()) {
+      unsigned int slot = m_cursor_recs.size();
+      m_cursor_recs.push_back(&recs);
+      m_cursor_pos.push_back(pos);
+      m_heap.push(make_pair(recs[pos], slot));
+    }
+  }
+}
+
+//--------------------------------------------------------
+// Procedure: collectMail
+//   Purpose: Gather the mail due up to the current boundary, both
+//            the app's own postings it wants back and logged records
+//            of registered variables, the latter in record order.
+
+void ALogReplayer::collectMail(MOOSMSG_LIST& mail)
+{
+  MOOSMSG_LIST::iterator p;
+  for(p=m_loopback.begin(); p!=m_loopback.end(); p++) {
+    if(m_app->WantsHeadlessMail(p->GetKey(), p->GetSource()))
+      mail.push_back(*p);
+  }
+  m_loopback.clear();
+
+  while(!m_heap.empty() && (m_heap.top().first < m_boundary)) {
+    long ix = m_heap.top().first;
+    unsigned int slot = m_heap.top().second;
+    m_heap.pop();
+
+    addRecordMail(ix, mail);
+
+    unsigned int pos = ++m_cursor_pos[slot];
+    if(pos < m_cursor_recs[slot]->size())
+      m_heap.push(make_pair((*m_cursor_recs[slot])[pos], slot));
+  }
+}
+
+//--------------------------------------------------------
+// Procedure: addRecordMail
+//      Note: Values that read as numbers are handed over as doubles
+//            since the alog does not note the type of a posting.
+
+void ALogReplayer::addRecordMail(long ix, MOOSMSG_LIST& mail)
+{
+  string line = m_index.getRecordLine(ix);
+  string src  = getSourceName(line);
+  string src_aux;
+  if(strContains(src, ':')) {
+    src_aux = src;
+    src = biteString(src_aux, ':');
+  }
+  if(src == m_app_name)
+    return;
+
+  string var = getVarName(line);
+  if(!m_app->WantsHeadlessMail(var, src))
+    return;
+
+  double time = m_logstart + m_index.getTime(ix);
+  string sval = stripBlankEnds(getDataEntry(line));
+
+  if(isNumber(sval)) {
+    CMOOSMsg msg(MOOS_NOTIFY, var, atof(sval.c_str()), time);
+    msg.m_sSrc = src;
+    msg.SetSourceAux(src_aux);
+    mail.push_back(msg);
+  }
+  else {
+    CMOOSMsg msg(MOOS_NOTIFY, var, sval, time);
+    msg.m_sSrc = src;
+    msg.SetSourceAux(src_aux);
+    mail.push_back(msg);
+  }
+  m_total_records++;
+}
+
+//--------------------------------------------------------
+// Procedure: handleOutput
+//   Purpose: Log the postings of the app in the format of pLogger
+//            and keep them to be handed back on the next step.
+
+void ALogReplayer::handleOutput(MOOSMSG_LIST& output)
+{
+  MOOSMSG_LIST::iterator p;
+  for(p=output.begin(); p!=output.end(); p++) {
+    m_total_output++;
+    if(!m_outfile)
+      continue;
+    string src = p->GetSource();
+    if(p->GetSourceAux() != "")
+      src += ":" + p->GetSourceAux();
+    fprintf(m_outfile, "%-15.3f %-20s %-15s %s \n",
+	    p->GetTime() - m_logstart, p->GetKey().c_str(), src.c_str(),
+	    p->GetAsString(12, 5).c_str());
+  }
+  m_loopback.splice(m_loopback.end(), output);
+}
+
+//--------------------------------------------------------
+// Procedure: printReport
+
+void ALogReplayer::printReport() const
+{
+  double msgs_per_sec = 0;
+  double speedup = 0;
+  if(m_wall_time > 0) {
+    msgs_per_sec = (double)(m_total_mail) / m_wall_time;
+    speedup = m_replay_time / m_wall_time;
+  }
+
+  cout << "Replayed " << m_alog_file << " into " << m_app_name;
+  cout << " (" << m_app_type << ")" << endl;
+  cout << "  Log time replayed:  " << doubleToString(m_replay_time, 1);
+  cout << " secs" << endl;
+  cout << "  Wall time:          " << doubleToString(m_wall_time, 3);
+  cout << " secs (" << doubleToString(speedup, 0) << "x)" << endl;
+  cout << "  Records delivered:  " << uintToCommaString(m_total_records) << endl;
+  cout << "  Mail delivered:     " << uintToCommaString(m_total_mail) << endl;
+  cout << "  App steps:          " << uintToCommaString(m_total_steps) << endl;
+  cout << "  Postings by app:    " << uintToCommaString(m_total_output) << endl;
+  cout << "  Throughput:         " << uintToCommaString((unsigned int)(msgs_per_sec));
+  cout << " msgs/sec" << endl;
+}
@@ -0,0 +1,115 @@
+/*****************************************************************/
+/*    NAME: MOOS-IvP contributors                                */
+/*    ORGN: Dept of Mechanical Eng / CSAIL, MIT Cambridge MA     */
+/*    FILE: ALogReplayer.h                                       */
+/*    DATE: Oct 18th 2026                                        */
+/*                                                               */
+/* This file is part of MOOS-IvP                                 */
+/*                                                               */
+/* MOOS-IvP is free software: you can redistribute it and/or     */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation, either version  */
+/* 3 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* MOOS-IvP is distributed in the hope that it will be useful,   */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty   */
+/* of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See  */
+/* the GNU General Public License for more details.              */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with MOOS-IvP.  If not, see                     */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+
+#ifndef ALOG_REPLAYER_HEADER
+#define ALOG_REPLAYER_HEADER
+
+#include <string>
+#include <vector>
+#include <queue>
+#include <functional>
+#include <cstdio>
+#include "MOOS/libMOOS/MOOSLib.h"
+#include "ALogIndex.h"
+
+//---------------------------------------------------------------
+// ALogReplayer feeds the mail logged in an alog file directly into
+// an app hosted in this process, driven headless (no MOOSDB and no
+// sockets) on a virtual clock, as fast as the app can take it. The
+// app is stepped once per AppTick of log time. Before each step it
+// is handed every logged posting up to that time of a variable it
+// has registered for, and any of its own postings it registered
+// for. Postings made by the app are written to an output alog.
+//
+// Only the records of variables registered for are read, found by
+// merging their lists from the alog index. When the app registers
+// for a new variable it is also handed the latest posting before
+// now, as a MOOSDB would. Records posted by the app itself in the
+// logged mission are not replayed.
+//
+// Replay is open-loop: the logged mission does not react to what
+// the app now posts.
+
+class ALogReplayer
+{
+ public:
+  ALogReplayer();
+  ~ALogReplayer();
+
+  bool setALogFile(const std::string&);
+  bool setAppType(const std::string&);
+  void setAppName(const std::string& s)     {m_app_name=s;}
+  void setMissionFile(const std::string& s) {m_mission_file=s;}
+  bool setOutFile(const std::string&);
+
+  bool replay();
+  void printReport() const;
+
+ protected:
+  CMOOSApp* newApp(const std::string& app_type) const;
+
+  void   activateVars();
+  void   collectMail(MOOSMSG_LIST& mail);
+  void   addRecordMail(long ix, MOOSMSG_LIST& mail);
+  void   handleOutput(MOOSMSG_LIST& output);
+
+ protected: // Configuration variables
+  std::string  m_alog_file;
+  std::string  m_app_type;
+  std::string  m_app_name;
+  std::string  m_mission_file;
+
+ protected: // State variables
+  ALogIndex    m_index;
+  CMOOSApp*    m_app;
+  FILE*        m_outfile;
+  double       m_logstart;
+
+  // Records [0, m_boundary) are at or before the current time
+  long         m_boundary;
+
+  // Variables whose records are being merged, and their cursors
+  std::vector<bool>                      m_var_active;
+  std::vector<const std::vector<long>*>  m_cursor_recs;
+  std::vector<unsigned int>              m_cursor_pos;
+  unsigned int                           m_registrations;
+
+  // Next record of each merged variable, lowest record index first
+  std::priority_queue<std::pair<long, unsigned int>,
+    std::vector<std::pair<long, unsigned int> >,
+    std::greater<std::pair<long, unsigned int> > > m_heap;
+
+  // Postings by the app to be handed back to it next step
+  MOOSMSG_LIST m_loopback;
+
+ protected: // Results
+  unsigned int m_total_records;
+  unsigned int m_total_mail;
+  unsigned int m_total_steps;
+  unsigned int m_total_output;
+  double       m_replay_time;
+  double       m_wall_time;
+};
+
+#endif
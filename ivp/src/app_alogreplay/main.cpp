@@ -0,0 +1,156 @@
+/*****************************************************************/
+/*    NAME: MOOS-IvP contributors                                */
+/*    ORGN: Dept of Mechanical Eng / CSAIL, MIT Cambridge MA     */
+/*    FILE: main.cpp                                             */
+/*    DATE: Oct 18th 2026                                        */
+/*                                                               */
+/* This file is part of MOOS-IvP                                 */
+/*                                                               */
+/* MOOS-IvP is free software: you can redistribute it and/or     */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation, either version  */
+/* 3 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* MOOS-IvP is distributed in the hope that it will be useful,   */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty   */
+/* of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See  */
+/* the GNU General Public License for more details.              */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with MOOS-IvP.  If not, see                     */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+
+#include <string>
+#include <iostream>
+#include "MBUtils.h"
+#include "ReleaseInfo.h"
+#include "ALogReplayer.h"
+
+using namespace std;
+
+void display_usage();
+
+//--------------------------------------------------------
+// Procedure: main
+
+int main(int argc, char *argv[])
+{
+  // Look for a request for version information
+  if(scanArgs(argc, argv, "-v", "--version", "-version")) {
+    showReleaseInfo("alogreplay", "gpl");
+    return(0);
+  }
+
+  // Look for a request for usage information
+  if(scanArgs(argc, argv, "-h", "--help", "-help")) {
+    display_usage();
+    return(0);
+  }
+
+  bool verbose = true;
+  if(scanArgs(argc, argv, "-q", "--quiet", "-quiet"))
+    verbose = false;
+
+  ALogReplayer replayer;
+
+  string alog_infile;
+  string alog_outfile;
+  string mission_file;
+  string app_type;
+
+  for(int i=1; i<argc; i++) {
+    string argi = argv[i];
+    if(strBegins(argi, "--app="))
+      app_type = argi.substr(6);
+    else if(strBegins(argi, "--name="))
+      replayer.setAppName(argi.substr(7));
+    else if(strEnds(argi, ".moos") || strEnds(argi, ".moos++"))
+      mission_file = argi;
+    else if(strEnds(argi, ".alog")) {
+      if(alog_infile == "")
+	alog_infile = argi;
+      else
+	alog_outfile = argi;
+    }
+  }
+
+  if((alog_infile == "") || (mission_file == "") || (app_type == "")) {
+    display_usage();
+    return(1);
+  }
+
+  if(!replayer.setALogFile(alog_infile)) {
+    cout << "Input file: " << alog_infile << " does not exist." << endl;
+    return(1);
+  }
+  if(!replayer.setAppType(app_type)) {
+    cout << "Unknown app: " << app_type << endl;
+    return(1);
+  }
+  replayer.setMissionFile(mission_file);
+
+  if(alog_outfile != "") {
+    if(!replayer.setOutFile(alog_outfile)) {
+      cout << "Unable to create output file: " << alog_outfile << endl;
+      return(1);
+    }
+  }
+
+  if(!replayer.replay())
+    return(1);
+
+  if(verbose)
+    replayer.printReport();
+
+  return(0);
+}
+
+//--------------------------------------------------------
+// Procedure: display_usage
+
+void display_usage()
+{
+  cout << "Usage: " << endl;
+  cout << "  alogreplay in.alog mission.moos --app=APP [out.alog] [OPTIONS]" << endl;
+  cout << "                                                         " << endl;
+  cout << "Synopsis:                                                " << endl;
+  cout << "  Replay the mail logged in an alog file into an app run " << endl;
+  cout << "  in this process without a MOOSDB, as fast as it can    " << endl;
+  cout << "  take it, on a virtual clock. The app is configured     " << endl;
+  cout << "  from the mission file and stepped once per AppTick of  " << endl;
+  cout << "  log time. Postings made by the app are written to      " << endl;
+  cout << "  out.alog, e.g. to diff the helm against a recorded     " << endl;
+  cout << "  mission after a change.                                " << endl;
+  cout << "                                                         " << endl;
+  cout << "Standard Arguments:                                      " << endl;
+  cout << "  in.alog       - The logfile to replay.                 " << endl;
+  cout << "  mission.moos  - The mission file configuring the app.  " << endl;
+  cout << "  --app=APP     - The app to replay into, one of:        " << endl;
+  cout << "                  pHelmIvP, pMarinePID, pNodeReporter,   " << endl;
+  cout << "                  pBasicContactMgr, uSimMarine,          " << endl;
+  cout << "                  uProcessWatch, uTimerScript.           " << endl;
+  cout << "  out.alog      - File for the postings made by the app. " << endl;
+  cout << "                                                         " << endl;
+  cout << "Options:                                                 " << endl;
+  cout << "  -h,--help     Display this usage/help message.         " << endl;
+  cout << "  -v,--version  Display version information.             " << endl;
+  cout << "  -q,--quiet    Replay report suppressed at conclusion.  " << endl;
+  cout << "  --name=NAME   Name of the app in the mission and in    " << endl;
+  cout << "                the log. Default is APP.                 " << endl;
+  cout << "                                                         " << endl;
+  cout << "Further Notes:                                           " << endl;
+  cout << "  (1) Postings logged by the app itself are not replayed." << endl;
+  cout << "  (2) Replay is open-loop: the logged mission does not   " << endl;
+  cout << "      react to what the app posts now.                   " << endl;
+  cout << "  (3) Logged values that read as numbers are replayed as " << endl;
+  cout << "      doubles, all others as strings.                    " << endl;
+  cout << "  (4) Files named in the mission, e.g. the helm's        " << endl;
+  cout << "      behavior file, are found relative to the current   " << endl;
+  cout << "      directory as when the app is launched normally.    " << endl;
+  cout << "  (5) The alog is read through in.alog.idx if present,  " << endl;
+  cout << "      else an index built in memory. None is written.    " << endl;
+  cout << "  (6) See also: aloggrep, alogclip, aloghelm, uMultiApp  " << endl;
+  cout << endl;
+}
@@ -0,0 +1,62 @@
+/*****************************************************************/
+/*    NAME: MOOS-IvP contributors                                */
+/*    ORGN: Dept of Mechanical Eng / CSAIL, MIT Cambridge MA     */
+/*    FILE: AllocCounter.cpp                                     */
+/*    DATE: Oct 18th 2026                                        */
+/*                                                               */
+/* This file is part of MOOS-IvP                                 */
+/*                                                               */
+/* MOOS-IvP is free software: you can redistribute it and/or     */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation, either version  */
+/* 3 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* MOOS-IvP is distributed in the hope that it will be useful,   */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty   */
+/* of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See  */
+/* the GNU General Public License for more details.              */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with MOOS-IvP.  If not, see                     */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+
+
+#include <cstdlib>
+#include <new>
+#include "AllocCounter.h"
+
+static unsigned long total_alloc_count = 0;
+static unsigned long total_alloc_bytes = 0;
+
+//--------------------------------------------------------
+// Procedure: allocCount, allocBytes
+
+unsigned long allocCount() {return(total_alloc_count);}
+unsigned long allocBytes() {return(total_alloc_bytes);}
+
+//--------------------------------------------------------
+// Procedure: countedAlloc
+
+static void* countedAlloc(size_t size)
+{
+  total_alloc_count++;
+  total_alloc_bytes += size;
+  if(size == 0)
+    size = 1;
+  void *ptr = malloc(size);
+  if(!ptr)
+    throw std::bad_alloc();
+  return(ptr);
+}
+
+//--------------------------------------------------------
+// Replacements of the global allocation functions. The other
+// forms of new and delete are built on these.
+
+void* operator new(size_t size)   {return(countedAlloc(size));}
+void* operator new[](size_t size) {return(countedAlloc(size));}
+
+void operator delete(void *ptr)   {free(ptr);}
+void operator delete[](void *ptr) {free(ptr);}
@@ -0,0 +1,153 @@
+/*****************************************************************/
+/*    NAME: MOOS-IvP contributors                                */
+/*    ORGN: Dept of Mechanical Eng / CSAIL, MIT Cambridge MA     */
+/*    FILE: BenchUtils.cpp                                       */
+/*    DATE: Oct 19th 2026                                        */
+/*                                                               */
+/* This file is part of MOOS-IvP                                 */
+/*                                                               */
+/* MOOS-IvP is free software: you can redistribute it and/or     */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation, either version  */
+/* 3 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* MOOS-IvP is distributed in the hope that it will be useful,   */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty   */
+/* of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See  */
+/* the GNU General Public License for more details.              */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with MOOS-IvP.  If not, see                     */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+
+
+#ifndef _WIN32
+#include <sys/time.h>
+#else
+#include <ctime>
+#endif
+#include <iostream>
+#include <fstream>
+#include <algorithm>
+#include "BenchUtils.h"
+#include "MBUtils.h"
+
+using namespace std;
+
+//--------------------------------------------------------
+// Procedure: wallTime
+//      Note: MBTimer only resolves clock ticks, too coarse for
+//            timing a single decision.
+
+double wallTime()
+{
+#ifndef _WIN32
+  struct timeval tv;
+  gettimeofday(&tv, 0);
+  return((double)(tv.tv_sec) + ((double)(tv.tv_usec) / 1000000.0));
+#else
+  return((double)(clock()) / CLOCKS_PER_SEC);
+#endif
+}
+
+//--------------------------------------------------------
+// Procedure: percentile
+//      Note: Given values must be sorted.
+
+double percentile(const vector<double>& vals, double pct)
+{
+  if(vals.size() == 0)
+    return(0);
+  unsigned int ix = (unsigned int)(pct * (double)(vals.size()-1) + 0.5);
+  return(vals[ix]);
+}
+
+//--------------------------------------------------------
+// Procedure: mean
+
+double mean(const vector<double>& vals)
+{
+  if(vals.size() == 0)
+    return(0);
+  double total = 0;
+  for(unsigned int i=0; i<vals.size(); i++)
+    total += vals[i];
+  return(total / (double)(vals.size()));
+}
+
+//--------------------------------------------------------
+// Procedure: addStats
+//   Purpose: Add the distribution of the given values to a report
+//            as the entries key.p50, key.p99, key.max and key.mean.
+//            Values are scaled, e.g. seconds to microseconds.
+
+void addStats(vector<pair<string, string> >& report,
+	      const string& key, vector<double> vals,
+	      double scale, int digits)
+{
+  sort(vals.begin(), vals.end());
+  double vmax = (vals.size() > 0) ? vals.back() : 0;
+  report.push_back(make_pair(key + ".p50", 
+			     doubleToString(scale*percentile(vals,0.5),digits)));
+  report.push_back(make_pair(key + ".p99", 
+			     doubleToString(scale*percentile(vals,0.99),digits)));
+  report.push_back(make_pair(key + ".max", 
+			     doubleToString(scale*vmax, digits)));
+  report.push_back(make_pair(key + ".mean", 
+			     doubleToString(scale*mean(vals), digits)));
+}
+
+//--------------------------------------------------------
+// Procedure: printBenchReport
+
+void printBenchReport(const vector<pair<string, string> >& report,
+		      const string& title)
+{
+  cout << endl << title << endl;
+  cout << "--------------------------------------------------------";
+  cout << endl;
+
+  // Distributions are reported on one line: p50, p99, max, mean
+  bool header_done = false;
+  for(unsigned int i=0; i<report.size(); i++) {
+    string key = report[i].first;
+    if(!strEnds(key, ".p50")) {
+      cout << padString(key, 36, false) << report[i].second << endl;
+      continue;
+    }
+    if((i+3) >= report.size())
+      break;
+    if(!header_done) {
+      cout << endl << padString("", 36, false) << padString("p50", 11);
+      cout << padString("p99", 11) << padString("max", 11);
+      cout << padString("mean", 11) << endl;
+      header_done = true;
+    }
+    key = key.substr(0, key.length()-4);
+    cout << padString(key, 36, false);
+    for(unsigned int j=0; j<4; j++)
+      cout << padString(report[i+j].second, 11);
+    cout << endl;
+    i += 3;
+  }
+  cout << endl;
+}
+
+//--------------------------------------------------------
+// Procedure: writeBenchReport
+//   Purpose: Write the results for trend tracking, one key=value
+//            per line, keys being stable across runs.
+
+bool writeBenchReport(const vector<pair<string, string> >& report,
+		      const string& filename)
+{
+  ofstream fout(filename.c_str());
+  if(!fout)
+    return(false);
+
+  for(unsigned int i=0; i<report.size(); i++)
+    fout << report[i].first << "=" << report[i].second << endl;
+  return(true);
+}
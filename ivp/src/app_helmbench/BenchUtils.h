@@ -0,0 +1,49 @@
+/*****************************************************************/
+/*    NAME: MOOS-IvP contributors                                */
+/*    ORGN: Dept of Mechanical Eng / CSAIL, MIT Cambridge MA     */
+/*    FILE: BenchUtils.h                                         */
+/*    DATE: Oct 19th 2026                                        */
+/*                                                               */
+/* This file is part of MOOS-IvP                                 */
+/*                                                               */
+/* MOOS-IvP is free software: you can redistribute it and/or     */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation, either version  */
+/* 3 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* MOOS-IvP is distributed in the hope that it will be useful,   */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty   */
+/* of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See  */
+/* the GNU General Public License for more details.              */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with MOOS-IvP.  If not, see                     */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+
+
+#ifndef HELMBENCH_BENCH_UTILS_HEADER
+#define HELMBENCH_BENCH_UTILS_HEADER
+
+#include <vector>
+#include <string>
+
+//--------------------------------------------------------
+// Timing and reporting shared by the helmbench suites. A report
+// is a list of key,value pairs in the order reported.
+
+double wallTime();
+double percentile(const std::vector<double>& sorted_vals, double pct);
+double mean(const std::vector<double>&);
+
+void   addStats(std::vector<std::pair<std::string, std::string> >& report,
+		const std::string& key, std::vector<double> vals,
+		double scale=1, int digits=1);
+
+void   printBenchReport(const std::vector<std::pair<std::string, std::string> >&,
+			const std::string& title);
+bool   writeBenchReport(const std::vector<std::pair<std::string, std::string> >&,
+			const std::string& filename);
+
+#endif
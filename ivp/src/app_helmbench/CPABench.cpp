@@ -0,0 +1,325 @@
+/*****************************************************************/
+/*    NAME: MOOS-IvP contributors                                */
+/*    ORGN: Dept of Mechanical Eng / CSAIL, MIT Cambridge MA     */
+/*    FILE: CPABench.cpp                                         */
+/*    DATE: Oct 19th 2026                                        */
+/*                                                               */
+/* This file is part of MOOS-IvP                                 */
+/*                                                               */
+/* MOOS-IvP is free software: you can redistribute it and/or     */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation, either version  */
+/* 3 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* MOOS-IvP is distributed in the hope that it will be useful,   */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty   */
+/* of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See  */
+/* the GNU General Public License for more details.              */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with MOOS-IvP.  If not, see                     */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+
+
+#include <cmath>
+#include <algorithm>
+#include "CPABench.h"
+#include "BenchUtils.h"
+#include "AllocCounter.h"
+#include "AOF_AvoidCollision.h"
+#include "AOF_CutRangeCPA.h"
+#include "OF_Reflector.h"
+#include "IvPFunction.h"
+#include "PDMap.h"
+#include "IvPBox.h"
+#include "BuildUtils.h"
+#include "MBUtils.h"
+
+using namespace std;
+
+//--------------------------------------------------------
+// PointAOF hides the evalGrid() of the AOF it wraps, so a build
+// samples it through evalBox() one point at a time as before.
+
+class PointAOF : public AOF {
+public:
+  PointAOF(const AOF* aof) : AOF(aof->getDomain()) {m_aof=aof;}
+  ~PointAOF() {}
+
+  double evalBox(const IvPBox* box) const {return(m_aof->evalBox(box));}
+
+protected:
+  const AOF* m_aof;
+};
+
+//--------------------------------------------------------
+// Procedure: samePDMaps
+//   Purpose: True if both maps hold the same boxes, in the same 
+//            order, with the same bounds and weights.
+
+static bool samePDMaps(PDMap *pdmap_a, PDMap *pdmap_b)
+{
+  if(!pdmap_a || !pdmap_b)
+    return(pdmap_a == pdmap_b);
+  if(pdmap_a->size() != pdmap_b->size())
+    return(false);
+
+  for(int i=0; i<pdmap_a->size(); i++) {
+    const IvPBox *box_a = pdmap_a->bx(i);
+    const IvPBox *box_b = pdmap_b->bx(i);
+    if(box_a->getDim() != box_b->getDim())
+      return(false);
+    for(int d=0; d<box_a->getDim(); d++) {
+      if((box_a->pt(d,0) != box_b->pt(d,0)) ||
+	 (box_a->pt(d,1) != box_b->pt(d,1)))
+	return(false);
+    }
+    if(box_a->getWtc() != box_b->getWtc())
+      return(false);
+    for(int w=0; w<box_a->getWtc(); w++)
+      if(box_a->wt(w) != box_b->wt(w))
+	return(false);
+  }
+  return(true);
+}
+
+//--------------------------------------------------------
+// Constructor
+
+CPABench::CPABench()
+{
+  m_reps       = 1;
+  m_mismatches = 0;
+
+  m_domain.addDomain("course", 0, 359, 360);
+  m_domain.addDomain("speed", 0, 4, 21);
+
+  // Build info as set by the behaviors using each AOF
+  m_types.push_back("avoid");
+  m_build_info["avoid"] = "uniform_piece = discrete @ course:3,speed:3 # "
+    "uniform_grid = discrete @ course:9,speed:6";
+  m_types.push_back("cutrange");
+  m_build_info["cutrange"] = "uniform_piece=discrete@course:2,speed:3 # "
+    "uniform_grid =discrete@course:8,speed:6";
+
+  // Contacts near and far, closing, crossing and opening
+  double ranges[]   = {30, 120, 500};
+  double bearings[] = {0, 60, 150, 270};
+  double speeds[]   = {1.5, 2.0, 3.0, 0.5};
+  for(unsigned int i=0; i<3; i++) {
+    for(unsigned int j=0; j<4; j++) {
+      m_cn_range.push_back(ranges[i]);
+      m_cn_bearing.push_back(bearings[j]);
+      m_cn_heading.push_back(fmod(bearings[j] + 180 + (i*40), 360));
+      m_cn_speed.push_back(speeds[j]);
+    }
+  }
+}
+
+//--------------------------------------------------------
+// Procedure: run
+
+void CPABench::run()
+{
+  for(unsigned int rep=0; rep<m_reps; rep++) {
+    for(unsigned int i=0; i<m_types.size(); i++) {
+      for(unsigned int g=0; g<m_cn_range.size(); g++) {
+	AOF *aof = makeAOF(m_types[i], g);
+	if(!aof) {
+	  m_mismatches++;
+	  continue;
+	}
+	runPoints(m_types[i], aof);
+	runBuild(m_types[i], aof);
+	delete(aof);
+      }
+    }
+  }
+}
+
+//--------------------------------------------------------
+// Procedure: makeAOF
+//   Purpose: An initialized AOF of the given type for the given
+//            contact geometry, or null. Ownship is at the origin.
+
+AOF* CPABench::makeAOF(const string& type, unsigned int g) const
+{
+  double rads = m_cn_bearing[g] * M_PI / 180.0;
+  double cnx  = m_cn_range[g] * sin(rads);
+  double cny  = m_cn_range[g] * cos(rads);
+
+  if(type == "avoid") {
+    AOF_AvoidCollision *aof = new AOF_AvoidCollision(m_domain);
+    aof->setOwnshipParams(0, 0);
+    aof->setContactParams(cnx, cny, m_cn_heading[g], m_cn_speed[g]);
+    aof->setParam("tol", 60);
+    aof->setParam("collision_distance", 10);
+    aof->setParam("all_clear_distance", 75);
+    if(aof->initialize())
+      return(aof);
+    delete(aof);
+  }
+  else if(type == "cutrange") {
+    AOF_CutRangeCPA *aof = new AOF_CutRangeCPA(m_domain);
+    aof->setParam("cnlat", cny);
+    aof->setParam("cnlon", cnx);
+    aof->setParam("cncrs", m_cn_heading[g]);
+    aof->setParam("cnspd", m_cn_speed[g]);
+    aof->setParam("oslat", 0);
+    aof->setParam("oslon", 0);
+    aof->setParam("tol", 60);
+    aof->setParam("patience", 50);
+    if(aof->initialize())
+      return(aof);
+    delete(aof);
+  }
+  return(0);
+}
+
+//--------------------------------------------------------
+// Procedure: runPoints
+//   Purpose: Evaluate every point of the domain through evalBox()
+//            and then through one evalGrid() call, and compare.
+
+void CPABench::runPoints(const string& type, const AOF* aof)
+{
+  unsigned int crs_pts = m_domain.getVarPoints(0);
+  unsigned int spd_pts = m_domain.getVarPoints(1);
+
+  vector<double> box_vals(crs_pts * spd_pts, 0);
+  IvPBox box(2);
+
+  unsigned long allocs = allocCount();
+  double start_time = wallTime();
+  for(unsigned int s=0; s<spd_pts; s++) {
+    box.pt(1,0) = box.pt(1,1) = s;
+    for(unsigned int c=0; c<crs_pts; c++) {
+      box.pt(0,0) = box.pt(0,1) = c;
+      box_vals[c + (s * crs_pts)] = aof->evalBox(&box);
+    }
+  }
+  double time = wallTime() - start_time;
+  allocs = allocCount() - allocs;
+  m_times[type + ".points"].push_back(time);
+  m_allocs[type + ".points"].push_back(allocs);
+
+  vector<vector<int> > grid_pts(2);
+  for(unsigned int c=0; c<crs_pts; c++)
+    grid_pts[0].push_back(c);
+  for(unsigned int s=0; s<spd_pts; s++)
+    grid_pts[1].push_back(s);
+  vector<double> grid_vals;
+
+  allocs = allocCount();
+  start_time = wallTime();
+  bool ok = aof->evalGrid(grid_pts, grid_vals);
+  time = wallTime() - start_time;
+  allocs = allocCount() - allocs;
+  m_times[type + ".grid"].push_back(time);
+  m_allocs[type + ".grid"].push_back(allocs);
+
+  if(!ok || (grid_vals != box_vals))
+    m_mismatches++;
+}
+
+//--------------------------------------------------------
+// Procedure: runBuild
+//   Purpose: Build the IvP function with the behavior's build info
+//            with evalGrid() hidden and then offered, and compare.
+
+void CPABench::runBuild(const string& type, const AOF* aof)
+{
+  PointAOF point_aof(aof);
+  const AOF *aofs[2] = {&point_aof, aof};
+  string paths[2] = {".build_points", ".build_grid"};
+  IvPFunction *ipfs[2] = {0, 0};
+
+  for(unsigned int i=0; i<2; i++) {
+    unsigned long allocs = allocCount();
+    double start_time = wallTime();
+    OF_Reflector reflector(aofs[i], 1);
+    reflector.create(m_build_info[type]);
+    ipfs[i] = reflector.extractIvPFunction();
+    double time = wallTime() - start_time;
+    allocs = allocCount() - allocs;
+    m_times[type + paths[i]].push_back(time);
+    m_allocs[type + paths[i]].push_back(allocs);
+  }
+
+  if(!ipfs[0] || !ipfs[1] || 
+     !samePDMaps(ipfs[0]->getPDMap(), ipfs[1]->getPDMap()))
+    m_mismatches++;
+  if(ipfs[1] && ipfs[1]->getPDMap())
+    m_pieces[type].push_back(ipfs[1]->getPDMap()->size());
+
+  delete(ipfs[0]);
+  delete(ipfs[1]);
+}
+
+//--------------------------------------------------------
+// Procedure: buildReport
+//   Purpose: The results as key,value pairs, in the order reported.
+//            Times are in microseconds. The speedups compare the
+//            p50 times of the point and grid paths.
+
+vector<pair<string, string> > CPABench::buildReport() const
+{
+  vector<pair<string, string> > report;
+  report.push_back(make_pair("domain", domainToString(m_domain)));
+  report.push_back(make_pair("geometries", uintToString(m_cn_range.size())));
+  report.push_back(make_pair("reps", uintToString(m_reps)));
+  report.push_back(make_pair("mismatches", uintToString(m_mismatches)));
+
+  string paths[4] = {"points", "grid", "build_points", "build_grid"};
+  for(unsigned int i=0; i<m_types.size(); i++) {
+    string type = m_types[i];
+    map<string, vector<double> >::const_iterator p;
+    for(unsigned int j=0; j<4; j++) {
+      p = m_times.find(type + "." + paths[j]);
+      if(p != m_times.end())
+	addStats(report, type + "." + paths[j] + "_us", p->second, 1000000);
+      p = m_allocs.find(type + "." + paths[j]);
+      if(p != m_allocs.end())
+	addStats(report, type + "." + paths[j] + "_allocs", p->second);
+    }
+    p = m_pieces.find(type);
+    if(p != m_pieces.end())
+      addStats(report, type + ".pieces", p->second);
+
+    for(unsigned int j=0; j<4; j+=2) {
+      vector<double> slow, fast;
+      if(m_times.count(type + "." + paths[j]))
+	slow = m_times.find(type + "." + paths[j])->second;
+      if(m_times.count(type + "." + paths[j+1]))
+	fast = m_times.find(type + "." + paths[j+1])->second;
+      sort(slow.begin(), slow.end());
+      sort(fast.begin(), fast.end());
+      double fast_p50 = percentile(fast, 0.5);
+      string speedup = "n/a";
+      if(fast_p50 > 0)
+	speedup = doubleToString(percentile(slow, 0.5) / fast_p50, 2);
+      string key = (j==0) ? ".grid_speedup" : ".build_speedup";
+      report.push_back(make_pair(type + key, speedup));
+    }
+  }
+  return(report);
+}
+
+//--------------------------------------------------------
+// Procedure: printReport
+
+void CPABench::printReport() const
+{
+  printBenchReport(buildReport(), "CPA Benchmark: AOF_AvoidCollision, "
+		   "AOF_CutRangeCPA");
+}
+
+//--------------------------------------------------------
+// Procedure: writeReport
+
+bool CPABench::writeReport(const string& filename) const
+{
+  return(writeBenchReport(buildReport(), filename));
+}
@@ -0,0 +1,86 @@
+/*****************************************************************/
+/*    NAME: MOOS-IvP contributors                                */
+/*    ORGN: Dept of Mechanical Eng / CSAIL, MIT Cambridge MA     */
+/*    FILE: CPABench.h                                           */
+/*    DATE: Oct 19th 2026                                        */
+/*                                                               */
+/* This file is part of MOOS-IvP                                 */
+/*                                                               */
+/* MOOS-IvP is free software: you can redistribute it and/or     */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation, either version  */
+/* 3 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* MOOS-IvP is distributed in the hope that it will be useful,   */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty   */
+/* of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See  */
+/* the GNU General Public License for more details.              */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with MOOS-IvP.  If not, see                     */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+
+
+#ifndef HELMBENCH_CPA_BENCH_HEADER
+#define HELMBENCH_CPA_BENCH_HEADER
+
+#include <vector>
+#include <string>
+#include <map>
+#include "IvPDomain.h"
+
+class AOF;
+
+//--------------------------------------------------------
+// CPABench times the CPA objective functions of the collision
+// avoidance and cut-range behaviors over a 360x21 course,speed 
+// domain, for a fixed set of contact geometries. Each AOF is timed
+// point by point through evalBox() against one evalGrid() call over
+// the whole domain, and through an OF_Reflector build, with the
+// behavior's own build_info, with and without evalGrid(). The two
+// paths must agree exactly; disagreements are counted.
+
+class CPABench
+{
+ public:
+  CPABench();
+  ~CPABench() {}
+
+  void setReps(unsigned int v) {if(v>0) m_reps=v;}
+
+  void run();
+  unsigned int mismatches() const {return(m_mismatches);}
+
+  void printReport() const;
+  bool writeReport(const std::string&) const;
+
+ protected:
+  AOF* makeAOF(const std::string& type, unsigned int geometry) const;
+  void runPoints(const std::string& type, const AOF*);
+  void runBuild(const std::string& type, const AOF*);
+
+  std::vector<std::pair<std::string, std::string> > buildReport() const;
+
+ protected:
+  unsigned int m_reps;
+  IvPDomain    m_domain;
+  unsigned int m_mismatches;
+
+  std::vector<std::string> m_types;
+  std::map<std::string, std::string> m_build_info;
+
+  // Contact geometries relative to ownship at the origin
+  std::vector<double> m_cn_range;
+  std::vector<double> m_cn_bearing;
+  std::vector<double> m_cn_heading;
+  std::vector<double> m_cn_speed;
+
+  // Results keyed on AOF type and path, e.g. avoid.grid
+  std::map<std::string, std::vector<double> > m_times;
+  std::map<std::string, std::vector<double> > m_allocs;
+  std::map<std::string, std::vector<double> > m_pieces;
+};
+
+#endif
@@ -0,0 +1,227 @@
+/*****************************************************************/
+/*    NAME: MOOS-IvP contributors                                */
+/*    ORGN: Dept of Mechanical Eng / CSAIL, MIT Cambridge MA     */
+/*    FILE: CoupledBench.cpp                                     */
+/*    DATE: Oct 19th 2026                                        */
+/*                                                               */
+/* This file is part of MOOS-IvP                                 */
+/*                                                               */
+/* MOOS-IvP is free software: you can redistribute it and/or     */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation, either version  */
+/* 3 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* MOOS-IvP is distributed in the hope that it will be useful,   */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty   */
+/* of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See  */
+/* the GNU General Public License for more details.              */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with MOOS-IvP.  If not, see                     */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+
+
+#include <cmath>
+#include <algorithm>
+#include "CoupledBench.h"
+#include "BenchUtils.h"
+#include "ZAIC_PEAK.h"
+#include "OF_Coupler.h"
+#include "IvPProblem.h"
+#include "IvPFunction.h"
+#include "PDMap.h"
+#include "BuildUtils.h"
+#include "MBUtils.h"
+
+using namespace std;
+
+//--------------------------------------------------------
+// Constructor
+
+CoupledBench::CoupledBench()
+{
+  m_reps       = 1;
+  m_mismatches = 0;
+  m_ties       = 0;
+
+  IvPDomain fine;
+  fine.addDomain("course", 0, 359, 360);
+  fine.addDomain("speed", 0, 4, 21);
+  m_labels.push_back("360x21");
+  m_domains.push_back(fine);
+
+  IvPDomain coarse;
+  coarse.addDomain("course", 0, 355, 72);
+  coarse.addDomain("speed", 0, 4, 9);
+  m_labels.push_back("72x9");
+  m_domains.push_back(coarse);
+
+  // Peaks on and between grid points, near and across the wrap
+  double crs[] = {0, 45, 90, 137.5, 180, 271, 359};
+  double spd[] = {0.5, 1.2, 2.0, 3.3};
+  for(unsigned int i=0; i<7; i++) {
+    for(unsigned int j=0; j<4; j++) {
+      m_crs.push_back(crs[i]);
+      m_spd.push_back(spd[j]);
+    }
+  }
+}
+
+//--------------------------------------------------------
+// Procedure: run
+
+void CoupledBench::run()
+{
+  for(unsigned int rep=0; rep<m_reps; rep++)
+    for(unsigned int d=0; d<m_domains.size(); d++)
+      for(unsigned int g=0; g<m_crs.size(); g++)
+	runSet(m_labels[d], m_domains[d], g);
+}
+
+//--------------------------------------------------------
+// Procedure: makeIPF
+//   Purpose: A coupled course,speed function peaked as by the 
+//            waypoint behavior's ZAIC method, or null.
+
+IvPFunction* CoupledBench::makeIPF(const IvPDomain& domain, double crs,
+				   double spd, bool materialize) const
+{
+  ZAIC_PEAK spd_zaic(domain, "speed");
+  spd_zaic.setParams(spd, spd/2, 1.6, 20, 0, 100);
+  IvPFunction *spd_ipf = spd_zaic.extractIvPFunction();
+
+  ZAIC_PEAK crs_zaic(domain, "course");
+  crs_zaic.setValueWrap(true);
+  crs_zaic.setParams(crs, 0, 180, 50, 0, 100);
+  IvPFunction *crs_ipf = crs_zaic.extractIvPFunction(false);
+
+  if(!spd_ipf || !crs_ipf) {
+    delete(spd_ipf);
+    delete(crs_ipf);
+    return(0);
+  }
+
+  OF_Coupler coupler;
+  coupler.setMaterialize(materialize);
+  return(coupler.couple(crs_ipf, spd_ipf, 50, 50));
+}
+
+//--------------------------------------------------------
+// Procedure: runSet
+//   Purpose: Build and solve the problem for one geometry with 
+//            the functions factored and then materialized, and 
+//            compare the decisions. Decisions at different points
+//            of equal weight are ties, equally correct.
+
+void CoupledBench::runSet(const string& label, const IvPDomain& domain,
+			  unsigned int g)
+{
+  string forms[2] = {".factored", ".materialized"};
+  double crs[2]    = {0, 0};
+  double spd[2]    = {0, 0};
+  double weight[2] = {0, 0};
+  bool   solved[2] = {false, false};
+  unsigned int pieces[2] = {0, 0};
+
+  for(unsigned int i=0; i<2; i++) {
+    bool materialize = (i == 1);
+    double start_time = wallTime();
+    IvPFunction *ipf_a = makeIPF(domain, m_crs[g], m_spd[g], materialize);
+    IvPFunction *ipf_b = makeIPF(domain, fmod(m_crs[g]+100, 360), 
+				 m_spd[g]/2, materialize);
+    if(!ipf_a || !ipf_b) {
+      delete(ipf_a);
+      delete(ipf_b);
+      m_mismatches++;
+      return;
+    }
+    ipf_b->setPWT(50);
+    pieces[i] = ipf_a->size() + ipf_b->size();
+
+    IvPProblem problem;
+    problem.addOF(ipf_a);
+    problem.addOF(ipf_b);
+    problem.setDomain(domain);
+    problem.alignOFs();
+    solved[i] = problem.solve();
+    double time = wallTime() - start_time;
+    m_times[label + forms[i]].push_back(time);
+
+    if(solved[i]) {
+      crs[i]    = problem.getResult("course");
+      spd[i]    = problem.getResult("speed");
+      weight[i] = problem.getMaxWT();
+    }
+  }
+  m_pieces[label].push_back(pieces[1]);
+
+  double tolerance = 1e-6 * (1 + fabs(weight[1]));
+  bool same_point  = (crs[0] == crs[1]) && (spd[0] == spd[1]);
+  bool same_weight = (fabs(weight[0] - weight[1]) <= tolerance);
+  if((solved[0] != solved[1]) || !same_weight || (pieces[0] != pieces[1]))
+    m_mismatches++;
+  else if(!same_point)
+    m_ties++;
+}
+
+//--------------------------------------------------------
+// Procedure: buildReport
+//   Purpose: The results as key,value pairs, in the order reported.
+//            Times, from coupling through solving, are in 
+//            microseconds. The speedup compares the p50 times of
+//            the materialized and factored forms.
+
+vector<pair<string, string> > CoupledBench::buildReport() const
+{
+  vector<pair<string, string> > report;
+  report.push_back(make_pair("geometries", uintToString(m_crs.size())));
+  report.push_back(make_pair("reps", uintToString(m_reps)));
+  report.push_back(make_pair("mismatches", uintToString(m_mismatches)));
+  report.push_back(make_pair("ties", uintToString(m_ties)));
+
+  string forms[2] = {"factored", "materialized"};
+  for(unsigned int d=0; d<m_labels.size(); d++) {
+    string label = m_labels[d];
+    report.push_back(make_pair(label + ".domain", 
+			       domainToString(m_domains[d])));
+    map<string, vector<double> >::const_iterator p;
+    p = m_pieces.find(label);
+    if(p != m_pieces.end())
+      addStats(report, label + ".pieces", p->second);
+
+    vector<double> times[2];
+    for(unsigned int i=0; i<2; i++) {
+      p = m_times.find(label + "." + forms[i]);
+      if(p == m_times.end())
+	continue;
+      addStats(report, label + "." + forms[i] + "_us", p->second, 1000000);
+      times[i] = p->second;
+      sort(times[i].begin(), times[i].end());
+    }
+    double fast_p50 = percentile(times[0], 0.5);
+    string speedup = "n/a";
+    if(fast_p50 > 0)
+      speedup = doubleToString(percentile(times[1], 0.5) / fast_p50, 2);
+    report.push_back(make_pair(label + ".factored_speedup", speedup));
+  }
+  return(report);
+}
+
+//--------------------------------------------------------
+// Procedure: printReport
+
+void CoupledBench::printReport() const
+{
+  printBenchReport(buildReport(), "Coupled Benchmark: factored vs "
+		   "materialized OF_Coupler functions");
+}
+
+//--------------------------------------------------------
+// Procedure: writeReport
+
+bool CoupledBench::writeReport(const string& filename) const
+{
+  return(writeBenchReport(buildReport(), filename));
+}
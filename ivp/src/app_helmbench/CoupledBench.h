@@ -0,0 +1,83 @@
+/*****************************************************************/
+/*    NAME: MOOS-IvP contributors                                */
+/*    ORGN: Dept of Mechanical Eng / CSAIL, MIT Cambridge MA     */
+/*    FILE: CoupledBench.h                                       */
+/*    DATE: Oct 19th 2026                                        */
+/*                                                               */
+/* This file is part of MOOS-IvP                                 */
+/*                                                               */
+/* MOOS-IvP is free software: you can redistribute it and/or     */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation, either version  */
+/* 3 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* MOOS-IvP is distributed in the hope that it will be useful,   */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty   */
+/* of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See  */
+/* the GNU General Public License for more details.              */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with MOOS-IvP.  If not, see                     */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+#ifndef HELMBENCH_COUPLED_BENCH_HEADER
+#define HELMBENCH_COUPLED_BENCH_HEADER
+
+#include <vector>
+#include <string>
+#include <map>
+#include "IvPDomain.h"
+
+class IvPFunction;
+
+//--------------------------------------------------------
+// CoupledBench checks that a coupled course,speed function solves
+// the same whether it is left factored by OF_Coupler or built as
+// one materialized PDMap. For a fixed set of waypoint-like peaks,
+// two coupled functions are built and solved together by IvPProblem
+// in each form, over a fine and a coarse domain. The decisions must
+// be at the same point or tied in weight, and the factored function
+// must count the pieces its materialized form has; disagreements 
+// are counted.
+
+class CoupledBench
+{
+ public:
+  CoupledBench();
+  ~CoupledBench() {}
+
+  void setReps(unsigned int v) {if(v>0) m_reps=v;}
+
+  void run();
+  unsigned int mismatches() const {return(m_mismatches);}
+
+  void printReport() const;
+  bool writeReport(const std::string&) const;
+
+ protected:
+  IvPFunction* makeIPF(const IvPDomain&, double crs, double spd,
+		       bool materialize) const;
+  void runSet(const std::string& label, const IvPDomain&, 
+	      unsigned int geometry);
+
+  std::vector<std::pair<std::string, std::string> > buildReport() const;
+
+ protected:
+  unsigned int m_reps;
+  unsigned int m_mismatches;
+  unsigned int m_ties;
+
+  std::vector<std::string> m_labels;
+  std::vector<IvPDomain>   m_domains;
+
+  // Course and speed peaks of the two functions
+  std::vector<double> m_crs;
+  std::vector<double> m_spd;
+
+  // Results keyed on domain label and form, e.g. 360x21.factored
+  std::map<std::string, std::vector<double> > m_times;
+  std::map<std::string, std::vector<double> > m_pieces;
+};
+
+#endif
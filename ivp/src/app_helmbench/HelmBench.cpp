@@ -0,0 +1,595 @@
+/*****************************************************************/
+/*    NAME: MOOS-IvP contributors                                */
+/*    ORGN: Dept of Mechanical Eng / CSAIL, MIT Cambridge MA     */
+/*    FILE: HelmBench.cpp                                        */
+/*    DATE: Oct 18th 2026                                        */
+/*                                                               */
+/* This file is part of MOOS-IvP                                 */
+/*                                                               */
+/* MOOS-IvP is free software: you can redistribute it and/or     */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation, either version  */
+/* 3 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* MOOS-IvP is distributed in the hope that it will be useful,   */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty   */
+/* of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See  */
+/* the GNU General Public License for more details.              */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with MOOS-IvP.  If not, see                     */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <cstdlib>
+#include "MOOS/libMOOS/MOOSLib.h"
+#include "HelmBench.h"
+#include "HelmEngine.h"
+#include "InfoBuffer.h"
+#include "BehaviorSet.h"
+#include "Populator_BehaviorSet.h"
+#include "IvPProblem.h"
+#include "IvPFunction.h"
+#include "FunctionEncoder.h"
+#include "ALogIndex.h"
+#include "LogUtils.h"
+#include "NodeRecordUtils.h"
+#include "AllocCounter.h"
+#include "BenchUtils.h"
+#include "MBUtils.h"
+
+using namespace std;
+
+//--------------------------------------------------------
+// Constructor
+
+HelmBench::HelmBench()
+{
+  m_reps      = 1;
+  m_helm_name = "pHelmIvP";
+
+  m_tick   = 1.0 / DEFAULT_MOOS_APP_FREQ;
+  m_solver = "auto";
+  m_bhv_dir_not_found_ok = false;
+
+  m_logstart   = 0;
+  m_iterations = 0;
+}
+
+//--------------------------------------------------------
+// Procedure: setMissionFile
+//   Purpose: Read the helm configuration from the mission file.
+//            Only what shapes the decisions is needed: behavior
+//            files and dirs, domain, solver and AppTick.
+
+bool HelmBench::setMissionFile(const string& mission_file)
+{
+  CProcessConfigReader reader;
+  reader.SetFile(mission_file);
+  reader.SetAppName(m_helm_name);
+
+  STRING_LIST sParams;
+  if(!reader.GetConfiguration(m_helm_name, sParams)) {
+    cout << "No " << m_helm_name << " block found in ";
+    cout << mission_file << endl;
+    return(false);
+  }
+
+  bool ok = true;
+  STRING_LIST::iterator p;
+  for(p=sParams.begin(); p!=sParams.end(); p++) {
+    string orig  = *p;
+    string line  = *p;
+    string param = tolower(biteStringX(line, '='));
+    string value = line;
+
+    bool handled = true;
+    if(param == "behaviors")
+      m_bhv_files.insert(value);
+    else if(param == "domain")
+      handled = handleConfigDomain(value);
+    else if(param == "solver")
+      m_solver = tolower(value);
+    else if((param == "ivp_behavior_dir") || (param == "ivp_behavior_dirs"))
+      m_bhv_dirs.push_back(value);
+    else if((param == "bhv_dir_not_found_ok") || 
+	    (param == "bhv_dirs_not_found_ok"))
+      handled = setBooleanOnString(m_bhv_dir_not_found_ok, value);
+    else if((param == "apptick") && isNumber(value)) {
+      double freq = atof(value.c_str());
+      if(freq > 0)
+	m_tick = 1.0 / freq;
+    }
+
+    if(!handled) {
+      cout << "Bad " << m_helm_name << " config line: " << orig << endl;
+      ok = false;
+    }
+  }
+
+  if(m_bhv_files.size() == 0) {
+    cout << "No behavior files given for " << m_helm_name << endl;
+    ok = false;
+  }
+  if(m_domain.size() == 0) {
+    cout << "No decision domain given for " << m_helm_name << endl;
+    ok = false;
+  }
+
+  m_mission_file = mission_file;
+  return(ok);
+}
+
+//--------------------------------------------------------
+// Procedure: handleConfigDomain
+//     Notes: As in pHelmIvP, e.g. speed:0:4:21 or speed,0,4,21
+
+bool HelmBench::handleConfigDomain(const string& g_entry)
+{
+  string entry = stripBlankEnds(g_entry);
+  entry = findReplace(entry, ',', ':');
+
+  vector<string> svector = parseString(entry, ':');
+  unsigned int vsize = svector.size();
+  if((vsize < 4) || (vsize > 5))
+    return(false);
+
+  string dname = svector[0];
+  double dlow  = atof(svector[1].c_str());
+  double dhgh  = atof(svector[2].c_str());
+  int    dcnt  = atoi(svector[3].c_str());
+
+  return(m_domain.addDomain(dname.c_str(), dlow, dhgh, dcnt));
+}
+
+//--------------------------------------------------------
+// Procedure: setALogFile
+//   Purpose: Read the logged mail once, so reps replay it from 
+//            memory. Postings of the helm itself are not replayed.
+//            The helm's logged state and its logged IvP functions
+//            are kept aside for the two suites.
+
+bool HelmBench::setALogFile(const string& alog_file)
+{
+  ALogIndex index;
+  if(!index.open(alog_file))
+    return(false);
+
+  m_alog_file = alog_file;
+  m_logstart  = index.getLogStart();
+
+  unsigned int rsize = index.size();
+  for(unsigned int i=0; i<rsize; i++) {
+    string line = index.getRecordLine(i);
+    string src  = getSourceNameNoAux(line);
+    string var  = getVarName(line);
+    string sval = stripBlankEnds(getDataEntry(line));
+    double time = index.getTime(i);
+
+    if(src == m_helm_name) {
+      if(var == "IVPHELM_STATE") {
+	m_drive_time.push_back(time);
+	m_drive_state.push_back(sval == "DRIVE");
+      }
+      else if(var == "BHV_IPF")
+	addIPF(sval);
+      continue;
+    }
+
+    m_rec_time.push_back(time);
+    m_rec_var.push_back(var);
+    m_rec_sval.push_back(sval);
+    m_rec_numeric.push_back(isNumber(sval));
+    m_rec_dval.push_back(atof(sval.c_str()));
+    m_rec_node_report.push_back((var == "NODE_REPORT") || 
+				(var == "NODE_REPORT_LOCAL") ||
+				(var == "AIS_REPORT") || 
+				(var == "AIS_REPORT_LOCAL"));
+  }
+  return(true);
+}
+
+//--------------------------------------------------------
+// Procedure: addIPF
+//     Notes: The helm posts functions broken into packets, 
+//            "P,function-id,total,index,...". Whole functions are
+//            handled once all their packets have arrived.
+//     Notes: The context string is "iteration:behavior"
+
+void HelmBench::addIPF(const string& ipf_str)
+{
+  if(strBegins(ipf_str, "P,")) {
+    m_demuxer.addMuxPacket(ipf_str, 0);
+    string demux_str = m_demuxer.getDemuxString();
+    while(demux_str != "") {
+      addIPF(demux_str);
+      demux_str = m_demuxer.getDemuxString();
+    }
+    return;
+  }
+
+  string context = StringToIvPContext(ipf_str);
+  string iter_str = biteString(context, ':');
+  if(!isNumber(iter_str))
+    return;
+
+  unsigned int iter = (unsigned int)(atoi(iter_str.c_str()));
+  m_ipf_sets[iter].push_back(ipf_str);
+}
+
+//--------------------------------------------------------
+// Procedure: runHelm
+
+bool HelmBench::runHelm()
+{
+  if(m_rec_time.size() == 0) {
+    cout << "No mail to replay in " << m_alog_file << endl;
+    return(false);
+  }
+
+  for(unsigned int r=0; r<m_reps; r++) {
+    if(!runHelmOnce())
+      return(false);
+  }
+  return(true);
+}
+
+//--------------------------------------------------------
+// Procedure: runHelmOnce
+//   Purpose: Build the helm afresh and drive it through the logged
+//            mission, one decision per AppTick of log time while
+//            the logged helm was in DRIVE. Only the call to 
+//            determineNextDecision is measured.
+
+bool HelmBench::runHelmOnce()
+{
+  InfoBuffer *info_buffer = new InfoBuffer;
+
+  Populator_BehaviorSet populator(m_domain, info_buffer);
+  populator.setBHVDirNotFoundOK(m_bhv_dir_not_found_ok);
+  for(unsigned int k=0; k<m_bhv_dirs.size(); k++)
+    populator.addBehaviorDir(m_bhv_dirs[k]);
+
+  // The populator reports its progress to the terminal, shown 
+  // here only if the behaviors could not be built.
+  ostringstream populate_out;
+  streambuf *cout_buf = cout.rdbuf(populate_out.rdbuf());
+  BehaviorSet *bhv_set = populator.populate(m_bhv_files);
+  cout.rdbuf(cout_buf);
+
+  if(!bhv_set) {
+    cout << populate_out.str();
+    vector<string> warnings = populator.getConfigWarnings();
+    for(unsigned int k=0; k<warnings.size(); k++) 
+      cout << warnings[k] << endl;
+    cout << "Unable to build the behaviors of " << m_helm_name << endl;
+    delete(info_buffer);
+    return(false);
+  }
+
+  HelmEngine *hengine = new HelmEngine(m_domain, info_buffer);
+  hengine->setSolver(m_solver);
+  hengine->setProfiling(true, allocCount);
+
+  setInitialVars(bhv_set, info_buffer, false);
+
+  unsigned int rix  = 0;
+  unsigned int dix  = 0;
+  unsigned int rsize = m_rec_time.size();
+  bool   drive      = (m_drive_time.size() == 0);
+  bool   first_tick = true;
+  double end_time   = m_rec_time.back();
+
+  for(double t=m_rec_time[0]; t<=end_time; t+=m_tick) {
+    double curr_time = m_logstart + t;
+    for(; (rix<rsize) && (m_rec_time[rix] <= t); rix++) {
+      double msg_time = m_logstart + m_rec_time[rix];
+      if(m_rec_node_report[rix])
+	setNodeReport(info_buffer, m_rec_sval[rix]);
+      if(m_rec_numeric[rix])
+	info_buffer->setValue(m_rec_var[rix], m_rec_dval[rix], msg_time);
+      else
+	info_buffer->setValue(m_rec_var[rix], m_rec_sval[rix], msg_time);
+    }
+    for(; (dix<m_drive_time.size()) && (m_drive_time[dix] <= t); dix++)
+      drive = m_drive_state[dix];
+    if(first_tick) {
+      setInitialVars(bhv_set, info_buffer, true);
+      first_tick = false;
+    }
+
+    info_buffer->setCurrTime(curr_time);
+    if(drive) {
+      unsigned long allocs = allocCount();
+      unsigned long bytes  = allocBytes();
+      double start_time = wallTime();
+      hengine->determineNextDecision(bhv_set, curr_time);
+      double decide_time = wallTime() - start_time;
+
+      m_decide_times.push_back(decide_time);
+      m_decide_allocs.push_back((double)(allocCount() - allocs));
+      m_decide_bytes.push_back((double)(allocBytes() - bytes));
+      m_create_times.push_back(hengine->getProfileCreateTime());
+      m_solve_times.push_back(hengine->getProfileSolveTime());
+      m_iterations++;
+
+      const vector<string>& bhvs = hengine->getProfileBhvs();
+      const vector<double>& times = hengine->getProfileTimes();
+      const vector<unsigned int>& pieces = hengine->getProfilePieces();
+      const vector<unsigned long>& counts = hengine->getProfileCounts();
+      for(unsigned int i=0; i<bhvs.size(); i++) {
+	if(m_bhv_type.count(bhvs[i]) == 0) {
+	  for(unsigned int j=0; j<bhv_set->size(); j++) {
+	    if(bhv_set->getDescriptor(j) == bhvs[i])
+	      m_bhv_type[bhvs[i]] = bhv_set->getBehavior(j)->getBehaviorType();
+	  }
+	}
+	string bhv_type = getBehaviorType(bhvs[i]);
+	m_bhv_times[bhv_type].push_back(times[i]);
+	m_bhv_allocs[bhv_type].push_back((double)(counts[i]));
+	if(pieces[i] > 0)
+	  m_bhv_pieces[bhv_type].push_back((double)(pieces[i]));
+      }
+      setBehaviorMessages(bhv_set, info_buffer);
+
+      // pHelmIvP hands the functions held for reporting to its
+      // reporter thread. Here they are dropped, outside the timing.
+      vector<string> descs;
+      vector<double> scales, shifts;
+      vector<IvPFunction*> ipfs = bhv_set->pullReportedIPFs(descs, scales,
+							    shifts);
+      for(unsigned int i=0; i<ipfs.size(); i++)
+	delete(ipfs[i]);
+    }
+    info_buffer->clearDeltaVectors();
+  }
+
+  delete(hengine);
+  delete(bhv_set);
+  delete(info_buffer);
+  return(true);
+}
+
+//--------------------------------------------------------
+// Procedure: setInitialVars
+//     Notes: As pHelmIvP does on startup. Initial variables with
+//            deferment are set only if not known once the first
+//            mail has been read.
+
+void HelmBench::setInitialVars(BehaviorSet *bhv_set, 
+			       InfoBuffer *info_buffer, bool defer) const
+{
+  vector<VarDataPair> mvector;
+  if(!defer)
+    mvector = bhv_set->getHelmStartMessages();
+  vector<VarDataPair> ivector = bhv_set->getInitialVariables();
+  for(unsigned int j=0; j<ivector.size(); j++) {
+    string key = tolower(ivector[j].get_key());
+    if((!defer && (key == "post")) || 
+       (defer && (key == "defer") && 
+	!info_buffer->isKnown(ivector[j].get_var())))
+      mvector.push_back(ivector[j]);
+  }
+
+  for(unsigned int j=0; j<mvector.size(); j++) {
+    string var   = stripBlankEnds(mvector[j].get_var());
+    string sdata = stripBlankEnds(mvector[j].get_sdata());
+    if(strContainsWhite(var))
+      continue;
+    if(sdata != "")
+      info_buffer->setValue(var, sdata);
+    else
+      info_buffer->setValue(var, mvector[j].get_ddata());
+  }
+}
+
+//--------------------------------------------------------
+// Procedure: setBehaviorMessages
+//     Notes: As pHelmIvP does after each decision, behavior 
+//            postings other than functions are seen by the 
+//            behaviors on the next iteration.
+
+void HelmBench::setBehaviorMessages(BehaviorSet *bhv_set, 
+				    InfoBuffer *info_buffer) const
+{
+  bhv_set->clearWarnings();
+  for(unsigned int i=0; i<bhv_set->size(); i++) {
+    vector<VarDataPair> mvector = bhv_set->getMessages(i);
+    for(unsigned int j=0; j<mvector.size(); j++) {
+      string var = mvector[j].get_var();
+      if(var == "BHV_IPF")
+	continue;
+      if(mvector[j].is_string())
+	info_buffer->setValue(var, mvector[j].get_sdata());
+      else
+	info_buffer->setValue(var, mvector[j].get_ddata());
+    }
+  }
+  bhv_set->updateStateSpaceVars();
+  bhv_set->removeCompletedBehaviors();
+}
+
+//--------------------------------------------------------
+// Procedure: setNodeReport
+//     Notes: As pHelmIvP does, the contact's position is set as 
+//            variables named by the contact, e.g. HENRY_NAV_X.
+//            Node skews are not applied.
+
+void HelmBench::setNodeReport(InfoBuffer *info_buffer, 
+			      const string& report) const
+{
+  NodeRecord record = string2NodeRecord(report);
+  string vname = toupper(record.getName());
+
+  info_buffer->setValue(vname+"_NAV_X", record.getX());
+  info_buffer->setValue(vname+"_NAV_Y", record.getY());
+  info_buffer->setValue(vname+"_NAV_SPEED", record.getSpeed());
+  info_buffer->setValue(vname+"_NAV_HEADING", record.getHeading());
+  info_buffer->setValue(vname+"_NAV_DEPTH", record.getDepth());
+  info_buffer->setValue(vname+"_NAV_LAT", record.getLat());
+  info_buffer->setValue(vname+"_NAV_LONG", record.getLon());
+  info_buffer->setValue(vname+"_NAV_UTC", record.getTimeStamp());
+}
+
+//--------------------------------------------------------
+// Procedure: runIPFs
+
+void HelmBench::runIPFs()
+{
+  map<unsigned int, vector<string> >::iterator p;
+  for(p=m_ipf_sets.begin(); p!=m_ipf_sets.end(); p++)
+    solveIPFSet(p->second);
+}
+
+//--------------------------------------------------------
+// Procedure: solveIPFSet
+//   Purpose: Decode the functions of one logged helm iteration and
+//            solve them over the helm domain, reduced as the helm
+//            does to the variables used. Functions are decoded 
+//            afresh for each rep since solving applies weights.
+
+void HelmBench::solveIPFSet(const vector<string>& ipfs)
+{
+  for(unsigned int r=0; r<m_reps; r++) {
+    vector<IvPFunction*> functions;
+    for(unsigned int i=0; i<ipfs.size(); i++) {
+      unsigned long allocs = allocCount();
+      double start_time = wallTime();
+      IvPFunction *ipf = StringToIvPFunction(ipfs[i]);
+      double decode_time = wallTime() - start_time;
+      if(!ipf)
+	continue;
+
+      m_decode_times.push_back(decode_time);
+      m_decode_allocs.push_back((double)(allocCount() - allocs));
+      functions.push_back(ipf);
+      if(r == 0) {
+	string context = StringToIvPContext(ipfs[i]);
+	biteString(context, ':');
+	string bhv_type = getBehaviorType(context);
+	m_ipf_pieces[bhv_type].push_back((double)(ipf->size()));
+      }
+    }
+    if(functions.size() == 0)
+      return;
+
+    vector<string> dnames;
+    for(unsigned int i=0; i<functions.size(); i++) {
+      IvPDomain ipf_domain = functions[i]->getDomain();
+      for(unsigned int j=0; j<ipf_domain.size(); j++) {
+	string dname = ipf_domain.getVarName(j);
+	if(!vectorContains(dnames, dname))
+	  dnames.push_back(dname);
+      }
+    }
+    IvPDomain domain = m_domain;
+    if(dnames.size() != m_domain.size()) {
+      domain = IvPDomain();
+      for(unsigned int i=0; i<dnames.size(); i++) {
+	int ix = m_domain.getIndex(dnames[i]);
+	if(ix < 0)
+	  return;
+	domain.addDomain(dnames[i], m_domain.getVarLow(ix), 
+			 m_domain.getVarHigh(ix), m_domain.getVarPoints(ix));
+      }
+    }
+
+    IvPProblem *problem = new IvPProblem;
+    for(unsigned int i=0; i<functions.size(); i++)
+      problem->addOF(functions[i]);
+    problem->setDomain(domain);
+
+    unsigned long allocs = allocCount();
+    double start_time = wallTime();
+    problem->alignOFs();
+    problem->solve();
+    m_ipf_solve_times.push_back(wallTime() - start_time);
+    m_ipf_solve_allocs.push_back((double)(allocCount() - allocs));
+    delete(problem);
+  }
+}
+
+//--------------------------------------------------------
+// Procedure: getBehaviorType
+//     Notes: Behaviors not seen by the helm suite, e.g. if it was
+//            not run, are reported under their own descriptor.
+
+string HelmBench::getBehaviorType(const string& descriptor) const
+{
+  map<string, string>::const_iterator p = m_bhv_type.find(descriptor);
+  if(p == m_bhv_type.end())
+    return(descriptor);
+  return(p->second);
+}
+
+//--------------------------------------------------------
+// Procedure: buildReport
+//   Purpose: The results as key,value pairs, in the order reported.
+//            Times are in microseconds.
+
+vector<pair<string, string> > HelmBench::buildReport() const
+{
+  vector<pair<string, string> > report;
+  report.push_back(make_pair("mission", m_mission_file));
+  report.push_back(make_pair("alog", m_alog_file));
+  report.push_back(make_pair("reps", uintToString(m_reps)));
+  report.push_back(make_pair("solver", m_solver));
+
+  report.push_back(make_pair("helm.decisions", uintToString(m_iterations)));
+  addStats(report, "helm.decide_us", m_decide_times, 1000000);
+  addStats(report, "helm.create_us", m_create_times, 1000000);
+  addStats(report, "helm.solve_us", m_solve_times, 1000000);
+  addStats(report, "helm.allocs_per_decision", m_decide_allocs);
+  addStats(report, "helm.bytes_per_decision", m_decide_bytes, 1, 0);
+
+  map<string, vector<double> >::const_iterator p;
+  for(p=m_bhv_times.begin(); p!=m_bhv_times.end(); p++) {
+    string key = "bhv." + p->first;
+    report.push_back(make_pair(key + ".calls", uintToString(p->second.size())));
+    addStats(report, key + ".create_us", p->second, 1000000);
+    map<string, vector<double> >::const_iterator q;
+    q = m_bhv_allocs.find(p->first);
+    if(q != m_bhv_allocs.end())
+      addStats(report, key + ".allocs", q->second);
+    q = m_bhv_pieces.find(p->first);
+    if(q != m_bhv_pieces.end())
+      addStats(report, key + ".pieces", q->second);
+  }
+
+  unsigned int total_ipfs = 0;
+  for(p=m_ipf_pieces.begin(); p!=m_ipf_pieces.end(); p++)
+    total_ipfs += p->second.size();
+  report.push_back(make_pair("ipf.sets", uintToString(m_ipf_sets.size())));
+  report.push_back(make_pair("ipf.functions", uintToString(total_ipfs)));
+  addStats(report, "ipf.decode_us", m_decode_times, 1000000);
+  addStats(report, "ipf.allocs_per_decode", m_decode_allocs);
+  addStats(report, "ipf.solve_us", m_ipf_solve_times, 1000000);
+  addStats(report, "ipf.allocs_per_solve", m_ipf_solve_allocs);
+  for(p=m_ipf_pieces.begin(); p!=m_ipf_pieces.end(); p++)
+    addStats(report, "ipf." + p->first + ".pieces", p->second);
+
+  return(report);
+}
+
+//--------------------------------------------------------
+// Procedure: printReport
+
+void HelmBench::printReport() const
+{
+  printBenchReport(buildReport(), "Helm Benchmark: " + m_mission_file + 
+		   ", " + m_alog_file);
+}
+
+//--------------------------------------------------------
+// Procedure: writeReport
+
+bool HelmBench::writeReport(const string& filename) const
+{
+  return(writeBenchReport(buildReport(), filename));
+}
@@ -0,0 +1,131 @@
+/*****************************************************************/
+/*    NAME: MOOS-IvP contributors                                */
+/*    ORGN: Dept of Mechanical Eng / CSAIL, MIT Cambridge MA     */
+/*    FILE: HelmBench.h                                          */
+/*    DATE: Oct 18th 2026                                        */
+/*                                                               */
+/* This file is part of MOOS-IvP                                 */
+/*                                                               */
+/* MOOS-IvP is free software: you can redistribute it and/or     */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation, either version  */
+/* 3 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* MOOS-IvP is distributed in the hope that it will be useful,   */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty   */
+/* of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See  */
+/* the GNU General Public License for more details.              */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with MOOS-IvP.  If not, see                     */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+
+
+#ifndef HELM_BENCH_HEADER
+#define HELM_BENCH_HEADER
+
+#include <vector>
+#include <string>
+#include <set>
+#include <map>
+#include "IvPDomain.h"
+#include "Demuxer.h"
+
+class InfoBuffer;
+class BehaviorSet;
+
+//--------------------------------------------------------
+// HelmBench is a regression benchmark of the helm over a captured
+// mission. The helm of the mission file is rebuilt and driven by
+// the mail logged in the alog, on the logged clock, through 
+// HelmEngine::determineNextDecision as pHelmIvP would call it. 
+// Separately the IvP functions logged by the helm (BHV_IPF) are
+// decoded and re-solved by IvPProblem. Times, allocations and
+// piece counts are reported overall and per behavior type.
+
+class HelmBench
+{
+ public:
+  HelmBench();
+  ~HelmBench() {}
+
+  void setReps(unsigned int v)          {if(v>0) m_reps=v;}
+  void setHelmName(const std::string& s) {m_helm_name=s;}
+
+  bool setMissionFile(const std::string&);
+  bool setALogFile(const std::string&);
+
+  bool runHelm();
+  void runIPFs();
+
+  void printReport() const;
+  bool writeReport(const std::string&) const;
+
+ protected:
+  bool handleConfigDomain(const std::string&);
+  bool runHelmOnce();
+  void setInitialVars(BehaviorSet*, InfoBuffer*, bool defer) const;
+  void setBehaviorMessages(BehaviorSet*, InfoBuffer*) const;
+  void setNodeReport(InfoBuffer*, const std::string&) const;
+  void addIPF(const std::string&);
+  void solveIPFSet(const std::vector<std::string>&);
+
+  std::string getBehaviorType(const std::string& descriptor) const;
+
+  std::vector<std::pair<std::string, std::string> > buildReport() const;
+
+ protected: // Configuration
+  unsigned int m_reps;
+  std::string  m_helm_name;
+  std::string  m_mission_file;
+  std::string  m_alog_file;
+
+  IvPDomain    m_domain;
+  double       m_tick;
+  std::string  m_solver;
+  bool         m_bhv_dir_not_found_ok;
+
+  std::set<std::string>    m_bhv_files;
+  std::vector<std::string> m_bhv_dirs;
+
+ protected: // Logged mail, less that of the helm itself
+  double                   m_logstart;
+  std::vector<double>      m_rec_time;
+  std::vector<std::string> m_rec_var;
+  std::vector<std::string> m_rec_sval;
+  std::vector<double>      m_rec_dval;
+  std::vector<bool>        m_rec_numeric;
+  std::vector<bool>        m_rec_node_report;
+
+  // Helm state as logged by the helm, the helm decides in DRIVE
+  std::vector<double>      m_drive_time;
+  std::vector<bool>        m_drive_state;
+
+  // Logged IvP function strings, keyed on helm iteration
+  Demuxer                  m_demuxer;
+  std::map<unsigned int, std::vector<std::string> > m_ipf_sets;
+
+ protected: // Results of the helm suite, all reps pooled
+  std::vector<double>      m_decide_times;
+  std::vector<double>      m_create_times;
+  std::vector<double>      m_solve_times;
+  std::vector<double>      m_decide_allocs;
+  std::vector<double>      m_decide_bytes;
+  unsigned int             m_iterations;
+
+  std::map<std::string, std::string>          m_bhv_type;
+  std::map<std::string, std::vector<double> > m_bhv_times;
+  std::map<std::string, std::vector<double> > m_bhv_allocs;
+  std::map<std::string, std::vector<double> > m_bhv_pieces;
+
+ protected: // Results of the IPF suite
+  std::vector<double>      m_decode_times;
+  std::vector<double>      m_decode_allocs;
+  std::vector<double>      m_ipf_solve_times;
+  std::vector<double>      m_ipf_solve_allocs;
+  std::map<std::string, std::vector<double> > m_ipf_pieces;
+};
+
+#endif
@@ -0,0 +1,208 @@
+/*****************************************************************/
+/*    NAME: MOOS-IvP contributors                                */
+/*    ORGN: Dept of Mechanical Eng / CSAIL, MIT Cambridge MA     */
+/*    FILE: main.cpp                                             */
+/*    DATE: Oct 18th 2026                                        */
+/*                                                               */
+/* This file is part of MOOS-IvP                                 */
+/*                                                               */
+/* MOOS-IvP is free software: you can redistribute it and/or     */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation, either version  */
+/* 3 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* MOOS-IvP is distributed in the hope that it will be useful,   */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty   */
+/* of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See  */
+/* the GNU General Public License for more details.              */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with MOOS-IvP.  If not, see                     */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+
+
+#include <string>
+#include <iostream>
+#include <cstdlib>
+#include "MBUtils.h"
+#include "ReleaseInfo.h"
+#include "HelmBench.h"
+#include "CPABench.h"
+#include "CoupledBench.h"
+
+using namespace std;
+
+void display_usage();
+
+//--------------------------------------------------------
+// Procedure: main
+
+int main(int argc, char *argv[])
+{
+  // Look for a request for version information
+  if(scanArgs(argc, argv, "-v", "--version", "-version")) {
+    showReleaseInfo("helmbench", "gpl");
+    return(0);
+  }
+
+  // Look for a request for usage information
+  if(scanArgs(argc, argv, "-h", "--help", "-help")) {
+    display_usage();
+    return(0);
+  }
+
+  bool verbose = true;
+  if(scanArgs(argc, argv, "-q", "--quiet", "-quiet"))
+    verbose = false;
+
+  bool cpa_bench = false;
+  if(scanArgs(argc, argv, "--cpa", "-cpa"))
+    cpa_bench = true;
+
+  bool coupled_bench = false;
+  if(scanArgs(argc, argv, "--coupled", "-coupled"))
+    coupled_bench = true;
+
+  HelmBench bench;
+
+  string alog_file;
+  string mission_file;
+  string report_file;
+  unsigned int reps = 1;
+
+  for(int i=1; i<argc; i++) {
+    string argi = argv[i];
+    if(strBegins(argi, "--reps=")) {
+      string str = argi.substr(7);
+      if(!isNumber(str) || (atoi(str.c_str()) < 1)) {
+	cout << "Bad reps: " << str << endl;
+	return(1);
+      }
+      reps = atoi(str.c_str());
+      bench.setReps(reps);
+    }
+    else if(strBegins(argi, "--name="))
+      bench.setHelmName(argi.substr(7));
+    else if(strBegins(argi, "--report="))
+      report_file = argi.substr(9);
+    else if(strEnds(argi, ".moos") || strEnds(argi, ".moos++"))
+      mission_file = argi;
+    else if(strEnds(argi, ".alog"))
+      alog_file = argi;
+  }
+
+  // The CPA suite stands alone, needing no mission or log
+  if(cpa_bench) {
+    CPABench cpa;
+    cpa.setReps(reps);
+    cpa.run();
+    if(verbose)
+      cpa.printReport();
+    if((report_file != "") && !cpa.writeReport(report_file)) {
+      cout << "Unable to create report file: " << report_file << endl;
+      return(1);
+    }
+    return((cpa.mismatches() == 0) ? 0 : 1);
+  }
+
+  // As is the coupled function suite
+  if(coupled_bench) {
+    CoupledBench coupled;
+    coupled.setReps(reps);
+    coupled.run();
+    if(verbose)
+      coupled.printReport();
+    if((report_file != "") && !coupled.writeReport(report_file)) {
+      cout << "Unable to create report file: " << report_file << endl;
+      return(1);
+    }
+    return((coupled.mismatches() == 0) ? 0 : 1);
+  }
+
+  if((alog_file == "") || (mission_file == "")) {
+    display_usage();
+    return(1);
+  }
+
+  if(!bench.setMissionFile(mission_file))
+    return(1);
+  if(!bench.setALogFile(alog_file)) {
+    cout << "Input file: " << alog_file << " does not exist." << endl;
+    return(1);
+  }
+
+  if(!bench.runHelm())
+    return(1);
+  bench.runIPFs();
+
+  if(verbose)
+    bench.printReport();
+
+  if(report_file != "") {
+    if(!bench.writeReport(report_file)) {
+      cout << "Unable to create report file: " << report_file << endl;
+      return(1);
+    }
+  }
+
+  return(0);
+}
+
+//--------------------------------------------------------
+// Procedure: display_usage
+
+void display_usage()
+{
+  cout << "Usage: " << endl;
+  cout << "  helmbench mission.moos in.alog [OPTIONS]                " << endl;
+  cout << "  helmbench --cpa [OPTIONS]                              " << endl;
+  cout << "  helmbench --coupled [OPTIONS]                          " << endl;
+  cout << "                                                         " << endl;
+  cout << "Synopsis:                                                " << endl;
+  cout << "  Benchmark the helm over a captured mission. The helm   " << endl;
+  cout << "  configured in the mission file is built in this        " << endl;
+  cout << "  process and fed the mail logged in the alog, making a  " << endl;
+  cout << "  decision per AppTick of log time while the logged helm " << endl;
+  cout << "  was in DRIVE. The IvP functions logged by the helm     " << endl;
+  cout << "  (BHV_IPF) are then decoded and solved again on their   " << endl;
+  cout << "  own. Times (p50, p99, max, mean), allocations and      " << endl;
+  cout << "  piece counts are reported overall and by behavior type." << endl;
+  cout << "                                                         " << endl;
+  cout << "Standard Arguments:                                      " << endl;
+  cout << "  mission.moos  - The mission file configuring the helm. " << endl;
+  cout << "  in.alog       - The logfile of the captured mission.   " << endl;
+  cout << "                                                         " << endl;
+  cout << "Options:                                                 " << endl;
+  cout << "  -h,--help     Display this usage/help message.         " << endl;
+  cout << "  -v,--version  Display version information.             " << endl;
+  cout << "  -q,--quiet    Report to the terminal suppressed.       " << endl;
+  cout << "  --reps=N      Run each suite N times (default 1).      " << endl;
+  cout << "  --cpa         Run the CPA suite instead: the collision " << endl;
+  cout << "                and cut-range objective functions over a " << endl;
+  cout << "                360x21 course,speed domain, each point by" << endl;
+  cout << "                point and as one grid, and built with and" << endl;
+  cout << "                without the grid. Exits 1 if they differ." << endl;
+  cout << "  --coupled     Run the coupled function suite instead:  " << endl;
+  cout << "                course,speed functions coupled by        " << endl;
+  cout << "                OF_Coupler solved factored and then      " << endl;
+  cout << "                materialized. Exits 1 if they differ.    " << endl;
+  cout << "  --name=NAME   Name of the helm in the mission and in   " << endl;
+  cout << "                the log. Default is pHelmIvP.            " << endl;
+  cout << "  --report=FILE Write the results to FILE, one key=value " << endl;
+  cout << "                per line, for tracking across builds.    " << endl;
+  cout << "                                                         " << endl;
+  cout << "Further Notes:                                           " << endl;
+  cout << "  (1) Times are wall-clock, in microseconds.             " << endl;
+  cout << "  (2) Allocations are calls to operator new made within  " << endl;
+  cout << "      a decision, a decode or a solve.                   " << endl;
+  cout << "  (3) Replay is open-loop: the logged mission does not   " << endl;
+  cout << "      react to the decisions made now.                   " << endl;
+  cout << "  (4) The IvP function suite needs the mission to have   " << endl;
+  cout << "      been run with ipf_reporting = true.                " << endl;
+  cout << "  (5) Files named in the mission, e.g. the behavior      " << endl;
+  cout << "      file, are found relative to the current directory." << endl;
+  cout << "  (6) See also: aloghelm --solve, alogreplay             " << endl;
+  cout << endl;
+}
@@ -36,15 +36,41 @@ AppCastRepo::AppCastRepo()
   m_current_node = "";
   m_current_proc = "";
   m_refresh_mode = "events";
+  m_deltas_dropped = 0;
 }
 
 //---------------------------------------------------------
 // Procedure: addAppCast
 //   Returns: true if first time hearing from this node
+//      Note: The string may be a full appcast or a delta against the
+//            previous appcast from the same node and proc. A delta
+//            that cannot be applied, e.g., because the previous one
+//            was missed, is dropped until the next full appcast.
 
 bool AppCastRepo::addAppCast(const string& appcast_str)
 {
-  AppCast appcast = string2AppCast(appcast_str);
+  string full_str = appcast_str;
+
+  if(isAppCastDelta(appcast_str)) {
+    string node, proc;
+    unsigned int base_iter = 0;
+    getAppCastDeltaInfo(appcast_str, node, proc, base_iter);
+
+    string key = node + ":" + proc;
+    if((m_map_last_appcast.count(key) == 0) ||
+       !applyAppCastDelta(appcast_str, m_map_last_appcast[key],
+			  m_map_last_iter[key], full_str)) {
+      m_deltas_dropped++;
+      return(false);
+    }
+  }
+
+  AppCast appcast = string2AppCast(full_str);
+
+  string key = appcast.getNodeName() + ":" + appcast.getProcName();
+  m_map_last_appcast[key] = full_str;
+  m_map_last_iter[key]    = appcast.getIteration();
+
   return(addAppCast(appcast));
 }
 
@@ -58,6 +58,7 @@ class AppCastRepo
   unsigned int getProcCount(std::string node) const;
   unsigned int getAppCastCount(std::string node, std::string proc) const;
   unsigned int getAppCastCount(std::string node) const;
+  unsigned int getDeltasDropped() const {return(m_deltas_dropped);}
 
  private: 
   AppCastTree  m_appcast_tree;
@@ -67,6 +68,13 @@ class AppCastRepo
   std::string  m_refresh_mode; // paused,events,streaming
 
   std::map<std::string, std::string> m_map_node_proc;
+
+  // Latest full appcast string and iteration, keyed on node:proc,
+  // against which the next appcast delta will be applied.
+  std::map<std::string, std::string>  m_map_last_appcast;
+  std::map<std::string, unsigned int> m_map_last_iter;
+
+  unsigned int m_deltas_dropped;
 };
 
 #endif 
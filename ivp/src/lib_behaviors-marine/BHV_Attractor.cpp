@@ -355,7 +355,7 @@ IvPFunction *BHV_Attractor::onRunState()
 
   // Check for properly created IvPFunction before operating on it.
   if(ipf) {
-    ipf->getPDMap()->normalize(0.0, 100.0);
+    ipf->normalize(0.0, 100.0);
     ipf->setPWT(current_relevance * m_priority_wt);
   }
 
@@ -33,6 +33,8 @@ class BHV_Attractor : public IvPContactBehavior {
 public:
   BHV_Attractor(IvPDomain);
   ~BHV_Attractor() {}
+  bool         isCloneable() const {return(true);}
+  IvPBehavior* clone() const {return(new BHV_Attractor(*this));}
   
   IvPFunction* onRunState();
   bool         setParam(std::string, std::string);
@@ -31,6 +31,8 @@ class BHV_AvoidCollision : public IvPContactBehavior {
 public:
   BHV_AvoidCollision(IvPDomain);
   ~BHV_AvoidCollision() {}
+  bool         isCloneable() const {return(true);}
+  IvPBehavior* clone() const {return(new BHV_AvoidCollision(*this));}
 
   void         onHelmStart();
   IvPFunction* onRunState();
@@ -32,6 +32,8 @@ class BHV_CutRange : public IvPContactBehavior {
 public:
   BHV_CutRange(IvPDomain);
   ~BHV_CutRange() {}
+  bool         isCloneable() const {return(true);}
+  IvPBehavior* clone() const {return(new BHV_CutRange(*this));}
   
   IvPFunction* onRunState();
   bool         setParam(std::string, std::string);
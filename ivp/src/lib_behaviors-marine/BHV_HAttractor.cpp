@@ -296,7 +296,7 @@ IvPFunction *BHV_HAttractor::onRunState()
 
   // Check for properly created IvPFunction before operating on it.
   if(ipf) {
-    ipf->getPDMap()->normalize(0.0, 100.0);
+    ipf->normalize(0.0, 100.0);
     ipf->setPWT(relevance * m_priority_wt);
   }
 
@@ -276,7 +276,7 @@ IvPFunction *BHV_Loiter::onRunState()
   IvPFunction *ipf = buildIPF("zaic");
 
   if(ipf) {
-    ipf->getPDMap()->normalize(0,100);
+    ipf->normalize(0,100);
     ipf->setPWT(m_priority_wt);
   }
 
@@ -33,6 +33,8 @@ class BHV_RStationKeep : public IvPBehavior {
 public:
   BHV_RStationKeep(IvPDomain);
   ~BHV_RStationKeep() {}
+  bool         isCloneable() const {return(true);}
+  IvPBehavior* clone() const {return(new BHV_RStationKeep(*this));}
   
   bool         setParam(std::string, std::string);
   void         onIdleState();
@@ -157,7 +157,7 @@ IvPFunction *BHV_Shadow::onRunState()
   IvPFunction *ipf = coupler.couple(hdg_ipf, spd_ipf);
       
   if(ipf) {
-    ipf->getPDMap()->normalize(0.0, 100.0);
+    ipf->normalize(0.0, 100.0);
     ipf->setPWT(relevance * m_priority_wt);
   }
   else
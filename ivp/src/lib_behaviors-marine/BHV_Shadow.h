@@ -35,6 +35,8 @@ class BHV_Shadow : public IvPContactBehavior {
 public:
   BHV_Shadow(IvPDomain);
   ~BHV_Shadow() {}
+  bool         isCloneable() const {return(true);}
+  IvPBehavior* clone() const {return(new BHV_Shadow(*this));}
   
   IvPFunction* onRunState();
   bool         setParam(std::string, std::string);
@@ -337,7 +337,7 @@ IvPFunction *BHV_Trail::onRunState()
   }
   
   if(ipf) {
-    ipf->getPDMap()->normalize(0.0, 100.0);
+    ipf->normalize(0.0, 100.0);
     ipf->setPWT(relevance * m_priority_wt);
   }
   
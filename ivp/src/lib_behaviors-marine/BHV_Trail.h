@@ -32,6 +32,8 @@ class BHV_Trail : public IvPContactBehavior {
 public:
   BHV_Trail(IvPDomain);
   ~BHV_Trail() {}
+  bool         isCloneable() const {return(true);}
+  IvPBehavior* clone() const {return(new BHV_Trail(*this));}
   
   IvPFunction* onRunState();
   bool         setParam(std::string, std::string);
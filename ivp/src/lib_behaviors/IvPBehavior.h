@@ -60,6 +60,13 @@ public:
   virtual std::string getInfo(std::string)  {return("");}
   virtual double getDoubleInfo(std::string) {return(0);}
 
+  // A copy of this behavior, used to spawn from a configured template
+  // rather than from its spec. Only behaviors whose members are all
+  // safe to copy override this, and isCloneable() to say so. 
+  // Otherwise null is returned.
+  virtual bool isCloneable() const    {return(false);}
+  virtual IvPBehavior* clone() const  {return(0);}
+
   bool   setParamCommon(std::string, std::string);
   void   setInfoBuffer(const InfoBuffer*);
   bool   checkUpdates();
@@ -146,6 +146,12 @@ bool AOF_AttractorCPA::initialize()
   cpa_engine = new CPAEngine(cn_lat, cn_lon, cn_crs, cn_spd,
 			     os_lat, os_lon);
 
+  vector<double> courses;
+  unsigned int i, crs_pts = m_domain.getVarPoints(crs_ix);
+  for(i=0; i<crs_pts; i++)
+    courses.push_back(m_domain.getVal(crs_ix, i));
+  cpa_engine->setCourseCache(courses);
+
   max_heading = cpa_engine->minMaxROC(5, 360, min_roc, max_roc);
   
   range_roc = max_roc - min_roc;
@@ -162,16 +168,51 @@ bool AOF_AttractorCPA::initialize()
 
 double AOF_AttractorCPA::evalBox(const IvPBox *b) const
 {
-  double eval_crs = 0;
   double eval_spd = 0;
-
-  m_domain.getVal(crs_ix, b->pt(crs_ix,0), eval_crs);
   m_domain.getVal(spd_ix, b->pt(spd_ix,0), eval_spd);
 
   double roc;
 
-  double eval_dist = cpa_engine->evalCPA(eval_crs, eval_spd, tol, &roc);
+  double eval_dist = cpa_engine->evalCPAByIndex(b->pt(crs_ix,0), 
+						eval_spd, tol, &roc);
+
+  return(compromise(eval_dist, roc));
+}
+
+//----------------------------------------------------------------
+// Procedure: evalGrid
+//   Purpose: Eval a grid of <course, speed> points with one call to
+//            the CPA engine. Values are identical to evalBox() on 
+//            each point.
+
+bool AOF_AttractorCPA::evalGrid(const vector<vector<int> >& pts,
+				vector<double>& vals) const
+{
+  if(!cpa_engine || (pts.size() != 2) || (crs_ix < 0) || (spd_ix < 0))
+    return(false);
+
+  const vector<int>& spd_pts = pts[spd_ix];
+  unsigned int i, ssize = spd_pts.size();
+  vector<double> spds(ssize);
+  for(i=0; i<ssize; i++)
+    spds[i] = m_domain.getVal(spd_ix, spd_pts[i]);
+
+  vector<double> rocs;
+  cpa_engine->evalCPAGrid(pts[crs_ix], spds, tol, vals, &rocs, 
+			  (crs_ix == 0));
+
+  unsigned int vsize = vals.size();
+  for(i=0; i<vsize; i++)
+    vals[i] = compromise(vals[i], rocs[i]);
 
+  return(true);
+}
+
+//----------------------------------------------------------------
+// Procedure: compromise
+
+double AOF_AttractorCPA::compromise(double eval_dist, double roc) const
+{
   double nroc = 0;
 
   if(range_roc > 0)
@@ -181,9 +222,9 @@ double AOF_AttractorCPA::evalBox(const IvPBox *b) const
   
   double pct = patience / 100.0;
 
-  double compromise = ((1.0-pct) * nroc) + (pct * metric_eval);
+  double cval = ((1.0-pct) * nroc) + (pct * metric_eval);
 
-  return(compromise);
+  return(cval);
 }
 
 //----------------------------------------------------------------
@@ -34,11 +34,14 @@ public:
 
 public:    
   double evalBox(const IvPBox*) const;   // virtual defined
+  bool   evalGrid(const std::vector<std::vector<int> >&,
+		  std::vector<double>&) const;   // virtual defined
   bool   setParam(const std::string&, double);
   bool   initialize();
   
 protected:
   double metric(double) const;
+  double compromise(double eval_dist, double roc) const;
 
 protected:
   int    crs_ix;  // Index of "course" variable in IvPDomain
@@ -63,6 +63,12 @@ bool AOF_AvoidCollision::initialize()
   if((m_crs_ix==-1) || (m_spd_ix==-1))
     return(false);
 
+  vector<double> courses;
+  unsigned int i, crs_pts = m_domain.getVarPoints(m_crs_ix);
+  for(i=0; i<crs_pts; i++)
+    courses.push_back(m_domain.getVal(m_crs_ix, i));
+  m_cpa_engine.setCourseCache(courses);
+
   return(true);
 }
 
@@ -77,18 +83,44 @@ bool AOF_AvoidCollision::initialize()
 
 double AOF_AvoidCollision::evalBox(const IvPBox *b) const
 {
-  double eval_crs = 0;
   double eval_spd = 0; 
-
-  m_domain.getVal(m_crs_ix, b->pt(m_crs_ix), eval_crs);
   m_domain.getVal(m_spd_ix, b->pt(m_spd_ix), eval_spd);
 
-  double cpa_dist  = m_cpa_engine.evalCPA(eval_crs, eval_spd, m_tol);
+  double cpa_dist  = m_cpa_engine.evalCPAByIndex(b->pt(m_crs_ix), 
+						 eval_spd, m_tol);
   double eval_dist = metric(cpa_dist);
 
   return(eval_dist);
 }
 
+//----------------------------------------------------------------
+// Procedure: evalGrid
+//   Purpose: Evaluates a grid of <course, speed> points with one call
+//            to the CPA engine. Values are identical to calling 
+//            evalBox() on each point.
+
+bool AOF_AvoidCollision::evalGrid(const vector<vector<int> >& pts,
+				  vector<double>& vals) const
+{
+  if((pts.size() != 2) || (m_crs_ix == -1) || (m_spd_ix == -1))
+    return(false);
+
+  const vector<int>& spd_pts = pts[m_spd_ix];
+  unsigned int i, ssize = spd_pts.size();
+  vector<double> spds(ssize);
+  for(i=0; i<ssize; i++)
+    spds[i] = m_domain.getVal(m_spd_ix, spd_pts[i]);
+
+  m_cpa_engine.evalCPAGrid(pts[m_crs_ix], spds, m_tol, vals, 0,
+			   (m_crs_ix == 0));
+
+  unsigned int vsize = vals.size();
+  for(i=0; i<vsize; i++)
+    vals[i] = metric(vals[i]);
+
+  return(true);
+}
+
 //----------------------------------------------------------------
 // Procedure: metric
 
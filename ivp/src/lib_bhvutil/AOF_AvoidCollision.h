@@ -35,6 +35,8 @@ public:
 
 public: // virtuals defined
   double evalBox(const IvPBox*) const;   
+  bool   evalGrid(const std::vector<std::vector<int> >&, 
+		  std::vector<double>&) const;
   bool   setParam(const std::string&, double);
   bool   initialize();
 
@@ -144,6 +144,12 @@ bool AOF_CutRangeCPA::initialize()
 
   m_cpa_engine = new CPAEngine(m_cny, m_cnx, m_cnh, m_cnv, m_osy, m_osx);
 
+  vector<double> courses;
+  unsigned int i, crs_pts = m_domain.getVarPoints(m_crs_ix);
+  for(i=0; i<crs_pts; i++)
+    courses.push_back(m_domain.getVal(m_crs_ix, i));
+  m_cpa_engine->setCourseCache(courses);
+
   double max_ownship_spd = m_domain.getVarHigh(m_spd_ix);
 
   m_cpa_engine->minMaxROC(max_ownship_spd, 360, m_min_roc, m_max_roc);
@@ -190,10 +196,7 @@ void AOF_CutRangeCPA::okLowSpeeds()
 
 double AOF_CutRangeCPA::evalBox(const IvPBox *b) const
 {
-  double eval_crs = 0;
   double eval_spd = 0;
-
-  m_domain.getVal(m_crs_ix, b->pt(m_crs_ix,0), eval_crs);
   m_domain.getVal(m_spd_ix, b->pt(m_spd_ix,0), eval_spd);
 
   if((m_discourage_low_speeds == true) && 
@@ -204,7 +207,55 @@ double AOF_CutRangeCPA::evalBox(const IvPBox *b) const
 
   // Calculate the CPA distance and the RateOfClosure for a maneuver
   double roc;
-  double eval_dist = m_cpa_engine->evalCPA(eval_crs, eval_spd, m_tol, &roc);
+  double eval_dist = m_cpa_engine->evalCPAByIndex(b->pt(m_crs_ix,0), 
+						  eval_spd, m_tol, &roc);
+  return(compromise(eval_dist, roc));
+}
+
+//----------------------------------------------------------------
+// Procedure: evalGrid
+//   Purpose: Eval a grid of <course, speed> points with one call to
+//            the CPA engine. Values are identical to evalBox() on 
+//            each point.
+
+bool AOF_CutRangeCPA::evalGrid(const vector<vector<int> >& pts,
+			       vector<double>& vals) const
+{
+  if(!m_cpa_engine || (pts.size() != 2) || (m_crs_ix < 0) || (m_spd_ix < 0))
+    return(false);
+
+  const vector<int>& spd_pts = pts[m_spd_ix];
+  unsigned int c, csize = pts[m_crs_ix].size();
+  unsigned int s, ssize = spd_pts.size();
+  vector<double> spds(ssize);
+  for(s=0; s<ssize; s++)
+    spds[s] = m_domain.getVal(m_spd_ix, spd_pts[s]);
+
+  bool crs_fastest = (m_crs_ix == 0);
+  vector<double> rocs;
+  m_cpa_engine->evalCPAGrid(pts[m_crs_ix], spds, m_tol, vals, &rocs, 
+			    crs_fastest);
+
+  for(s=0; s<ssize; s++) {
+    bool low_speed = (m_discourage_low_speeds && 
+		      (spds[s] <= m_discourage_low_speeds_thresh));
+    for(c=0; c<csize; c++) {
+      unsigned int gix = crs_fastest ? (c + s*csize) : (s + c*ssize);
+      if(low_speed)
+	vals[gix] = m_discourage_low_speeds_value;
+      else
+	vals[gix] = compromise(vals[gix], rocs[gix]);
+    }
+  }
+  return(true);
+}
+
+//----------------------------------------------------------------
+// Procedure: compromise
+//   Purpose: Calculate a valuation based on the ROC and CPA
+
+double AOF_CutRangeCPA::compromise(double eval_dist, double roc) const
+{
   double metric_eval = metric(eval_dist);
 
   // Calculate the normalized RateOfClosure based on the ROC and Range
@@ -214,9 +265,7 @@ double AOF_CutRangeCPA::evalBox(const IvPBox *b) const
 
   // Calculate a valuation based on the ROC and CPA
   double pct = m_patience / 100.0;
-  double compromise = ((1.0-pct) * nroc) + (pct * metric_eval);
-
-  return(compromise);
+  return(((1.0-pct) * nroc) + (pct * metric_eval));
 }
 
 //----------------------------------------------------------------
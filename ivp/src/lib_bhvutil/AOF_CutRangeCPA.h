@@ -34,6 +34,8 @@ public:
 
 public:    
   double evalBox(const IvPBox*) const;   // virtual defined
+  bool   evalGrid(const std::vector<std::vector<int> >&,
+		  std::vector<double>&) const;   // virtual defined
   bool   setParam(const std::string&, double);
   bool   initialize();
   
@@ -42,6 +44,7 @@ public:
 
 protected:
   double metric(double) const;
+  double compromise(double eval_dist, double roc) const;
 
 protected:
   int    m_crs_ix;  // Index of "course" variable in IvPDomain
@@ -21,12 +21,17 @@
 /* <http://www.gnu.org/licenses/>.                               */
 /*****************************************************************/
 
+#include <cstring>
 #include "NodeRecord.h"
 #include "MBUtils.h"
 #include "AngleUtils.h"
 
 using namespace std;
 
+static void appendUInt(string&, unsigned int, unsigned int);
+static void appendDouble(string&, double);
+static void appendString(string&, const string&);
+
 #ifndef M_PI
 #define M_PI 3.1415926
 #endif
@@ -44,6 +49,8 @@ NodeRecord::NodeRecord(string vname, string vtype)
   m_speed_og   = 0;
   m_heading    = 0;
   m_heading_og = 0;
+  m_yaw        = 0;
+  m_pitch      = 0;
   m_depth      = 0;
   m_altitude   = 0;
   m_timestamp  = 0;
@@ -61,6 +68,8 @@ NodeRecord::NodeRecord(string vname, string vtype)
   m_speed_og_set   = false;
   m_heading_set    = false;
   m_heading_og_set = false;
+  m_yaw_set        = false;
+  m_pitch_set      = false;
   m_depth_set      = false;
   m_altitude_set   = false;
   m_length_set     = false;
@@ -216,6 +225,90 @@ string NodeRecord::getSpec() const
   return(str);
 }
 
+//------------------------------------------------------------
+// Procedure: getBinarySpec()
+//   Purpose: Build the binary form of the node report. It carries
+//            the same information as getSpec() but numeric fields
+//            are packed at fixed offsets rather than printed, so
+//            neither end pays for number formatting or parsing.
+//            Posted as a MOOS binary string. Decoded by
+//            string2NodeRecord() along with the text form.
+//
+//   Layout (version 1, all integers and doubles little-endian):
+//     [0-3]    0x00 'N' 'R' version
+//     [4-5]    bitmask of the numeric fields that are set, with
+//              bit 14 holding thrust_mode_reverse
+//     [6-9]    index
+//     [10-121] 14 doubles: x, y, spd, spd_og, hdg, hdg_og, yaw,
+//              pitch, depth, altitude, lat, lon, length, time
+//     then     name, type, group, mode, mode_aux, allstop and
+//              load_warning, each a 2-byte length and the chars
+//     then     a 2-byte count of properties, each a key string
+//              followed by a value string as above
+
+string NodeRecord::getBinarySpec() const
+{
+  unsigned int mask = 0;
+  if(m_x_set)            mask |= (1<<0);
+  if(m_y_set)            mask |= (1<<1);
+  if(m_speed_set)        mask |= (1<<2);
+  if(m_speed_og_set)     mask |= (1<<3);
+  if(m_heading_set)      mask |= (1<<4);
+  if(m_heading_og_set)   mask |= (1<<5);
+  if(m_yaw_set)          mask |= (1<<6);
+  if(m_pitch_set)        mask |= (1<<7);
+  if(m_depth_set)        mask |= (1<<8);
+  if(m_altitude_set)     mask |= (1<<9);
+  if(m_lat_set)          mask |= (1<<10);
+  if(m_lon_set)          mask |= (1<<11);
+  if(m_length_set)       mask |= (1<<12);
+  if(m_timestamp_set)    mask |= (1<<13);
+  if(m_thrust_mode_reverse) mask |= (1<<14);
+
+  string str;
+  str.reserve(160 + m_name.length() + m_type.length());
+  str += '\0';
+  str += 'N';
+  str += 'R';
+  str += (char)(1);
+
+  appendUInt(str, mask, 2);
+  appendUInt(str, (unsigned int)(m_index), 4);
+
+  appendDouble(str, m_x);
+  appendDouble(str, m_y);
+  appendDouble(str, m_speed);
+  appendDouble(str, m_speed_og);
+  appendDouble(str, m_heading);
+  appendDouble(str, m_heading_og);
+  // Mirror getSpec() which reports YAW derived from the heading
+  appendDouble(str, headingToRadians(m_heading));
+  appendDouble(str, m_pitch);
+  appendDouble(str, m_depth);
+  appendDouble(str, m_altitude);
+  appendDouble(str, m_lat);
+  appendDouble(str, m_lon);
+  appendDouble(str, m_length);
+  appendDouble(str, m_timestamp);
+
+  appendString(str, m_name);
+  appendString(str, m_type);
+  appendString(str, m_group);
+  appendString(str, m_mode);
+  appendString(str, m_mode_aux);
+  appendString(str, m_allstop);
+  appendString(str, m_load_warning);
+
+  appendUInt(str, m_properties.size(), 2);
+  map<string, string>::const_iterator p;
+  for(p=m_properties.begin(); p!=m_properties.end(); p++) {
+    appendString(str, p->first);
+    appendString(str, p->second);
+  }
+
+  return(str);
+}
+
 //---------------------------------------------------------------
 // Procedure: getName
 
@@ -361,5 +454,48 @@ bool NodeRecord::valid(string check, string& why) const
   return(true);
 }
 
+//---------------------------------------------------------------
+// Procedure: appendUInt
+//   Purpose: Append the lowest nbytes of val, least significant first
+
+static void appendUInt(string& str, unsigned int val, unsigned int nbytes)
+{
+  for(unsigned int i=0; i<nbytes; i++)
+    str += (char)((val >> (8*i)) & 0xFF);
+}
+
+//---------------------------------------------------------------
+// Procedure: appendDouble
+//   Purpose: Append the 8 bytes of an IEEE double in little-endian
+//            order regardless of the host byte order
 
+static void appendDouble(string& str, double val)
+{
+  unsigned char bytes[sizeof(double)];
+  memcpy(bytes, &val, sizeof(double));
+
+  const unsigned int one = 1;
+  bool little_endian = (*((const unsigned char*)(&one)) == 1);
+
+  for(unsigned int i=0; i<sizeof(double); i++) {
+    if(little_endian)
+      str += (char)(bytes[i]);
+    else
+      str += (char)(bytes[sizeof(double)-1-i]);
+  }
+}
+
+//---------------------------------------------------------------
+// Procedure: appendString
+//   Purpose: Append a string preceded by its 2-byte length. Strings
+//            longer than 65535 chars are truncated.
+
+static void appendString(string& str, const string& val)
+{
+  unsigned int len = val.length();
+  if(len > 0xFFFF)
+    len = 0xFFFF;
+  appendUInt(str, len, 2);
+  str.append(val, 0, len);
+}
 
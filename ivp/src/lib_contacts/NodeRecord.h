@@ -101,6 +101,7 @@ class NodeRecord
   std::string getLoadWarning(std::string s="") const;
 
   std::string getSpec() const;
+  std::string getBinarySpec() const;
 
   std::string getStringValue(std::string) const;
 
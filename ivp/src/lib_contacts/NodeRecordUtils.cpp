@@ -22,11 +22,16 @@
 /*****************************************************************/
 
 #include <cstdlib>
+#include <cstring>
 #include "NodeRecordUtils.h"
 #include "MBUtils.h"
 
 using namespace std;
 
+static bool readUInt(const string&, unsigned int&, unsigned int, unsigned int&);
+static bool readDouble(const string&, unsigned int&, double&);
+static bool readString(const string&, unsigned int&, string&);
+
 //---------------------------------------------------------
 // Procedure: string2NodeRecord
 //   Example: NAME=alpha,TYPE=KAYAK,UTC_TIME=1267294386.51,
@@ -36,6 +41,9 @@ using namespace std;
 
 NodeRecord string2NodeRecord(const string& node_rep_string, bool returnPartialResult)
 {
+  if(isBinaryNodeReport(node_rep_string))
+    return(binary2NodeRecord(node_rep_string));
+
   NodeRecord empty_record;
   NodeRecord new_record;
 
@@ -102,6 +110,138 @@ NodeRecord string2NodeRecord(const string& node_rep_string, bool returnPartialRe
   return(new_record);
 }
 
+//---------------------------------------------------------
+// Procedure: isBinaryNodeReport
+//      Note: A text node report never begins with a null char,
+//            so the leading 0x00 'N' 'R' marks the binary form.
+
+bool isBinaryNodeReport(const string& str)
+{
+  if(str.length() < 4)
+    return(false);
+  return((str[0] == '\0') && (str[1] == 'N') && (str[2] == 'R'));
+}
+
+//---------------------------------------------------------
+// Procedure: binary2NodeRecord
+//      Note: Decodes the form built by NodeRecord::getBinarySpec().
+//            An empty record is returned if the version is not
+//            known or the report is truncated.
+
+NodeRecord binary2NodeRecord(const string& str)
+{
+  NodeRecord empty_record;
+  if(!isBinaryNodeReport(str) || (str[3] != 1))
+    return(empty_record);
+
+  unsigned int ix = 4;
+  unsigned int mask  = 0;
+  unsigned int index = 0;
+  double vals[14];
+
+  bool ok = readUInt(str, ix, 2, mask) && readUInt(str, ix, 4, index);
+  for(unsigned int i=0; ok && (i<14); i++)
+    ok = readDouble(str, ix, vals[i]);
+
+  string name, type, group, mode, mode_aux, allstop, load_warning;
+  ok = ok && readString(str, ix, name) && readString(str, ix, type);
+  ok = ok && readString(str, ix, group) && readString(str, ix, mode);
+  ok = ok && readString(str, ix, mode_aux) && readString(str, ix, allstop);
+  ok = ok && readString(str, ix, load_warning);
+  if(!ok)
+    return(empty_record);
+
+  NodeRecord new_record(name, type);
+  new_record.setGroup(group);
+  new_record.setMode(mode);
+  new_record.setModeAux(mode_aux);
+  new_record.setAllStop(allstop);
+  new_record.setLoadWarning(load_warning);
+  new_record.setIndex((int)(index));
 
+  if(mask & (1<<0))   new_record.setX(vals[0]);
+  if(mask & (1<<1))   new_record.setY(vals[1]);
+  if(mask & (1<<2))   new_record.setSpeed(vals[2]);
+  if(mask & (1<<3))   new_record.setSpeedOG(vals[3]);
+  if(mask & (1<<4))   new_record.setHeading(vals[4]);
+  if(mask & (1<<5))   new_record.setHeadingOG(vals[5]);
+  if(mask & (1<<6))   new_record.setYaw(vals[6]);
+  if(mask & (1<<7))   new_record.setPitch(vals[7]);
+  if(mask & (1<<8))   new_record.setDepth(vals[8]);
+  if(mask & (1<<9))   new_record.setAltitude(vals[9]);
+  if(mask & (1<<10))  new_record.setLat(vals[10]);
+  if(mask & (1<<11))  new_record.setLon(vals[11]);
+  if(mask & (1<<12))  new_record.setLength(vals[12]);
+  if(mask & (1<<13))  new_record.setTimeStamp(vals[13]);
+  if(mask & (1<<14))  new_record.setThrustModeReverse(true);
+
+  unsigned int props = 0;
+  if(!readUInt(str, ix, 2, props))
+    return(new_record);
+  for(unsigned int i=0; i<props; i++) {
+    string key, value;
+    if(!readString(str, ix, key) || !readString(str, ix, value))
+      break;
+    new_record.setProperty(key, value);
+  }
+
+  return(new_record);
+}
 
+//---------------------------------------------------------
+// Procedure: readUInt
+//   Purpose: Read an nbytes little-endian unsigned int at ix,
+//            advancing ix. False if the string is too short.
+
+static bool readUInt(const string& str, unsigned int& ix,
+		     unsigned int nbytes, unsigned int& val)
+{
+  if((ix + nbytes) > str.length())
+    return(false);
+
+  val = 0;
+  for(unsigned int i=0; i<nbytes; i++)
+    val |= ((unsigned int)((unsigned char)(str[ix+i]))) << (8*i);
+  ix += nbytes;
+  return(true);
+}
+
+//---------------------------------------------------------
+// Procedure: readDouble
+//   Purpose: Read a little-endian IEEE double at ix, advancing ix
+
+static bool readDouble(const string& str, unsigned int& ix, double& val)
+{
+  if((ix + sizeof(double)) > str.length())
+    return(false);
+
+  const unsigned int one = 1;
+  bool little_endian = (*((const unsigned char*)(&one)) == 1);
+
+  unsigned char bytes[sizeof(double)];
+  for(unsigned int i=0; i<sizeof(double); i++) {
+    if(little_endian)
+      bytes[i] = (unsigned char)(str[ix+i]);
+    else
+      bytes[sizeof(double)-1-i] = (unsigned char)(str[ix+i]);
+  }
+  memcpy(&val, bytes, sizeof(double));
+  ix += sizeof(double);
+  return(true);
+}
+
+//---------------------------------------------------------
+// Procedure: readString
+//   Purpose: Read a 2-byte length and that many chars at ix
+
+static bool readString(const string& str, unsigned int& ix, string& val)
+{
+  unsigned int len = 0;
+  if(!readUInt(str, ix, 2, len) || ((ix + len) > str.length()))
+    return(false);
+
+  val = str.substr(ix, len);
+  ix += len;
+  return(true);
+}
 
@@ -28,6 +28,9 @@
 
 NodeRecord string2NodeRecord(const std::string&, bool retPartialResult=false);
 
+bool       isBinaryNodeReport(const std::string&);
+NodeRecord binary2NodeRecord(const std::string&);
+
 #endif 
 
 
@@ -117,6 +117,153 @@ double CPAEngine::evalCPA(double osCRS, double osSPD,
   double cgamOS = cos(gamOS);             // Cosine of Angle (osCRS).
   double sgamOS = sin(gamOS);             // Sine   of Angle (osCRS).
 
+  return(evalCPATrig(osCRS, cgamOS, sgamOS, osSPD, osTOL, calcROC));
+}
+
+//----------------------------------------------------------------
+// Procedure: setCourseCache
+//   Purpose: Precompute the cosine and sine of each given ownship
+//            course so evalCPAByIndex() and evalCPAGrid() need no trig.
+
+void CPAEngine::setCourseCache(const vector<double>& courses)
+{
+  m_os_crs_cache.clear();
+  m_os_cos_cache.clear();
+  m_os_sin_cache.clear();
+
+  unsigned int i, vsize = courses.size();
+  for(i=0; i<vsize; i++) {
+    double crs = angle360(courses[i]);
+    double gam = degToRadians(crs);
+    m_os_crs_cache.push_back(crs);
+    m_os_cos_cache.push_back(cos(gam));
+    m_os_sin_cache.push_back(sin(gam));
+  }
+}
+
+//----------------------------------------------------------------
+// Procedure: evalCPAByIndex
+//   Purpose: Same as evalCPA() but with the ownship course given as
+//            an index into the course cache. If the index is out of
+//            range of the cache, zero is returned.
+
+double CPAEngine::evalCPAByIndex(unsigned int crs_ix, double osSPD,
+				 double osTOL, double *calcROC) const
+{
+  if(crs_ix >= m_os_crs_cache.size()) {
+    if(calcROC)
+      *calcROC = 0;
+    return(0);
+  }
+  return(evalCPATrig(m_os_crs_cache[crs_ix], m_os_cos_cache[crs_ix],
+		     m_os_sin_cache[crs_ix], osSPD, osTOL, calcROC));
+}
+
+//----------------------------------------------------------------
+// Procedure: evalCPAGrid
+//   Purpose: Evaluate the CPA over the grid of the given ownship 
+//            course indices by the given speeds, sharing one time-
+//            on-leg. Results are written with the speed varying 
+//            fastest, or the course if crs_fastest is true, and are
+//            identical to evalCPAByIndex() on each pair. 
+//      Note: The terms depending only on the course are taken out
+//            of the speed loop, keeping the order of operations of
+//            evalCPATrig() so that no result changes. The speed 
+//            loop is straight-line arithmetic the compiler may
+//            vectorize. Courses out of range of the cache give 0.
+
+void CPAEngine::evalCPAGrid(const vector<int>& crs_ixs,
+			    const vector<double>& osvs, double osTOL,
+			    vector<double>& cpas, vector<double>* calcROCs,
+			    bool crs_fastest) const
+{
+  unsigned int c, csize = crs_ixs.size();
+  unsigned int s, ssize = osvs.size();
+
+  cpas.resize(csize * ssize);
+  if(calcROCs)
+    calcROCs->resize(csize * ssize);
+
+  unsigned int c_stride = ssize;
+  unsigned int s_stride = 1;
+  if(crs_fastest) {
+    c_stride = 1;
+    s_stride = csize;
+  }
+
+  double k0      = statK0;
+  double dist_k0 = sqrt(statK0);
+
+  unsigned int cache_size = m_os_crs_cache.size();
+  for(c=0; c<csize; c++) {
+    int ix = crs_ixs[c];
+    if((ix < 0) || ((unsigned int)(ix) >= cache_size)) {
+      for(s=0; s<ssize; s++) {
+	cpas[c*c_stride + s*s_stride] = 0;
+	if(calcROCs)
+	  (*calcROCs)[c*c_stride + s*s_stride] = 0;
+      }
+      continue;
+    }
+
+    double osCRS  = m_os_crs_cache[ix];
+    double cgamOS = m_os_cos_cache[ix];
+    double sgamOS = m_os_sin_cache[ix];
+    double cc     = cgamOS * cgamOS;
+    double ss     = sgamOS * sgamOS;
+    double m2c    = (-2.0) * cgamOS;
+    double m2s    = (-2.0) * sgamOS;
+    double p2c    = ( 2.0) * cgamOS;
+    double p2s    = ( 2.0) * sgamOS;
+    bool   same_crs = (cnCRS == osCRS);
+
+    for(s=0; s<ssize; s++) {
+      double osSPD = osvs[s];
+
+      double k2 = statK2;
+      k2 += cc * osSPD * osSPD;
+      k2 += ss * osSPD * osSPD;
+      k2 += m2c * osSPD * cgamCN * cnSPD;
+      k2 += m2s * osSPD * sgamCN * cnSPD;
+
+      double k1 = statK1;
+      k1 += p2c * osSPD * osLAT;
+      k1 += p2s * osSPD * osLON;
+      k1 += m2c * osSPD * cnLAT;
+      k1 += m2s * osSPD * cnLON;
+
+      double minT = 0;
+      if(k2 != 0)
+	minT = ((-1.0) * k1) / (2.0 * k2);
+      bool approaching = (minT > 0);
+      if(minT >= osTOL)
+	minT = osTOL;
+
+      double cpa_dist = dist_k0;
+      if(approaching) {
+	double dist_squared = (k2*minT*minT) + (k1*minT) + k0;
+	cpa_dist = (dist_squared < 0) ? 0 : sqrt(dist_squared);
+      }
+
+      // Same course and speed as the contact: the range holds
+      bool same = same_crs && (cnSPD == osSPD);
+      unsigned int gix = c*c_stride + s*s_stride;
+      cpas[gix] = same ? dist_k0 : cpa_dist;
+      if(calcROCs)
+	(*calcROCs)[gix] = same ? 0 : -k1;
+    }
+  }
+}
+
+//----------------------------------------------------------------
+// Procedure: evalCPATrig
+//   Purpose: Core of evalCPA() given the ownship course already
+//            normalized to [0,360) along with its cosine and sine.
+
+double CPAEngine::evalCPATrig(double osCRS, double cgamOS, double sgamOS,
+			      double osSPD, double osTOL, 
+			      double *calcROC) const
+{
   double k2 = statK2;
   double k1 = statK1;
   double k0 = statK0;
@@ -38,6 +38,20 @@ public:
 
 public:    
   double evalCPA(double osh, double osv, double ostol, double* calc_roc=0) const;
+
+  // Ownship course cache: the cos/sin of each given course (e.g., each
+  // point in the helm's discrete course domain) are computed once, and
+  // evals may then be requested by the course index.
+  void   setCourseCache(const std::vector<double>& courses);
+  bool   hasCourseCache() const {return(m_os_crs_cache.size() > 0);}
+  double evalCPAByIndex(unsigned int crs_ix, double osv, double ostol,
+			double* calc_roc=0) const;
+  void   evalCPAGrid(const std::vector<int>& crs_ixs, 
+		     const std::vector<double>& osvs, double ostol,
+		     std::vector<double>& cpas, 
+		     std::vector<double>* calc_rocs=0,
+		     bool crs_fastest=false) const;
+
   double evalROC(double osh, double osv) const;
   bool   crossesLines(double osh) const;
 
@@ -72,6 +86,8 @@ public:
   
  protected:
   void   setStatic();
+  double evalCPATrig(double osCRS, double cgamOS, double sgamOS, 
+		     double osSPD, double osTOL, double* calc_roc) const;
   double smallAngle(double, double) const;
 
  protected: // Config parameters
@@ -105,6 +121,10 @@ public:
   double cgamCN;  // Cosine of  cnCRS.
   double sgamCN;  // Sine  of   cnCRS.
 
+  std::vector<double> m_os_crs_cache;  // Course (0-359) per index
+  std::vector<double> m_os_cos_cache;  // Cosine of course per index
+  std::vector<double> m_os_sin_cache;  // Sine of course per index
+
   std::vector<double> m_cn_cache_x;
   std::vector<double> m_cn_cache_y;
   double m_cn_cache_tdelta;
@@ -42,6 +42,20 @@ CurrentField::CurrentField()
   m_active_ix  = 0;
   m_field_name = "generic_cfield";
   m_active_vertex = false;
+
+  m_index_valid = false;
+  m_bin_size    = 0;
+  m_bin_xmin    = 0;
+  m_bin_ymin    = 0;
+  m_bin_cols    = 0;
+  m_bin_rows    = 0;
+
+  m_raster_valid = false;
+  m_raster_size  = 0;
+  m_raster_xmin  = 0;
+  m_raster_ymin  = 0;
+  m_raster_cols  = 0;
+  m_raster_rows  = 0;
 }
 
 //-------------------------------------------------------------------
@@ -72,6 +86,7 @@ bool CurrentField::populate(string filename)
   }
 
   applyRenderHints();
+  buildIndex();
 
   cout << "Done Populating Current Field." << endl;
   cout << "  OK Entries: " << lines_ok << endl;
@@ -88,42 +103,69 @@ void CurrentField::addVector(const XYVector& new_vector, bool marked)
 {
   m_vectors.push_back(new_vector);
   m_vmarked.push_back(marked);
+  clearIndex();
 }
 
 //-------------------------------------------------------------------
 // Procedure: getLocalForce
-//   Purpose: 
+//   Purpose: Determine the force at the given point as the average of
+//            all vectors within m_radius, each weighted by the square
+//            of its relative closeness. If a raster has been built the
+//            force is instead interpolated from the raster.
 
 void CurrentField::getLocalForce(double x, double y, 
 				 double& return_force_x, 
 				 double& return_force_y) const
+{
+  if(m_raster_valid)
+    getLocalForceRaster(x, y, return_force_x, return_force_y);
+  else
+    getLocalForceDirect(x, y, return_force_x, return_force_y);
+}
+
+//-------------------------------------------------------------------
+// Procedure: getLocalForceDirect
+//   Purpose: If the spatial index is valid, only the vectors in the
+//            bins overlapping the query radius are considered. 
+//            Otherwise all vectors are checked.
+
+void CurrentField::getLocalForceDirect(double x, double y, 
+				       double& return_force_x, 
+				       double& return_force_y) const
 {
   double total_force_x = 0;
   double total_force_y = 0;
   unsigned int count = 0;
 
-  unsigned int i, vsize = m_vectors.size();
-  for(i=0; i<vsize; i++) {
-    double xpos = m_vectors[i].xpos();
-    double ypos = m_vectors[i].ypos();
-    double dist = distPointToPoint(x, y, xpos, ypos);
-    if(dist < m_radius) {
-      count++;
-
-      // radius = 10
-      // dist = 9, pct = 0.1 --> 0.01
-      // dist = 1, pct = 0.9 --> 0.81
-
-      double pct = (1 - (dist / m_radius));
-      pct = pct * pct;
-      
-      double xdot = pct * m_vectors[i].xdot();
-      double ydot = pct * m_vectors[i].ydot();
-
-      total_force_x += xdot;
-      total_force_y += ydot;
+  if(m_index_valid) {
+    int col_lo = (int)(floor((x - m_radius - m_bin_xmin) / m_bin_size));
+    int col_hi = (int)(floor((x + m_radius - m_bin_xmin) / m_bin_size));
+    int row_lo = (int)(floor((y - m_radius - m_bin_ymin) / m_bin_size));
+    int row_hi = (int)(floor((y + m_radius - m_bin_ymin) / m_bin_size));
+    if(col_lo < 0) col_lo = 0;
+    if(row_lo < 0) row_lo = 0;
+    if(col_hi >= (int)(m_bin_cols)) col_hi = (int)(m_bin_cols) - 1;
+    if(row_hi >= (int)(m_bin_rows)) row_hi = (int)(m_bin_rows) - 1;
+
+    for(int row=row_lo; row<=row_hi; row++) {
+      for(int col=col_lo; col<=col_hi; col++) {
+	const vector<unsigned int>& bin = m_bins[(row * m_bin_cols) + col];
+	unsigned int i, bsize = bin.size();
+	for(i=0; i<bsize; i++) {
+	  if(addLocalForce(bin[i], x, y, total_force_x, total_force_y))
+	    count++;
+	}
+      }
+    }
+  }
+  else {
+    unsigned int i, vsize = m_vectors.size();
+    for(i=0; i<vsize; i++) {
+      if(addLocalForce(i, x, y, total_force_x, total_force_y))
+	count++;
     }
   }
+
   if(count == 0) {
     return_force_x = 0;
     return_force_y = 0;
@@ -134,6 +176,219 @@ void CurrentField::getLocalForce(double x, double y,
   return_force_y = total_force_y / (double)(count); 
 }
 
+//-------------------------------------------------------------------
+// Procedure: addLocalForce
+//   Purpose: Add the weighted force of vector ix to the running total
+//            if the vector is within m_radius of the given point.
+//   Returns: true if the vector was within range.
+
+bool CurrentField::addLocalForce(unsigned int ix, double x, double y,
+				 double& total_force_x, 
+				 double& total_force_y) const
+{
+  double xpos = m_vectors[ix].xpos();
+  double ypos = m_vectors[ix].ypos();
+  double dist = distPointToPoint(x, y, xpos, ypos);
+  if(dist >= m_radius)
+    return(false);
+
+  // radius = 10
+  // dist = 9, pct = 0.1 --> 0.01
+  // dist = 1, pct = 0.9 --> 0.81
+  
+  double pct = (1 - (dist / m_radius));
+  pct = pct * pct;
+  
+  total_force_x += pct * m_vectors[ix].xdot();
+  total_force_y += pct * m_vectors[ix].ydot();
+  return(true);
+}
+
+//-------------------------------------------------------------------
+// Procedure: getLocalForceRaster
+//   Purpose: Bilinear interpolation between the four raster nodes 
+//            surrounding the given point. Outside the raster there
+//            are no vectors in range and the force is zero.
+
+void CurrentField::getLocalForceRaster(double x, double y, 
+				       double& return_force_x, 
+				       double& return_force_y) const
+{
+  return_force_x = 0;
+  return_force_y = 0;
+
+  double gx = (x - m_raster_xmin) / m_raster_size;
+  double gy = (y - m_raster_ymin) / m_raster_size;
+  if((gx < 0) || (gy < 0))
+    return;
+
+  unsigned int col = (unsigned int)(gx);
+  unsigned int row = (unsigned int)(gy);
+  if((col+1 >= m_raster_cols) || (row+1 >= m_raster_rows))
+    return;
+
+  double tx = gx - (double)(col);
+  double ty = gy - (double)(row);
+
+  unsigned int ix00 = (row * m_raster_cols) + col;
+  unsigned int ix10 = ix00 + 1;
+  unsigned int ix01 = ix00 + m_raster_cols;
+  unsigned int ix11 = ix01 + 1;
+
+  double w00 = (1-tx) * (1-ty);
+  double w10 = tx * (1-ty);
+  double w01 = (1-tx) * ty;
+  double w11 = tx * ty;
+
+  return_force_x = (w00 * m_raster_fx[ix00]) + (w10 * m_raster_fx[ix10]) +
+    (w01 * m_raster_fx[ix01]) + (w11 * m_raster_fx[ix11]);
+  return_force_y = (w00 * m_raster_fy[ix00]) + (w10 * m_raster_fy[ix10]) +
+    (w01 * m_raster_fy[ix01]) + (w11 * m_raster_fy[ix11]);
+}
+
+//-------------------------------------------------------------------
+// Procedure: buildIndex
+//   Purpose: Bin all vectors into a uniform grid with bin size equal
+//            to m_radius, so a force query need only look at the 
+//            (at most) 3x3 bins around the query point. A sparse 
+//            field, with many more bins than vectors, gets larger 
+//            bins instead. Any change to the vectors or radius 
+//            invalidates the index.
+
+void CurrentField::buildIndex()
+{
+  clearIndex();
+
+  unsigned int i, vsize = m_vectors.size();
+  if((vsize == 0) || (m_radius <= 0))
+    return;
+
+  double xmin = m_vectors[0].xpos();
+  double xmax = xmin;
+  double ymin = m_vectors[0].ypos();
+  double ymax = ymin;
+  for(i=1; i<vsize; i++) {
+    double x = m_vectors[i].xpos();
+    double y = m_vectors[i].ypos();
+    if(x < xmin)  xmin = x;
+    if(x > xmax)  xmax = x;
+    if(y < ymin)  ymin = y;
+    if(y > ymax)  ymax = y;
+  }
+
+  // Bound the bins by the number of vectors, doubling the bin size
+  // as needed, so a small radius over a wide field stays indexed
+  double bin_size = m_radius;
+  double max_bins = (double)(vsize * 16 + 1024);
+  double cols = floor((xmax - xmin) / bin_size) + 1;
+  double rows = floor((ymax - ymin) / bin_size) + 1;
+  while((cols * rows) > max_bins) {
+    bin_size *= 2;
+    cols = floor((xmax - xmin) / bin_size) + 1;
+    rows = floor((ymax - ymin) / bin_size) + 1;
+  }
+
+  m_bin_size = bin_size;
+  m_bin_xmin = xmin;
+  m_bin_ymin = ymin;
+  m_bin_cols = (unsigned int)(cols);
+  m_bin_rows = (unsigned int)(rows);
+  m_bins = vector<vector<unsigned int> >(m_bin_cols * m_bin_rows);
+
+  for(i=0; i<vsize; i++) {
+    unsigned int col, row;
+    col = (unsigned int)((m_vectors[i].xpos() - xmin) / bin_size);
+    row = (unsigned int)((m_vectors[i].ypos() - ymin) / bin_size);
+    if(col >= m_bin_cols)  col = m_bin_cols - 1;
+    if(row >= m_bin_rows)  row = m_bin_rows - 1;
+    m_bins[(row * m_bin_cols) + col].push_back(i);
+  }
+  m_index_valid = true;
+}
+
+//-------------------------------------------------------------------
+// Procedure: buildRaster
+//   Purpose: Precompute the force at the nodes of a regular grid with
+//            the given cell size, covering all vectors plus m_radius.
+//            Subsequent getLocalForce() queries are answered in 
+//            constant time by bilinear interpolation. Any change to
+//            the vectors or radius discards the raster.
+//   Returns: false if the cell size is non-positive or the raster
+//            would be unreasonably large.
+
+bool CurrentField::buildRaster(double cell_size)
+{
+  m_raster_valid = false;
+  m_raster_fx.clear();
+  m_raster_fy.clear();
+
+  unsigned int i, vsize = m_vectors.size();
+  if((vsize == 0) || (cell_size <= 0))
+    return(false);
+
+  if(!m_index_valid)
+    buildIndex();
+
+  double xmin = m_vectors[0].xpos();
+  double xmax = xmin;
+  double ymin = m_vectors[0].ypos();
+  double ymax = ymin;
+  for(i=1; i<vsize; i++) {
+    double x = m_vectors[i].xpos();
+    double y = m_vectors[i].ypos();
+    if(x < xmin)  xmin = x;
+    if(x > xmax)  xmax = x;
+    if(y < ymin)  ymin = y;
+    if(y > ymax)  ymax = y;
+  }
+  xmin -= m_radius;
+  ymin -= m_radius;
+  xmax += m_radius;
+  ymax += m_radius;
+
+  double cols = ceil((xmax - xmin) / cell_size) + 1;
+  double rows = ceil((ymax - ymin) / cell_size) + 1;
+  if((cols * rows) > 16000000)
+    return(false);
+
+  m_raster_size = cell_size;
+  m_raster_xmin = xmin;
+  m_raster_ymin = ymin;
+  m_raster_cols = (unsigned int)(cols);
+  m_raster_rows = (unsigned int)(rows);
+  m_raster_fx   = vector<double>(m_raster_cols * m_raster_rows, 0);
+  m_raster_fy   = vector<double>(m_raster_cols * m_raster_rows, 0);
+
+  for(unsigned int row=0; row<m_raster_rows; row++) {
+    double y = ymin + (row * cell_size);
+    for(unsigned int col=0; col<m_raster_cols; col++) {
+      double x = xmin + (col * cell_size);
+      unsigned int ix = (row * m_raster_cols) + col;
+      getLocalForceDirect(x, y, m_raster_fx[ix], m_raster_fy[ix]);
+    }
+  }
+
+  m_raster_valid = true;
+  return(true);
+}
+
+//-------------------------------------------------------------------
+// Procedure: clearIndex
+//   Purpose: Invalidate the spatial index and any raster. Called 
+//            whenever the vectors or the radius are modified.
+
+void CurrentField::clearIndex()
+{
+  m_index_valid = false;
+  m_bins.clear();
+  m_bin_cols = 0;
+  m_bin_rows = 0;
+
+  m_raster_valid = false;
+  m_raster_fx.clear();
+  m_raster_fy.clear();
+}
+
 //-------------------------------------------------------------------
 // Procedure: setRadius
 //   Purpose: 
@@ -143,6 +398,12 @@ void CurrentField::setRadius(double radius)
   if(radius < 1)
     radius = 1;
   m_radius = radius;
+
+  // Bin size is tied to the radius so rebuild if previously indexed
+  bool reindex = m_index_valid;
+  clearIndex();
+  if(reindex)
+    buildIndex();
 }
 
 //-------------------------------------------------------------------
@@ -260,6 +521,7 @@ bool CurrentField::deleteVector(unsigned int ix)
 
   m_vectors = new_vectors;
   m_vmarked = new_vmarked;
+  clearIndex();
   return(true);
 }
 
@@ -296,6 +558,7 @@ void CurrentField::deleteMarkedVectors()
 
   m_vectors = new_vectors;
   m_vmarked = new_vmarked;
+  clearIndex();
 }
 
 //-------------------------------------------------------------------
@@ -312,6 +575,7 @@ void CurrentField::modVector(unsigned int ix, string param, double value)
     m_vectors[ix].shift_horz(value);
   else if(param == "aug_y")
     m_vectors[ix].shift_vert(value);
+  clearIndex();
 }
 
 //-------------------------------------------------------------------
@@ -372,6 +636,7 @@ void CurrentField::applySnap(double snapval)
   unsigned int i, vsize = m_vectors.size();
   for(i=0; i<vsize; i++)
     m_vectors[i].applySnap(snapval);
+  clearIndex();
 }
 
 //-------------------------------------------------------------------
@@ -553,6 +818,7 @@ bool CurrentField::handleLine(string line)
       return(false);
     double val = atof(line.c_str());
     m_radius = val;
+    clearIndex();
     return(true);
   }
     
@@ -563,9 +829,7 @@ bool CurrentField::handleLine(string line)
   }
     
   XYVector new_vector = string2Vector(line);
-  if(new_vector.valid())
-    addVector(new_vector);
-  else
+  if(!new_vector.valid())
     return(false);
 
 #if 0
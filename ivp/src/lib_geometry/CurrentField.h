@@ -39,6 +39,9 @@ public:
   void addVector(const XYVector&, bool marked=false);
   void getLocalForce(double x, double y, double& fx, double& fy) const;
   void setRadius(double radius);
+  void buildIndex();
+  void clearIndex();
+  bool buildRaster(double cell_size);
   bool initGeodesy(double datum_lat, double datum_lon);
   void print();
 
@@ -77,7 +80,17 @@ public:
 
   std::vector<std::string> getListing();
 
+  bool indexed() const  {return(m_index_valid);}
+  bool rastered() const {return(m_raster_valid);}
+
  protected:
+  void   getLocalForceDirect(double x, double y, 
+			     double& fx, double& fy) const;
+  void   getLocalForceRaster(double x, double y, 
+			     double& fx, double& fy) const;
+  bool   addLocalForce(unsigned int ix, double x, double y,
+		       double& fx, double& fy) const;
+
   bool   handleLine(std::string);
   void   applyRenderHints();
   void   applyRenderHint(std::string, std::string);
@@ -93,6 +106,24 @@ protected:
 
   std::vector<std::string> m_render_hints;
 
+ protected: // Spatial index. Uniform bins, no smaller than m_radius
+  bool         m_index_valid;
+  double       m_bin_size;
+  double       m_bin_xmin;
+  double       m_bin_ymin;
+  unsigned int m_bin_cols;
+  unsigned int m_bin_rows;
+  std::vector<std::vector<unsigned int> > m_bins;
+
+ protected: // Optional precomputed raster of the field, row-major
+  bool         m_raster_valid;
+  double       m_raster_size;
+  double       m_raster_xmin;
+  double       m_raster_ymin;
+  unsigned int m_raster_cols;
+  unsigned int m_raster_rows;
+  std::vector<double> m_raster_fx;
+  std::vector<double> m_raster_fy;
 };
 
 #endif 
@@ -121,6 +121,7 @@ bool XYConvexGrid::initialize(const XYPolygon& poly,
   
   for(i=0; i<esize; i++)
     m_cell_vals.push_back(cell_init_vals);
+  m_cell_changed = vector<bool>(m_elements.size(), false);
 
   m_cell_vars      = cell_vars;
   m_cell_init_vals = cell_init_vals;
@@ -227,6 +228,8 @@ void XYConvexGrid::setVal(unsigned int ix, double val,
     val = m_cell_min_limit[cix];
     
   // Set the value of the cell IX for cell var CIX
+  if(m_cell_vals[ix][cix] != val)
+    noteDelta(ix);
   m_cell_vals[ix][cix] = val;
 
   
@@ -481,6 +484,8 @@ void XYConvexGrid::reset()
   for(ix=0; ix<esize; ix++) {
     for(cix=0; cix<csize; cix++) {
       double init_val = m_cell_init_vals[cix];
+      if(m_cell_vals[ix][cix] != init_val)
+	noteDelta(ix);
       m_cell_vals[ix][cix] = init_val;
     }
   }
@@ -508,6 +513,8 @@ void XYConvexGrid::reset(const string& cell_var)
   unsigned int ix,  esize = m_elements.size();
   for(ix=0; ix<esize; ix++) {
     double init_val = m_cell_init_vals[cix];
+    if(m_cell_vals[ix][cix] != init_val)
+      noteDelta(ix);
     m_cell_vals[ix][cix] = init_val;
   }
 
@@ -536,6 +543,8 @@ string XYConvexGrid::get_spec() const
     for(cix=0; cix<csize; cix++) {
       if(m_cell_vals[ix][cix] != m_cell_init_vals[cix]) {
 	double dval = m_cell_vals[ix][cix];
+	if(cell_spec != "")
+	  cell_spec += ":";
 	cell_spec += m_cell_vars[cix] + ":" + doubleToStringX(dval);	
       }
     }
@@ -554,6 +563,95 @@ string XYConvexGrid::get_spec() const
 
 
 
+//-------------------------------------------------------------
+// Procedure: get_delta_spec
+//   Purpose: Serialize only the cells changed since the last call
+//            to clearDeltas(). All cell vars of a changed cell are
+//            included since a value may have returned to its 
+//            initial value. Format is generally like:
+//            "label=psg,cell=23:x:4:y:0,cell=24:x:5:y:1"
+
+string XYConvexGrid::get_delta_spec() const
+{
+  string spec = "label=" + get_label();
+
+  unsigned int i, dsize = m_delta_ixs.size();
+  for(i=0; i<dsize; i++) {
+    unsigned int ix = m_delta_ixs[i];
+    spec += ",cell=" + uintToString(ix);
+    unsigned int cix, csize = m_cell_vars.size();
+    for(cix=0; cix<csize; cix++) {
+      spec += ":" + m_cell_vars[cix] + ":";
+      spec += doubleToStringX(m_cell_vals[ix][cix]);
+    }
+  }
+  return(spec);
+}
+
+//-------------------------------------------------------------
+// Procedure: processDelta
+//   Purpose: Apply a delta produced by get_delta_spec() of a grid
+//            with the same configuration and label. Returns false
+//            if the label does not match or an entry is malformed.
+
+bool XYConvexGrid::processDelta(const string& str)
+{
+  string rest = str;
+  string label = biteStringX(rest, ',');
+  if(biteStringX(label, '=') != "label")
+    return(false);
+  if(label != get_label())
+    return(false);
+
+  bool ok = true;
+  while(rest != "") {
+    string entry = biteStringX(rest, ',');
+    if(biteStringX(entry, '=') != "cell") {
+      ok = false;
+      continue;
+    }
+    string index = biteString(entry, ':');
+    if(!isNumber(index)) {
+      ok = false;
+      continue;
+    }
+    unsigned int ix = atoi(index.c_str());
+    while(entry != "") {
+      string cell_var = biteString(entry, ':');
+      string value = biteString(entry, ':');
+      if(hasCellVar(cell_var) && isNumber(value)) {
+	unsigned int cix = getCellVarIX(cell_var);
+	setVal(ix, atof(value.c_str()), cix);
+      }
+      else
+	ok = false;
+    }
+  }
+  return(ok);
+}
+
+//-------------------------------------------------------------
+// Procedure: clearDeltas
+
+void XYConvexGrid::clearDeltas()
+{
+  unsigned int i, dsize = m_delta_ixs.size();
+  for(i=0; i<dsize; i++)
+    m_cell_changed[m_delta_ixs[i]] = false;
+  m_delta_ixs.clear();
+}
+
+//-------------------------------------------------------------
+// Procedure: noteDelta
+
+void XYConvexGrid::noteDelta(unsigned int ix)
+{
+  if((ix >= m_cell_changed.size()) || m_cell_changed[ix])
+    return;
+  m_cell_changed[ix] = true;
+  m_delta_ixs.push_back(ix);
+}
+
 //-------------------------------------------------------------
 // Procedure: getConfigStr
 //   Purpose: Return a serialized version of just the grid config
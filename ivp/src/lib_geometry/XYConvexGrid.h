@@ -60,6 +60,12 @@ public:
   std::string  getConfigStr() const;
   std::string  get_spec() const;
 
+  // Delta support: only cells changed since the last clearDeltas()
+  std::string  get_delta_spec() const;
+  bool         processDelta(const std::string&);
+  void         clearDeltas();
+  unsigned int getDeltaCnt() const {return(m_delta_ixs.size());}
+
   void    setVal(unsigned int ix, double val, unsigned int cix=0);
   void    incVal(unsigned int ix, double val, unsigned int cix=0);
   void    setMinLimit(double, unsigned int cix=0);
@@ -81,6 +87,7 @@ public:
 
 protected:
   bool    initialize(const XYSquare&, const XYSquare&);
+  void    noteDelta(unsigned int ix);
     
  protected: // Config variables
   XYPolygon m_config_poly;
@@ -107,6 +114,10 @@ protected:
   std::vector<double>                m_cell_max_sofar;
   std::vector<double>                m_cell_min_sofar;
   std::vector<bool>                  m_cell_minmax_noted;
+
+  // Index is per grid element. Cells changed since last clearDeltas()
+  std::vector<bool>                  m_cell_changed;
+  std::vector<unsigned int>          m_delta_ixs;
 };
 
 #endif
@@ -102,7 +102,7 @@ void BehaviorReport::makeKeysUnique()
   // For example "depth", "course:speed"
   for(i=0; i<vsize; i++) {
     if(m_key[i] == "") {
-      IvPDomain domain = m_ipf[i]->getPDMap()->getDomain();
+      IvPDomain domain = m_ipf[i]->getDomain();
       m_key[i] = domainToString(domain, false);
     }
   }
@@ -247,7 +247,7 @@ double BehaviorReport::getAvgPieces() const
   double count = 0;
   for(i=0; i<vsize; i++) 
     if(m_ipf[i])
-      count += m_ipf[i]->getPDMap()->size();
+      count += m_ipf[i]->size();
 
   return(count / (double)(vsize));
 }
@@ -38,6 +38,7 @@ BehaviorSet::BehaviorSet()
 {
   m_report_ipf = true;
   m_curr_time  = -1;
+  m_ipf_report_interval = 0;
   m_bfactory_dynamic.loadEnvVarDirectories("IVP_BEHAVIOR_DIRS");
 
   m_total_behaviors_ever = 0;
@@ -51,6 +52,13 @@ BehaviorSet::BehaviorSet()
 BehaviorSet::~BehaviorSet()
 {
   clearBehaviors();
+  for(unsigned int i=0; i<m_reported_ipfs.size(); i++)
+    delete(m_reported_ipfs[i]);
+
+  map<unsigned int, IvPBehavior*>::iterator p;
+  for(p=m_spec_templates.begin(); p!=m_spec_templates.end(); p++)
+    if(p->second)
+      delete(p->second);
 }
 
 //------------------------------------------------------------
@@ -236,9 +244,13 @@ bool BehaviorSet::buildBehaviorsFromSpecs()
 
 //------------------------------------------------------------
 // Procedure: buildBehaviorFromSpec()
+//      Note: If helm_start is false the behavior's onHelmStart() is
+//            not invoked, as for a template from which behaviors
+//            will later be cloned.
 
 SpecBuild BehaviorSet::buildBehaviorFromSpec(BehaviorSpec spec, 
-					     string update_str)
+					     string update_str,
+					     bool helm_start)
 {
   SpecBuild    sbuild;
   string       bhv_kind = spec.getKind();
@@ -304,6 +316,101 @@ SpecBuild BehaviorSet::buildBehaviorFromSpec(BehaviorSpec spec,
   // Then apply all the behavior specs from an UPDATES string which may
   // possibly be empty.
   // NOTE: If the update_str is non-empty we can assume this is a spawning
+  bool updates_valid = applyUpdateStr(bhv, update_str, sbuild);
+  specs_valid = specs_valid && updates_valid;
+
+  if(specs_valid) {
+    sbuild.setIvPBehavior(bhv);
+    // Added Oct 1313 mikerb - allow template behaviors to make an initial
+    // posting on helm startup, even if no instance made on startup (or ever).
+    if(helm_start)
+      bhv->onHelmStart();
+    // The behavior may now have some messages (var-data pairs) ready for 
+    // retrieval
+  }
+  else {
+    delete(bhv);
+  }
+
+  return(sbuild);
+}
+
+
+//------------------------------------------------------------
+// Procedure: buildBehaviorFromTemplate()
+//   Purpose: Spawn a behavior by cloning the template for the given
+//            spec and applying only the UPDATES string. The result
+//            is the same as building it from the spec with the 
+//            UPDATES string, without applying the spec yet again.
+
+SpecBuild BehaviorSet::buildBehaviorFromTemplate(unsigned int spec_ix,
+						 string update_str)
+{
+  SpecBuild sbuild;
+  if(spec_ix >= m_behavior_specs.size())
+    return(sbuild);
+
+  BehaviorSpec& spec = m_behavior_specs[spec_ix];
+  sbuild.setBehaviorKind(spec.getKind(), spec.getKindLine());
+
+  IvPBehavior *tmpl = getSpecTemplate(spec_ix);
+  IvPBehavior *bhv  = 0;
+  if(tmpl)
+    bhv = tmpl->clone();
+  if(!bhv) {
+    sbuild.setKindResult("failed");
+    return(sbuild);
+  }
+  sbuild.setKindResult("clone");
+  
+  if(applyUpdateStr(bhv, update_str, sbuild)) {
+    sbuild.setIvPBehavior(bhv);
+    bhv->onHelmStart();
+  }
+  else
+    delete(bhv);
+
+  return(sbuild);
+}
+
+//------------------------------------------------------------
+// Procedure: getSpecTemplate()
+//   Purpose: Return the template for the given spec, building it
+//            on first use. Null if the spec's behavior kind cannot
+//            be cloned, or the spec is not valid.
+
+IvPBehavior* BehaviorSet::getSpecTemplate(unsigned int spec_ix)
+{
+  if(m_spec_templates.count(spec_ix))
+    return(m_spec_templates[spec_ix]);
+
+  IvPBehavior *tmpl = 0;
+  if(spec_ix < m_behavior_specs.size()) {
+    SpecBuild sbuild = buildBehaviorFromSpec(m_behavior_specs[spec_ix], 
+					     "", false);
+    tmpl = sbuild.getIvPBehavior();
+  }
+
+  // Confirm the behavior kind supports cloning
+  if(tmpl && !tmpl->isCloneable()) {
+    delete(tmpl);
+    tmpl = 0;
+  }
+
+  m_spec_templates[spec_ix] = tmpl;
+  return(tmpl);
+}
+
+//------------------------------------------------------------
+// Procedure: applyUpdateStr()
+//   Purpose: Apply the parameters of an UPDATES string, e.g., on
+//            spawning a behavior. Bad parameters are noted in the
+//            given SpecBuild. Returns false if any were bad.
+
+bool BehaviorSet::applyUpdateStr(IvPBehavior *bhv, string update_str,
+				 SpecBuild& sbuild)
+{
+  bool all_valid = true;
   vector<string> jvector = parseStringQ(update_str, '#');
   unsigned int j, jsize = jvector.size();
   for(j=0; j<jsize; j++) {
@@ -327,24 +434,11 @@ SpecBuild BehaviorSet::buildBehaviorFromSpec(BehaviorSpec spec,
       addWarning(msg);
     }
 
-    specs_valid = specs_valid && valid;
+    all_valid = all_valid && valid;
   }
-  if(specs_valid) {
-    sbuild.setIvPBehavior(bhv);
-    // Added Oct 1313 mikerb - allow template behaviors to make an initial
-    // posting on helm startup, even if no instance made on startup (or ever).
-    bhv->onHelmStart();
-    // The behavior may now have some messages (var-data pairs) ready for 
-    // retrieval
-  }
-  else {
-    delete(bhv);
-  }
-
-  return(sbuild);
+  return(all_valid);
 }
 
-
 //------------------------------------------------------------
 // Procedure: handlePossibleSpawnings
 //   Purpose: Called typically once on each iteration of the helm
@@ -367,8 +461,12 @@ bool BehaviorSet::handlePossibleSpawnings()
 	string bname = tokStringParse(update_str, "name", '#', '=');
 	//	string fullname = m_behavior_specs[i].getNamePrefix() + bname;
 	if(m_bhv_names.count(bname)==0) {
-	  SpecBuild sbuild = buildBehaviorFromSpec(m_behavior_specs[i], 
-						   update_str);
+	  // Clone from the spec's template if its kind allows it
+	  SpecBuild sbuild;
+	  if(getSpecTemplate(i))
+	    sbuild = buildBehaviorFromTemplate(i, update_str);
+	  else
+	    sbuild = buildBehaviorFromSpec(m_behavior_specs[i], update_str);
 	  //sbuild.print();
 
 	  LifeEvent life_event;
@@ -465,21 +563,38 @@ IvPFunction* BehaviorSet::produceOF(unsigned int ix,
     // Step 3: If IvP function has non-positive priority, abort
     if(ipf) {
       pwt = ipf->getPWT();
-      pcs = ipf->getPDMap()->size();
+      pcs = ipf->size();
       if(pwt <= 0) {
 	delete(ipf);
 	ipf = 0;
 	pcs = 0;
       }
     }
-    // Step 4: If we're serializing and posting IvP functions, do here
+    // Step 4: If we're reporting IvP functions, hold on to it here.
+    // Serializing and posting is left to the helm application so
+    // it need not happen on the helm's critical path. The function
+    // is shared with the helm engine rather than copied.
     if(ipf && m_report_ipf) {
       string desc_str = bhv->getDescriptor();
-      string iter_str = uintToString(iteration);
-      string ctxt_str = iter_str + ":" + desc_str;
-      ipf->setContextStr(ctxt_str);
-      string ipf_str = IvPFunctionToString(ipf);
-      bhv->postMessage("BHV_IPF", ipf_str);
+      double interval = m_ipf_report_interval;
+      if(m_ipf_report_intervals.count(desc_str))
+	interval = m_ipf_report_intervals[desc_str];
+      bool report_due = true;
+      if(m_ipf_report_tstamp.count(desc_str)) {
+	double elapsed = m_curr_time - m_ipf_report_tstamp[desc_str];
+	if(elapsed < interval)
+	  report_due = false;
+      }
+      if(report_due) {
+	string iter_str = uintToString(iteration);
+	string ctxt_str = iter_str + ":" + desc_str;
+	ipf->setContextStr(ctxt_str);
+	m_reported_ipfs.push_back(ipf);
+	m_reported_descs.push_back(desc_str);
+	m_reported_scales.push_back(1);
+	m_reported_shifts.push_back(0);
+	m_ipf_report_tstamp[desc_str] = m_curr_time;
+      }
     }
     // Step 5: Handle normal case of healthy IvP function returned
     if(ipf) {
@@ -518,6 +633,95 @@ IvPFunction* BehaviorSet::produceOF(unsigned int ix,
   return(ipf);
 }
 
+//------------------------------------------------------------
+// Procedure: setIPFReportInterval
+//   Purpose: Set the minimum time between reported IvP functions
+//            for the named behavior, or all behaviors if no name.
+
+void BehaviorSet::setIPFReportInterval(double interval, string bhv)
+{
+  if(interval < 0)
+    interval = 0;
+  if(bhv == "")
+    m_ipf_report_interval = interval;
+  else
+    m_ipf_report_intervals[bhv] = interval;
+}
+
+//------------------------------------------------------------
+// Procedure: isReportedIPF
+//   Purpose: Determine if the given IvP function, produced by a
+//            behavior this iteration, is held for reporting.
+
+bool BehaviorSet::isReportedIPF(IvPFunction *ipf) const
+{
+  for(unsigned int i=0; i<m_reported_ipfs.size(); i++)
+    if(m_reported_ipfs[i] == ipf)
+      return(true);
+  return(false);
+}
+
+//------------------------------------------------------------
+// Procedure: copyReportedIPF
+//   Purpose: Hold a copy of the given IvP function for reporting in
+//            place of the function itself. For use by the helm engine
+//            when it will change the function in ways that cannot
+//            be undone, or will not hand it back.
+
+bool BehaviorSet::copyReportedIPF(IvPFunction *ipf)
+{
+  for(unsigned int i=0; i<m_reported_ipfs.size(); i++) {
+    if(m_reported_ipfs[i] == ipf) {
+      m_reported_ipfs[i] = ipf->copy();
+      return(true);
+    }
+  }
+  return(false);
+}
+
+//------------------------------------------------------------
+// Procedure: setReportedIPFWeights
+//   Purpose: Note the weight change made to an IvP function held for
+//            reporting, to be undone as w*scale+shift before the
+//            function is reported.
+
+bool BehaviorSet::setReportedIPFWeights(IvPFunction *ipf, 
+					double scale, double shift)
+{
+  for(unsigned int i=0; i<m_reported_ipfs.size(); i++) {
+    if(m_reported_ipfs[i] == ipf) {
+      m_reported_scales[i] = scale;
+      m_reported_shifts[i] = shift;
+      return(true);
+    }
+  }
+  return(false);
+}
+
+//------------------------------------------------------------
+// Procedure: pullReportedIPFs
+//   Purpose: Hand over the IvP functions held for reporting since
+//            the last call. The caller takes ownership of them.
+//            The descriptor of the producing behavior, and the 
+//            weight change to be undone, are put in the given 
+//            vectors at the same index.
+
+vector<IvPFunction*> BehaviorSet::pullReportedIPFs(vector<string>& descs,
+						   vector<double>& scales,
+						   vector<double>& shifts)
+{
+  vector<IvPFunction*> rvector = m_reported_ipfs;
+  descs  = m_reported_descs;
+  scales = m_reported_scales;
+  shifts = m_reported_shifts;
+  
+  m_reported_ipfs.clear();
+  m_reported_descs.clear();
+  m_reported_scales.clear();
+  m_reported_shifts.clear();
+  return(rvector);
+}
+
 //------------------------------------------------------------
 // Procedure: produceOFX
 
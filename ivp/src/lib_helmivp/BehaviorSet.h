@@ -27,6 +27,7 @@
 #include <string>
 #include <vector>
 #include <set>
+#include <map>
 #include "IvPBehavior.h"
 #include "IvPDomain.h"
 #include "VarDataPair.h"
@@ -51,7 +52,9 @@ public:
   void       setDomain(IvPDomain domain);
   void       connectInfoBuffer(InfoBuffer*);
   bool       buildBehaviorsFromSpecs();
-  SpecBuild  buildBehaviorFromSpec(BehaviorSpec spec, std::string s="");
+  SpecBuild  buildBehaviorFromSpec(BehaviorSpec spec, std::string s="",
+				   bool helm_start=true);
+  SpecBuild  buildBehaviorFromTemplate(unsigned int spec_ix, std::string s);
   bool       handlePossibleSpawnings();
 
   void   addBehavior(IvPBehavior *b);
@@ -68,6 +71,14 @@ public:
   unsigned int size()                   {return(m_bhv_entry.size());}
 
   void         setReportIPF(bool v)     {m_report_ipf=v;}
+  void         setIPFReportInterval(double v, std::string bhv="");
+  bool         isReportedIPF(IvPFunction*) const;
+  bool         copyReportedIPF(IvPFunction*);
+  bool         setReportedIPFWeights(IvPFunction*, double scale, 
+				     double shift);
+  std::vector<IvPFunction*> pullReportedIPFs(std::vector<std::string>&,
+					     std::vector<double>& scales,
+					     std::vector<double>& shifts);
   bool         stateOK(unsigned int);
   void         resetStateOK();
   IvPFunction* produceOF(unsigned int ix, unsigned int iter, 
@@ -120,6 +131,10 @@ public:
 
   void print();
 
+protected:
+  IvPBehavior* getSpecTemplate(unsigned int spec_ix);
+  bool         applyUpdateStr(IvPBehavior*, std::string, SpecBuild&);
+
 protected:
   std::vector<BehaviorSetEntry> m_bhv_entry;
   std::set<std::string>         m_bhv_names;
@@ -137,9 +152,29 @@ protected:
   BFactoryStatic                m_bfactory_static;
   BFactoryDynamic               m_bfactory_dynamic;
 
+  // Behaviors configured from a templating spec, indexed by spec, 
+  // and cloned on spawning so the spec need not be applied again.
+  // Null for specs whose behavior kind cannot be cloned.
+  std::map<unsigned int, IvPBehavior*> m_spec_templates;
+
   std::vector<LifeEvent>        m_life_events;
 
   bool    m_report_ipf;
+
+  // IvP functions to be reported are held here, with the behavior
+  // descriptor, until pulled by the helm application. They are not
+  // copied but shared with the helm engine, which hands them back
+  // after solving along with the weight change to be undone, as
+  // w*scale+shift. Reporting is limited to once per interval for
+  // each behavior.
+  std::vector<IvPFunction*>     m_reported_ipfs;
+  std::vector<std::string>      m_reported_descs;
+  std::vector<double>           m_reported_scales;
+  std::vector<double>           m_reported_shifts;
+  double                        m_ipf_report_interval;
+  std::map<std::string, double> m_ipf_report_intervals;
+  std::map<std::string, double> m_ipf_report_tstamp;
+
   double  m_curr_time;
   bool    m_completed_pending;
 
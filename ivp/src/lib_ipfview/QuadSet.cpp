@@ -92,11 +92,14 @@ bool QuadSet::applyIPF1D(IvPFunction *ipf, string source)
 
   unsigned int i, total_pts = m_ivp_domain.getVarPoints(0);
 
-  IvPBox ptbox(1);
+  vector<double> pvals;
+  pdmap->rasterize(pdmap->getUniverse(), pvals);
+  if(pvals.size() != total_pts)
+    return(false);
+
   for(i=0; i<total_pts; i++) {
-    ptbox.setPTS(0, i, i);
     double domain_val = m_ivp_domain.getVal(0, i);
-    double range_val = pdmap->evalPoint(&ptbox) * priority_wt;
+    double range_val = pvals[i] * priority_wt;
     domain_pts.push_back(domain_val);
     domain_ptsx.push_back(false);
     range_vals.push_back(range_val);
@@ -164,18 +167,26 @@ bool QuadSet::applyIPF2D(IvPFunction *ipf)
       vals[i][j] = 0;
   }
 
-  // Create the "sample" box 
-  IvPBox sbox(m_ivp_domain.size());
-  
+  // Evaluate the whole domain at once, the first variable varying
+  // fastest in the results
+  PDMap *pdmap = ipf->getPDMap();
+  vector<double> pvals;
+  pdmap->rasterize(pdmap->getUniverse(), pvals);
+  if(pvals.size() != (crs_pts * spd_pts)) {
+    for(i=0; i<crs_pts; i++) 
+      delete [] vals[i];
+    delete [] vals;
+    return(false);
+  }
+
   int crs_ix = m_ivp_domain.getIndex("course");
-  int spd_ix = m_ivp_domain.getIndex("speed");
+  unsigned int crs_stride = (crs_ix == 0) ? 1 : spd_pts;
+  unsigned int spd_stride = (crs_ix == 0) ? crs_pts : 1;
 
   double priority_wt = ipf->getPWT();
   for(i=0; i<crs_pts; i++) {
-    sbox.setPTS(crs_ix, i, i);
     for(j=0; j<spd_pts; j++) {
-      sbox.setPTS(spd_ix, j, j);
-      double pval = priority_wt * ipf->getPDMap()->evalPoint(&sbox);
+      double pval = priority_wt * pvals[(i*crs_stride) + (j*spd_stride)];
       pval = snapToStep(pval, m_snap_val);
       vals[i][j] = pval;
     }
@@ -46,6 +46,15 @@ public:
   {return(0);}
 
   virtual double evalPoint(const std::vector<double>&) const {return(0);}
+
+  // Optional bulk form of evalBox(). An AOF that can evaluate a grid
+  // of points more cheaply together returns true. The grid is given
+  // by the point indices on each domain variable, and vals is sized
+  // to hold the evalBox() value of every grid point, the first 
+  // variable varying fastest. The values are used as given, so an
+  // AOF relying on evalPoint() or evalBoxDebug() should not offer it.
+  virtual bool  evalGrid(const std::vector<std::vector<int> >&, 
+			 std::vector<double>&) const {return(false);}
   virtual bool  initialize() {return(true);}
   virtual bool  setParam(const std::string&, double) {return(false);}
   virtual bool  setParam(const std::string&, const std::string&) 
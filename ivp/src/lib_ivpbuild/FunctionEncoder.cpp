@@ -25,6 +25,8 @@
 
 #include <iostream>
 #include <cstdio>
+#include <cstring>
+#include <vector>
 #include "MBUtils.h"
 #include "BuildUtils.h"
 #include "FunctionEncoder.h"
@@ -32,6 +34,257 @@
 
 using namespace std;
 
+//--------------------------------------------------------------
+// Local helpers for the binary body. The packed pieces are
+// carried as base64 so that the whole function is still a plain
+// string with no commas or white space in the body.
+//
+// Packed body, version 1 (all values little-endian):
+//
+//   [version][options]    options bit 0 - weights are quantized
+//   If quantized, wtc pairs of float32 (low,high) giving the range
+//   of each weight over all pieces. Then for each piece:
+//
+//   (3*dim+wtc+7)/8 bytes of flags
+//     bit 3d      low bound of dimension d is open
+//     bit 3d+1    high bound of dimension d is open
+//     bit 3d+2    interval on dimension d same as previous piece
+//     bit 3dim+j  weight j same as previous piece
+//   For each dimension not repeated, two varints
+//     low relative to the previous piece's high+1 (zigzag)
+//     high-low
+//   For each weight not repeated
+//     float32, or uint16 over the weight's range if quantized
+//
+// Pieces are mostly laid out in runs across the domain so the
+// relative bounds are nearly always zero or one byte.
+
+#define IPF_BINARY_VERSION 1
+
+static const char b64_chars[] = 
+  "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+static string base64Encode(const unsigned char *raw, unsigned int len)
+{
+  string result(((len+2)/3)*4, '=');
+
+  unsigned int i, rix = 0;
+  for(i=0; (i+2)<len; i+=3) {
+    unsigned int val = (raw[i] << 16) | (raw[i+1] << 8) | raw[i+2];
+    result[rix++] = b64_chars[(val >> 18) & 0x3F];
+    result[rix++] = b64_chars[(val >> 12) & 0x3F];
+    result[rix++] = b64_chars[(val >> 6) & 0x3F];
+    result[rix++] = b64_chars[val & 0x3F];
+  }
+  if(i < len) {
+    unsigned int val = raw[i] << 16;
+    if((i+1) < len)
+      val |= raw[i+1] << 8;
+    result[rix++] = b64_chars[(val >> 18) & 0x3F];
+    result[rix++] = b64_chars[(val >> 12) & 0x3F];
+    if((i+1) < len)
+      result[rix++] = b64_chars[(val >> 6) & 0x3F];
+  }
+  return(result);
+}
+
+// The inverse of b64_chars, -1 for characters outside the alphabet.
+// A constant table, so it is ready before any thread may decode.
+static const signed char b64_lookup[256] = {
+  -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+  -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+  -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,62,-1,-1,-1,63,
+  52,53,54,55,56,57,58,59,60,61,-1,-1,-1,-1,-1,-1,
+  -1, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9,10,11,12,13,14,
+  15,16,17,18,19,20,21,22,23,24,25,-1,-1,-1,-1,-1,
+  -1,26,27,28,29,30,31,32,33,34,35,36,37,38,39,40,
+  41,42,43,44,45,46,47,48,49,50,51,-1,-1,-1,-1,-1,
+  -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+  -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+  -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+  -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+  -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+  -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+  -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+  -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1
+};
+
+static bool base64Decode(const char *str, unsigned int len,
+			 vector<unsigned char>& raw)
+{
+  raw.resize((len/4)*3 + 3);
+
+  unsigned int rix  = 0;
+  unsigned int val  = 0;
+  int          bits = 0;
+  for(unsigned int i=0; i<len; i++) {
+    if(str[i] == '=')
+      break;
+    int c = b64_lookup[(unsigned char)str[i]];
+    if(c < 0)
+      return(false);
+    val  = (val << 6) | (unsigned int)c;
+    bits += 6;
+    if(bits >= 8) {
+      bits -= 8;
+      raw[rix++] = (unsigned char)((val >> bits) & 0xFF);
+    }
+  }
+  raw.resize(rix);
+  return(true);
+}
+
+static unsigned int putVarint(unsigned char *buff, unsigned int val)
+{
+  unsigned int ix = 0;
+  while(val >= 0x80) {
+    buff[ix++] = (unsigned char)((val & 0x7F) | 0x80);
+    val >>= 7;
+  }
+  buff[ix++] = (unsigned char)val;
+  return(ix);
+}
+
+static bool getVarint(const vector<unsigned char>& buff, 
+		      unsigned int& ix, unsigned int& val)
+{
+  val = 0;
+  for(int shift=0; (shift<35) && (ix<buff.size()); shift+=7) {
+    unsigned char byte = buff[ix++];
+    val |= ((unsigned int)(byte & 0x7F)) << shift;
+    if(!(byte & 0x80))
+      return(true);
+  }
+  return(false);
+}
+
+static unsigned int zigzag(int val)
+{
+  return((((unsigned int)val) << 1) ^ (unsigned int)(val >> 31));
+}
+
+static int unzigzag(unsigned int val)
+{
+  return((int)(val >> 1) ^ -(int)(val & 1));
+}
+
+static unsigned int putFloat(unsigned char *buff, double dval)
+{
+  float fval = (float)dval;
+  unsigned int bits;
+  memcpy(&bits, &fval, 4);
+  for(int k=0; k<4; k++)
+    buff[k] = (unsigned char)((bits >> (8*k)) & 0xFF);
+  return(4);
+}
+
+static bool getFloat(const vector<unsigned char>& buff, 
+		     unsigned int& ix, double& dval)
+{
+  if((ix+4) > buff.size())
+    return(false);
+  unsigned int bits = 0;
+  for(int k=0; k<4; k++)
+    bits |= ((unsigned int)buff[ix+k]) << (8*k);
+  ix += 4;
+  float fval;
+  memcpy(&fval, &bits, 4);
+  dval = (double)fval;
+  return(true);
+}
+
+//--------------------------------------------------------------
+// Procedure: binaryToPDMap
+//   Purpose: Unpack the base64 body written by 
+//            IvPFunctionToBinaryString. Returns NULL if the body
+//            is malformed, of an unknown version, or does not 
+//            hold the expected pieces.
+
+static PDMap *binaryToPDMap(const char *body, unsigned int len,
+			    const IvPDomain& domain,
+			    int pcs, int dim, int deg)
+{
+  vector<unsigned char> raw;
+  if(!base64Decode(body, len, raw) || (raw.size() < 2))
+    return(0);
+  if(raw[0] != IPF_BINARY_VERSION)
+    return(0);
+
+  bool quantized  = ((raw[1] & 0x01) != 0);
+  int  wtc        = (deg*dim)+1;
+  int  flag_bytes = ((3*dim)+wtc+7) / 8;
+  unsigned int ix = 2;
+
+  vector<double> wt_low(wtc, 0);
+  vector<double> wt_rng(wtc, 0);
+  if(quantized) {
+    for(int j=0; j<wtc; j++) {
+      double hgh = 0;
+      if(!getFloat(raw, ix, wt_low[j]) || !getFloat(raw, ix, hgh))
+	return(0);
+      wt_rng[j] = (hgh - wt_low[j]) / 65535.0;
+    }
+  }
+
+  PDMap  *pdmap = new PDMap(pcs, domain, deg);
+  IvPBox *prev  = 0;
+  for(int i=0; i<pcs; i++) {
+    if((ix + flag_bytes) > raw.size()) {
+      delete(pdmap);
+      return(0);
+    }
+    IvPBox *newbox = new IvPBox(dim,deg);
+    pdmap->bx(i) = newbox;
+
+    const unsigned char *flags = &raw[ix];
+    ix += flag_bytes;
+
+    bool ok = true;
+    for(int d=0; ok && (d<dim); d++) {
+      int bit = 3*d;
+      if(flags[bit/8] & (1 << (bit%8)))
+	newbox->bd(d,0) = 0;
+      bit++;
+      if(flags[bit/8] & (1 << (bit%8)))
+	newbox->bd(d,1) = 0;
+      bit++;
+      if(prev && (flags[bit/8] & (1 << (bit%8)))) 
+	newbox->setPTS(d, prev->pt(d,0), prev->pt(d,1));
+      else {
+	unsigned int rel  = 0;
+	unsigned int span = 0;
+	ok = getVarint(raw, ix, rel) && getVarint(raw, ix, span);
+	int low = unzigzag(rel);
+	if(prev)
+	  low += prev->pt(d,1) + 1;
+	newbox->setPTS(d, low, low + (int)span);
+      }
+    }
+    for(int j=0; ok && (j<wtc); j++) {
+      int bit = (3*dim) + j;
+      if(prev && (flags[bit/8] & (1 << (bit%8))))
+	newbox->wt(j) = prev->wt(j);
+      else if(quantized) {
+	ok = ((ix+2) <= raw.size());
+	if(ok) {
+	  unsigned int qval = raw[ix] | (raw[ix+1] << 8);
+	  ix += 2;
+	  newbox->wt(j) = wt_low[j] + (qval * wt_rng[j]);
+	}
+      }
+      else
+	ok = getFloat(raw, ix, newbox->wt(j));
+    }
+
+    if(!ok) {
+      delete(pdmap);
+      return(0);
+    }
+    prev = newbox;
+  }
+  return(pdmap);
+}
+
 //--------------------------------------------------------------
 // Procedure: IvPFunctionToString
 //      Note: cstr is short for context_string
@@ -238,6 +491,164 @@ string IvPFunctionToString(IvPFunction *ivp_function)
   return(return_string);
 }
 
+//--------------------------------------------------------------
+// Procedure: IvPFunctionToBinaryString
+//   Purpose: Same header as IvPFunctionToString, but the pieces
+//            are packed rather than printed (see the notes on the
+//            binary body above), which is several times smaller 
+//            and faster to build and parse. Weights are float32,
+//            about seven significant digits. This is finer than the
+//            four decimal places of the text form only for weights
+//            under about 800 in magnitude, and coarser above that.
+//            If quantized, weights are 16 bits over the range of
+//            each weight across all pieces.
+//
+// H,cstr_len,cstr,dim,pcs,deg,pwt,
+// D,course;0;359;360:speed;0;8;9,G,9,4,
+// B,<base64 body>
+
+string IvPFunctionToBinaryString(IvPFunction *ivp_function, bool quantize)
+{
+  PDMap *pdmap = ivp_function->getPDMap();
+  if(!pdmap || (pdmap->size() == 0)) 
+    return("");
+
+  int dim = ivp_function->getDim();
+  int pcs = pdmap->size();
+  int deg = pdmap->getDegree();
+  int wtc = pdmap->bx(0)->getWtc();
+  double pwt  = ivp_function->getPWT();
+  string cstr = ivp_function->getContextStr();
+
+  string str = "H," + intToString(cstr.length()) + "," + cstr + ",";
+  str += intToString(dim) + "," + intToString(pcs) + ",";
+  str += intToString(deg) + ",";
+  str += dstringCompact(doubleToString(pwt)) + ",D,";
+
+  string domain_str = domainToString(pdmap->getDomain());
+  str += findReplace(domain_str, ',', ';') + ",G,";
+
+  IvPBox gelbox = pdmap->getGelBox();
+  for(int d=0; d<dim; d++)
+    str += intToString(gelbox.pt(d, 1)) + ",";
+
+  int i, j, d;
+  int flag_bytes = ((3*dim)+wtc+7) / 8;
+
+  unsigned int max_size = 2 + (wtc*8);
+  max_size += pcs * (flag_bytes + (dim*10) + (wtc*4));
+  vector<unsigned char> raw(max_size);
+  unsigned char *buff = &raw[0];
+  unsigned int ix = 0;
+
+  buff[ix++] = IPF_BINARY_VERSION;
+  buff[ix++] = quantize ? 0x01 : 0x00;
+
+  vector<double> wt_low(wtc, 0);
+  vector<double> wt_hgh(wtc, 0);
+  if(quantize) {
+    for(j=0; j<wtc; j++) 
+      wt_low[j] = wt_hgh[j] = pdmap->bx(0)->wt(j);
+    for(i=1; i<pcs; i++) {
+      for(j=0; j<wtc; j++) {
+	double wt = pdmap->bx(i)->wt(j);
+	if(wt < wt_low[j])
+	  wt_low[j] = wt;
+	if(wt > wt_hgh[j])
+	  wt_hgh[j] = wt;
+      }
+    }
+    // The range is sent as float32 so quantize on what arrives
+    for(j=0; j<wtc; j++) {
+      ix += putFloat(buff+ix, wt_low[j]);
+      ix += putFloat(buff+ix, wt_hgh[j]);
+      wt_low[j] = (double)((float)wt_low[j]);
+      wt_hgh[j] = (double)((float)wt_hgh[j]);
+    }
+  }
+
+  IvPBox *prev = 0;
+  for(i=0; i<pcs; i++) {
+    IvPBox *ibox = pdmap->bx(i);
+    unsigned char *flags = buff+ix;
+    memset(flags, 0, flag_bytes);
+    ix += flag_bytes;
+
+    for(d=0; d<dim; d++) {
+      int bit = 3*d;
+      if(ibox->bd(d,0)==0)
+	flags[bit/8] |= (1 << (bit%8));
+      bit++;
+      if(ibox->bd(d,1)==0)
+	flags[bit/8] |= (1 << (bit%8));
+      bit++;
+      int low = ibox->pt(d,0);
+      int hgh = ibox->pt(d,1);
+      if(prev && (prev->pt(d,0) == low) && (prev->pt(d,1) == hgh))
+	flags[bit/8] |= (1 << (bit%8));
+      else {
+	int ref = 0;
+	if(prev)
+	  ref = prev->pt(d,1) + 1;
+	ix += putVarint(buff+ix, zigzag(low - ref));
+	ix += putVarint(buff+ix, (unsigned int)(hgh - low));
+      }
+    }
+    for(j=0; j<wtc; j++) {
+      int    bit = (3*dim) + j;
+      double wt  = ibox->wt(j);
+      if(prev && (prev->wt(j) == wt))
+	flags[bit/8] |= (1 << (bit%8));
+      else if(quantize) {
+	unsigned int qval = 0;
+	double range = wt_hgh[j] - wt_low[j];
+	if(range > 0) {
+	  double frac = (wt - wt_low[j]) / range;
+	  if(frac < 0)
+	    frac = 0;
+	  if(frac > 1)
+	    frac = 1;
+	  qval = (unsigned int)((frac * 65535) + 0.5);
+	}
+	buff[ix++] = (unsigned char)(qval & 0xFF);
+	buff[ix++] = (unsigned char)(qval >> 8);
+      }
+      else
+	ix += putFloat(buff+ix, wt);
+    }
+    prev = ibox;
+  }
+
+  str += "B," + base64Encode(buff, ix);
+  return(str);
+}
+
+//--------------------------------------------------------------
+// Procedure: isBinaryIPFString
+//   Purpose: Determine if the body following the grid is binary.
+//            Only the header is examined.
+
+bool isBinaryIPFString(const string& str)
+{
+  if((str.length() < 2) || (str[0] != 'H'))
+    return(false);
+
+  // Skip past the context string which may hold anything
+  unsigned int cix = 2;
+  unsigned int cstr_len = 0;
+  while((cix < str.length()) && (str[cix] != ',')) {
+    cstr_len = (cstr_len * 10) + (unsigned int)(str[cix]-48);
+    cix++;
+  }
+  cix += cstr_len + 2;
+
+  // The text body holds only digits, signs and X's after the grid
+  string::size_type gix = str.find(",G,", cix);
+  if(gix == string::npos)
+    return(false);
+  return(str.find(",B,", gix) != string::npos);
+}
+
 //--------------------------------------------------------------
 // Procedure: IvPFunctionToVector
 //   Purpose: 
@@ -406,78 +817,84 @@ IvPFunction *StringToIvPFunction(const string& str)
     gelbox.setPTS(d,0,val);
   }
 
-  // Build the PDMap
+  // Build the PDMap, unpacking the pieces in one go if the
+  // body is binary
   int wtc = (deg*dim)+1;
-  cix += 2;
-
-  PDMap *pdmap = new PDMap(pcs, domain, deg);
-  for(i=0; i<pcs; i++) {
-    IvPBox *newbox = new IvPBox(dim,deg);
-    for(d=0; d<dim; d++) {
-      // Check the LowBound
-      if(str[cix] == 'X') {
-	newbox->bd(d,0) = 0;
-	cix++;
-      }
+  PDMap *pdmap = 0;
+  if(str[cix] == 'B')
+    pdmap = binaryToPDMap(str.c_str()+cix+2, str.length()-(cix+2),
+			  domain, pcs, dim, deg);
+  else {
+    cix += 2;
+    pdmap = new PDMap(pcs, domain, deg);
+    for(i=0; i<pcs; i++) {
+      IvPBox *newbox = new IvPBox(dim,deg);
+      for(d=0; d<dim; d++) {
+	// Check the LowBound
+	if(str[cix] == 'X') {
+	  newbox->bd(d,0) = 0;
+	  cix++;
+	}
 
-      // Determine the low value
-      int low = 0;
-      while(str[cix] != ',') {
-	low = low * 10;
-	low += (int)(str[cix]-48);
+	// Determine the low value
+	int low = 0;
+	while(str[cix] != ',') {
+	  low = low * 10;
+	  low += (int)(str[cix]-48);
+	  cix++;
+	}
 	cix++;
-      }
-      cix++;
 
-      // Check the HighBound
-      if(str[cix] == 'X') {
-	newbox->bd(d,1) = 0;
-	cix++;
-      }
-      // Determine the high value
-      int hgh = 0;
-      while(str[cix] != ',') {
-	hgh = hgh * 10;
-	hgh += (int)(str[cix]-48);
-	cix++;
-      }
-      cix++;
-      newbox->setPTS(d, low, hgh);
-    }  
-
-    // Determine the interior function coefficients
-    for(d=0; d<wtc; d++) {
-      // Begin Extract-Double-From-String Code
-      double sign = 1.0;
-      double coef = 0.0;
-      double frac = 0.1;
-      bool   left_of_decimal = true;
-
-      if(str[cix]=='-') {
-	sign = -1.0;
+	// Check the HighBound
+	if(str[cix] == 'X') {
+	  newbox->bd(d,1) = 0;
+	  cix++;
+	}
+	// Determine the high value
+	int hgh = 0;
+	while(str[cix] != ',') {
+	  hgh = hgh * 10;
+	  hgh += (int)(str[cix]-48);
+	  cix++;
+	}
 	cix++;
-      }
-      while((str[cix] != ',') && (str[cix] != '\0')) {
-	if(str[cix] == '.') {
-	  left_of_decimal = false;
+	newbox->setPTS(d, low, hgh);
+      }  
+
+      // Determine the interior function coefficients
+      for(d=0; d<wtc; d++) {
+	// Begin Extract-Double-From-String Code
+	double sign = 1.0;
+	double coef = 0.0;
+	double frac = 0.1;
+	bool   left_of_decimal = true;
+
+	if(str[cix]=='-') {
+	  sign = -1.0;
+	  cix++;
 	}
-	else {
-	  if(left_of_decimal) {
-	    coef = coef * 10;
-	    coef += (double)(str[cix]-48);
+	while((str[cix] != ',') && (str[cix] != '\0')) {
+	  if(str[cix] == '.') {
+	    left_of_decimal = false;
 	  }
 	  else {
-	    coef += ((double)(str[cix]-48)) * frac;
-	    frac = frac / 10.0;
+	    if(left_of_decimal) {
+	      coef = coef * 10;
+	      coef += (double)(str[cix]-48);
+	    }
+	    else {
+	      coef += ((double)(str[cix]-48)) * frac;
+	      frac = frac / 10.0;
+	    }
 	  }
+	  cix++;
 	}
 	cix++;
+	// End Extract-Double-From-String Code
+	newbox->wt(d) = coef * sign;
       }
-      cix++;
-      // End Extract-Double-From-String Code
-      newbox->wt(d) = coef * sign;
+      pdmap->bx(i) = newbox;
     }
-    pdmap->bx(i) = newbox;
   }
 
   if(!pdmap) {
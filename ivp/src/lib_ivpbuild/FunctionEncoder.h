@@ -32,11 +32,19 @@
 // Convert an IvPFunction to string represntation
 std::string IvPFunctionToString(IvPFunction*);
 
+// Convert an IvPFunction to the compact (binary body) representation,
+// optionally with the weights quantized to 16 bits
+std::string IvPFunctionToBinaryString(IvPFunction*, bool quantize=false);
+
+// True if the string representation carries a binary body
+bool isBinaryIPFString(const std::string&);
+
 // Convert an IvPFunction to a vector of strings
 std::vector<std::string> IvPFunctionToVector(const std::string&, 
 					     const std::string&, int);
 
-// Create an IvPFunction based on a string representation
+// Create an IvPFunction based on a string representation. Either
+// the text or the binary body representation is accepted.
 IvPFunction *StringToIvPFunction(const std::string&);
 
 // Create an IvPFunction Context String without building the function
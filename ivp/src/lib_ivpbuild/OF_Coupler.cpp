@@ -35,9 +35,10 @@ using namespace std;
 
 OF_Coupler::OF_Coupler()
 {
-  m_normalize = true;
-  m_normalmin = 0;
-  m_normalmax = 100;
+  m_normalize   = true;
+  m_normalmin   = 0;
+  m_normalmax   = 100;
+  m_materialize = false;
 }
 
 //-------------------------------------------------------------
@@ -87,18 +88,22 @@ IvPFunction *OF_Coupler::couple(IvPFunction* ipf1, IvPFunction* ipf2,
     return(0);
   }
   
-  ipf1->getPDMap()->normalize(0, wt1);
-  ipf2->getPDMap()->normalize(0, wt2);
+  ipf1->normalize(0, wt1);
+  ipf2->normalize(0, wt2);
 
   IvPFunction *ipf = coupleRaw(ipf1, ipf2);
   if(ipf && m_normalize)
-    ipf->getPDMap()->normalize(m_normalmin, m_normalmax);
+    ipf->normalize(m_normalmin, m_normalmax);
 
   return(ipf);    
 }
 
 //-------------------------------------------------------------
 // Procedure: coupleRaw
+//   Purpose: Build the sum of the two functions, held as the list of
+//            their factors. Unless materialization was requested, no
+//            piece is built for each pair of pieces; the solver and
+//            most other users work on the factors directly.
 
 IvPFunction *OF_Coupler::coupleRaw(IvPFunction* ipf1, 
 				   IvPFunction* ipf2)
@@ -111,58 +116,32 @@ IvPFunction *OF_Coupler::coupleRaw(IvPFunction* ipf1,
     return(0);
   }
 
-  int degree1 = ipf1->getPDMap()->getDegree();
-  int degree2 = ipf2->getPDMap()->getDegree();
+  int degree1 = ipf1->getDegree();
+  int degree2 = ipf2->getDegree();
   if(degree1 != degree2)
     return(0);
 
-  IvPDomain domain1 = ipf1->getPDMap()->getDomain();
-  IvPDomain domain2 = ipf2->getPDMap()->getDomain();
-
-  int i,j;
+  IvPDomain domain1 = ipf1->getDomain();
+  IvPDomain domain2 = ipf2->getDomain();
 
   if(intersectDomain(domain1, domain2))
      return(0);
 
   IvPDomain coup_domain = unionDomain(domain1, domain2);
-  
-  ipf1->transDomain(coup_domain);
-  ipf2->transDomain(coup_domain);
 
-  int pc1 = ipf1->getPDMap()->size();
-  int pc2 = ipf2->getPDMap()->size();
-
-  vector<IvPBox*> pieces;
+  unsigned int i;
+  vector<PDMap*> factors;
+  for(i=0; i<ipf1->getFactorCnt(); i++)
+    factors.push_back(new PDMap(ipf1->getFactor(i)));
+  for(i=0; i<ipf2->getFactorCnt(); i++)
+    factors.push_back(new PDMap(ipf2->getFactor(i)));
   
-  bool ok = true;
-  for(i=0; i<pc1; i++) {
-    IvPBox *ipiece = ipf1->getPDMap()->bx(i);
-
-    for(j=0; j<pc2; j++) {
-      IvPBox *jpiece = ipf2->getPDMap()->bx(j);
-      IvPBox *new_piece = 0;
-      ok = ok && ipiece->intersect(jpiece, new_piece);
-      if(ok && (new_piece != 0))
-	pieces.push_back(new_piece);
-    }
-  }
-  
-  int new_cnt = pieces.size();
-
-  PDMap *pdmap = new PDMap(new_cnt, coup_domain, degree1);
-  
-  for(i=0; i<new_cnt; i++)
-    pdmap->bx(i) = pieces[i];
-  
-  IvPFunction *new_ipf = new IvPFunction(pdmap);
+  IvPFunction *new_ipf = new IvPFunction(factors, coup_domain);
+  if(m_materialize)
+    new_ipf->getPDMap();
   
   delete(ipf1);
   delete(ipf2);
 
   return(new_ipf);
 }
-    
-
-
-
-
@@ -39,6 +39,10 @@ public:
 
   void disableNormalize();
   void enableNormalize(double minwt=0, double maxwt=100);
+
+  // Build the full PDMap of the coupled function right away rather
+  // than leaving the function factored until it is needed.
+  void setMaterialize(bool v=true) {m_materialize=v;}
   
   IvPFunction *couple(IvPFunction* ipf_one, IvPFunction* ipf_two);
   IvPFunction *couple(IvPFunction* ipf_one, IvPFunction* ipf_two, 
@@ -51,6 +55,7 @@ public:
   bool   m_normalize;
   double m_normalmin;
   double m_normalmax;
+  bool   m_materialize;
 };
 #endif
 
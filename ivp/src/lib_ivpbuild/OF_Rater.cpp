@@ -31,6 +31,10 @@
 #include "OF_Rater.h"
 #include "BuildUtils.h"
 
+// Pdmaps over more points than this are sampled point by point
+// rather than evaluated over their whole domain at once.
+#define OF_RATER_MAX_RASTER 4194304
+
 #define min(x, y) ((x)<(y)?(x):(y))
 #define max(x, y) ((x)>(y)?(x):(y))
 
@@ -53,6 +57,8 @@ OF_Rater::OF_Rater(const PDMap *g_pdmap, const AOF *g_aof)
   m_samp_low      = 0.0;   // sample value will be assigned
   m_err          = 0;
 
+  m_pdmap_rastered = false;
+
   if(m_aof)
     m_domain = m_aof->getDomain();
 }
@@ -66,6 +72,8 @@ OF_Rater::OF_Rater(const PDMap *g_pdmap, const AOF *g_aof)
 void OF_Rater::setPDMap(const PDMap *g_pdmap)
 {
   m_pdmap = g_pdmap;
+  m_pdmap_vals.clear();
+  m_pdmap_rastered = false;
   resetSamples();
 }
 
@@ -123,7 +131,7 @@ void OF_Rater::takeSamples(int amount, double winterruptVal)
     IvPBox rand_box = makeRand(domain);
     m_sample_count++;
     val1 = this->evalPtBox(&rand_box);
-    val2 = m_pdmap->evalPoint(&rand_box);
+    val2 = evalPDMap(&rand_box);
 
     diff = (val1-val2);
     if(diff<0) diff = (diff * -1.0);
@@ -214,8 +222,35 @@ double OF_Rater::evalPtBox(const IvPBox *gbox)
   return(val);
 }
 
+//-------------------------------------------------------------
+// Procedure: evalPDMap()
+//   Purpose: Evaluate the pdmap at a point box. The first time, if
+//            the domain is not too large, the whole pdmap is
+//            evaluated at once and later points are looked up.
 
+double OF_Rater::evalPDMap(const IvPBox *gbox)
+{
+  int d, dim = m_pdmap->getDim();
+  if(!m_pdmap_rastered) {
+    m_pdmap_rastered = true;
+    IvPDomain domain = m_pdmap->getDomain();
+    double points = 1;
+    m_pdmap_stride.clear();
+    for(d=0; d<dim; d++) {
+      m_pdmap_stride.push_back((unsigned int)(points));
+      points *= (double)(domain.getVarPoints(d));
+    }
+    if(points <= OF_RATER_MAX_RASTER)
+      m_pdmap->rasterize(m_pdmap->getUniverse(), m_pdmap_vals);
+  }
 
+  if((m_pdmap_vals.size() == 0) || (gbox->getDim() != dim))
+    return(m_pdmap->evalPoint(gbox));
 
-
-
+  unsigned int ix = 0;
+  for(d=0; d<dim; d++)
+    ix += gbox->pt(d,0) * m_pdmap_stride[d];
+  if(ix >= m_pdmap_vals.size())
+    return(0);
+  return(m_pdmap_vals[ix]);
+}
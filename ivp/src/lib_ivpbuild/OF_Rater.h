@@ -26,6 +26,7 @@
 #ifndef OF_RATER_HEADER
 #define OF_RATER_HEADER
 
+#include <vector>
 #include "PDMap.h"
 #include "AOF.h"
 
@@ -49,6 +50,7 @@ public:
 
 protected:
   double  evalPtBox(const IvPBox*);
+  double  evalPDMap(const IvPBox*);
 
 
 protected:
@@ -64,6 +66,12 @@ protected:
   double  m_samp_high;      // Highest value of samples
   double  m_samp_low;       // Lowest  value of samples
   double* m_err;            // Err val of all samples so far
+
+  // The pdmap evaluated over its whole domain, first variable 
+  // varying fastest. Built on the first sample if not too large.
+  std::vector<double>       m_pdmap_vals;
+  std::vector<unsigned int> m_pdmap_stride;
+  bool                      m_pdmap_rastered;
 };
 
 #endif
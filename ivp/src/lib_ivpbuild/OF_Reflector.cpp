@@ -446,6 +446,7 @@ int OF_Reflector::create(int unif_amt, int smart_amt,
 			 double smart_thresh)
 {
   clearPDMap();
+  m_regressor->clearGrid();
   if(!m_aof)
     return(0);
   
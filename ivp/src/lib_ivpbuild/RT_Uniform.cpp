@@ -88,6 +88,9 @@ PDMap* RT_Uniform::create(const IvPBox* unifbox, const IvPBox* gelbox,
   else
     pdmap->setGelBox(*unifbox);
   
+  // Sample the AOF over all the pieces in one call if it can
+  m_regressor->sampleGrid(pdmap);
+
   int unifCount = pdmap->size();
   for(int i=0; i<unifCount; i++) {
     if(use_pqueue) {
@@ -89,6 +89,8 @@ Regressor::Regressor(const AOF *g_aof, int g_degree)
   // desirable property, but there is typically a small measure
   // of overall fit that is sacrificed.
   m_strict_range = true;
+
+  m_grid_set = false;
 }
 
 //-------------------------------------------------------------
@@ -597,6 +599,76 @@ void Regressor::setCorners(IvPBox *gbox)
   }
 }
 
+//-------------------------------------------------------------
+// Procedure: sampleGrid()
+//   Purpose: Evaluate the AOF in one call at all the points that 
+//            setWeight() will sample for the pieces of the given 
+//            pdmap, i.e., their corners and centers, if the AOF
+//            supports evaluation over a grid. The points sampled 
+//            are the grid of the piece bounds and centers on each 
+//            variable. Later evaluations of points on the grid, 
+//            including for pieces made by refining these pieces,
+//            are then looked up.
+//   Returns: false if the AOF has no grid evaluation, or the grid
+//            would be too large, leaving the points to be 
+//            evaluated one at a time.
+
+bool Regressor::sampleGrid(PDMap *pdmap)
+{
+  clearGrid();
+  if(!m_aof || !pdmap || (pdmap->size() == 0))
+    return(false);
+  if(m_domain.size() != (unsigned int)(m_dim))
+    return(false);
+
+  int i, d, pcs = pdmap->size();
+
+  m_grid_pts.resize(m_dim);
+  m_grid_pos.resize(m_dim);
+  unsigned int total = 1;
+  for(d=0; d<m_dim; d++) {
+    vector<int>& pos = m_grid_pos[d];
+    pos.assign(m_domain.getVarPoints(d), -1);
+    for(i=0; i<pcs; i++) {
+      IvPBox *box = pdmap->bx(i);
+      int low = box->pt(d,0);
+      int hgh = box->pt(d,1);
+      pos[low] = 0;
+      pos[hgh] = 0;
+      pos[low + ((hgh-low)/2)] = 0;
+    }
+    vector<int>& pts = m_grid_pts[d];
+    pts.clear();
+    unsigned int j, psize = pos.size();
+    for(j=0; j<psize; j++) {
+      if(pos[j] == 0) {
+	pos[j] = pts.size();
+	pts.push_back(j);
+      }
+    }
+    total *= pts.size();
+  }
+
+  // Past this the grid costs more than the points it saves
+  if(total > (unsigned int)(8 * m_corners * pcs))
+    return(false);
+
+  if(!m_aof->evalGrid(m_grid_pts, m_grid_vals) || 
+     (m_grid_vals.size() != total))
+    return(false);
+
+  m_grid_set = true;
+  return(true);
+}
+
+//-------------------------------------------------------------
+// Procedure: clearGrid()
+
+void Regressor::clearGrid()
+{
+  m_grid_set = false;
+}
+
 //-------------------------------------------------------------
 // Procedure: evalPtBox()
 //   Purpose: Evaluate a point box based on the set of linear coefficients.
@@ -610,6 +682,21 @@ double Regressor::evalPtBox(const IvPBox *gbox)
   if(dim != m_domain.size())
     return(0);
   
+  // Look the point up if it was sampled by sampleGrid()
+  if(m_grid_set) {
+    unsigned int gix = 0, stride = 1;
+    bool on_grid = true;
+    for(unsigned int d=0; on_grid && (d<dim); d++) {
+      int pos = m_grid_pos[d][gbox->pt(d)];
+      if(pos < 0)
+	on_grid = false;
+      gix += (unsigned int)(pos) * stride;
+      stride *= m_grid_pts[d].size();
+    }
+    if(on_grid)
+      return(m_grid_vals[gix]);
+  }
+
   vector<double> pvals;
   for(unsigned int d=0; d<dim; d++)
     pvals.push_back(m_domain.getVal(d, gbox->pt(d)));
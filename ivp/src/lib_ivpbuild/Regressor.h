@@ -29,6 +29,7 @@
 #include <vector>
 #include <string>
 #include "AOF.h"
+#include "PDMap.h"
 
 class Regressor {
 public:
@@ -46,6 +47,9 @@ public:
 
   const AOF* getAOF() {return(m_aof);}
 
+  bool    sampleGrid(PDMap*);
+  void    clearGrid();
+
 protected:
   void    setCorners(IvPBox*);
   double  setWeight0(IvPBox*, bool);
@@ -77,6 +81,15 @@ protected:
   int*      m_mask;
   double*   m_vals;
 
+  // AOF values sampled in bulk by sampleGrid(). The grid points on
+  // each variable, the position of each domain index among them 
+  // (or -1), and the values with the first variable varying fastest.
+  // The buffers are kept from one build to the next.
+  std::vector<std::vector<int> > m_grid_pts;
+  std::vector<std::vector<int> > m_grid_pos;
+  std::vector<double>            m_grid_vals;
+  bool                           m_grid_set;
+
   int       m_degree;
 };
 
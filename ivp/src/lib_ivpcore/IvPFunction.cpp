@@ -30,6 +30,47 @@
 
 using namespace std;
 
+//-------------------------------------------------------------
+// Procedure: transPDMap
+//   Purpose: Translate the given pdmap into the given domain, which
+//            must contain all of the pdmap's domain variables.
+
+static bool transPDMap(PDMap *pdmap, const IvPDomain& gdomain)
+{
+  if(pdmap->getDomain() == gdomain)
+    return(true);
+
+  // First measure the sizes of the given domain and the 
+  // number of dimensions for this objective function. Ensure
+  // the number of dimensions in this function is not greater.
+  int dom_dim = gdomain.size();
+  int of_dim  = pdmap->getDim();
+  if(of_dim > dom_dim)
+    return(false);
+
+  int i;
+
+  // Now build a translation map. Ensure that all domain names
+  // in this function are found in the given IvPDomain.
+  bool ok = true;
+  int *dmap = new int[of_dim]; 
+  for(i=0; i<of_dim; i++) {
+    string i_dom = pdmap->getDomain().getVarName(i);
+    dmap[i] = gdomain.getIndex(i_dom);
+    if(dmap[i] == -1)
+      ok = false;
+  }
+
+  // Now perform the domain translation on the pdmap, check
+  // the result and quit now if it failed.
+  ok = ok && pdmap->transDomain(gdomain, dmap);
+
+  // Clean up temp memory from the heap
+  delete [] dmap;
+
+  return(ok);
+}
+
 //-------------------------------------------------------------
 // Procedure: Constructor
 
@@ -41,6 +82,23 @@ IvPFunction::IvPFunction(PDMap *g_pdmap)
   m_pwt   = 10.0;
 }
 
+//-------------------------------------------------------------
+// Procedure: Constructor
+//   Purpose: Build a function that is the sum of the given factors.
+//            Each factor is over a subset of the given domain, and
+//            no two factors share a domain variable. The function 
+//            takes ownership of the factors.
+
+IvPFunction::IvPFunction(const vector<PDMap*>& factors, IvPDomain domain)
+{
+  assert(factors.size() > 0);
+
+  m_pdmap   = 0;
+  m_pwt     = 10.0;
+  m_factors = factors;
+  m_domain  = domain;
+}
+
 //-------------------------------------------------------------
 // Procedure: Destructor
 
@@ -48,6 +106,8 @@ IvPFunction::~IvPFunction()
 {
   if(m_pdmap) 
     delete(m_pdmap);
+  for(unsigned int i=0; i<m_factors.size(); i++)
+    delete(m_factors[i]);
 }
 
 //-------------------------------------------------------------
@@ -62,41 +122,173 @@ void IvPFunction::setPWT(double g_pwt)
 
 //-------------------------------------------------------------
 // Procedure: transDomain
+//      Note: The factors of a factored function are left over 
+//            their own domains until the function is materialized.
 
 bool IvPFunction::transDomain(IvPDomain gdomain)
 {
-  if(m_pdmap->getDomain() == gdomain)
+  if(m_pdmap)
+    return(transPDMap(m_pdmap, gdomain));
+
+  if(m_domain == gdomain)
     return(true);
 
-  // First measure the sizes of the given domain and the 
-  // number of dimensions for this objective function. Ensure
-  // the number of dimensions in this function is not greater.
-  int dom_dim = gdomain.size();
-  int of_dim  = m_pdmap->getDim();
-  if(of_dim > dom_dim)
+  unsigned int i, dim = m_domain.size();
+  if(dim > gdomain.size())
     return(false);
+  for(i=0; i<dim; i++)
+    if(!gdomain.hasDomain(m_domain.getVarName(i)))
+      return(false);
 
-  int i;
+  m_domain = gdomain;
+  return(true);
+}
 
-  // Now build a translation map. Ensure that all domain names
-  // in this function are found in the given IvPDomain.
-  bool ok = true;
-  int *dmap = new int[of_dim]; 
-  for(i=0; i<of_dim; i++) {
-    string i_dom = this->getVarName(i);
-    dmap[i] = gdomain.getIndex(i_dom);
-    if(dmap[i] == -1)
-      ok = false;
+//-------------------------------------------------------------
+// Procedure: applyWeight
+//   Purpose: Scale the function by the given weight
+
+void IvPFunction::applyWeight(double weight)
+{
+  if(m_pdmap)
+    m_pdmap->applyWeight(weight);
+  for(unsigned int i=0; i<m_factors.size(); i++)
+    m_factors[i]->applyWeight(weight);
+}
+
+//-------------------------------------------------------------
+// Procedure: applyScalar
+//   Purpose: As PDMap::applyScalar(). For a factored function the
+//            scalar is added to one factor only.
+
+void IvPFunction::applyScalar(double scalar)
+{
+  if(m_pdmap)
+    m_pdmap->applyScalar(scalar);
+  else if(m_factors.size() > 0)
+    m_factors[0]->applyScalar(scalar);
+}
+
+//-------------------------------------------------------------
+// Procedure: normalize
+//   Purpose: As PDMap::normalize(). For a factored function the
+//            shift is applied to one factor only and the scale
+//            to all of them.
+
+void IvPFunction::normalize(double target_base, double target_range)
+{
+  if(m_pdmap) {
+    m_pdmap->normalize(target_base, target_range);
+    return;
   }
 
-  // Now perform the domain translation on the pdmap, check
-  // the result and quit now if it failed.
-  ok = ok && m_pdmap->transDomain(gdomain, dmap);
+  double existing_base  = getMinWT();
+  double existing_range = getMaxWT() - existing_base;
+  if(existing_range <= 0)
+    return;
 
-  // Clean up temp memory from the heap
-  delete [] dmap;
+  m_factors[0]->applyScalar(target_base - existing_base);
+  applyWeight(target_range / existing_range);
+}
 
-  return(ok);
+//-------------------------------------------------------------
+// Procedure: getPDMap
+//      Note: A factored function is materialized on the first call.
+//            If that fails the function is left factored and null
+//            is returned.
+
+PDMap* IvPFunction::getPDMap()
+{
+  if(!m_pdmap)
+    materialize();
+  return(m_pdmap);
+}
+
+//-------------------------------------------------------------
+// Procedure: freeOfNan
+
+bool IvPFunction::freeOfNan()
+{
+  if(m_pdmap)
+    return(m_pdmap->freeOfNan());
+  for(unsigned int i=0; i<m_factors.size(); i++)
+    if(!m_factors[i]->freeOfNan())
+      return(false);
+  return(true);
+}
+
+//-------------------------------------------------------------
+// Procedure: size
+//   Purpose: Return the number of pieces. For a factored function
+//            this is the number the materialized function would 
+//            have.
+
+int IvPFunction::size()
+{
+  if(m_pdmap)
+    return(m_pdmap->size());
+  int pieces = 1;
+  for(unsigned int i=0; i<m_factors.size(); i++)
+    pieces *= m_factors[i]->size();
+  return(pieces);
+}
+
+//-------------------------------------------------------------
+// Procedure: getDim
+
+int IvPFunction::getDim()
+{
+  if(m_pdmap)
+    return(m_pdmap->getDim());
+  return(m_domain.size());
+}
+
+//-------------------------------------------------------------
+// Procedure: getDegree
+
+int IvPFunction::getDegree()
+{
+  if(m_pdmap)
+    return(m_pdmap->getDegree());
+  return(m_factors[0]->getDegree());
+}
+
+//-------------------------------------------------------------
+// Procedure: getMinWT
+//      Note: The factors share no variables, so the least value of
+//            their sum is the sum of their least values.
+
+double IvPFunction::getMinWT()
+{
+  if(m_pdmap)
+    return(m_pdmap->getMinWT());
+  double total = 0;
+  for(unsigned int i=0; i<m_factors.size(); i++)
+    total += m_factors[i]->getMinWT();
+  return(total);
+}
+
+//-------------------------------------------------------------
+// Procedure: getMaxWT
+
+double IvPFunction::getMaxWT()
+{
+  if(m_pdmap)
+    return(m_pdmap->getMaxWT());
+  double total = 0;
+  for(unsigned int i=0; i<m_factors.size(); i++)
+    total += m_factors[i]->getMaxWT();
+  return(total);
+}
+
+//-------------------------------------------------------------
+// Procedure: getDomain
+
+IvPDomain IvPFunction::getDomain()
+{
+  if(m_pdmap)
+    return(m_pdmap->getDomain());
+  return(m_domain);
 }
 
 //-------------------------------------------------------------
@@ -104,9 +296,32 @@ bool IvPFunction::transDomain(IvPDomain gdomain)
 
 string IvPFunction::getVarName(int i)
 {
-  return(m_pdmap->getDomain().getVarName(i));
+  return(getDomain().getVarName(i));
+}
+
+//-------------------------------------------------------------
+// Procedure: getFactorCnt
+//   Purpose: Return the number of factors. A function that is not
+//            factored is its own single factor.
+
+unsigned int IvPFunction::getFactorCnt() const
+{
+  if(m_pdmap)
+    return(1);
+  return(m_factors.size());
 }
 
+//-------------------------------------------------------------
+// Procedure: getFactor
+
+PDMap* IvPFunction::getFactor(unsigned int ix) const
+{
+  if(m_pdmap)
+    return((ix == 0) ? m_pdmap : 0);
+  if(ix < m_factors.size())
+    return(m_factors[ix]);
+  return(0);
+}
 
 //-------------------------------------------------------------
 // Procedure: copy
@@ -114,14 +329,79 @@ string IvPFunction::getVarName(int i)
 
 IvPFunction *IvPFunction::copy() const
 {
-  PDMap *pdmap = new PDMap(m_pdmap);
-  
-  IvPFunction *ipf = new IvPFunction(pdmap);
+  IvPFunction *ipf = 0;
+  if(m_pdmap)
+    ipf = new IvPFunction(new PDMap(m_pdmap));
+  else {
+    vector<PDMap*> factors;
+    for(unsigned int i=0; i<m_factors.size(); i++)
+      factors.push_back(new PDMap(m_factors[i]));
+    ipf = new IvPFunction(factors, m_domain);
+  }
   ipf->setPWT(m_pwt);
   ipf->setContextStr(m_context_string);
 
   return(ipf);
 }
 
+//-------------------------------------------------------------
+// Procedure: materialize
+//   Purpose: Replace the factors with one PDMap over the whole 
+//            domain holding the intersection of every combination
+//            of factor pieces. Each such intersection is non-empty
+//            since the factors share no variables.
+//   Returns: false if a factor could not be translated to the 
+//            domain of the function, which is then left factored.
+//            Nothing is printed. It is up to the caller to report
+//            the failure, e.g., on a null from getPDMap().
 
+bool IvPFunction::materialize()
+{
+  unsigned int i, j, k, fcnt = m_factors.size();
+  if(fcnt == 0)
+    return(false);
+  int degree = m_factors[0]->getDegree();
 
+  // Translate copies of the factors so that on failure the 
+  // function is left as it was.
+  vector<PDMap*> factors;
+  bool ok = true;
+  for(k=0; ok && (k<fcnt); k++) {
+    factors.push_back(new PDMap(m_factors[k]));
+    ok = transPDMap(factors[k], m_domain);
+  }
+  if(!ok) {
+    for(k=0; k<factors.size(); k++)
+      delete(factors[k]);
+    return(false);
+  }
+
+  vector<IvPBox*> pieces;
+  for(i=0; i<(unsigned int)(factors[0]->size()); i++)
+    pieces.push_back(factors[0]->bx(i)->copy());
+
+  for(k=1; k<fcnt; k++) {
+    PDMap *factor = factors[k];
+    vector<IvPBox*> new_pieces;
+    for(i=0; i<pieces.size(); i++) {
+      for(j=0; j<(unsigned int)(factor->size()); j++) {
+	IvPBox *new_piece = 0;
+	if(pieces[i]->intersect(factor->bx(j), new_piece) && new_piece)
+	  new_pieces.push_back(new_piece);
+      }
+      delete(pieces[i]);
+    }
+    pieces = new_pieces;
+  }
+
+  m_pdmap = new PDMap(pieces.size(), m_domain, degree);
+  for(i=0; i<pieces.size(); i++)
+    m_pdmap->bx(i) = pieces[i];
+
+  for(k=0; k<fcnt; k++) {
+    delete(factors[k]);
+    delete(m_factors[k]);
+  }
+  m_factors.clear();
+  return(true);
+}
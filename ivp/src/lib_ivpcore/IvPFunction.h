@@ -26,33 +26,60 @@
 #ifndef IVP_FUNCTION_HEADER
 #define IVP_FUNCTION_HEADER
 
+#include <vector>
 #include "IvPBox.h"
 #include "PDMap.h"
 #include "IvPDomain.h"
 
+// An IvP function is normally a single PDMap. A function that is
+// the sum of functions over disjoint sets of decision variables,
+// e.g., built by the OF_Coupler, may instead be held as its 
+// separate factors. The full PDMap, with a piece for every 
+// combination of factor pieces, is only built if getPDMap() is 
+// called. The solver takes the factors as they are.
+
 class IvPFunction {
 public:
   IvPFunction(PDMap*);
+  IvPFunction(const std::vector<PDMap*>& factors, IvPDomain);
   virtual ~IvPFunction();
 
   void   setPWT(double);
   void   setContextStr(const std::string& s) {m_context_string=s;}
   bool   transDomain(IvPDomain);
+  void   applyWeight(double);
+  void   applyScalar(double);
+  void   normalize(double base, double range);
 
   double      getPWT()         {return(m_pwt);}
-  PDMap*      getPDMap()       {return(m_pdmap);}
-  bool        freeOfNan()      {return(m_pdmap->freeOfNan());}
-  int         size()           {return(m_pdmap->size());}
-  int         getDim()         {return(m_pdmap->getDim());}
+  PDMap*      getPDMap();
+  bool        freeOfNan();
+  int         size();
+  int         getDim();
+  int         getDegree();
+  double      getMinWT();
+  double      getMaxWT();
+  IvPDomain   getDomain();
   std::string getContextStr()  {return(m_context_string);}
   std::string getVarName(int); 
+
+  bool         isFactored() const  {return(m_pdmap == 0);}
+  unsigned int getFactorCnt() const;
+  PDMap*       getFactor(unsigned int) const;
   
   IvPFunction *copy() const;
 
+protected:
+  bool   materialize();
+
 protected:
   PDMap*      m_pdmap;
   double      m_pwt;
   std::string m_context_string;
+
+  // Used only while the function is factored
+  std::vector<PDMap*> m_factors;
+  IvPDomain           m_domain;
 };
 #endif
 
@@ -331,6 +331,175 @@ void PDMap::setGelBox()
   }
 }
 
+//---------------------------------------------------------------------
+// Procedure: clipToRegion
+//   Purpose: Set the range of points of the region covered by the
+//            given box, excluding points on open box edges. Returns
+//            false if the box covers no point of the region.
+
+static bool clipToRegion(const IvPBox *box, const IvPBox& region,
+			 vector<int>& low, vector<int>& high)
+{
+  int dim = region.getDim();
+  if(!box || (box->getDim() != dim))
+    return(false);
+
+  for(int d=0; d<dim; d++) {
+    int blow  = box->pt(d,0);
+    int bhigh = box->pt(d,1);
+    if(!box->bd(d,0))
+      blow++;
+    if(!box->bd(d,1))
+      bhigh--;
+    if(blow < region.pt(d,0))
+      blow = region.pt(d,0);
+    if(bhigh > region.pt(d,1))
+      bhigh = region.pt(d,1);
+    if(blow > bhigh)
+      return(false);
+    low[d]  = blow;
+    high[d] = bhigh;
+  }
+  return(true);
+}
+
+//---------------------------------------------------------------------
+// Procedure: rasterize
+//   Purpose: Paint the interior function of each piece directly into
+//            the points of the region it covers. The cost is linear
+//            in the number of points and pieces, where evaluating 
+//            each point with evalPoint() searches the grid.
+//     Notes: o Pieces are painted one row at a time along the 
+//              variable with the most points in the region. Rows
+//              along the first variable are contiguous in memory.
+//            o Weights are laid out as in IvPBox::ptVal().
+
+bool PDMap::rasterize(const IvPBox& region, vector<double>& vals,
+		      bool add, vector<unsigned short>* cover) const
+{
+  int d, dim = m_domain.size();
+  if((dim == 0) || (region.getDim() != dim))
+    return(false);
+
+  vector<unsigned int> stride(dim);
+  unsigned int total = 1;
+  int row = 0;
+  for(d=0; d<dim; d++) {
+    int pts = region.pt(d,1) - region.pt(d,0) + 1;
+    if(pts <= 0)
+      return(false);
+    stride[d] = total;
+    total *= (unsigned int)(pts);
+    if(pts > (region.pt(row,1) - region.pt(row,0) + 1))
+      row = d;
+  }
+
+  if(!add)
+    vals.assign(total, 0);
+  else if(vals.size() != total)
+    return(false);
+  if(cover && (cover->size() != total))
+    cover->assign(total, 0);
+
+  vector<int> low(dim), high(dim), at(dim);
+  for(int i=0; i<m_boxCount; i++) {
+    const IvPBox *box = m_boxes[i];
+    if(!clipToRegion(box, region, low, high))
+      continue;
+
+    int    degree = box->getDegree();
+    double slope  = 0;
+    double curve  = 0;
+    if(degree == 1)
+      slope = box->wt(row);
+    else if(degree == 2) {
+      curve = box->wt(row);
+      slope = box->wt(row+dim);
+    }
+    
+    int row_low  = low[row];
+    int row_high = high[row];
+    unsigned int row_stride = stride[row];
+    unsigned int row_start  = (row_low - region.pt(row,0)) * row_stride;
+
+    for(d=0; d<dim; d++)
+      at[d] = low[d];
+
+    while(true) {
+      double base = box->wt(degree * dim);
+      unsigned int offset = row_start;
+      for(d=0; d<dim; d++) {
+	if(d == row)
+	  continue;
+	double p = (double)(at[d]);
+	if(degree == 1)
+	  base += box->wt(d) * p;
+	else if(degree == 2)
+	  base += (box->wt(d) * p * p) + (box->wt(d+dim) * p);
+	offset += (at[d] - region.pt(d,0)) * stride[d];
+      }
+
+      double *val = &vals[offset];
+      int x, len = row_high - row_low + 1;
+      if(row_stride == 1) {
+	for(x=0; x<len; x++) {
+	  double p = (double)(row_low + x);
+	  val[x] += base + (((curve * p) + slope) * p);
+	}
+      }
+      else {
+	for(x=0; x<len; x++) {
+	  double p = (double)(row_low + x);
+	  val[x * row_stride] += base + (((curve * p) + slope) * p);
+	}
+      }
+      if(cover) {
+	unsigned short *cov = &((*cover)[offset]);
+	for(x=0; x<len; x++)
+	  cov[x * row_stride]++;
+      }
+
+      // Advance to the next row, odometer style
+      for(d=0; d<dim; d++) {
+	if(d == row)
+	  continue;
+	if(at[d] < high[d]) {
+	  at[d]++;
+	  break;
+	}
+	at[d] = low[d];
+      }
+      if(d >= dim)
+	break;
+    }
+  }
+  return(true);
+}
+
+//---------------------------------------------------------------------
+// Procedure: coverage
+//      Note: Pieces do not overlap, so the points they cover in the
+//            region may simply be summed.
+
+unsigned int PDMap::coverage(const IvPBox& region) const
+{
+  int dim = m_domain.size();
+  if((dim == 0) || (region.getDim() != dim))
+    return(0);
+
+  unsigned int total = 0;
+  vector<int> low(dim), high(dim);
+  for(int i=0; i<m_boxCount; i++) {
+    if(!clipToRegion(m_boxes[i], region, low, high))
+      continue;
+    unsigned int points = 1;
+    for(int d=0; d<dim; d++)
+      points *= (unsigned int)(high[d] - low[d] + 1);
+    total += points;
+  }
+  return(total);
+}
+
 //---------------------------------------------------------------------
 // Procedure: evalPoint
 //     Notes: o Evaluate the value (based on the pieces) of given box.
@@ -371,8 +540,10 @@ double PDMap::evalPoint(const IvPBox *gbox, bool* covered) const
 
   if(m_grid) {
     BoxSet *bs = m_grid->getBS(gbox);
-    if(bs->getSize() == 0)
+    if(bs->getSize() == 0) {
+      delete(bs);
       return(retVal);
+    }
     else {
       if(covered) *covered = true;
       if(bs->getSize() > 1) {
@@ -382,12 +553,13 @@ double PDMap::evalPoint(const IvPBox *gbox, bool* covered) const
 	  IvPBox *bx = bsn->getBox();
 	  if(gbox->intersect(bx)) {
 	    numHits++;
-	    retVal = bs->retBSN()->getBox()->ptVal(gbox);
+	    retVal = bx->ptVal(gbox);
 	  }
 	  bsn = bsn->getNext();
 	}
 	if(numHits != 1) {
 	  if(covered) *covered = false;
+	  delete(bs);
 	  return(0.0);
 	}
       }
@@ -26,6 +26,7 @@
 #ifndef PDMAP_HEADER
 #define PDMAP_HEADER
 
+#include <vector>
 #include "IvPBox.h"
 #include "BoxSet.h"
 #include "IvPGrid.h"
@@ -60,6 +61,19 @@ public:
 
   double    evalPoint(const IvPBox*, bool* covered=0) const;
 
+  // Evaluate every point of the region (a box of inclusive domain
+  // indices) at once. Values are laid out with the first variable
+  // varying fastest. If add is true values are added to those in 
+  // vals, which must be the size of the region. Points covered by 
+  // no piece are zero. If cover is given it is incremented at each 
+  // covered point.
+  bool      rasterize(const IvPBox& region, std::vector<double>& vals,
+		      bool add=false,
+		      std::vector<unsigned short>* cover=0) const;
+
+  // The number of points of the region covered by some piece
+  unsigned int coverage(const IvPBox& region) const;
+
   void      print(bool full=true) const;
   void      growBoxArray(int);
   void      growBoxCount(int i=1) {m_boxCount += i;}
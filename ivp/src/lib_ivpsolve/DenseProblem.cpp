@@ -0,0 +1,187 @@
+/*****************************************************************/
+/*    NAME: MOOS-IvP contributors                                */
+/*    ORGN: Dept of Mechanical Eng / CSAIL, MIT Cambridge MA     */
+/*    FILE: DenseProblem.cpp                                     */
+/*    DATE: Oct 18th 2026                                        */
+/*                                                               */
+/* The algorithms embodied in this software are protected under  */
+/* U.S. Pat. App. Ser. Nos. 10/631,527 and 10/911,765 and are    */
+/* the property of the United States Navy.                       */
+/*                                                               */
+/* Permission to use, copy, modify and distribute this software  */
+/* and its documentation for any non-commercial purpose, without */
+/* fee, and without a written agreement is hereby granted        */
+/* provided that the above notice and this paragraph and the     */
+/* following three paragraphs appear in all copies.              */
+/*                                                               */
+/* Commercial licences for this software may be obtained by      */
+/* contacting Patent Counsel, Naval Undersea Warfare Center      */
+/* Division Newport at 401-832-4736 or 1176 Howell Street,       */
+/* Newport, RI 02841.                                            */
+/*                                                               */
+/* In no event shall the US Navy be liable to any party for      */
+/* direct, indirect, special, incidental, or consequential       */
+/* damages, including lost profits, arising out of the use       */
+/* of this software and its documentation, even if the US Navy   */
+/* has been advised of the possibility of such damage.           */
+/*                                                               */
+/* The US Navy specifically disclaims any warranties, including, */
+/* but not limited to, the implied warranties of merchantability */
+/* and fitness for a particular purpose. The software provided   */
+/* hereunder is on an 'as-is' basis, and the US Navy has no      */
+/* obligations to provide maintenance, support, updates,         */
+/* enhancements or modifications.                                */
+/*****************************************************************/
+
+#include <iostream> 
+#include "DenseProblem.h"
+#include "PDMap.h"
+
+using namespace std;
+
+// Beyond this many points a dense solve needs more memory than is
+// sensible and branch and bound should be used instead.
+#define DENSE_MAX_POINTS 16777216
+
+// Up to this many points a dense solve was measured to be at least
+// as fast as branch and bound on logged helm problems. Well beyond
+// it the cost of visiting every point dominates; at the common 
+// 360x21 course/speed domain IvPProblem is several times faster.
+#define DENSE_AUTO_POINTS 512
+
+// Beyond that a dense solve costs about one unit per function per
+// domain point, and branch and bound about this many units per
+// piece. On logged helm problems the two broke even with between
+// 9 (dense ahead) and 26 (IvPProblem ahead by 25%) points visited
+// per piece.
+#define DENSE_AUTO_RATIO 16
+
+//---------------------------------------------------------------
+// Procedure: domainPoints
+
+unsigned int DenseProblem::domainPoints(const IvPDomain& domain)
+{
+  unsigned int dsize = domain.size();
+  if(dsize == 0)
+    return(0);
+
+  double total = 1;
+  for(unsigned int d=0; d<dsize; d++)
+    total *= (double)(domain.getVarPoints(d));
+
+  if((total <= 0) || (total > DENSE_MAX_POINTS))
+    return(0);
+  return((unsigned int)(total));
+}
+
+//---------------------------------------------------------------
+// Procedure: preferred
+
+bool DenseProblem::preferred(const IvPDomain& domain,
+			     unsigned int ofs, unsigned int pieces)
+{
+  unsigned int points = domainPoints(domain);
+  if(points == 0)
+    return(false);
+  if(points <= DENSE_AUTO_POINTS)
+    return(true);
+  double dense_cost = (double)(points) * (double)(ofs);
+  return(dense_cost <= (double)(DENSE_AUTO_RATIO) * (double)(pieces));
+}
+
+//---------------------------------------------------------------
+// Procedure: solve
+//   Purpose: Paint all objective functions into one array of sums,
+//            counting at each point how many functions cover it, 
+//            and take the best point covered by all of them. Ties
+//            go to the first point in the array.
+//      Note: Sums are kept in double precision so that near-ties
+//            are broken the same way as by IvPProblem. The painting
+//            is done by PDMap::rasterize().
+
+bool DenseProblem::solve(const IvPBox *isolbox)
+{
+  if(m_ofnum == 0) {
+    cout << "DenseProblem::solve() - zero OFS!!!!!" << endl;
+    return(false);
+  }
+
+  unsigned int total = domainPoints(m_domain);
+  if(total == 0)
+    return(false);
+
+  int d, dim = m_domain.size();
+  IvPBox region(dim);
+  for(d=0; d<dim; d++)
+    region.setPTS(d, 0, m_domain.getVarPoints(d)-1);
+
+  // If every function covers the whole domain every point is 
+  // feasible and coverage need not be counted.
+  bool count_cover = false;
+  for(int i=0; i<m_ofnum; i++)
+    if(m_ofs[i]->getPDMap()->coverage(region) < total)
+      count_cover = true;
+
+  m_sum.assign(total, 0.0);
+  if(count_cover)
+    m_cover.assign(total, 0);
+
+  for(int i=0; i<m_ofnum; i++) {
+    PDMap *pdmap = m_ofs[i]->getPDMap();
+    pdmap->rasterize(region, m_sum, true, (count_cover ? &m_cover : 0));
+  }
+
+  const double* sum = &m_sum[0];
+
+  bool   found   = false;
+  double best_wt = 0;
+  unsigned int k, best_ix = 0;
+  if(!count_cover) {
+    // Find the greatest sum with four independent running maxima,
+    // free of branches, then the first point holding it.
+    double mx[4] = {sum[0], sum[0], sum[0], sum[0]};
+    for(k=0; k+4<=total; k+=4) {
+      mx[0] = (sum[k]   > mx[0]) ? sum[k]   : mx[0];
+      mx[1] = (sum[k+1] > mx[1]) ? sum[k+1] : mx[1];
+      mx[2] = (sum[k+2] > mx[2]) ? sum[k+2] : mx[2];
+      mx[3] = (sum[k+3] > mx[3]) ? sum[k+3] : mx[3];
+    }
+    for(; k<total; k++)
+      mx[0] = (sum[k] > mx[0]) ? sum[k] : mx[0];
+    best_wt = mx[0];
+    for(int j=1; j<4; j++)
+      if(mx[j] > best_wt)
+	best_wt = mx[j];
+    for(k=0; (k<total) && (sum[k] != best_wt); k++);
+    found   = true;
+    best_ix = k;
+  }
+  else {
+    const unsigned short* cover = &m_cover[0];
+    unsigned short need = (unsigned short)(m_ofnum);
+    for(k=0; k<total; k++) {
+      if((cover[k] == need) && (!found || (sum[k] > best_wt))) {
+	found   = true;
+	best_wt = sum[k];
+	best_ix = k;
+      }
+    }
+  }
+
+  if(!found)
+    return(true);
+
+  // The first domain variable varies fastest in the array
+  IvPBox ptbox(dim, 0);
+  for(d=0; d<dim; d++) {
+    unsigned int points = m_domain.getVarPoints(d);
+    int val = (int)(best_ix % points);
+    best_ix = best_ix / points;
+    ptbox.setPTS(d, val, val);
+    ptbox.setBDS(d, 1, 1);
+  }
+  ptbox.setWT(best_wt);
+  newSolution(best_wt, &ptbox);
+
+  return(true);
+}
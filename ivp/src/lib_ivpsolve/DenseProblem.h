@@ -0,0 +1,72 @@
+/*****************************************************************/
+/*    NAME: MOOS-IvP contributors                                */
+/*    ORGN: Dept of Mechanical Eng / CSAIL, MIT Cambridge MA     */
+/*    FILE: DenseProblem.h                                       */
+/*    DATE: Oct 18th 2026                                        */
+/*                                                               */
+/* The algorithms embodied in this software are protected under  */
+/* U.S. Pat. App. Ser. Nos. 10/631,527 and 10/911,765 and are    */
+/* the property of the United States Navy.                       */
+/*                                                               */
+/* Permission to use, copy, modify and distribute this software  */
+/* and its documentation for any non-commercial purpose, without */
+/* fee, and without a written agreement is hereby granted        */
+/* provided that the above notice and this paragraph and the     */
+/* following three paragraphs appear in all copies.              */
+/*                                                               */
+/* Commercial licences for this software may be obtained by      */
+/* contacting Patent Counsel, Naval Undersea Warfare Center      */
+/* Division Newport at 401-832-4736 or 1176 Howell Street,       */
+/* Newport, RI 02841.                                            */
+/*                                                               */
+/* In no event shall the US Navy be liable to any party for      */
+/* direct, indirect, special, incidental, or consequential       */
+/* damages, including lost profits, arising out of the use       */
+/* of this software and its documentation, even if the US Navy   */
+/* has been advised of the possibility of such damage.           */
+/*                                                               */
+/* The US Navy specifically disclaims any warranties, including, */
+/* but not limited to, the implied warranties of merchantability */
+/* and fitness for a particular purpose. The software provided   */
+/* hereunder is on an 'as-is' basis, and the US Navy has no      */
+/* obligations to provide maintenance, support, updates,         */
+/* enhancements or modifications.                                */
+/*****************************************************************/
+ 
+#ifndef DENSE_PROBLEM_HEADER
+#define DENSE_PROBLEM_HEADER
+
+#include <vector>
+#include "Problem.h"
+
+//---------------------------------------------------------------
+// DenseProblem solves by brute force. Every objective function is
+// painted, box by box, into a dense array over every point of the
+// domain and the point of greatest total weight is taken. Over
+// very small domains this is as fast as branch and bound, and the
+// answer is the same up to ties. Points not covered by every 
+// function are infeasible, as they are for IvPProblem.
+
+class DenseProblem: public Problem {
+public:
+  DenseProblem() {}
+  ~DenseProblem() {}
+
+  bool   solve(const IvPBox *isolbox=0);
+
+  // The number of points in the domain, zero if there are more
+  // than can be indexed.
+  static unsigned int domainPoints(const IvPDomain&);
+
+  // True if a dense solve over the given domain, of the given 
+  // number of functions with the given total number of pieces, is
+  // expected to be at least as fast as IvPProblem
+  static bool preferred(const IvPDomain&, unsigned int ofs, 
+			unsigned int pieces);
+
+protected:
+  std::vector<double>         m_sum;
+  std::vector<unsigned short> m_cover;
+};  
+
+#endif
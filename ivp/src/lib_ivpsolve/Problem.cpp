@@ -68,6 +68,16 @@ Problem::~Problem()
       delete(m_ofs[i]);
     delete[] m_ofs;
   }
+
+  unsigned int j;
+  if(m_owner_ofs) {
+    for(j=0; j<m_factored_ofs.size(); j++)
+      delete(m_factored_ofs[j]);
+  }
+  else {
+    for(j=0; j<m_factor_ofs.size(); j++)
+      delete(m_factor_ofs[j]);
+  }
 }
 
 //---------------------------------------------------------------
@@ -94,6 +104,16 @@ void Problem::clearIPFs()
     delete[] m_ofs;
   }
   m_ofs = 0;
+  m_ofnum = 0;
+
+  for(unsigned int j=0; j<m_factored_ofs.size(); j++)
+    delete(m_factored_ofs[j]);
+  m_factored_ofs.clear();
+  m_factor_ofs.clear();
+
+  m_added_ofs.clear();
+  m_added_scales.clear();
+  m_added_shifts.clear();
 }
 
 
@@ -113,14 +133,80 @@ void Problem::addOF(IvPFunction *gof)
   // positive priority weight.
   if(gof->getPWT() <= 0) return;
 
-  double range = gof->getPDMap()->getMaxWT() - gof->getPDMap()->getMinWT();
-  if(range > 100)
-    gof->getPDMap()->normalize(0,100);
+  double min_wt = gof->getMinWT();
+  double range  = gof->getMaxWT() - min_wt;
+  double scale  = 1.0 / gof->getPWT();
+  double shift  = 0;
+  if(range > 100) {
+    gof->normalize(0,100);
+    scale *= range / 100;
+    shift  = min_wt;
+  }
 
   // Apply the priority weight to the OF
-  gof->getPDMap()->applyWeight(gof->getPWT());
+  gof->applyWeight(gof->getPWT());
 
+  m_added_ofs.push_back(gof);
+  m_added_scales.push_back(scale);
+  m_added_shifts.push_back(shift);
 
+  if(!gof->isFactored()) {
+    appendOF(gof);
+    return;
+  }
+
+  // A factored OF is solved as one OF per factor. Their sum is the
+  // original OF, and together they have far fewer pieces than it 
+  // would have if materialized. The factors are copied since the 
+  // solver alters the OFs it is given, and the given OF may be 
+  // reused if the problem is not made its owner.
+  m_factored_ofs.push_back(gof);
+  for(unsigned int i=0; i<gof->getFactorCnt(); i++) {
+    IvPFunction *fof = new IvPFunction(new PDMap(gof->getFactor(i)));
+    fof->setPWT(gof->getPWT());
+    fof->setContextStr(gof->getContextStr());
+    m_factor_ofs.push_back(fof);
+    appendOF(fof);
+  }
+}
+
+//---------------------------------------------------------------
+// Procedure: releaseOF
+//   Purpose: Give up ownership of an OF given to addOF(), so that
+//            it outlives the problem. The weights it was given are
+//            restored by w*scale+shift. The OF must not be touched
+//            again by the problem, so call this only after solve().
+//   Returns: false if the OF was not given to this problem.
+
+bool Problem::releaseOF(IvPFunction *gof, double& scale, double& shift)
+{
+  unsigned int i, vsize = m_added_ofs.size();
+  for(i=0; i<vsize; i++) {
+    if(m_added_ofs[i] == gof) 
+      break;
+  }
+  if(i == vsize)
+    return(false);
+
+  scale = m_added_scales[i];
+  shift = m_added_shifts[i];
+
+  for(int j=0; j<m_ofnum; j++) {
+    if(m_ofs[j] == gof)
+      m_ofs[j] = 0;
+  }
+  for(unsigned int k=0; k<m_factored_ofs.size(); k++) {
+    if(m_factored_ofs[k] == gof)
+      m_factored_ofs[k] = 0;
+  }
+  return(true);
+}
+
+//---------------------------------------------------------------
+// Procedure: appendOF
+
+void Problem::appendOF(IvPFunction *gof)
+{
   IvPFunction** newOFs = new IvPFunction*[m_ofnum+1];
   for(int i=0; (i < m_ofnum); i++)
     newOFs[i] = m_ofs[i];
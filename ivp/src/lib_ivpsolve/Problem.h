@@ -36,6 +36,7 @@
 #ifndef PROBLEM_HEADER
 #define PROBLEM_HEADER
 
+#include <vector>
 #include "IvPFunction.h"
 #include "IvPDomain.h"
 #include "IvPBox.h"
@@ -50,6 +51,7 @@ public:    // Virtual Function
 
   void   setDomain(IvPDomain);
   void   addOF(IvPFunction*);
+  bool   releaseOF(IvPFunction*, double& scale, double& shift);
   void   setOwnerIPFs(bool v)    {m_owner_ofs = v;}
   void   clearIPFs();
   bool   alignOFs();
@@ -75,6 +77,7 @@ public:    // Virtual Function
 protected:
   bool     universesInSync();
   void     newSolution(double, const IvPBox*);
+  void     appendOF(IvPFunction*);
 
 protected:
   IvPBox*       m_maxbox;   // Box of best working solution
@@ -83,6 +86,19 @@ protected:
   bool          m_owner_ofs;
   IvPFunction** m_ofs;      // array of objective functions
   int           m_ofnum;    // # of objective functions
+  
+  // Factored functions given to addOF(), and the functions made 
+  // from their factors and solved in their place. The latter are
+  // always owned by the problem.
+  std::vector<IvPFunction*> m_factored_ofs;
+  std::vector<IvPFunction*> m_factor_ofs;
+
+  // Functions given to addOF() and the weight change applied to
+  // each, as w*scale+shift restoring the given weights.
+  std::vector<IvPFunction*> m_added_ofs;
+  std::vector<double>       m_added_scales;
+  std::vector<double>       m_added_shifts;
+
   bool          m_silent;   // true if no output during solve
   double        m_epsilon;  // delta threshold for new max weight
 
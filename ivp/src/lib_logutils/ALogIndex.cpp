@@ -0,0 +1,642 @@
+/*****************************************************************/
+/*    NAME: MOOS-IvP contributors                                */
+/*    ORGN: Dept of Mechanical Eng / CSAIL, MIT Cambridge MA     */
+/*    FILE: ALogIndex.cpp                                        */
+/*    DATE: Oct 18th 2026                                        */
+/*                                                               */
+/* This file is part of MOOS-IvP                                 */
+/*                                                               */
+/* MOOS-IvP is free software: you can redistribute it and/or     */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation, either version  */
+/* 3 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* MOOS-IvP is distributed in the hope that it will be useful,   */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty   */
+/* of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See  */
+/* the GNU General Public License for more details.              */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with MOOS-IvP.  If not, see                     */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+
+#include <algorithm>
+#include <cstdlib>
+#include <cctype>
+#include <cstring>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include "ALogIndex.h"
+
+using namespace std;
+
+// Must agree with FILE_FORMAT_VERSION of the libAlogTools indexWriter
+#define ALOG_INDEX_VERSION 1
+
+//--------------------------------------------------------
+// Procedure: fileChecksum
+//     Notes: The 32 bit FNV-1a checksum of a whole file, as used by
+//            the libAlogTools index to tell a stale index.
+
+static bool fileChecksum(FILE *f, unsigned int& checksum)
+{
+  if(!f || (fseek(f, 0, SEEK_SET) != 0))
+    return(false);
+
+  unsigned int hash = 2166136261u;
+  char   buff[65536];
+  size_t n;
+  while((n = fread(buff, 1, sizeof(buff), f)) > 0) {
+    for(size_t i=0; i<n; i++) {
+      hash ^= (unsigned char)(buff[i]);
+      hash *= 16777619u;
+    }
+  }
+  checksum = hash;
+  return(true);
+}
+
+//--------------------------------------------------------
+// Procedure: readListLine
+//     Notes: Reads one line of the form "a,b,c," into a vector
+
+static bool readListLine(FILE *f, vector<string>& names)
+{
+  string str;
+  int c = fgetc(f);
+  while((c != EOF) && (c != '\n')) {
+    if(c == ',') {
+      if(str != "")
+	names.push_back(str);
+      str = "";
+    }
+    else
+      str.push_back((char)(c));
+    c = fgetc(f);
+  }
+  if(str != "")
+    names.push_back(str);
+  return(c == '\n');
+}
+
+//--------------------------------------------------------
+// Procedure: writeListLine
+
+static void writeListLine(FILE *f, const vector<string>& names)
+{
+  for(unsigned int i=0; i<names.size(); i++)
+    fprintf(f, "%s,", names[i].c_str());
+  fprintf(f, "\n");
+}
+
+//--------------------------------------------------------
+// Procedure: readRecords
+//     Notes: Reads a run of index records (time, offset, length),
+//            a block at a time. Times are dropped if times is null.
+
+static bool readRecords(FILE *f, long count, vector<double> *times,
+			vector<long>& begins, vector<long>& lens)
+{
+  const size_t rec_size = sizeof(double) + 2*sizeof(long);
+  const long   block = 4096;
+  vector<char> buff(block * rec_size);
+
+  if(times)
+    times->resize(count);
+  begins.resize(count);
+  lens.resize(count);
+
+  for(long i=0; i<count; i+=block) {
+    long amt = count - i;
+    if(amt > block)
+      amt = block;
+    if(fread(&buff[0], rec_size, amt, f) != (size_t)(amt))
+      return(false);
+    const char *p = &buff[0];
+    for(long k=0; k<amt; k++, p+=rec_size) {
+      if(times)
+	memcpy(&(*times)[i+k], p, sizeof(double));
+      memcpy(&begins[i+k], p + sizeof(double), sizeof(long));
+      memcpy(&lens[i+k], p + sizeof(double) + sizeof(long), sizeof(long));
+    }
+  }
+  return(true);
+}
+
+//--------------------------------------------------------
+// Constructor
+
+ALogIndex::ALogIndex()
+{
+  m_file     = 0;
+  m_file_pos = -1;
+  m_ends_newline = true;
+
+  clear();
+}
+
+//--------------------------------------------------------
+// Destructor
+
+ALogIndex::~ALogIndex()
+{
+  close();
+}
+
+//--------------------------------------------------------
+// Procedure: open
+//     Notes: Opens the alog for reading lines and loads its index.
+//            The index in <alogfile>.idx is used if it was built from
+//            this alog. Otherwise the index is built in memory and
+//            only if write_index is true saved for the next user. The
+//            full checksum is only checked when the alog is newer
+//            than the index (to the second).
+
+bool ALogIndex::open(const string& alogfile, bool write_index)
+{
+  close();
+
+  m_file = fopen(alogfile.c_str(), "rb");
+  if(!m_file)
+    return(false);
+
+  long size = 0;
+  if(fseek(m_file, 0, SEEK_END) == 0)
+    size = ftell(m_file);
+  m_file_pos = -1;
+
+  m_ends_newline = false;
+  if((size > 0) && (fseek(m_file, size-1, SEEK_SET) == 0))
+    m_ends_newline = (fgetc(m_file) == '\n');
+
+  string idxfile = alogfile + ".idx";
+  bool ok = readIndex(idxfile) && (m_alog_size == size);
+
+  if(ok) {
+    struct stat alog_stat, idx_stat;
+    bool older = false;
+    if((stat(alogfile.c_str(), &alog_stat) == 0) &&
+       (stat(idxfile.c_str(), &idx_stat) == 0))
+      older = (alog_stat.st_mtime <= idx_stat.st_mtime);
+
+    if(!older) {
+      unsigned int checksum = 0;
+      ok = fileChecksum(m_file, checksum) && (checksum == m_alog_checksum);
+      // Rewrite an index still good so the next check is cheap
+      if(ok && write_index)
+	writeIndex(idxfile);
+    }
+  }
+
+  if(!ok) {
+    if(!build(alogfile)) {
+      close();
+      return(false);
+    }
+    if(write_index)
+      writeIndex(idxfile);
+  }
+  return(true);
+}
+
+//--------------------------------------------------------
+// Procedure: close
+
+void ALogIndex::close()
+{
+  if(m_file)
+    fclose(m_file);
+  m_file = 0;
+  m_file_pos = -1;
+  clear();
+}
+
+//--------------------------------------------------------
+// Procedure: clear
+//     Notes: Clears the index but leaves the alog open
+
+void ALogIndex::clear()
+{
+  m_alog_size     = 0;
+  m_alog_checksum = 0;
+  m_logstart      = 0;
+
+  m_rec_time.clear();
+  m_rec_begin.clear();
+  m_rec_len.clear();
+  m_oth_begin.clear();
+  m_oth_len.clear();
+
+  m_var_names.clear();
+  m_sources.clear();
+  m_var_records.clear();
+  m_var_ix.clear();
+
+  m_bucket_start = 0;
+  m_bucket_width = 0;
+  m_buckets.clear();
+
+  m_build_var_recs.clear();
+  m_build_sources.clear();
+}
+
+//--------------------------------------------------------
+// Procedure: build
+//     Notes: Makes one pass over the alog, finding the lines and the
+//            checksum together.
+
+bool ALogIndex::build(const string& alogfile)
+{
+  clear();
+
+  FILE *f = fopen(alogfile.c_str(), "rb");
+  if(!f)
+    return(false);
+
+  unsigned int hash = 2166136261u;
+  long   offset = 0;
+  string line;
+  char   buff[65536];
+  size_t n;
+  bool   last_newline = false;
+  while((n = fread(buff, 1, sizeof(buff), f)) > 0) {
+    size_t start = 0;
+    for(size_t i=0; i<n; i++) {
+      hash ^= (unsigned char)(buff[i]);
+      hash *= 16777619u;
+      if(buff[i] == '\n') {
+	line.append(buff+start, i-start);
+	addLine(line, offset, line.length()+1);
+	offset += line.length()+1;
+	line.clear();
+	start = i+1;
+      }
+    }
+    line.append(buff+start, n-start);
+    last_newline = (buff[n-1] == '\n');
+  }
+  fclose(f);
+
+  // A last line without a newline
+  if(line.length() > 0) {
+    addLine(line, offset, line.length());
+    offset += line.length();
+  }
+
+  m_alog_size     = offset;
+  m_alog_checksum = hash;
+  m_ends_newline  = last_newline;
+
+  finishBuild();
+  return(true);
+}
+
+//--------------------------------------------------------
+// Procedure: addLine
+//     Notes: Lines are sorted as by the libAlogTools indexWriter. A
+//            record is a line whose first non-blank is a digit.
+
+void ALogIndex::addLine(const string& line, long begin, long len)
+{
+  string::size_type pos = line.find_first_not_of(" \t\r\n");
+  if((pos == string::npos) || !isdigit((unsigned char)(line[pos]))) {
+    if((pos != string::npos) && (line[pos] == '%')) {
+      if(line.find("LOGSTART") != string::npos) {
+	string::size_type tpos = line.find_first_of("0123456789.");
+	if(tpos != string::npos)
+	  m_logstart = atof(line.c_str() + tpos);
+      }
+    }
+    m_oth_begin.push_back(begin);
+    m_oth_len.push_back(len);
+    return;
+  }
+
+  // Fields are separated by white space: TIME VAR SOURCE DATA
+  const char *cstr = line.c_str();
+  char *endp = 0;
+  double timestamp = strtod(cstr, &endp);
+
+  string fields[2];
+  unsigned int ix = endp - cstr;
+  unsigned int llen = line.length();
+  for(unsigned int k=0; k<2; k++) {
+    while((ix < llen) && isspace((unsigned char)(line[ix])))
+      ix++;
+    while((ix < llen) && !isspace((unsigned char)(line[ix])))
+      fields[k].push_back(line[ix++]);
+  }
+
+  if(fields[0] != "")
+    m_build_var_recs[fields[0]].push_back(m_rec_time.size());
+  if(fields[1] != "")
+    m_build_sources.insert(fields[1]);
+
+  m_rec_time.push_back(timestamp);
+  m_rec_begin.push_back(begin);
+  m_rec_len.push_back(len);
+}
+
+//--------------------------------------------------------
+// Procedure: finishBuild
+//     Notes: Sorts the records by time, keeping file order for equal
+//            times, then builds the variable lists and time buckets.
+
+void ALogIndex::finishBuild()
+{
+  unsigned int i, rsize = m_rec_time.size();
+
+  vector<pair<double, long> > order(rsize);
+  for(i=0; i<rsize; i++)
+    order[i] = make_pair(m_rec_time[i], (long)(i));
+  sort(order.begin(), order.end());
+
+  vector<double> times(rsize);
+  vector<long>   begins(rsize);
+  vector<long>   lens(rsize);
+  vector<long>   new_pos(rsize);
+  for(i=0; i<rsize; i++) {
+    long j = order[i].second;
+    times[i]  = m_rec_time[j];
+    begins[i] = m_rec_begin[j];
+    lens[i]   = m_rec_len[j];
+    new_pos[j] = i;
+  }
+  m_rec_time.swap(times);
+  m_rec_begin.swap(begins);
+  m_rec_len.swap(lens);
+
+  map<string, vector<long> >::iterator p;
+  for(p=m_build_var_recs.begin(); p!=m_build_var_recs.end(); p++) {
+    vector<long> recs = p->second;
+    for(unsigned int k=0; k<recs.size(); k++)
+      recs[k] = new_pos[recs[k]];
+    sort(recs.begin(), recs.end());
+
+    m_var_ix[p->first] = m_var_names.size();
+    m_var_names.push_back(p->first);
+    m_var_records.push_back(recs);
+  }
+  m_sources.assign(m_build_sources.begin(), m_build_sources.end());
+
+  m_build_var_recs.clear();
+  m_build_sources.clear();
+
+  // About a thousand time buckets over the duration of the log
+  if(rsize == 0)
+    return;
+  double tstart = m_rec_time.front();
+  double tend   = m_rec_time.back();
+  double width  = (tend - tstart) / 1024.0;
+  if(width < 0.001)
+    width = 0.001;
+  long buckets = (long)((tend - tstart) / width) + 1;
+
+  long ix = 0;
+  for(long b=0; b<buckets; b++) {
+    double t = tstart + b * width;
+    while((ix < (long)(rsize)) && (m_rec_time[ix] < t))
+      ix++;
+    m_buckets.push_back(ix);
+  }
+  m_bucket_start = tstart;
+  m_bucket_width = width;
+}
+
+//--------------------------------------------------------
+// Procedure: readIndex
+//     Notes: Returns false, with the index cleared, if the file is
+//            missing, of another version, or cut short.
+
+bool ALogIndex::readIndex(const string& idxfile)
+{
+  clear();
+
+  FILE *f = fopen(idxfile.c_str(), "rb");
+  if(!f)
+    return(false);
+
+  int    version = 0;
+  long   recs_begin = 0;
+  long   num_recs = 0;
+  long   num_buckets = 0;
+  long   num_others = 0;
+
+  bool ok = (fread(&version, sizeof(version), 1, f) == 1);
+  ok = ok && (version == ALOG_INDEX_VERSION);
+  ok = ok && (fread(&recs_begin, sizeof(recs_begin), 1, f) == 1);
+  ok = ok && (fread(&num_recs, sizeof(num_recs), 1, f) == 1);
+  ok = ok && (fread(&m_logstart, sizeof(m_logstart), 1, f) == 1);
+  ok = ok && (fread(&m_alog_size, sizeof(m_alog_size), 1, f) == 1);
+  ok = ok && (fread(&m_alog_checksum, sizeof(m_alog_checksum), 1, f) == 1);
+  ok = ok && (fread(&m_bucket_start, sizeof(m_bucket_start), 1, f) == 1);
+  ok = ok && (fread(&m_bucket_width, sizeof(m_bucket_width), 1, f) == 1);
+  ok = ok && (fread(&num_buckets, sizeof(num_buckets), 1, f) == 1);
+  ok = ok && (fread(&num_others, sizeof(num_others), 1, f) == 1);
+  ok = ok && (num_recs >= 0) && (num_buckets >= 0) && (num_others >= 0);
+
+  ok = ok && readListLine(f, m_var_names);
+  ok = ok && readListLine(f, m_sources);
+  ok = ok && (fseek(f, recs_begin, SEEK_SET) == 0);
+
+  ok = ok && readRecords(f, num_recs, &m_rec_time, m_rec_begin, m_rec_len);
+
+  if(ok && (num_buckets > 0)) {
+    m_buckets.resize(num_buckets);
+    ok = (fread(&m_buckets[0], sizeof(long), num_buckets, f) ==
+	  (size_t)(num_buckets));
+  }
+
+  m_var_records.resize(m_var_names.size());
+  for(unsigned int k=0; ok && (k<m_var_names.size()); k++) {
+    long count = 0;
+    ok = (fread(&count, sizeof(count), 1, f) == 1) && (count >= 0);
+    if(ok && (count > 0)) {
+      m_var_records[k].resize(count);
+      ok = (fread(&m_var_records[k][0], sizeof(long), count, f) ==
+	    (size_t)(count));
+    }
+    m_var_ix[m_var_names[k]] = k;
+  }
+
+  ok = ok && readRecords(f, num_others, 0, m_oth_begin, m_oth_len);
+  fclose(f);
+
+  if(!ok)
+    clear();
+  return(ok);
+}
+
+//--------------------------------------------------------
+// Procedure: writeIndex
+
+bool ALogIndex::writeIndex(const string& idxfile) const
+{
+  FILE *f = fopen(idxfile.c_str(), "wb");
+  if(!f)
+    return(false);
+
+  int    version = ALOG_INDEX_VERSION;
+  long   recs_begin = 0;
+  long   num_recs = m_rec_time.size();
+  long   num_buckets = m_buckets.size();
+  long   num_others = m_oth_begin.size();
+
+  // The header is written twice, the second time knowing where the
+  // records begin
+  for(unsigned int pass=0; pass<2; pass++) {
+    fseek(f, 0, SEEK_SET);
+    fwrite(&version, sizeof(version), 1, f);
+    fwrite(&recs_begin, sizeof(recs_begin), 1, f);
+    fwrite(&num_recs, sizeof(num_recs), 1, f);
+    fwrite(&m_logstart, sizeof(m_logstart), 1, f);
+    fwrite(&m_alog_size, sizeof(m_alog_size), 1, f);
+    fwrite(&m_alog_checksum, sizeof(m_alog_checksum), 1, f);
+    fwrite(&m_bucket_start, sizeof(m_bucket_start), 1, f);
+    fwrite(&m_bucket_width, sizeof(m_bucket_width), 1, f);
+    fwrite(&num_buckets, sizeof(num_buckets), 1, f);
+    fwrite(&num_others, sizeof(num_others), 1, f);
+    if(pass == 0) {
+      writeListLine(f, m_var_names);
+      writeListLine(f, m_sources);
+      recs_begin = ftell(f);
+    }
+  }
+  fseek(f, recs_begin, SEEK_SET);
+
+  for(long i=0; i<num_recs; i++) {
+    fwrite(&m_rec_time[i], sizeof(double), 1, f);
+    fwrite(&m_rec_begin[i], sizeof(long), 1, f);
+    fwrite(&m_rec_len[i], sizeof(long), 1, f);
+  }
+  if(num_buckets > 0)
+    fwrite(&m_buckets[0], sizeof(long), num_buckets, f);
+
+  for(unsigned int k=0; k<m_var_records.size(); k++) {
+    long count = m_var_records[k].size();
+    fwrite(&count, sizeof(count), 1, f);
+    if(count > 0)
+      fwrite(&m_var_records[k][0], sizeof(long), count, f);
+  }
+
+  double unused_time = 0;
+  for(long i=0; i<num_others; i++) {
+    fwrite(&unused_time, sizeof(double), 1, f);
+    fwrite(&m_oth_begin[i], sizeof(long), 1, f);
+    fwrite(&m_oth_len[i], sizeof(long), 1, f);
+  }
+
+  bool ok = (ferror(f) == 0);
+  if(fclose(f) != 0)
+    ok = false;
+  return(ok);
+}
+
+//--------------------------------------------------------
+// Procedure: getLineLen
+
+long ALogIndex::getLineLen(unsigned int ix) const
+{
+  return(textLen(m_rec_begin[ix], m_rec_len[ix]));
+}
+
+//--------------------------------------------------------
+// Procedure: getOtherLen
+
+long ALogIndex::getOtherLen(unsigned int ix) const
+{
+  return(textLen(m_oth_begin[ix], m_oth_len[ix]));
+}
+
+//--------------------------------------------------------
+// Procedure: textLen
+//     Notes: Every line but an unterminated last line ends with a
+//            newline counted in its stored length.
+
+long ALogIndex::textLen(long begin, long len) const
+{
+  if((len > 0) && (m_ends_newline || (begin + len < m_alog_size)))
+    return(len - 1);
+  return(len);
+}
+
+//--------------------------------------------------------
+// Procedure: getIndexByTime
+//     Notes: Returns the index of the first record at or after the
+//            given time, or size() if there is none.
+
+unsigned int ALogIndex::getIndexByTime(double gtime) const
+{
+  unsigned int rsize = m_rec_time.size();
+  if((rsize == 0) || m_buckets.empty())
+    return(0);
+
+  long b = 0;
+  if(gtime > m_bucket_start)
+    b = (long)((gtime - m_bucket_start) / m_bucket_width);
+  if(b >= (long)(m_buckets.size()))
+    b = m_buckets.size() - 1;
+
+  unsigned int ix = m_buckets[b];
+  while((ix < rsize) && (m_rec_time[ix] < gtime))
+    ix++;
+  return(ix);
+}
+
+//--------------------------------------------------------
+// Procedure: getVarRecords
+
+const vector<long>& ALogIndex::getVarRecords(const string& var) const
+{
+  static const vector<long> none;
+
+  map<string, unsigned int>::const_iterator p = m_var_ix.find(var);
+  if((p == m_var_ix.end()) || (p->second >= m_var_records.size()))
+    return(none);
+  return(m_var_records[p->second]);
+}
+
+//--------------------------------------------------------
+// Procedure: getRecordLine
+
+string ALogIndex::getRecordLine(unsigned int ix)
+{
+  return(readLine(m_rec_begin[ix], m_rec_len[ix]));
+}
+
+//--------------------------------------------------------
+// Procedure: getOtherLine
+
+string ALogIndex::getOtherLine(unsigned int ix)
+{
+  return(readLine(m_oth_begin[ix], m_oth_len[ix]));
+}
+
+//--------------------------------------------------------
+// Procedure: readLine
+//     Notes: Lines read in file order need no seek.
+
+string ALogIndex::readLine(long begin, long len)
+{
+  string line;
+  if(!m_file || (len <= 0))
+    return(line);
+
+  if(begin != m_file_pos) {
+    if(fseek(m_file, begin, SEEK_SET) != 0) {
+      m_file_pos = -1;
+      return(line);
+    }
+  }
+
+  line.resize(len);
+  size_t amt = fread(&line[0], 1, len, m_file);
+  m_file_pos = begin + amt;
+  line.resize(amt);
+
+  if((line.length() > 0) && (line[line.length()-1] == '\n'))
+    line.erase(line.length()-1);
+  return(line);
+}
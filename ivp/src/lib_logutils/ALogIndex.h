@@ -0,0 +1,130 @@
+/*****************************************************************/
+/*    NAME: MOOS-IvP contributors                                */
+/*    ORGN: Dept of Mechanical Eng / CSAIL, MIT Cambridge MA     */
+/*    FILE: ALogIndex.h                                          */
+/*    DATE: Oct 18th 2026                                        */
+/*                                                               */
+/* This file is part of MOOS-IvP                                 */
+/*                                                               */
+/* MOOS-IvP is free software: you can redistribute it and/or     */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation, either version  */
+/* 3 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* MOOS-IvP is distributed in the hope that it will be useful,   */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty   */
+/* of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See  */
+/* the GNU General Public License for more details.              */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with MOOS-IvP.  If not, see                     */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+
+#ifndef ALOG_INDEX_HEADER
+#define ALOG_INDEX_HEADER
+
+#include <vector>
+#include <map>
+#include <set>
+#include <string>
+#include <cstdio>
+
+//---------------------------------------------------------------
+// ALogIndex opens an alog file through an index kept next to it
+// in <alogfile>.idx, building the index in memory when there is
+// no such file or the alog has changed since. The index is only
+// written back if asked for, so by default opening an alog leaves
+// its directory untouched. The index file is the format
+// written by the libAlogTools indexWriter used by uIndexedPlayBack
+// (format version 1), so either tool may build it for the other.
+//
+// The index holds, for each line beginning with a timestamp (a
+// record), its time and byte offset and length in the alog, in
+// time order. For each variable it holds the list of its records,
+// and a table of time buckets for seeking to a time. Comments and
+// other lines are kept in file order. Line lengths returned here
+// do not include the newline.
+
+class ALogIndex
+{
+ public:
+  ALogIndex();
+  ~ALogIndex();
+
+  bool open(const std::string& alogfile, bool write_index=false);
+  void close();
+
+  bool build(const std::string& alogfile);
+  bool readIndex(const std::string& idxfile);
+  bool writeIndex(const std::string& idxfile) const;
+
+  // Records, in time order
+  unsigned int size() const {return(m_rec_time.size());}
+
+  double getTime(unsigned int ix) const      {return(m_rec_time[ix]);}
+  long   getLineBegin(unsigned int ix) const {return(m_rec_begin[ix]);}
+  long   getLineLen(unsigned int ix) const;
+
+  unsigned int getIndexByTime(double) const;
+
+  // Comments, blank lines and other lines, in file order
+  unsigned int sizeOthers() const {return(m_oth_begin.size());}
+
+  long   getOtherBegin(unsigned int ix) const {return(m_oth_begin[ix]);}
+  long   getOtherLen(unsigned int ix) const;
+
+  // Variables and sources, in sorted order
+  const std::vector<std::string>& getVarNames() const {return(m_var_names);}
+  const std::vector<std::string>& getSources() const  {return(m_sources);}
+
+  // Indices of the records of one variable, in time order
+  const std::vector<long>& getVarRecords(const std::string&) const;
+
+  double getLogStart() const    {return(m_logstart);}
+  long   getALogSize() const    {return(m_alog_size);}
+  bool   endsWithNewline() const {return(m_ends_newline);}
+
+  // Read the text of a line from the open alog
+  std::string getRecordLine(unsigned int ix);
+  std::string getOtherLine(unsigned int ix);
+
+ protected:
+  void   clear();
+  void   addLine(const std::string& line, long begin, long len);
+  void   finishBuild();
+  long   textLen(long begin, long len) const;
+  std::string readLine(long begin, long len);
+
+ protected:
+  FILE*  m_file;
+  long   m_file_pos;
+
+  long         m_alog_size;
+  unsigned int m_alog_checksum;
+  bool         m_ends_newline;
+  double       m_logstart;
+
+  std::vector<double> m_rec_time;
+  std::vector<long>   m_rec_begin;
+  std::vector<long>   m_rec_len;
+
+  std::vector<long>   m_oth_begin;
+  std::vector<long>   m_oth_len;
+
+  std::vector<std::string>           m_var_names;
+  std::vector<std::string>           m_sources;
+  std::vector<std::vector<long> >    m_var_records;
+  std::map<std::string, unsigned int> m_var_ix;
+
+  double              m_bucket_start;
+  double              m_bucket_width;
+  std::vector<long>   m_buckets;
+
+  // Used only while building, records of each variable in file order
+  std::map<std::string, std::vector<long> > m_build_var_recs;
+  std::set<std::string>                     m_build_sources;
+};
+
+#endif
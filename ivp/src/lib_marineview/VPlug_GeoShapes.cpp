@@ -272,15 +272,20 @@ bool VPlug_GeoShapes::updateGrid(const string& delta)
 //-----------------------------------------------------------
 // Procedure: updateConvexGrid
 
+//      Note: The delta is applied only to the convex grid with the
+//            matching label. If no such grid has yet been received
+//            the delta is dropped until the next full grid arrives.
+
 bool VPlug_GeoShapes::updateConvexGrid(const string& delta)
 {
-  bool ok = true;
-#if 0
+  string label = tokStringParse(delta, "label", ',', '=');
+
   unsigned int i, vsize = m_convex_grids.size();
-  for(i=0; i<vsize; i++)
-    ok = ok && m_convex_grids[i].processDelta(delta);
-#endif
-  return(ok);
+  for(i=0; i<vsize; i++) {
+    if(m_convex_grids[i].get_label() == label)
+      return(m_convex_grids[i].processDelta(delta));
+  }
+  return(false);
 }
 
 //-----------------------------------------------------------
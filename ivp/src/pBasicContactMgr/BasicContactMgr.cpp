@@ -71,6 +71,9 @@ BasicContactMgr::BasicContactMgr()
 
   m_contacts_recap_interval = 0;
   m_contacts_recap_posted = 0;
+
+  m_contacts_changed = false;
+  m_alerts_changed   = false;
 }
 
 //---------------------------------------------------------
@@ -354,24 +357,38 @@ void BasicContactMgr::handleMailNodeReport(const string& report)
   //  return;
   //}
   
-  bool newly_known_vehicle = false;
-  if(m_map_node_records.count(vname) == 0)
-    newly_known_vehicle = true;
-  
-  m_map_node_records[vname] = new_node_record;
-  
-  if(newly_known_vehicle) {
-    m_map_node_ranges[vname] = 0;
-    m_map_node_alerts_total[vname]    = 0;
-    m_map_node_alerts_active[vname]   = 0;
-    m_map_node_alerts_resolved[vname] = 0;
-
-    m_map_node_ranges_actual[vname] = 0;
-    m_map_node_ranges_extrap[vname] = 0;
-    m_map_node_ranges_cpa[vname]    = 0;
+  unsigned int ix = m_cn_records.size();
+  map<string, unsigned int>::iterator p = m_map_contact_ix.find(vname);
+  if(p != m_map_contact_ix.end())
+    ix = p->second;
+  else {
+    m_map_contact_ix[vname] = ix;
+    m_cn_records.push_back(new_node_record);
+    m_cn_x.push_back(0);
+    m_cn_y.push_back(0);
+    m_cn_hdg.push_back(0);
+    m_cn_spd.push_back(0);
+    m_cn_utc.push_back(0);
+    m_cn_range.push_back(0);
+    m_cn_alerts_total.push_back(0);
+    m_cn_alerts_active.push_back(0);
+    m_cn_alerts_resolved.push_back(0);
+
+    m_cn_range_actual.push_back(0);
+    m_cn_range_extrap.push_back(0);
+    m_cn_range_cpa.push_back(0);
 
     m_par.addVehicle(vname);
+    m_contacts_changed = true;
+    m_alerts_changed   = true;
   }
+
+  m_cn_records[ix] = new_node_record;
+  m_cn_x[ix]   = new_node_record.getX();
+  m_cn_y[ix]   = new_node_record.getY();
+  m_cn_hdg[ix] = new_node_record.getHeading();
+  m_cn_spd[ix] = new_node_record.getSpeed();
+  m_cn_utc[ix] = new_node_record.getTimeStamp();
 }
 
 
@@ -411,10 +428,14 @@ void BasicContactMgr::handleMailResolved(const string& str)
     return;
   }
   
-  m_map_node_alerts_active[vehicle]--;
-  m_map_node_alerts_resolved[vehicle]++;
+  map<string, unsigned int>::iterator p = m_map_contact_ix.find(vehicle);
+  if(p != m_map_contact_ix.end()) {
+    m_cn_alerts_active[p->second]--;
+    m_cn_alerts_resolved[p->second]++;
+  }
   
   m_par.setValue(vehicle, alertid, false);
+  m_alerts_changed = true;
   reportEvent("Resolved: (" + vehicle + "," + alertid + ")");
 }
 
@@ -461,6 +482,7 @@ bool BasicContactMgr::handleConfigAlert(const string& alert_str)
   if(alert_id == "")
     alert_id = "no_id";
   m_par.addAlertID(alert_id);
+  m_alerts_changed = true;
 
   vector<string> svector = parseStringQ(alert_str, ',');
   unsigned int i, vsize = svector.size();
@@ -498,25 +520,31 @@ bool BasicContactMgr::handleConfigAlert(const string& alert_str)
 
 //---------------------------------------------------------
 // Procedure: postSummaries
+//      Note: The contacts list and the alerted groups are only 
+//            rebuilt when contacts or alerts have changed, and the 
+//            recap only when it is due to be posted.
 
 void BasicContactMgr::postSummaries()
 {
   string contacts_list;
   string contacts_retired;
-  string contacts_alerted;
-  string contacts_unalerted;
   string contacts_recap;
 
-  map<string, NodeRecord>::const_iterator p;
-  for(p=m_map_node_records.begin(); p!= m_map_node_records.end(); p++) {
-    string     contact_name = p->first;
-    NodeRecord node_record  = p->second;
+  double time_since_last_recap = m_curr_time - m_contacts_recap_posted;
+  bool   recap_due = (time_since_last_recap > m_contacts_recap_interval);
+
+  map<string, unsigned int>::const_iterator p;
+  for(p=m_map_contact_ix.begin(); p!= m_map_contact_ix.end(); p++) {
+    const string& contact_name = p->first;
+    unsigned int  ix = p->second;
 
-    if(contacts_list != "")
-      contacts_list += ",";
-    contacts_list += contact_name;
+    if(m_contacts_changed) {
+      if(contacts_list != "")
+	contacts_list += ",";
+      contacts_list += contact_name;
+    }
 
-    double age = m_curr_time - node_record.getTimeStamp();
+    double age = m_curr_time - m_cn_utc[ix];
 
     // If retired
     if(age > m_contact_max_age) {
@@ -524,8 +552,8 @@ void BasicContactMgr::postSummaries()
 	contacts_retired += ",";
       contacts_retired += contact_name;
     }    
-    else { // Else if not retired
-      double range = m_map_node_ranges[contact_name];
+    else if(recap_due) { // Else if not retired
+      double range = m_cn_range[ix];
       if(contacts_recap != "")
 	contacts_recap += " # ";
       contacts_recap += "vname=" + contact_name;
@@ -534,21 +562,25 @@ void BasicContactMgr::postSummaries()
     }
   }
 
-  if(m_prev_contacts_list != contacts_list) {
+  if(m_contacts_changed && (m_prev_contacts_list != contacts_list)) {
     Notify("CONTACTS_LIST", contacts_list);
     m_prev_contacts_list = contacts_list;
   }
+  m_contacts_changed = false;
 
-  contacts_alerted = m_par.getAlertedGroup(true);
-  if(m_prev_contacts_alerted != contacts_alerted) {
-    Notify("CONTACTS_ALERTED", contacts_alerted);
-    m_prev_contacts_alerted = contacts_alerted;
-  }
-
-  contacts_unalerted = m_par.getAlertedGroup(false);
-  if(m_prev_contacts_unalerted != contacts_unalerted) {
-    Notify("CONTACTS_UNALERTED", contacts_unalerted);
-    m_prev_contacts_unalerted = contacts_unalerted;
+  if(m_alerts_changed) {
+    string contacts_alerted = m_par.getAlertedGroup(true);
+    if(m_prev_contacts_alerted != contacts_alerted) {
+      Notify("CONTACTS_ALERTED", contacts_alerted);
+      m_prev_contacts_alerted = contacts_alerted;
+    }
+    
+    string contacts_unalerted = m_par.getAlertedGroup(false);
+    if(m_prev_contacts_unalerted != contacts_unalerted) {
+      Notify("CONTACTS_UNALERTED", contacts_unalerted);
+      m_prev_contacts_unalerted = contacts_unalerted;
+    }
+    m_alerts_changed = false;
   }
 
   if(m_prev_contacts_retired != contacts_retired) {
@@ -556,9 +588,7 @@ void BasicContactMgr::postSummaries()
     m_prev_contacts_retired = contacts_retired;
   }
 
-  double time_since_last_recap = m_curr_time - m_contacts_recap_posted;
-
-  if(time_since_last_recap > m_contacts_recap_interval) {
+  if(recap_due) {
     m_contacts_recap_posted = m_curr_time;
     Notify("CONTACTS_RECAP", contacts_recap);
     m_prev_contacts_recap = contacts_recap;
@@ -568,20 +598,34 @@ void BasicContactMgr::postSummaries()
 
 //---------------------------------------------------------
 // Procedure: postAlerts
+//      Note: Contacts that are retired, or beyond the largest alert
+//            range, cannot be alerted and their alerts are not
+//            checked.
 
 bool BasicContactMgr::postAlerts()
 {
   bool new_alerts = false;
 
-  map<string, NodeRecord>::iterator p;
-  for(p=m_map_node_records.begin(); p!=m_map_node_records.end(); p++) {
-    string     contact_name  = p->first;
-    NodeRecord node_record   = p->second;
-    double     contact_range = m_map_node_ranges[contact_name];
-    double     age = m_curr_time - node_record.getTimeStamp();
+  double alert_range_max = 0;
+  map<string,string>::iterator q;
+  for(q=m_map_alert_varname.begin(); q!=m_map_alert_varname.end(); q++) {
+    double alert_range = getAlertRange(q->first);
+    if(alert_range > alert_range_max)
+      alert_range_max = alert_range;
+  }
+
+  map<string, unsigned int>::iterator p;
+  for(p=m_map_contact_ix.begin(); p!=m_map_contact_ix.end(); p++) {
+    const string& contact_name = p->first;
+    unsigned int  ix = p->second;
+    double     contact_range = m_cn_range[ix];
+    double     age = m_curr_time - m_cn_utc[ix];
+    if((age > m_contact_max_age) || (contact_range > alert_range_max))
+      continue;
+
+    const NodeRecord& node_record = m_cn_records[ix];
 
     // For each alert_id
-    map<string,string>::iterator q;
     for(q=m_map_alert_varname.begin(); q!=m_map_alert_varname.end(); q++) {
       string alert_id = q->first;
       bool alerted = m_par.getValue(contact_name, alert_id);
@@ -632,6 +676,7 @@ bool BasicContactMgr::postAlerts()
 
 	  Notify(var, msg);
 	  m_par.setValue(contact_name, alert_id, true);
+	  m_alerts_changed = true;
 	  reportEvent(var + "=" + msg);
 
 
@@ -644,20 +689,20 @@ bool BasicContactMgr::postAlerts()
 
 	    mval += ",range_used=" + doubleToString(contact_range,1);
 
-	    double range_actual = m_map_node_ranges_actual[contact_name];
+	    double range_actual = m_cn_range_actual[ix];
 	    mval += ",range_actual=" + doubleToString(range_actual,1);
 
-	    double range_extrap = m_map_node_ranges_actual[contact_name];
+	    double range_extrap = m_cn_range_actual[ix];
 	    mval += ",range_extrap=" + doubleToString(range_extrap,1);
 
-	    double range_cpa = m_map_node_ranges_cpa[contact_name];
+	    double range_cpa = m_cn_range_cpa[ix];
 	    mval += ",range_cpa=" + doubleToString(range_cpa,1);
 
 	    Notify(mvar, mval);
 	  }
 
-	  m_map_node_alerts_total[contact_name]++;
-	  m_map_node_alerts_active[contact_name]++;
+	  m_cn_alerts_total[ix]++;
+	  m_cn_alerts_active[ix]++;
 	}
       }
     }
@@ -668,32 +713,39 @@ bool BasicContactMgr::postAlerts()
 
 //---------------------------------------------------------
 // Procedure: updateRanges
+//      Note: The CPA range is only calculated if it will be used,
+//            or if verbose alerts are requested.
+//      Note: Every contact, near or far, is extrapolated and ranged
+//            each iteration since CONTACTS_RECAP and the AppCast
+//            report give the range of all contacts. A spatial index
+//            would only spare far contacts the alert checks.
 
 void BasicContactMgr::updateRanges()
 {
   double alert_range_cpa_time = 36000; // 10 hours
 
-  map<string, NodeRecord>::iterator p;
-  for(p=m_map_node_records.begin(); p!=m_map_node_records.end(); p++) {
-    string     vname = p->first;
-    NodeRecord node_record = p->second;
+  LinearExtrapolator linex;
+  linex.setDecay(m_decay_start, m_decay_end);
+
+  map<string, unsigned int>::iterator p;
+  for(p=m_map_contact_ix.begin(); p!=m_map_contact_ix.end(); p++) {
+    const string& vname = p->first;
+    unsigned int  ix = p->second;
 
     // First figure out the raw range to the contact
-    double cnx = node_record.getX();
-    double cny = node_record.getY();
-    double cnh = node_record.getHeading();
-    double cns = node_record.getSpeed();
-    double cnt = node_record.getTimeStamp();
+    double cnx = m_cn_x[ix];
+    double cny = m_cn_y[ix];
+    double cnh = m_cn_hdg[ix];
+    double cns = m_cn_spd[ix];
+    double cnt = m_cn_utc[ix];
 
     // #1 Determine and store the actual point-to-point range between ownship
     // and the last absolute known position of the contact
     double range_actual = hypot((m_nav_x - cnx), (m_nav_y - cny));
-    m_map_node_ranges_actual[vname] = range_actual;
+    m_cn_range_actual[ix] = range_actual;
 
     // #2 Determine and store the extrapolated range between ownship and the
     // contact position determined by its last known range and extrapolation.
-    LinearExtrapolator linex;
-    linex.setDecay(m_decay_start, m_decay_end);
     linex.setPosition(cnx, cny, cns, cnh, cnt);
 
     double extrap_x = cnx;
@@ -706,25 +758,7 @@ void BasicContactMgr::updateRanges()
       cny = extrap_y;
       range_extrap = hypot((m_nav_x - cnx), (m_nav_y - cny));
     }
-    m_map_node_ranges_extrap[vname] = range_extrap;
-
-    //XYPoint point_mb(cnx, cny);
-    //point_mb.set_label(node_record.getName() + "xpt_mb");
-    //m_Comms.Notify("VIEW_POINT", point_mb.get_spec());
-
-    // #3 Determine and store the cpa range between ownship and the
-    // contact position determined by the contact's extrapolated position
-    // and it's last known heading and speed.
-    CPAEngine engine(cny, cnx, cnh, cns, m_nav_y, m_nav_x);      
-    double range_cpa = engine.evalCPA(m_nav_hdg, m_nav_spd, alert_range_cpa_time);
-    m_map_node_ranges_cpa[vname] = range_cpa;
-    
-    // Now we have set:
-    //   1. m_map_node_ranges_actual[vname]  (range_actual)
-    //   2. m_map_node_ranges_extrap[vname]  (range_extrap)
-    //   3. m_map_node_ranges_cpa[vname]     (range_cpa)
-    // We just need to decide which one to use for the purposes of 
-    // determining whether an alert should be generated.
+    m_cn_range_extrap[ix] = range_extrap;
 
     // If the extrapolated (non-cpa) range exceeds the minimum threshold, 
     // but is less than the alert_cpa threshold, calculate the CPA and 
@@ -732,10 +766,22 @@ void BasicContactMgr::updateRanges()
 
     double alert_range = getAlertRange(vname);          // min threshold
     double alert_range_cpa = getAlertRangeCPA(vname);   // cpa threshold
+    bool   use_cpa = ((range_extrap > alert_range) && 
+		      (range_extrap < alert_range_cpa));
 
-    m_map_node_ranges[vname] = range_extrap;
-    if((range_extrap > alert_range) && (range_extrap < alert_range_cpa)) 
-      m_map_node_ranges[vname] = range_cpa;
+    // #3 Determine and store the cpa range between ownship and the
+    // contact position determined by the contact's extrapolated position
+    // and it's last known heading and speed.
+    double range_cpa = 0;
+    if(use_cpa || m_alert_verbose) {
+      CPAEngine engine(cny, cnx, cnh, cns, m_nav_y, m_nav_x);      
+      range_cpa = engine.evalCPA(m_nav_hdg, m_nav_spd, alert_range_cpa_time);
+      m_cn_range_cpa[ix] = range_cpa;
+    }
+    
+    m_cn_range[ix] = range_extrap;
+    if(use_cpa)
+      m_cn_range[ix] = range_cpa;
   }
 }
 
@@ -861,13 +907,14 @@ bool BasicContactMgr::buildReport()
   actab << "        |       | Total   | Active | Resolved ";
   actab.addHeaderLines();
 
-  map<string, NodeRecord>::iterator q;
-  for(q=m_map_node_records.begin(); q!=m_map_node_records.end(); q++) {
+  map<string, unsigned int>::iterator q;
+  for(q=m_map_contact_ix.begin(); q!=m_map_contact_ix.end(); q++) {
     string vname = q->first;
-    string range = doubleToString(m_map_node_ranges[vname], 1);
-    string alerts_total  = uintToString(m_map_node_alerts_total[vname]);
-    string alerts_active = uintToString(m_map_node_alerts_active[vname]);
-    string alerts_resolved = uintToString(m_map_node_alerts_resolved[vname]);
+    unsigned int ix = q->second;
+    string range = doubleToString(m_cn_range[ix], 1);
+    string alerts_total  = uintToString(m_cn_alerts_total[ix]);
+    string alerts_active = uintToString(m_cn_alerts_active[ix]);
+    string alerts_resolved = uintToString(m_cn_alerts_resolved[ix]);
     actab << vname << range << alerts_total << alerts_active << alerts_resolved;
   }
   m_msgs << "Contact Status Summary:" << endl;
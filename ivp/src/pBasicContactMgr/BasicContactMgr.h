@@ -93,16 +93,29 @@ class BasicContactMgr : public AppCastingMOOSApp
 
  protected: // State variables
 
-  // Main Record #2: The Vehicles (contacts) and position info
-  std::map<std::string, NodeRecord>   m_map_node_records;
-  std::map<std::string, double>       m_map_node_ranges;
-  std::map<std::string, unsigned int> m_map_node_alerts_total;
-  std::map<std::string, unsigned int> m_map_node_alerts_active;
-  std::map<std::string, unsigned int> m_map_node_alerts_resolved;
+  // Main Record #2: The Vehicles (contacts) and position info. Each
+  // contact is given an index into the below vectors when first heard
+  // from. Contacts are never removed, only retired by age.
+  std::map<std::string, unsigned int> m_map_contact_ix;
+  std::vector<NodeRecord>   m_cn_records;
+  std::vector<double>       m_cn_x;
+  std::vector<double>       m_cn_y;
+  std::vector<double>       m_cn_hdg;
+  std::vector<double>       m_cn_spd;
+  std::vector<double>       m_cn_utc;
+  std::vector<double>       m_cn_range;
+  std::vector<unsigned int> m_cn_alerts_total;
+  std::vector<unsigned int> m_cn_alerts_active;
+  std::vector<unsigned int> m_cn_alerts_resolved;
   // Calculated for verbose purposes
-  std::map<std::string, double>       m_map_node_ranges_actual;
-  std::map<std::string, double>       m_map_node_ranges_extrap;
-  std::map<std::string, double>       m_map_node_ranges_cpa;
+  std::vector<double>       m_cn_range_actual;
+  std::vector<double>       m_cn_range_extrap;
+  std::vector<double>       m_cn_range_cpa;
+
+  // True if the contacts list or the alert record has changed
+  // since the summaries were last posted
+  bool   m_contacts_changed;
+  bool   m_alerts_changed;
 
   // memory of previous status postings: A posting to the MOOS var
   // is only made when a change is detected between curr and prev.
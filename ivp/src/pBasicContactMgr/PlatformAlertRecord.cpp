@@ -138,7 +138,7 @@ bool PlatformAlertRecord::getValue(string vehicle, string alertid) const
   if(p==m_par.end())
     return(false);
   else {
-    map<string, bool> imap = p->second;
+    const map<string, bool>& imap = p->second;
     map<string,bool>::const_iterator q=imap.find(alertid);
     if(q==imap.end())
       return(false);
@@ -161,7 +161,7 @@ string PlatformAlertRecord::getAlertedGroup(bool alerted) const
   map<string, map<string, bool> >::const_iterator p1;
   for(p1=m_par.begin(); p1!=m_par.end(); p1++) {
     string vehicle = p1->first;
-    map<string, bool> imap = p1->second;
+    const map<string, bool>& imap = p1->second;
     map<string, bool>::const_iterator p2;
     for(p2=imap.begin(); p2!=imap.end(); p2++) {
       string alertid = p2->first;
@@ -185,7 +185,7 @@ bool PlatformAlertRecord::alertsPending() const
   map<string, map<string, bool> >::const_iterator p1;
   for(p1=m_par.begin(); p1!=m_par.end(); p1++) {
     string vehicle = p1->first;
-    map<string, bool> imap = p1->second;
+    const map<string, bool>& imap = p1->second;
     map<string, bool>::const_iterator p2;
     for(p2=imap.begin(); p2!=imap.end(); p2++) {
       bool bool_val = p2->second;
@@ -205,7 +205,7 @@ void PlatformAlertRecord::print() const
   map<string, map<string, bool> >::const_iterator p1;
   for(p1=m_par.begin(); p1!=m_par.end(); p1++) {
     string vehicle = p1->first;
-    map<string, bool> imap = p1->second;
+    const map<string, bool>& imap = p1->second;
     map<string, bool>::const_iterator p2;
     for(p2=imap.begin(); p2!=imap.end(); p2++) {
       string alertid = p2->first;
@@ -25,6 +25,11 @@
 #pragma warning(disable : 4786)
 #endif
 
+#ifndef _WIN32
+#include <sys/time.h>
+#else
+#include <ctime>
+#endif
 #include <iostream>
 #include <string>
 #include "HelmEngine.h"
@@ -32,10 +37,27 @@
 #include "MBTimer.h"
 #include "IO_Utilities.h"
 #include "IvPProblem.h"
+#include "DenseProblem.h"
 #include "BehaviorSet.h"
 
 using namespace std;
 
+//-----------------------------------------------------------
+// Procedure: wallTime
+//      Note: Used only when profiling. MBTimer resolves only
+//            milliseconds, too coarse for a single behavior.
+
+static double wallTime()
+{
+#ifndef _WIN32
+  struct timeval tv;
+  gettimeofday(&tv, 0);
+  return((double)(tv.tv_sec) + ((double)(tv.tv_usec) / 1000000.0));
+#else
+  return((double)(clock()) / CLOCKS_PER_SEC);
+#endif
+}
+
 //-----------------------------------------------------------
 // Procedure: Constructor
 
@@ -52,6 +74,13 @@ HelmEngine::HelmEngine(IvPDomain g_ivp_domain,
   m_max_loop_time   = 0;
   m_max_solve_time  = 0;
   m_max_create_time = 0;
+
+  m_solver = "auto";
+
+  m_profiling        = false;
+  m_prof_counter     = 0;
+  m_prof_create_time = 0;
+  m_prof_solve_time  = 0;
 }
 
 //-----------------------------------------------------------
@@ -62,6 +91,18 @@ HelmEngine::~HelmEngine()
   delete(m_ivp_problem);
 }
 
+//-----------------------------------------------------------
+// Procedure: setSolver
+
+bool HelmEngine::setSolver(string solver)
+{
+  solver = tolower(solver);
+  if((solver != "ivp") && (solver != "dense") && (solver != "auto"))
+    return(false);
+  m_solver = solver;
+  return(true);
+}
+
 //------------------------------------------------------------------
 // Procedure: determineNextDecision()
 
@@ -75,6 +116,15 @@ HelmReport HelmEngine::determineNextDecision(BehaviorSet *bhv_set,
   m_helm_report.clear();
   m_ivp_functions.clear();
 
+  if(m_profiling) {
+    m_prof_create_time = 0;
+    m_prof_solve_time  = 0;
+    m_prof_bhvs.clear();
+    m_prof_times.clear();
+    m_prof_pieces.clear();
+    m_prof_counts.clear();
+  }
+
   bool filter_behaviors_present = bhv_set->filterBehaviorsPresent();
 
   bool handled = true;
@@ -139,10 +189,20 @@ bool HelmEngine::part2_GetFunctionsFromBehaviorSet(int filter_level)
   int bhv_ix, bhv_cnt = m_bhv_set->size();
 
   // get all the objective functions and add time info to helm report
+  double create_start = 0;
+  if(m_profiling)
+    create_start = wallTime();
   m_create_timer.start();
   for(bhv_ix=0; bhv_ix<bhv_cnt; bhv_ix++) {
     if(m_bhv_set->getFilterLevel(bhv_ix) == filter_level) {
       string bhv_state;
+      double ipf_start = 0;
+      unsigned long count_start = 0;
+      if(m_profiling) {
+	ipf_start = wallTime();
+	if(m_prof_counter)
+	  count_start = m_prof_counter();
+      }
       m_ipf_timer.start();
       IvPFunction *newof = m_bhv_set->produceOF(bhv_ix, m_iteration, bhv_state);
 #if 1
@@ -153,6 +213,13 @@ bool HelmEngine::part2_GetFunctionsFromBehaviorSet(int filter_level)
 							bhv_state);
 #endif
       m_ipf_timer.stop();
+      if(m_profiling) {
+	m_prof_bhvs.push_back(m_bhv_set->getDescriptor(bhv_ix));
+	m_prof_times.push_back(wallTime() - ipf_start);
+	m_prof_pieces.push_back(newof ? newof->size() : 0);
+	if(m_prof_counter)
+	  m_prof_counts.push_back(m_prof_counter() - count_start);
+      }
   
       // Determine the amt of time the bhv has been in this state
       // double state_elapsed = m_bhv_set->getStateElapsed(bhv_ix);
@@ -167,6 +234,8 @@ bool HelmEngine::part2_GetFunctionsFromBehaviorSet(int filter_level)
 	  bhv_error_str = " - unknown - ";
 	m_helm_report.setHaltMsg("BHV_ERROR: " + bhv_error_str);
 	m_create_timer.stop();
+	if(m_profiling)
+	  m_prof_create_time += wallTime() - create_start;
 	return(false);
       }
       
@@ -218,6 +287,8 @@ bool HelmEngine::part2_GetFunctionsFromBehaviorSet(int filter_level)
     }
   }
   m_create_timer.stop();
+  if(m_profiling)
+    m_prof_create_time += wallTime() - create_start;
 
   return(true);
 }
@@ -321,14 +392,45 @@ bool HelmEngine::part4_BuildAndSolveIvPProblem(string phase)
   }
 
   // Create, Prepare, and Solve the IvP problem
-  m_ivp_problem = new IvPProblem;
+  bool dense = (m_solver == "dense");
+  if(m_solver == "auto") {
+    unsigned int pieces = 0;
+    for(i=0; i<ipfs; i++)
+      pieces += m_ivp_functions[i]->size();
+    dense = DenseProblem::preferred(m_sub_domain, ipfs, pieces);
+  }
+  if(dense && (DenseProblem::domainPoints(m_sub_domain) == 0))
+    dense = false;
+
+  if(dense)
+    m_ivp_problem = new DenseProblem;
+  else
+    m_ivp_problem = new IvPProblem;
+  m_helm_report.addMsg(string("Solver: ") + (dense ? "dense" : "ivp"));
+
+  double solve_start = 0;
+  if(m_profiling)
+    solve_start = wallTime();
   m_solve_timer.start();
-  for(i=0; i<ipfs; i++)
-      m_ivp_problem->addOF(m_ivp_functions[i]);
+  for(i=0; i<ipfs; i++) {
+    // A function held for reporting is shared with the problem and
+    // handed back after solving. It is copied instead if the problem
+    // would change it beyond a weight change: by translating it to
+    // another domain, or in the prefilter phase by solving it twice.
+    IvPFunction *ipf = m_ivp_functions[i];
+    if(m_bhv_set->isReportedIPF(ipf)) {
+      if((phase == "prefilter") || 
+	 (!ipf->isFactored() && !(ipf->getDomain() == m_sub_domain)))
+	m_bhv_set->copyReportedIPF(ipf);
+    }
+    m_ivp_problem->addOF(ipf);
+  }
   m_ivp_problem->setDomain(m_sub_domain);
   m_ivp_problem->alignOFs();
   m_ivp_problem->solve();
   m_solve_timer.stop();
+  if(m_profiling)
+    m_prof_solve_time += wallTime() - solve_start;
 
   unsigned int dsize = m_sub_domain.size();
   for(i=0; i<dsize; i++) {
@@ -347,6 +449,15 @@ bool HelmEngine::part4_BuildAndSolveIvPProblem(string phase)
   
   if(phase == "prefilter")
     m_ivp_problem->setOwnerIPFs(false);
+  else {
+    for(i=0; i<ipfs; i++) {
+      IvPFunction *ipf = m_ivp_functions[i];
+      double scale, shift;
+      if(m_bhv_set->isReportedIPF(ipf) && 
+	 m_ivp_problem->releaseOF(ipf, scale, shift))
+	m_bhv_set->setReportedIPFWeights(ipf, scale, shift);
+    }
+  }
 
   delete(m_ivp_problem);
   m_ivp_problem = 0;
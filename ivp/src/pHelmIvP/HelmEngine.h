@@ -25,13 +25,14 @@
 #define HELM_ENGINE_HEADER
 
 #include <vector>
+#include <string>
 #include "IvPDomain.h"
 #include "HelmReport.h"
 #include "MBTimer.h"
 
 class InfoBuffer;
 class IvPFunction;
-class IvPProblem;
+class Problem;
 class BehaviorSet;
 class HelmEngine {
 public:
@@ -40,6 +41,28 @@ public:
 
   HelmReport determineNextDecision(BehaviorSet *bset, double curr_time);
 
+  // Solver used: "ivp" (branch and bound), "dense" or "auto" to
+  // solve densely only where that is expected to be as fast.
+  bool   setSolver(std::string);
+
+  // Optional profiling of each decision in wall time, finer than
+  // the CPU times of the HelmReport. Off by default. A counter, 
+  // e.g. of allocations, may be given to be sampled per behavior.
+  void   setProfiling(bool v, unsigned long (*counter)()=0)
+    {m_profiling=v; m_prof_counter=counter;}
+  double getProfileCreateTime() const   {return(m_prof_create_time);}
+  double getProfileSolveTime() const    {return(m_prof_solve_time);}
+
+  // One entry per behavior asked for a function on the last decision
+  const std::vector<std::string>& getProfileBhvs() const   
+    {return(m_prof_bhvs);}
+  const std::vector<double>&      getProfileTimes() const  
+    {return(m_prof_times);}
+  const std::vector<unsigned int>& getProfilePieces() const 
+    {return(m_prof_pieces);}
+  const std::vector<unsigned long>& getProfileCounts() const 
+    {return(m_prof_counts);}
+
 protected:
   bool   checkOFDomains(std::vector<IvPFunction*>);
 
@@ -58,18 +81,30 @@ protected:
   HelmReport   m_helm_report;
   BehaviorSet *m_bhv_set;
   double       m_curr_time;
-  IvPProblem  *m_ivp_problem;
+  Problem     *m_ivp_problem;
   InfoBuffer  *m_info_buffer;
 
   double       m_max_create_time;
   double       m_max_solve_time;
   double       m_max_loop_time;
 
+  std::string  m_solver;
+
   std::vector<IvPFunction*> m_ivp_functions;
 
   MBTimer  m_create_timer;
   MBTimer  m_ipf_timer;
   MBTimer  m_solve_timer;
+
+  bool                      m_profiling;
+  double                    m_prof_create_time;
+  double                    m_prof_solve_time;
+  std::vector<std::string>  m_prof_bhvs;
+  std::vector<double>       m_prof_times;
+  std::vector<unsigned int> m_prof_pieces;
+
+  unsigned long           (*m_prof_counter)();
+  std::vector<unsigned long> m_prof_counts;
 };
 
 #endif
@@ -92,6 +92,15 @@ HelmIvP::HelmIvP()
 
   m_rejournal_requested = true;
 
+  m_report_ipf = true;
+  m_ipf_report_interval = 0;
+  m_ipf_report_failed   = 0;
+
+  m_iterate_min_gap      = 0.05;
+  m_solver               = "auto";
+  m_triggered_iterations = 0;
+  m_oldest_nav_time      = 0;
+
   m_init_vars_ready  = false;
   m_init_vars_done   = false;
 
@@ -127,6 +136,8 @@ HelmIvP::~HelmIvP()
 
 void HelmIvP::cleanup()
 {
+  m_ipf_reporter.stop();
+
   delete(m_info_buffer);
   m_info_buffer = 0;
   m_ibuffer_curr_time_updated = false;
@@ -145,6 +156,10 @@ void HelmIvP::cleanup()
 
 bool HelmIvP::OnNewMail(MOOSMSG_LIST &NewMail)
 {
+  // Trigger mail not yet handled is handled in time order with the
+  // rest, as it would be were it not queued apart.
+  mergeTriggerMail(NewMail);
+
   AppCastingMOOSApp::OnNewMail(NewMail);
   // If this helm has been disabled, don't bother processing mail.
   if(helmStatus() == "DISABLED")
@@ -206,6 +221,13 @@ bool HelmIvP::OnNewMail(MOOSMSG_LIST &NewMail)
       }
     }
 
+    // Note the oldest update not yet acted upon for decision latency
+    if(m_latency_vars.count(moosvar)) {
+      double msg_time = msg.GetTime();
+      if((m_oldest_nav_time == 0) || (msg_time < m_oldest_nav_time))
+	m_oldest_nav_time = msg_time;
+    }
+
     if((moosvar =="MOOS_MANUAL_OVERIDE") || 
        (moosvar =="MOOS_MANUAL_OVERRIDE") ||
        ((moosvar == m_additional_override) && (moosvar != ""))) {
@@ -281,6 +303,12 @@ bool HelmIvP::OnNewMail(MOOSMSG_LIST &NewMail)
 
 bool HelmIvP::Iterate()
 {
+  // Mail for the iterate triggers arrives by its own queue and may be
+  // the reason we are iterating now. Handle it as any other mail. Any
+  // that came in before the regular mail was handled with it.
+  if(handleTriggerMail())
+    m_triggered_iterations++;
+
   AppCastingMOOSApp::Iterate();
 
   double cpu_load = GetCPULoad();
@@ -290,6 +318,7 @@ bool HelmIvP::Iterate()
   postHelmStatus();
   if(!helmStatusEnabled()) {
     m_info_buffer->clearDeltaVectors();
+    m_oldest_nav_time = 0;
     AppCastingMOOSApp::PostReport();
     return(true);
   }
@@ -314,6 +343,7 @@ bool HelmIvP::Iterate()
 
   if(!m_has_control) {
     postAllStop("ManualOverride");
+    m_oldest_nav_time = 0;
     AppCastingMOOSApp::PostReport();
     return(false);
   }
@@ -336,6 +366,7 @@ bool HelmIvP::Iterate()
   registerNewVariables();
   postModeMessages();
   postBehaviorMessages();
+  postReportedIPFs();
   postLifeEvents();
   postDefaultVariables();
 
@@ -416,7 +447,9 @@ bool HelmIvP::Iterate()
       double domain_val = m_helm_report.getDecision(domain_var);
       Notify(post_alias, domain_val);
     }
+    noteDecisionLatency();
   }
+  m_oldest_nav_time = 0;
   
   Notify("IVPHELM_CREATE_CPU", m_helm_report.getCreateTime());
   Notify("IVPHELM_LOOP_CPU", m_helm_report.getLoopTime());
@@ -536,6 +569,35 @@ void HelmIvP::postBehaviorMessages()
   m_bhv_set->removeCompletedBehaviors();
 }
 
+//------------------------------------------------------------
+// Procedure: postReportedIPFs()
+//      Note: Run once after every iteration of control loop. The
+//            functions are only handed over here. Serializing and
+//            posting is done by the IPF reporter thread.
+
+void HelmIvP::postReportedIPFs()
+{
+  if(!m_bhv_set) 
+    return;
+
+  vector<string> descs;
+  vector<double> scales, shifts;
+  vector<IvPFunction*> ipfs = m_bhv_set->pullReportedIPFs(descs, scales,
+							  shifts);
+  for(unsigned int i=0; i<ipfs.size(); i++)
+    m_ipf_reporter.addFunction(ipfs[i], descs[i], m_helm_iteration,
+			       scales[i], shifts[i]);
+
+  // Functions the reporter thread could not serialize since last time
+  unsigned int failed = m_ipf_reporter.getFailed();
+  if(failed > m_ipf_report_failed) {
+    unsigned int new_failed = failed - m_ipf_report_failed;
+    reportRunWarning("IvP function report failed: " + uintToString(new_failed) +
+		     " function(s) could not be materialized");
+    m_ipf_report_failed = failed;
+  }
+}
+
 //------------------------------------------------------------
 // Procedure: buildReport
 //      Note: A virtual function of the AppCastingMOOSApp superclass, conditionally 
@@ -584,9 +646,151 @@ bool HelmIvP::buildReport()
   m_msgs << endl << endl;
   m_msgs << actab.getFormattedString();
 
+  if(m_report_ipf) {
+    string format = "text";
+    if(m_ipf_reporter.getQuantize())
+      format = "quantized";
+    else if(m_ipf_reporter.getBinary())
+      format = "binary";
+    m_msgs << endl << endl;
+    m_msgs << "IvP Function Reports (" << format << "): ";
+    m_msgs << m_ipf_reporter.getPosted()  << " posted, ";
+    m_msgs << m_ipf_reporter.getQueued()  << " queued, ";
+    m_msgs << m_ipf_reporter.getDropped() << " dropped, ";
+    m_msgs << m_ipf_reporter.getFailed()  << " failed" << endl;
+  }
+
+  m_msgs << endl << endl;
+  m_msgs << "Solver: " << m_solver << endl;
+  if(m_iterate_triggers.size() == 0)
+    m_msgs << "Iterate: periodic" << endl;
+  else {
+    string triggers;
+    set<string>::iterator p;
+    for(p=m_iterate_triggers.begin(); p!=m_iterate_triggers.end(); p++) {
+      if(triggers != "")
+	triggers += ",";
+      triggers += *p;
+    }
+    m_msgs << "Iterate: on " << triggers << " (min gap ";
+    m_msgs << doubleToStringX(m_iterate_min_gap) << "s), ";
+    m_msgs << m_triggered_iterations << " of " << m_iteration;
+    m_msgs << " iterations triggered" << endl;
+  }
+  m_msgs << "Decision latency (ms): ";
+  if(m_decision_latency.GetCount() == 0)
+    m_msgs << "n/a" << endl;
+  else
+    m_msgs << m_decision_latency.GetSummary() << endl;
+
+  return(true);
+}
+
+//------------------------------------------------------------
+// Procedure: onTriggerMail
+//      Note: Invoked on the active queue thread for each message of
+//            an iterate trigger variable. The message is handed over
+//            to be processed by the main thread in Iterate().
+
+bool HelmIvP::onTriggerMail(CMOOSMsg &msg)
+{
+  m_trigger_lock.Lock();
+  m_trigger_mail.push_back(msg);
+  m_trigger_lock.UnLock();
+
+  RequestIterate();
+  return(true);
+}
+
+//------------------------------------------------------------
+// Procedure: handleTriggerMail
+//   Returns: true if there was trigger mail to handle
+
+bool HelmIvP::handleTriggerMail()
+{
+  MOOSMSG_LIST mail;
+  mergeTriggerMail(mail);
+  if(mail.size() == 0)
+    return(false);
+
+  OnNewMail(mail);
   return(true);
 }
 
+//------------------------------------------------------------
+// Procedure: mergeTriggerMail
+//   Purpose: Take the trigger mail handed over so far and put it in
+//            the given mail, each message ahead of the first later
+//            one. The given mail keeps its own order, which is the
+//            order in which it arrived.
+
+void HelmIvP::mergeTriggerMail(MOOSMSG_LIST &mail)
+{
+  MOOSMSG_LIST trigger_mail;
+  m_trigger_lock.Lock();
+  trigger_mail.swap(m_trigger_mail);
+  m_trigger_lock.UnLock();
+
+  MOOSMSG_LIST::iterator p = mail.begin();
+  MOOSMSG_LIST::iterator q;
+  for(q=trigger_mail.begin(); q!=trigger_mail.end(); q++) {
+    while((p != mail.end()) && (p->GetTime() <= q->GetTime()))
+      p++;
+    mail.insert(p, *q);
+  }
+}
+
+//------------------------------------------------------------
+// Procedure: startIterateTriggers
+//      Note: Mail for trigger variables is routed to an active queue
+//            whose callback wakes the main thread. The AppTick still
+//            applies when no trigger mail arrives.
+
+void HelmIvP::startIterateTriggers()
+{
+  m_latency_vars = m_iterate_triggers;
+  if(m_latency_vars.size() == 0) {
+    m_latency_vars.insert("NAV_X");
+    m_latency_vars.insert("NAV_Y");
+    m_latency_vars.insert("NAV_HEADING");
+    return;
+  }
+
+  if(!m_Comms.HasActiveQueue("helm_triggers"))
+    AddActiveQueue("helm_triggers", this, &HelmIvP::onTriggerMail);
+
+  set<string>::iterator p;
+  for(p=m_iterate_triggers.begin(); p!=m_iterate_triggers.end(); p++) {
+    AddMessageRouteToActiveQueue("helm_triggers", *p);
+    registerSingleVariable(*p);
+  }
+
+  double max_tick = 0;
+  if(m_iterate_min_gap > 0)
+    max_tick = 1.0 / m_iterate_min_gap;
+  SetAppFreq(GetAppFreq(), max_tick);
+  EnableIterateOnRequest(true);
+}
+
+//------------------------------------------------------------
+// Procedure: noteDecisionLatency
+//      Note: Called as the DESIRED_* variables are posted. Latency is
+//            measured in real (unwarped) time from the oldest latency
+//            variable update consumed since the last decision.
+
+void HelmIvP::noteDecisionLatency()
+{
+  if(m_oldest_nav_time == 0)
+    return;
+
+  double latency = MOOSTime() - m_oldest_nav_time;
+  double warp = GetMOOSTimeWarp();
+  if(warp > 0)
+    latency = latency / warp;
+
+  m_decision_latency.Add(latency);
+}
+
 //------------------------------------------------------------
 // Procedure: postLifeEvents()
 //      Note: Run once after every iteration of control loop.
@@ -1084,6 +1288,18 @@ bool HelmIvP::OnStartUp()
     }
     else if(param == "OTHER_OVERRIDE_VAR") 
       handled = setNonWhiteVarOnString(m_additional_override, value);
+    else if(param == "IPF_REPORTING") 
+      handled = setBooleanOnString(m_report_ipf, value);
+    else if(param == "IPF_REPORT_INTERVAL") 
+      handled = handleConfigIPFReportInterval(value);
+    else if(param == "IPF_FORMAT") 
+      handled = handleConfigIPFFormat(value);
+    else if(param == "ITERATE_TRIGGER") 
+      handled = handleConfigIterateTrigger(value);
+    else if(param == "ITERATE_MIN_GAP") 
+      handled = handleConfigIterateMinGap(value);
+    else if(param == "SOLVER") 
+      handled = handleConfigSolver(value);
 
     if(!handled)
       reportUnhandledConfigWarning(orig);
@@ -1097,6 +1313,7 @@ bool HelmIvP::OnStartUp()
   }
 
   m_hengine = new HelmEngine(m_ivp_domain, m_info_buffer);
+  m_hengine->setSolver(m_solver);
 
   Populator_BehaviorSet *p_bset;
   p_bset = new Populator_BehaviorSet(m_ivp_domain, m_info_buffer);
@@ -1128,6 +1345,14 @@ bool HelmIvP::OnStartUp()
     return(false);
   }
 
+  m_bhv_set->setReportIPF(m_report_ipf);
+  m_bhv_set->setIPFReportInterval(m_ipf_report_interval);
+  map<string, double>::iterator q;
+  for(q=m_ipf_report_intervals.begin(); q!=m_ipf_report_intervals.end(); q++)
+    m_bhv_set->setIPFReportInterval(q->second, q->first);
+  if(m_report_ipf)
+    m_ipf_reporter.start(&m_Comms);
+
   // Set the "ownship" parameter for all behaviors
   unsigned int i, bsize = m_bhv_set->size();
   for(i=0; i<bsize; i++) {
@@ -1140,6 +1365,7 @@ bool HelmIvP::OnStartUp()
   handleInitialVarsPhase1();
   handleHelmStartMessages();
   registerVariables();
+  startIterateTriggers();
   requestBehaviorLogging();
 
   Notify("IVPHELM_DOMAIN",  domainToString(m_ivp_domain));
@@ -1170,6 +1396,96 @@ bool HelmIvP::handleConfigNodeSkew(const string& given_value)
   return(false);
 }
 
+//--------------------------------------------------------------------
+// Procedure: handleConfigIPFReportInterval
+//  Examples: IPF_REPORT_INTERVAL = 2           (all behaviors)
+//            IPF_REPORT_INTERVAL = loiter,0.5  (just this behavior)
+
+bool HelmIvP::handleConfigIPFReportInterval(const string& given_value)
+{
+  string value = given_value;
+  string bhv   = "";
+  if(strContains(value, ','))
+    bhv = biteStringX(value, ',');
+  if(!isNumber(value))
+    return(false);
+
+  double interval = atof(value.c_str());
+  if(interval < 0)
+    return(false);
+
+  if(bhv == "")
+    m_ipf_report_interval = interval;
+  else
+    m_ipf_report_intervals[bhv] = interval;
+  return(true);
+}
+
+//--------------------------------------------------------------------
+// Procedure: handleConfigIPFFormat
+//  Examples: IPF_FORMAT = text       (default)
+//            IPF_FORMAT = binary
+//            IPF_FORMAT = quantized  (binary, 16-bit weights)
+
+bool HelmIvP::handleConfigIPFFormat(const string& value)
+{
+  string format = tolower(stripBlankEnds(value));
+  if((format != "text") && (format != "binary") && (format != "quantized"))
+    return(false);
+
+  m_ipf_reporter.setBinary(format != "text");
+  m_ipf_reporter.setQuantize(format == "quantized");
+  return(true);
+}
+
+//--------------------------------------------------------------------
+// Procedure: handleConfigIterateTrigger
+//  Examples: ITERATE_TRIGGER = NAV_X,NAV_Y,NAV_HEADING
+//            ITERATE_TRIGGER = NAV_X
+
+bool HelmIvP::handleConfigIterateTrigger(const string& value)
+{
+  vector<string> svector = parseString(value, ',');
+  for(unsigned int i=0; i<svector.size(); i++) {
+    string var = stripBlankEnds(svector[i]);
+    if(strContainsWhite(var) || (var == ""))
+      return(false);
+    m_iterate_triggers.insert(var);
+  }
+  return(svector.size() > 0);
+}
+
+//--------------------------------------------------------------------
+// Procedure: handleConfigIterateMinGap
+//   Example: ITERATE_MIN_GAP = 0.05   (seconds, 0 means no limit)
+
+bool HelmIvP::handleConfigIterateMinGap(const string& value)
+{
+  if(!isNumber(value))
+    return(false);
+  double gap = atof(value.c_str());
+  if(gap < 0)
+    return(false);
+  m_iterate_min_gap = gap;
+  return(true);
+}
+
+//--------------------------------------------------------------------
+// Procedure: handleConfigSolver
+//  Examples: SOLVER = ivp     (branch and bound)
+//            SOLVER = dense   (brute force over every domain point)
+//            SOLVER = auto    (the default, dense when the domain is
+//                              small or the pieces are many)
+
+bool HelmIvP::handleConfigSolver(const string& value)
+{
+  string solver = tolower(stripBlankEnds(value));
+  if((solver != "ivp") && (solver != "dense") && (solver != "auto"))
+    return(false);
+  m_solver = solver;
+  return(true);
+}
+
 //--------------------------------------------------------------------
 // Procedure: handleConfigSkewAny
 
@@ -40,10 +40,13 @@
 #include <set>
 #include <map>
 #include "MOOS/libMOOS/Thirdparty/AppCasting/AppCastingMOOSApp.h"
+#include "MOOS/libMOOS/Utils/MOOSLock.h"
+#include "MOOS/libMOOS/Utils/LatencyHistogram.h"
 #include "InfoBuffer.h"
 #include "IvPDomain.h"
 #include "BehaviorSet.h"
 #include "HelmEngine.h"
+#include "IPFReporter.h"
 
 class HelmIvP : public AppCastingMOOSApp
 {
@@ -67,13 +70,24 @@ public:
   bool handleConfigSkewAny(const std::string&);
   bool handleConfigStandBy(const std::string&);
   bool handleConfigDomain(const std::string&);
+  bool handleConfigIPFReportInterval(const std::string&);
+  bool handleConfigIPFFormat(const std::string&);
+  bool handleConfigIterateTrigger(const std::string&);
+  bool handleConfigIterateMinGap(const std::string&);
+  bool handleConfigSolver(const std::string&);
   
  protected:
   bool handleHeartBeat(const std::string&);
   bool updateInfoBuffer(CMOOSMsg &Msg);
+  bool onTriggerMail(CMOOSMsg &Msg);
+  bool handleTriggerMail();
+  void mergeTriggerMail(MOOSMSG_LIST&);
+  void startIterateTriggers();
+  void noteDecisionLatency();
   void postHelmStatus();
   void postCharStatus();
   void postBehaviorMessages();
+  void postReportedIPFs();
   void postLifeEvents();
   void postModeMessages();
   void postDefaultVariables();
@@ -188,5 +202,34 @@ protected:
 
   // A mapping of vehicle node_report skews  VEHICLE_NAME --> SKEW
   std::map<std::string, double>  m_node_skews;
+
+  // IvP functions are reported (BHV_IPF) by a worker thread, at most
+  // once per interval per behavior. Intervals for named behaviors
+  // override the general interval.
+  IPFReporter                    m_ipf_reporter;
+  bool                           m_report_ipf;
+  double                         m_ipf_report_interval;
+  std::map<std::string, double>  m_ipf_report_intervals;
+  unsigned int                   m_ipf_report_failed;
+
+  // The helm may be woken as soon as mail arrives for any of the
+  // trigger variables rather than waiting for the next AppTick, but
+  // never iterating more often than once per min gap. Trigger mail is
+  // routed to an active queue and handed to the main thread here.
+  std::set<std::string>          m_iterate_triggers;
+  double                         m_iterate_min_gap;
+  MOOSMSG_LIST                   m_trigger_mail;
+  CMOOSLock                      m_trigger_lock;
+  unsigned int                   m_triggered_iterations;
+
+  // IvP solver used by the engine: ivp, dense or auto
+  std::string                    m_solver;
+
+  // Decision latency is the time from the oldest unconsumed update of
+  // a latency variable (the triggers, or NAV_X/Y/HEADING if none) to
+  // the posting of the DESIRED_* variables it fed into.
+  std::set<std::string>          m_latency_vars;
+  double                         m_oldest_nav_time;
+  MOOS::LatencyHistogram         m_decision_latency;
 };
 #endif 
@@ -133,6 +133,20 @@ void showExampleConfigAndExit()
 
   blk("  // Allow unfound bhv directories to not be a problem.         ");
   blk("  bhv_dir_not_found_ok = true "," // or {true,FALSE}            ");
+  blk("                                                                ");
+  blk("  // Reporting of IvP functions (BHV_IPF) for post-mission use  ");
+  blk("  ipf_reporting        = true     ","// or {false}              ");
+  blk("  ipf_format           = text     ","// or {binary,quantized}   ");
+  blk("  ipf_report_interval  = 0        ","// secs between reports    ");
+  blk("  ipf_report_interval  = loiter,2 ","// for a named behavior    ");
+  blk("                                                                ");
+  blk("  // Iterate as soon as mail arrives for these (default none)   ");
+  blk("  iterate_trigger      = NAV_X,NAV_Y,NAV_HEADING                ");
+  blk("  iterate_min_gap      = 0.05     ","// secs between iterations ");
+  blk("                                                                ");
+  blk("  // IvP solver: branch and bound, dense, or auto to choose per ");
+  blk("  // iteration by domain size and total piece count            ");
+  blk("  solver               = auto     ","// or {ivp,dense}          ");
   blk("}                                                               ");
   blk("                                                                ");
   exit(0);
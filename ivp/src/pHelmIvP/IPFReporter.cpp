@@ -0,0 +1,204 @@
+/*****************************************************************/
+/*    NAME: MOOS-IvP contributors                                */
+/*    ORGN: Dept of Mechanical Eng / CSAIL, MIT Cambridge MA     */
+/*    FILE: IPFReporter.cpp                                      */
+/*    DATE: Oct 18th 2026                                        */
+/*                                                               */
+/* This file is part of MOOS-IvP                                 */
+/*                                                               */
+/* MOOS-IvP is free software: you can redistribute it and/or     */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation, either version  */
+/* 3 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* MOOS-IvP is distributed in the hope that it will be useful,   */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty   */
+/* of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See  */
+/* the GNU General Public License for more details.              */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with MOOS-IvP.  If not, see                     */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+#include "IPFReporter.h"
+#include "FunctionEncoder.h"
+#include "MBUtils.h"
+
+using namespace std;
+
+//--------------------------------------------------------------------
+// Procedure: Constructor
+
+IPFReporter::IPFReporter()
+{
+  m_comms     = 0;
+  m_running   = false;
+  m_binary    = false;
+  m_quantize  = false;
+  m_max_queue = 200;
+  m_posted    = 0;
+  m_dropped   = 0;
+  m_failed    = 0;
+}
+
+//--------------------------------------------------------------------
+// Procedure: start
+//   Purpose: Begin posting on the given comms client. Notify on the
+//            comms client is thread safe so postings made here are
+//            interleaved with those of the helm thread.
+
+bool IPFReporter::start(CMOOSCommClient *comms)
+{
+  if(m_running || !comms)
+    return(false);
+
+  m_comms = comms;
+  m_thread.Initialise(threadFunc, this);
+  m_running = m_thread.Start();
+  return(m_running);
+}
+
+//--------------------------------------------------------------------
+// Procedure: stop
+//      Note: Blocks until the worker has finished. Any functions
+//            still queued are discarded.
+
+void IPFReporter::stop()
+{
+  if(m_running)
+    m_thread.Stop();
+  m_running = false;
+
+  IPFReportEntry entry;
+  while(m_queue.Pull(entry));
+}
+
+//--------------------------------------------------------------------
+// Procedure: addFunction
+//   Purpose: Hand over an IvP function for reporting. The reporter
+//            takes ownership. If the worker has fallen too far
+//            behind the function is dropped rather than letting
+//            the queue grow without bound. The given weight change
+//            is applied by the worker, not here on the helm thread.
+
+bool IPFReporter::addFunction(IvPFunction *ipf, const string& desc,
+			      unsigned int iteration, double scale, 
+			      double shift)
+{
+  if(!ipf)
+    return(false);
+  
+  if(!m_running || (m_queue.Size() >= m_max_queue)) {
+    delete(ipf);
+    m_stats_lock.Lock();
+    m_dropped++;
+    m_stats_lock.UnLock();
+    return(false);
+  }
+
+  m_queue.Push(IPFReportEntry(ipf, desc, iteration, scale, shift));
+  return(true);
+}
+
+//--------------------------------------------------------------------
+// Procedure: getPosted()
+
+unsigned int IPFReporter::getPosted()
+{
+  m_stats_lock.Lock();
+  unsigned int posted = m_posted;
+  m_stats_lock.UnLock();
+  return(posted);
+}
+
+//--------------------------------------------------------------------
+// Procedure: getDropped()
+
+unsigned int IPFReporter::getDropped()
+{
+  m_stats_lock.Lock();
+  unsigned int dropped = m_dropped;
+  m_stats_lock.UnLock();
+  return(dropped);
+}
+
+//--------------------------------------------------------------------
+// Procedure: getFailed()
+//      Note: Functions that could not be serialized, e.g., a factored
+//            function whose factors could not be materialized.
+
+unsigned int IPFReporter::getFailed()
+{
+  m_stats_lock.Lock();
+  unsigned int failed = m_failed;
+  m_stats_lock.UnLock();
+  return(failed);
+}
+
+//--------------------------------------------------------------------
+// Procedure: threadFunc
+
+bool IPFReporter::threadFunc(void *param)
+{
+  IPFReporter *reporter = static_cast<IPFReporter*>(param);
+  return(reporter->work());
+}
+
+//--------------------------------------------------------------------
+// Procedure: work
+//   Purpose: Worker thread loop. Wake on each hand-over (or every
+//            so often to check for a quit request) and post 
+//            whatever is queued.
+
+bool IPFReporter::work()
+{
+  while(!m_thread.IsQuitRequested()) {
+    m_queue.WaitForPush(100);
+    IPFReportEntry entry;
+    while(!m_thread.IsQuitRequested() && m_queue.Pull(entry))
+      postFunction(entry);
+  }
+  return(true);
+}
+
+//--------------------------------------------------------------------
+// Procedure: postFunction
+//   Purpose: Serialize, break into packets and post, in the same
+//            form as always posted by the helm, so that the 
+//            viewers and log tools need not know this was done 
+//            on another thread.
+
+void IPFReporter::postFunction(IPFReportEntry& entry)
+{
+  if(entry.m_scale != 1)
+    entry.m_ipf->applyWeight(entry.m_scale);
+  if(entry.m_shift != 0)
+    entry.m_ipf->applyScalar(entry.m_shift);
+
+  // A factored function that cannot be materialized has no PDMap
+  // to serialize. Count it so the helm can warn of it.
+  if(!entry.m_ipf->getPDMap()) {
+    m_stats_lock.Lock();
+    m_failed++;
+    m_stats_lock.UnLock();
+    return;
+  }
+
+  string ipf_str;
+  if(m_binary)
+    ipf_str = IvPFunctionToBinaryString(entry.m_ipf.get(), m_quantize);
+  else
+    ipf_str = IvPFunctionToString(entry.m_ipf.get());
+  if(ipf_str == "")
+    return;
+
+  string id = entry.m_desc + "^" + intToString(entry.m_iteration);
+  vector<string> svector = IvPFunctionToVector(ipf_str, id, 2000);
+  for(unsigned int k=0; k<svector.size(); k++)
+    m_comms->Notify("BHV_IPF", svector[k], entry.m_desc);
+
+  m_stats_lock.Lock();
+  m_posted++;
+  m_stats_lock.UnLock();
+}
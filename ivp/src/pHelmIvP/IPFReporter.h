@@ -0,0 +1,98 @@
+/*****************************************************************/
+/*    NAME: MOOS-IvP contributors                                */
+/*    ORGN: Dept of Mechanical Eng / CSAIL, MIT Cambridge MA     */
+/*    FILE: IPFReporter.h                                        */
+/*    DATE: Oct 18th 2026                                        */
+/*                                                               */
+/* This file is part of MOOS-IvP                                 */
+/*                                                               */
+/* MOOS-IvP is free software: you can redistribute it and/or     */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation, either version  */
+/* 3 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* MOOS-IvP is distributed in the hope that it will be useful,   */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty   */
+/* of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See  */
+/* the GNU General Public License for more details.              */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with MOOS-IvP.  If not, see                     */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+#ifndef IPF_REPORTER_HEADER
+#define IPF_REPORTER_HEADER
+
+#include <string>
+#include "MOOS/libMOOS/MOOSLib.h"
+#include "MOOS/libMOOS/Utils/SafeList.h"
+#include "MOOS/libMOOS/Thirdparty/PocoBits/SharedPtr.h"
+#include "IvPFunction.h"
+
+// An IvP function queued for reporting, shared between the helm
+// thread handing it over and the worker thread posting it. The 
+// weights given to the function by the helm's IvP problem are 
+// undone, as w*scale+shift, by the worker before posting.
+class IPFReportEntry {
+public:
+  IPFReportEntry() {m_iteration=0; m_scale=1; m_shift=0;}
+  IPFReportEntry(IvPFunction *ipf, const std::string& desc,
+		 unsigned int iteration, double scale, double shift) :
+    m_ipf(ipf), m_desc(desc), m_iteration(iteration), 
+    m_scale(scale), m_shift(shift) {}
+
+  Poco::SharedPtr<IvPFunction> m_ipf;
+  std::string   m_desc;
+  unsigned int  m_iteration;
+  double        m_scale;
+  double        m_shift;
+};
+
+// Serializes and posts BHV_IPF on a thread of its own so the cost
+// of string formatting stays off the helm's critical path.
+class IPFReporter {
+public:
+  IPFReporter();
+  ~IPFReporter() {stop();}
+
+  void setBinary(bool v)             {m_binary=v;}
+  void setQuantize(bool v)           {m_quantize=v;}
+  void setMaxQueue(unsigned int v)   {m_max_queue=v;}
+  bool getBinary() const             {return(m_binary);}
+  bool getQuantize() const           {return(m_quantize);}
+
+  bool start(CMOOSCommClient*);
+  void stop();
+
+  bool addFunction(IvPFunction*, const std::string& desc,
+		   unsigned int iteration, double scale=1, double shift=0);
+
+  unsigned int getPosted();
+  unsigned int getDropped();
+  unsigned int getFailed();
+  unsigned int getQueued()           {return(m_queue.Size());}
+
+protected:
+  static bool threadFunc(void *param);
+  bool work();
+  void postFunction(IPFReportEntry&);
+
+protected:
+  CMOOSCommClient*  m_comms;
+  CMOOSThread       m_thread;
+  bool              m_running;
+
+  MOOS::SafeList<IPFReportEntry> m_queue;
+
+  bool              m_binary;
+  bool              m_quantize;
+  unsigned int      m_max_queue;
+
+  CMOOSLock         m_stats_lock;
+  unsigned int      m_posted;
+  unsigned int      m_dropped;
+  unsigned int      m_failed;
+};
+
+#endif 
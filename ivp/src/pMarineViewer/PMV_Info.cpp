@@ -151,6 +151,7 @@ void showExampleConfigAndExit()
   blk("  appcast_color_scheme = default  // {default, indigo, beige}   ");
   blk("  appcast_width        = 40       // {20, 25, 30, ..., 65, 70}  ");
   blk("  appcast_height       = 70       // {30, 35, 40, ..., 85, 90}  ");
+  blk("  appcast_deltas       = false    // {true, FALSE}              ");
   blk("                                                                ");
   blk("  // Context Pull-Down Menu ====================================");
   blk("  left_context[survey-point] = SURVEY_UPDATES = points =        ");
@@ -206,6 +207,7 @@ void showInterfaceAndExit()
   blk("  VIEW_MARKER                                                   ");
   blk("  VIEW_CIRCLE                                                   ");
   blk("  VIEW_GRID                                                     ");
+  blk("  VIEW_GRID_DELTA                                               ");
   blk("  VIEW_RANGE_PULSE                                              ");
   blk("  VIEW_COMMS_PULSE                                              ");
   blk("  NODE_REPORT                                                   ");
@@ -48,6 +48,7 @@ PMV_MOOSApp::PMV_MOOSApp()
   m_appcast_repo             = 0;
   m_appcast_last_req_time    = 0;
   m_appcast_request_interval = 1.0;  // seconds
+  m_appcast_deltas           = false;
   m_clear_geoshapes_received = 0;
 
   m_node_reports_received = 0;
@@ -200,6 +201,7 @@ void PMV_MOOSApp::registerVariables()
   AppCastingMOOSApp::RegisterVariables();
 
   m_Comms.Register("APPCAST", 0);
+  m_Comms.Register("APPCAST_DELTA", 0);
   m_Comms.Register("VIEW_POLYGON", 0);
   m_Comms.Register("PHI_HOST_IP",  0);
   m_Comms.Register("VIEW_POINT",   0);
@@ -212,6 +214,7 @@ void PMV_MOOSApp::registerVariables()
   m_Comms.Register("GRID_CONFIG",  0);
   m_Comms.Register("GRID_DELTA",   0);
   m_Comms.Register("VIEW_GRID", 0);
+  m_Comms.Register("VIEW_GRID_DELTA", 0);
   m_Comms.Register("VIEW_RANGE_PULSE", 0);
   m_Comms.Register("PMV_MENU_CONTEXT", 0);
   m_Comms.Register("PMV_CLEAR", 0);
@@ -356,7 +359,7 @@ void PMV_MOOSApp::handleNewMail(const MOOS_event & e)
     if(!handled)
       handled = m_gui->mviewer->setParam(key, sval);
 
-    if(!handled && (key == "APPCAST")) {
+    if(!handled && ((key == "APPCAST") || (key == "APPCAST_DELTA"))) {
       handled = m_appcast_repo->addAppCast(sval);
       handled_appcast = true;
     }
@@ -580,6 +583,8 @@ void PMV_MOOSApp::handleStartUp(const MOOS_event & e) {
       handled = m_gui->mviewer->setParam(param, value);
     else if(param == "stale_remove_thresh") 
       handled = m_gui->mviewer->setParam(param, value);
+    else if(param == "appcast_deltas") 
+      handled = setBooleanOnString(m_appcast_deltas, value);
 
     else if(param == "log_the_image") 
       handled = setBooleanOnString(m_log_the_image, value);
@@ -776,6 +781,8 @@ void PMV_MOOSApp::postAppCastRequest(string channel_node,
   str += ",duration=" + doubleToString(duration, 1);
   str += ",key=" + key;
   str += ",thresh=" + threshold;
+  if(m_appcast_deltas)
+    str += ",deltas=true";
 
   Notify("APPCAST_REQ", str);
   Notify("APPCAST_REQ_"+toupper(channel_node), str);
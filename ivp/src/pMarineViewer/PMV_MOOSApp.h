@@ -79,6 +79,7 @@ class PMV_MOOSApp : public AppCastingMOOSApp
   AppCastRepo *m_appcast_repo;
   double       m_appcast_last_req_time;
   double       m_appcast_request_interval;
+  bool         m_appcast_deltas;
 
   unsigned int m_node_reports_received;
   unsigned int m_clear_geoshapes_received;
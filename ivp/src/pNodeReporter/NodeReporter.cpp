@@ -79,6 +79,7 @@ NodeReporter::NodeReporter()
   m_record_gt_updated     = 0;
 
   m_node_report_var = "NODE_REPORT_LOCAL";
+  m_node_report_binary = false;
   m_plat_report_var = "PLATFORM_REPORT_LOCAL";
 }
 
@@ -337,6 +338,13 @@ bool NodeReporter::OnStartUp()
 	handled = true;
       }
     }      
+    else if(param == "NODE_REPORT_FORMAT") {
+      string format = tolower(value);
+      if((format == "text") || (format == "binary")) {
+	m_node_report_binary = (format == "binary");
+	handled = true;
+      }
+    }
     else if(param == "PLAT_REPORT_OUTPUT") {
       if(!strContainsWhite(value)) {
 	m_plat_report_var = value;
@@ -431,9 +439,9 @@ bool NodeReporter::Iterate()
       crossFillCoords(m_record, m_nav_xy_updated, m_nav_latlon_updated);
     
     m_record.setIndex(m_reports_posted);
-    string report = assembleNodeReport(m_record);    
+    string report = assembleNodeReport(m_record, m_node_report_binary);
     if(!m_paused) {
-      Notify(m_node_report_var, report);
+      postNodeReport(report);
       m_reports_posted++;
     }
 
@@ -444,9 +452,9 @@ bool NodeReporter::Iterate()
 			m_nav_latlon_updated_gt);
       
       m_record_gt.setIndex(m_reports_posted);
-      string report_gt = assembleNodeReport(m_record_gt);
+      string report_gt = assembleNodeReport(m_record_gt, m_node_report_binary);
       if(!m_paused) {
-	Notify(m_node_report_var, report_gt);
+	postNodeReport(report_gt);
 	m_reports_posted_alt_nav++;
       }
     }
@@ -594,9 +602,10 @@ string NodeReporter::assemblePlatformReport()
 
 //------------------------------------------------------------------
 // Procedure: assembleNodeReport
-//   Purpose: Assemble the node report from member variables.
+//   Purpose: Assemble the node report from member variables, either
+//            as the text spec or, if binary is true, the binary spec.
 
-string NodeReporter::assembleNodeReport(NodeRecord record)
+string NodeReporter::assembleNodeReport(NodeRecord record, bool binary)
 {
   record.setTimeStamp(m_curr_time); 
 
@@ -633,10 +642,29 @@ string NodeReporter::assembleNodeReport(NodeRecord record)
   record.setMode(mode);
   record.setAllStop(m_helm_allstop_mode);
 
+  if(binary)
+    return(record.getBinarySpec());
+
   string summary = record.getSpec();
   return(summary);
 }
 
+//------------------------------------------------------------------
+// Procedure: postNodeReport
+//      Note: Binary reports go out as a MOOS binary string. Readers
+//            of the report need no change since string2NodeRecord()
+//            recognizes and decodes either form. pLogger however puts
+//            binary strings in the .blog file, so the .alog holds only
+//            a placeholder and the alog tools cannot read the reports.
+
+void NodeReporter::postNodeReport(const string& report)
+{
+  if(m_node_report_binary)
+    Notify(m_node_report_var, (void*)(report.c_str()), report.length());
+  else
+    Notify(m_node_report_var, report);
+}
+
 //------------------------------------------------------------------
 // Procedure: setCrossFillPolicy
 //      Note: Determines how or whether the local and global coords
@@ -812,6 +840,10 @@ bool NodeReporter::buildReport()
   m_msgs << "Node Report Summary:"                 << endl;
   m_msgs << "----------------------------"         << endl;
   m_msgs << "Reports Posted: " << m_reports_posted << endl;
+  m_msgs << "Report Format:  " << (m_node_report_binary ? "binary" : "text");
+  if(m_node_report_binary)
+    m_msgs << " (logged to .blog, not readable by alog tools)";
+  m_msgs << endl;
   
   string report = assembleNodeReport(m_record);    
   ACBlock block(" Latest Report: ", report, 50);
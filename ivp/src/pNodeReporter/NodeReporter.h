@@ -46,7 +46,8 @@ public:
 
  protected:
   void handleLocalHelmSummary(const std::string&);
-  std::string assembleNodeReport(NodeRecord);
+  std::string assembleNodeReport(NodeRecord, bool binary=false);
+  void        postNodeReport(const std::string&);
   std::string assemblePlatformReport();
   
   void updatePlatformVar(std::string, std::string);
@@ -61,6 +62,7 @@ public:
   std::string  m_vessel_name;
   std::string  m_crossfill_policy;
   std::string  m_node_report_var;
+  bool         m_node_report_binary;
   double       m_nohelm_thresh;
   std::string  m_group_name;
 
@@ -105,6 +105,12 @@ void showExampleConfigAndExit()
   blk("                                                                ");
   blk("  // Configure the MOOS variable containg the node report       ");
   blu("  node_report_output = NODE_REPORT_LOCAL                        ");
+  blu("  node_report_format = text    "," // or binary                 ");
+  blk("                                                                ");
+  blk("  // Note: pLogger writes binary reports to the .blog file and   ");
+  blk("  // leaves only a <MOOS_BINARY> placeholder in the .alog, so    ");
+  blk("  // alog tools (alogview, aloghelm, etc.) will not see them.    ");
+  blk("  // Keep text format if node reports are to be post-processed.  ");
   blk("                                                                ");
   blk("  // Threshold for conveying an absense of the helm             ");
   blu("  nohelm_threshold   = 5       "," // seconds                   ");
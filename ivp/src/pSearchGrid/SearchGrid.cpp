@@ -31,6 +31,19 @@
 
 using namespace std;
 
+//---------------------------------------------------------
+// Constructor
+
+SearchGrid::SearchGrid()
+{
+  m_post_deltas        = false;
+  m_full_post_interval = 10;
+
+  m_last_full_post = 0;
+  m_full_posts     = 0;
+  m_delta_posts    = 0;
+}
+
 //---------------------------------------------------------
 // Procedure: OnNewMail
 
@@ -107,6 +120,16 @@ bool SearchGrid::OnStartUp()
 	  grid_config += ",";
 	grid_config += value;
       }	
+      else if(param == "POST_DELTAS") {
+	bool handled = setBooleanOnString(m_post_deltas, value);
+	if(!handled)
+	  reportUnhandledConfigWarning(*p);
+      }
+      else if(param == "FULL_POST_INTERVAL") {
+	bool handled = setNonNegDoubleOnString(m_full_post_interval, value);
+	if(!handled)
+	  reportUnhandledConfigWarning(*p);
+      }
     }
   }
 
@@ -156,11 +179,31 @@ void SearchGrid::handleNodeReport(string str)
 
 //------------------------------------------------------------
 // Procedure: postGrid
+//      Note: By default the full grid is posted on each iteration.
+//            If post_deltas is enabled, the full grid is posted only
+//            once every full_post_interval seconds (as a keyframe
+//            for late-joining viewers), and in between only the
+//            cells changed since the previous post are published.
 
 void SearchGrid::postGrid()
 {
+  if(m_post_deltas) {
+    double elapsed = m_curr_time - m_last_full_post;
+    if((m_full_posts > 0) && (elapsed < m_full_post_interval)) {
+      if(m_grid.getDeltaCnt() > 0) {
+	Notify("VIEW_GRID_DELTA", m_grid.get_delta_spec());
+	m_grid.clearDeltas();
+	m_delta_posts++;
+      }
+      return;
+    }
+    m_last_full_post = m_curr_time;
+  }
+
   string spec = m_grid.get_spec();
   Notify("VIEW_GRID", spec);
+  m_grid.clearDeltas();
+  m_full_posts++;
 }
 
 //------------------------------------------------------------
@@ -222,6 +265,10 @@ bool SearchGrid::buildReport()
   }
   m_msgs << actab.getFormattedString();
 
+  m_msgs << endl << endl;
+  m_msgs << "Full Grid Posts: " << m_full_posts  << endl;
+  m_msgs << "    Delta Posts: " << m_delta_posts << endl;
+
   return(true);
 }
 
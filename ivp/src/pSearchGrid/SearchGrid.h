@@ -30,7 +30,7 @@
 class SearchGrid : public AppCastingMOOSApp
 {
  public:
-  SearchGrid() {}
+  SearchGrid();
   virtual ~SearchGrid() {}
 
   bool OnNewMail(MOOSMSG_LIST &NewMail);
@@ -45,8 +45,16 @@ class SearchGrid : public AppCastingMOOSApp
 
   void postGrid();
 
- protected:
+ protected: // Config variables
+  bool   m_post_deltas;
+  double m_full_post_interval;
+
+ protected: // State variables
   XYConvexGrid m_grid;
+
+  double       m_last_full_post;
+  unsigned int m_full_posts;
+  unsigned int m_delta_posts;
 };
 
 #endif 
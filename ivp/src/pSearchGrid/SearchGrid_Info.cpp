@@ -95,6 +95,9 @@ void showExampleConfigAndExit()
   blk("  GRID_CONFIG = cell_max=x:10                                   ");
   blk("  GRID_CONFIG = cell_min=y:0                                    ");
   blk("  GRID_CONFIG = cell_max=y:1000                                 ");
+  blk("                                                                ");
+  blk("  POST_DELTAS        = false  // Default is false                ");
+  blk("  FULL_POST_INTERVAL = 10     // Seconds. Default is 10          ");
   blk("}                                                               ");
   exit(0);
 }
@@ -129,6 +132,12 @@ void showInterfaceAndExit()
   blk("              cell_max=x:50,cell=211:x:50, cell=212:x:50,       ");
   blk("              cell=237:x:50,cell=238:x:50,label=psg             ");
   blk("                                                                ");
+  blk("  VIEW_GRID_DELTA = label=psg,cell=211:x:50:y:0:z:0,            ");
+  blk("                    cell=212:x:49:y:0:z:0                       ");
+  blk("                                                                ");
+  blk("  (VIEW_GRID_DELTA is only posted if POST_DELTAS is true. The   ");
+  blk("   full VIEW_GRID is then posted every FULL_POST_INTERVAL secs) ");
+  blk("                                                                ");
   exit(0);
 }
 
@@ -56,6 +56,10 @@ CollisionDetector::CollisionDetector()
   m_total_collisions = 0;
   m_total_near_misses = 0;
   m_total_cpa_violations = 0;
+
+  m_pairs_total   = 0;
+  m_pairs_checked = 0;
+  m_broad_phase   = true;
 }
 
 //---------------------------------------------------------
@@ -140,143 +144,282 @@ bool CollisionDetector::Iterate()
     m_check_string = "ON";
   }
 
-  // check positions relative to other vehicles
-  for (map<string,NodeRecord>::iterator it1=m_moos_map.begin(); it1!=m_moos_map.end(); ++it1){
+  // Broad phase: only pairs that could plausibly be within the CPA
+  // violation range, plus pairs already interacting, are evaluated.
+  set<pair<unsigned int, unsigned int> > pairs = getCandidatePairs();
+  m_pairs_total = (m_vnames.size() * (m_vnames.size()-1)) / 2;
+  m_pairs_checked = pairs.size();
+
+  set<pair<unsigned int, unsigned int> >::iterator q;
+  for(q=pairs.begin(); q!=pairs.end(); q++) 
+    checkPair(q->first, q->second);
+
+  AppCastingMOOSApp::PostReport();
+  return(true);
+}
+
+//---------------------------------------------------------
+// Procedure: checkPair
+//   Purpose: Evaluate the CPA of the given pair of vehicles, given by
+//            their index into m_vnames, and update or post any 
+//            interaction. The first vehicle is first alphabetically.
+
+void CollisionDetector::checkPair(unsigned int ix1, unsigned int ix2)
+{
+  const string& v1 = m_vnames[ix1];
+  const string& v2 = m_vnames[ix2];
+
+  bool collisionKnown = false;
+  double clear_time = MOOSTime() - 5; // ensures default of clearing screen case below if no prior collision existed.
+  bool posted = false;
+
+  if(! ( m_col_bools.find(make_pair(v1,v2)) == m_col_bools.end() )) {
+    // v1, v2 pair found => this pair has already had at least one interaction.  
+    // Determine if they are in an existing interaction condition. 
+    // If not in existing interaction, then the false from initialization will hold and a new interaction will be processed.
+    collisionKnown = (m_col_bools.find(make_pair(v1,v2))->second).getInteracting();
+    clear_time = (m_col_bools.find(make_pair(v1,v2))->second).getDisplayClearTime();
+    posted =  (m_col_bools.find(make_pair(v1,v2))->second).getPosted();
+  }
+
+  // os is first alphabetically; cn is other vessel
+  const NodeRecord& os = m_moos_map[v1];
+  const NodeRecord& cn = m_moos_map[v2];
+
+  double cnx = cn.getX();
+  double cny = cn.getY();
+  double cnh = cn.getHeading();
+  double cnv = cn.getSpeed();
     
-    //check only vehicles that have not yet been checked
-    for (map<string,NodeRecord>::iterator it2=m_moos_map.find(it1->first);it2!=m_moos_map.end(); ++it2){
-      //vehicle names
-      string v1 = it1->first;
-      string v2 = it2->first;
-      //      string collision_string = "";
-
-      if(v1 != v2){
-	bool collisionKnown = false;
-	double clear_time = MOOSTime() - 5; // ensures default of clearing screen case below if no prior collision existed.
-	bool posted = false;
-
-	if(! ( m_col_bools.find(make_pair(v1,v2)) == m_col_bools.end() )) {
-	  // v1, v2 pair found => this pair has already had at least one interaction.  
-	  // Determine if they are in an existing interaction condition. 
-	  // If not in existing interaction, then the false from initialization will hold and a new interaction will be processed.
-	  collisionKnown = (m_col_bools.find(make_pair(v1,v2))->second).getInteracting();
-	  clear_time = (m_col_bools.find(make_pair(v1,v2))->second).getDisplayClearTime();
-	  posted =  (m_col_bools.find(make_pair(v1,v2))->second).getPosted();
-	}
-	 // variables to be posted to MOOSDB
-	const string name_string = "VEHICLE_INTERACTION_REPORT_" + toupper(v1) + "_" + toupper(v2);
-	const string name_string_immediate = "VEHICLE_INTERACTION_IMMEDIATE_" + toupper(v1) + "_" + toupper(v2);
-
-	// os is first alphabetically; cn is other vessel
-	NodeRecord os = m_moos_map[v1];
-	NodeRecord cn = m_moos_map[v2];
-
-	double cnx = cn.getX();
-	double cny = cn.getY();
-	double cnh = cn.getHeading();
-	double cnv = cn.getSpeed();
-	  
-	double osx = os.getX();
-	double osy = os.getY();
-	double osh = os.getHeading();
-	double osv = os.getSpeed();
-	double ostol = os.getElapsedTime(MOOSTime());
-	  
-	CPAEngine cpaengine = CPAEngine(cny,cnx,cnh,cnv,osy,osx);
-	double distance = cpaengine.evalCPA(osh,osv,ostol);
-	
-	// if within interaction threshold distance AND interaction not already known
-	if((distance < m_preferred_min_cpa_distance) && (!collisionKnown) && (m_check_collisions)){ 
-	  // this is a new interaction
-	  // keep track of current interaction in m_col_bools for appcasting
-	  // a interaction is known to exist between v1 and v2.
-
-	  CollisionRecord cr;
-	  cr.set2Vehicles(v1, v2);
-	  cr.setParameters(m_collision_distance, m_near_miss_distance, m_preferred_min_cpa_distance);
-	  cr.setInteracting(true);// = true;
-	  cr.setMinDistance(distance);
-	  cr.setDetectionDistance(distance);
-	  cr.setDisplayClearTime((MOOSTime()+m_delay_time_to_clear));
-	  cr.setPosted(false);
-	  cr.updateCollisionType();
-	  cr.setInteractionTime(MOOSTime());
-	  storeVehicleModes(cr,v1,v2);
-	  
-	  if((m_pulse_bool)){
-	    MakeCPAViolationRangePulse((it1->second).getX(),(it1->second).getY());
-	    MakeCPAViolationRangePulse((it2->second).getX(),(it2->second).getY());
-	    cr.cpaRangeRingFired();
-	  }
-
-	  
-	  m_col_bools[make_pair(v1,v2)] = cr;
-	  string info_string = cr.getString();
-	  reportEvent(info_string);
-	  
-	  if(m_post_immediately){
-	      Notify(name_string_immediate,info_string);
-	  }
-	}
-	else if((distance < m_preferred_min_cpa_distance) && (collisionKnown) ){ 
-	  // interaction remains; update the minimum distance and time until appcast is cleared.
-	  // interaction is assumed if any distance is less than preferred cpa distance
-
-	  CollisionRecord& rec =  (m_col_bools[make_pair(v1,v2)]);
-	  rec.setMinDistance(distance);
-	  rec.setDisplayClearTime(MOOSTime() + m_delay_time_to_clear);
-	  storeVehicleModes(rec,v1,v2);
-
-	  string info_string = (rec).getString();
-	  
-	  if((distance < m_collision_distance)){
-	    if(m_post_immediately && ! (rec).getCollisionPosted()){
-	      Notify(name_string_immediate,info_string);
-	      (rec).collisionPosted();
-	    }
-	    if( (m_pulse_bool) &&  (!(rec).getCollisionRangeRingFired())){
-	      MakeCollisionRangePulse((it1->second).getX(),(it1->second).getY());
-	      MakeCollisionRangePulse((it2->second).getX(),(it2->second).getY());
-	      (rec).collisionRangeRingFired();
-	    }
-	  }
-	  else if(distance < m_near_miss_distance){
-	    if(m_post_immediately && !(rec).getNearMissPosted()){
-	      Notify(name_string_immediate,info_string);
-	      (rec).nearMissPosted();
-	    }
-	    if( (m_pulse_bool) && (!(rec).getNearMissRangeRingFired())){
-	      MakeNearMissRangePulse((it1->second).getX(),(it1->second).getY());
-	      MakeNearMissRangePulse((it2->second).getX(),(it2->second).getY());
-	      (rec).nearMissRangeRingFired();
-	    }
-	  }
-	}
-	else if((collisionKnown) && (clear_time >= MOOSTime())){
-	  // interaction no longer exists, but still desire the appcast display to occur
-	  
-	  if((!posted)){
-	    postAndUpdate(v1, v2, name_string);
-	  }
-	  
-	}
-	else if((collisionKnown) && (clear_time < MOOSTime())){
-	  // no interaction exists between these two vehicles and no longer desire appcast display.
-	  if( (!posted)){
-	    postAndUpdate(v1, v2, name_string);
-	  }
-	  (m_col_bools[make_pair(v1,v2)]).clearInteraction();
-	}
-	else{
-	  // no interaction exists and message has already been posted; do not re-post.  Case reserved for future use.
+  double osx = os.getX();
+  double osy = os.getY();
+  double osh = os.getHeading();
+  double osv = os.getSpeed();
+  double ostol = os.getElapsedTime(MOOSTime());
+
+  // Narrow phase: the CPA distance can be no less than the current
+  // range minus the distance closed at the sum of the speeds over the
+  // time-on-leg. Skip the CPA calc if the pair cannot interact.
+  if(!collisionKnown && m_broad_phase) {
+    double range = hypot(osx-cnx, osy-cny);
+    double reach = (fabs(osv) + fabs(cnv)) * fabs(ostol);
+    if(range >= (m_preferred_min_cpa_distance + reach))
+      return;
+  }
+
+  // variables to be posted to MOOSDB
+  const string& name_string = m_pair_names[make_pair(ix1,ix2)].first;
+  const string& name_string_immediate = m_pair_names[make_pair(ix1,ix2)].second;
+
+  CPAEngine cpaengine = CPAEngine(cny,cnx,cnh,cnv,osy,osx);
+  double distance = cpaengine.evalCPA(osh,osv,ostol);
+  
+  // if within interaction threshold distance AND interaction not already known
+  if((distance < m_preferred_min_cpa_distance) && (!collisionKnown) && (m_check_collisions)){ 
+    // this is a new interaction
+    // keep track of current interaction in m_col_bools for appcasting
+    // a interaction is known to exist between v1 and v2.
+
+    CollisionRecord cr;
+    cr.set2Vehicles(v1, v2);
+    cr.setParameters(m_collision_distance, m_near_miss_distance, m_preferred_min_cpa_distance);
+    cr.setInteracting(true);// = true;
+    cr.setMinDistance(distance);
+    cr.setDetectionDistance(distance);
+    cr.setDisplayClearTime((MOOSTime()+m_delay_time_to_clear));
+    cr.setPosted(false);
+    cr.updateCollisionType();
+    cr.setInteractionTime(MOOSTime());
+    storeVehicleModes(cr,v1,v2);
+    
+    if((m_pulse_bool)){
+      MakeCPAViolationRangePulse(os.getX(),os.getY());
+      MakeCPAViolationRangePulse(cn.getX(),cn.getY());
+      cr.cpaRangeRingFired();
+    }
+
+    
+    m_col_bools[make_pair(v1,v2)] = cr;
+    string info_string = cr.getString();
+    reportEvent(info_string);
+    
+    if(m_post_immediately){
+	Notify(name_string_immediate,info_string);
+    }
+  }
+  else if((distance < m_preferred_min_cpa_distance) && (collisionKnown) ){ 
+    // interaction remains; update the minimum distance and time until appcast is cleared.
+    // interaction is assumed if any distance is less than preferred cpa distance
+
+    CollisionRecord& rec =  (m_col_bools[make_pair(v1,v2)]);
+    rec.setMinDistance(distance);
+    rec.setDisplayClearTime(MOOSTime() + m_delay_time_to_clear);
+    storeVehicleModes(rec,v1,v2);
+
+    string info_string = (rec).getString();
+    
+    if((distance < m_collision_distance)){
+      if(m_post_immediately && ! (rec).getCollisionPosted()){
+	Notify(name_string_immediate,info_string);
+	(rec).collisionPosted();
+      }
+      if( (m_pulse_bool) &&  (!(rec).getCollisionRangeRingFired())){
+	MakeCollisionRangePulse(os.getX(),os.getY());
+	MakeCollisionRangePulse(cn.getX(),cn.getY());
+	(rec).collisionRangeRingFired();
+      }
+    }
+    else if(distance < m_near_miss_distance){
+      if(m_post_immediately && !(rec).getNearMissPosted()){
+	Notify(name_string_immediate,info_string);
+	(rec).nearMissPosted();
+      }
+      if( (m_pulse_bool) && (!(rec).getNearMissRangeRingFired())){
+	MakeNearMissRangePulse(os.getX(),os.getY());
+	MakeNearMissRangePulse(cn.getX(),cn.getY());
+	(rec).nearMissRangeRingFired();
+      }
+    }
+  }
+  else if((collisionKnown) && (clear_time >= MOOSTime())){
+    // interaction no longer exists, but still desire the appcast display to occur
+    
+    if((!posted)){
+      postAndUpdate(v1, v2, name_string);
+    }
+    
+  }
+  else if((collisionKnown) && (clear_time < MOOSTime())){
+    // no interaction exists between these two vehicles and no longer desire appcast display.
+    if( (!posted)){
+      postAndUpdate(v1, v2, name_string);
+    }
+    (m_col_bools[make_pair(v1,v2)]).clearInteraction();
+  }
+  else{
+    // no interaction exists and message has already been posted; do not re-post.  Case reserved for future use.
+  }
+}
+
+//---------------------------------------------------------
+// Procedure: getCandidatePairs
+//   Purpose: Hash all vehicles into square cells sized to the CPA 
+//            violation range plus the farthest two vehicles could 
+//            close at max speed over the longest time-on-leg. Only
+//            vehicles in the same or adjacent cells can interact.
+//            Pairs with an existing interaction are always included
+//            so that they may be cleared.
+//   Returns: Pairs of indices into m_vnames, first index smaller.
+
+set<pair<unsigned int, unsigned int> > CollisionDetector::getCandidatePairs()
+{
+  set<pair<unsigned int, unsigned int> > pairs;
+
+  // Refresh the vehicle index if new vehicles have been seen
+  if(m_vnames.size() != m_moos_map.size()) {
+    m_vnames.clear();
+    m_vindex.clear();
+    m_pair_names.clear();
+    map<string,NodeRecord>::iterator p;
+    for(p=m_moos_map.begin(); p!=m_moos_map.end(); p++) {
+      m_vindex[p->first] = m_vnames.size();
+      m_vnames.push_back(p->first);
+    }
+  }
+
+  unsigned int i, vsize = m_vnames.size();
+  if(vsize < 2)
+    return(pairs);
+
+  // With the broad phase off, every pair is a candidate
+  if(!m_broad_phase) {
+    for(i=0; i<vsize; i++)
+      for(unsigned int k=i+1; k<vsize; k++)
+	pairs.insert(make_pair(i, k));
+    nameCandidatePairs(pairs);
+    return(pairs);
+  }
+
+  double curr_time = MOOSTime();
+  double max_speed = 0;
+  double max_tol   = 0;
+  vector<const NodeRecord*> records;
+  for(i=0; i<vsize; i++) {
+    const NodeRecord& record = m_moos_map[m_vnames[i]];
+    records.push_back(&record);
+    double speed = fabs(record.getSpeed());
+    double tol   = fabs(record.getElapsedTime(curr_time));
+    if(speed > max_speed)
+      max_speed = speed;
+    if(tol > max_tol)
+      max_tol = tol;
+  }
+
+  double cell_size = m_preferred_min_cpa_distance + (2 * max_speed * max_tol);
+  if(cell_size <= 0)
+    cell_size = 1;
+
+  map<pair<int,int>, vector<unsigned int> > cells;
+  vector<pair<int,int> > vcells;
+  for(i=0; i<vsize; i++) {
+    int cx = (int)(floor(records[i]->getX() / cell_size));
+    int cy = (int)(floor(records[i]->getY() / cell_size));
+    vcells.push_back(make_pair(cx, cy));
+    cells[make_pair(cx, cy)].push_back(i);
+  }
+
+  for(i=0; i<vsize; i++) {
+    for(int dx=-1; dx<=1; dx++) {
+      for(int dy=-1; dy<=1; dy++) {
+	pair<int,int> cell(vcells[i].first+dx, vcells[i].second+dy);
+	map<pair<int,int>, vector<unsigned int> >::iterator c;
+	c = cells.find(cell);
+	if(c == cells.end())
+	  continue;
+	unsigned int j, csize = c->second.size();
+	for(j=0; j<csize; j++) {
+	  unsigned int k = c->second[j];
+	  if(k > i)
+	    pairs.insert(make_pair(i, k));
 	}
       }
     }
-  } 
-  AppCastingMOOSApp::PostReport();
-  return(true);
+  }
+
+  // Pairs currently interacting are always checked
+  map<pair<string,string>,CollisionRecord>::iterator r;
+  for(r=m_col_bools.begin(); r!=m_col_bools.end(); r++) {
+    if(!r->second.getInteracting())
+      continue;
+    map<string,unsigned int>::iterator i1 = m_vindex.find(r->first.first);
+    map<string,unsigned int>::iterator i2 = m_vindex.find(r->first.second);
+    if((i1 != m_vindex.end()) && (i2 != m_vindex.end()))
+      pairs.insert(make_pair(i1->second, i2->second));
+  }
+
+  nameCandidatePairs(pairs);
+  return(pairs);
 }
 
+//---------------------------------------------------------
+// Procedure: nameCandidatePairs
+//   Purpose: Build the posting variable names once per pair.
+
+void CollisionDetector::nameCandidatePairs(const set<pair<unsigned int, unsigned int> >& pairs)
+{
+  set<pair<unsigned int, unsigned int> >::const_iterator q;
+  for(q=pairs.begin(); q!=pairs.end(); q++) {
+    if(m_pair_names.count(*q))
+      continue;
+    string suffix = toupper(m_vnames[q->first]) + "_" + toupper(m_vnames[q->second]);
+    m_pair_names[*q] = make_pair("VEHICLE_INTERACTION_REPORT_" + suffix,
+				 "VEHICLE_INTERACTION_IMMEDIATE_" + suffix);
+  }
+}
+
+//---------------------------------------------------------
+// Procedure: postAndUpdate
+
 void CollisionDetector::postAndUpdate(string v1, string v2, string name_string){
   string info_string = (m_col_bools.find(make_pair(v1,v2))->second).getString();
   Notify(name_string,info_string);
@@ -383,6 +526,11 @@ bool CollisionDetector::OnStartUp()
       handled = true;
       m_deploy_delay = atof(value.c_str());
     }
+    else if(param == "BROAD_PHASE") {
+      // option to check every vehicle pair, e.g. to benchmark the
+      // pair culling against the exhaustive check.
+      handled = setBooleanOnString(m_broad_phase, value);
+    }
     if(!handled)
       reportUnhandledConfigWarning(orig);
 
@@ -437,6 +585,8 @@ bool CollisionDetector::buildReport()
   m_msgs << "                Total Collisions:   " << doubleToString(m_total_collisions,0) << "" << endl;
   m_msgs << "               Total Near-Misses:   " << doubleToString(m_total_near_misses,0) << "" << endl;
   m_msgs << "            Total CPA Violations:   " << doubleToString(m_total_cpa_violations,0) << "\n" << endl;
+  m_msgs << "  Vehicle Pairs Checked (last it):   " << m_pairs_checked << " of " << m_pairs_total;
+  m_msgs << (m_broad_phase ? "" : " (broad phase off)") << "\n" << endl;
   
   // determine list of vehicles with known interactions for appcasting report:
 
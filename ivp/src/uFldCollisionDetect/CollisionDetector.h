@@ -29,6 +29,7 @@
 #include <iterator>
 #include <math.h>
 #include <map>
+#include <set>
 #include "MBUtils.h"
 #include "ACTable.h"
 #include "NodeRecordUtils.h"
@@ -56,6 +57,10 @@ class CollisionDetector : public AppCastingMOOSApp
 
  protected:
    void registerVariables();
+   void checkPair(unsigned int, unsigned int);
+   std::set<std::pair<unsigned int, unsigned int> > getCandidatePairs();
+   void nameCandidatePairs(const std::set<std::pair<unsigned int, unsigned int> >&);
+
    std::map <std::string,NodeRecord> m_moos_map;  // holds the most recent NodeReport of a given vehicle
    std::map <std::pair<std::string,std::string>,CollisionRecord> m_col_bools; // holds the CollisionRecord associated with a given vehicle pair
    std::map <pair<std::string,std::string>,std::pair<std::string,std::string> > m_colregs_mode_map; //<v_os,v_cn>,<mode,submode>
@@ -94,6 +99,17 @@ class CollisionDetector : public AppCastingMOOSApp
    int m_total_near_misses;
    int m_total_cpa_violations;
    bool m_start_running_by_clock;
+
+   // Vehicle names in alphabetical order, index into m_vnames, and
+   // per index-pair posting names (report, immediate).
+   std::vector<std::string>         m_vnames;
+   std::map<std::string,unsigned int> m_vindex;
+   std::map<std::pair<unsigned int,unsigned int>,
+     std::pair<std::string,std::string> > m_pair_names;
+
+   unsigned int m_pairs_total;
+   unsigned int m_pairs_checked;
+   bool         m_broad_phase;
 };
 
 #endif 
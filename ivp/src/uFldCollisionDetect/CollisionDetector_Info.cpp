@@ -119,6 +119,10 @@ void showExampleConfigAndExit()
   blk("  pulse_range = 50    // meters                                 ");  
   blk("  pulse_duration = 15 //seconds                                 ");  
   blk("                                                                ");  
+  blk("  // Cull vehicle pairs on a spatial grid before the CPA check.  ");
+  blk("  // Set false to check every pair (e.g. for benchmarking).      ");
+  blk("  broad_phase = true                                            ");
+  blk("                                                                ");  
   blk("");
 
 exit(0);
@@ -22,6 +22,7 @@
 /*****************************************************************/
 
 #include <iterator>
+#include <algorithm>
 #include <cmath>
 #include "HazardSensor_MOOSApp.h"
 #include "XYFormatUtilsHazard.h"
@@ -65,6 +66,14 @@ HazardSensor_MOOSApp::HazardSensor_MOOSApp()
   m_rn_uniform_pct = 0;
 
   m_seed_random  = true;
+
+  // Spatial index over hazards, built after configuration
+  m_bin_size    = 0;
+  m_bin_xmin    = 0;
+  m_bin_ymin    = 0;
+  m_bin_cols    = 0;
+  m_bin_rows    = 0;
+  m_index_valid = false;
   
   // Visual preferences
   m_circle_duration = -1;
@@ -286,6 +295,7 @@ bool HazardSensor_MOOSApp::OnStartUp()
   postVisuals();
   perhapsSeedRandom();
   sortSensorProperties();
+  buildHazardIndex();
 
   if(m_map_hazards.size() == 0)
     reportConfigWarning("No Hazard Field Laydown Provided.");
@@ -334,6 +344,7 @@ bool HazardSensor_MOOSApp::addHazard(string line)
   }
 
   m_map_hazards[label] = hazard;
+  m_index_valid = false;
 
   // Keep a running count of object type for later in appcast report
   if(hazard.getType() == "hazard")
@@ -554,37 +565,52 @@ bool HazardSensor_MOOSApp::processSensorRequest(string vname)
   if(!sensor_on)
     return(true);
 
-  // Part 6: For each hazard, determine if the hazard is newly within
-  // the sensor swath of the requesting vehicle.
-  map<string, XYHazard>::iterator p;
-  for(p=m_map_hazards.begin(); p!=m_map_hazards.end(); p++) {
-    string hlabel = p->first;
-    XYHazard hazard = p->second;
-    bool is_hazard = (hazard.getType() == "hazard");
-
-    bool dice_roll_needed = updateVehicleHazardStatus(vix, hlabel);
-    if(dice_roll_needed) {
-      if(is_hazard)
-	m_map_haz_detect_chances[vname]++;
+  // Part 6: Determine the hazards now within the sensor swath of the
+  // requesting vehicle. Only hazards binned near the swath are checked.
+  if(m_map_swath_width.count(vname) == 0) {
+    reportRunWarning("No sensor setting for: " + vname);
+    return(true);
+  }
+  if(!m_index_valid)
+    buildHazardIndex();
+  vector<unsigned int> inside;
+  getHazardsInPolygon(m_node_polygons[vix], inside);
+
+  // Part 7: For each hazard newly within the swath, roll the dice for
+  // detection. Both index lists are ascending, so hazards are visited
+  // in label order as are the random draws.
+  vector<unsigned int>& prev_inside = m_map_hv_inside[vname];
+  unsigned int i, k=0, ksize = prev_inside.size();
+  for(i=0; i<inside.size(); i++) {
+    unsigned int hix = inside[i];
+    while((k < ksize) && (prev_inside[k] < hix))
+      k++;
+    if((k < ksize) && (prev_inside[k] == hix))
+      continue;
+
+    const string& hlabel = m_hazard_labels[hix];
+    bool is_hazard = (m_map_hazards[hlabel].getType() == "hazard");
+    if(is_hazard)
+      m_map_haz_detect_chances[vname]++;
+    else
+      m_map_ben_detect_chances[vname]++;
+    
+    int    rand_int  = rand() % 10000;
+    double dice_roll = (double)(rand_int) / 10000;
+
+    bool detect_result_normal = rollDetectionDiceNormal(vix, hlabel, dice_roll);
+    bool detect_result_aspect = rollDetectionDiceAspect(vix, hlabel, dice_roll);
+    if(detect_result_normal) {
+      if(is_hazard) 
+	m_map_haz_detect_reports[vname]++;
       else
-	m_map_ben_detect_chances[vname]++;
-      
-      int    rand_int  = rand() % 10000;
-      double dice_roll = (double)(rand_int) / 10000;
-
-      bool detect_result_normal = rollDetectionDiceNormal(vix, hlabel, dice_roll);
-      bool detect_result_aspect = rollDetectionDiceAspect(vix, hlabel, dice_roll);
-      if(detect_result_normal) {
-	if(is_hazard) 
-	  m_map_haz_detect_reports[vname]++;
-	else
-	  m_map_ben_detect_reports[vname]++;
-	postHazardDetectionReport(hlabel, vix); 
-      }
-      else if(detect_result_aspect) 
-	postHazardDetectionAspect(hlabel);
+	m_map_ben_detect_reports[vname]++;
+      postHazardDetectionReport(hlabel, vix); 
     }
+    else if(detect_result_aspect) 
+      postHazardDetectionAspect(hlabel);
   }
+  prev_inside = inside;
 
   return(true);
 }
@@ -883,10 +909,10 @@ void HazardSensor_MOOSApp::postVisuals()
   if(m_show_hazards == false)
     return;
 
-  map<string, XYHazard>::iterator p;
+  map<string, XYHazard>::const_iterator p;
   for(p=m_map_hazards.begin(); p!=m_map_hazards.end(); p++) {
     
-    XYHazard hazard = p->second;
+    const XYHazard& hazard = p->second;
 
     string color = m_color_hazard;
     string shape = m_shape_hazard;
@@ -953,41 +979,115 @@ void HazardSensor_MOOSApp::postVisuals()
 }
 
 //------------------------------------------------------------
-// Procedure: updateVehicleHazardStatus
-
-bool HazardSensor_MOOSApp::updateVehicleHazardStatus(unsigned int vix, 
-						     string hazard_label)
+// Procedure: buildHazardIndex
+//   Purpose: Number the hazards in label order and bin them into a
+//            uniform grid. The cell size is about the extent of the
+//            widest sensor swath, so a swath overlaps few cells. The
+//            cell size is grown if needed to keep the grid no larger
+//            than a few cells per hazard.
+
+void HazardSensor_MOOSApp::buildHazardIndex()
 {
-  // Part 1: Sanity checking
-  if((m_map_hazards.count(hazard_label)==0) || (vix >= m_node_records.size()))
-    return(false);
+  m_hazard_labels.clear();
+  m_hazard_x.clear();
+  m_hazard_y.clear();
+  m_bins.clear();
+  m_map_hv_inside.clear();
+
+  double xmin=0, xmax=0, ymin=0, ymax=0;
+  map<string, XYHazard>::const_iterator p;
+  for(p=m_map_hazards.begin(); p!=m_map_hazards.end(); p++) {
+    double hx = p->second.getX();
+    double hy = p->second.getY();
+    if(m_hazard_labels.size() == 0) {
+      xmin = xmax = hx;
+      ymin = ymax = hy;
+    }
+    xmin = (hx < xmin) ? hx : xmin;
+    xmax = (hx > xmax) ? hx : xmax;
+    ymin = (hy < ymin) ? hy : ymin;
+    ymax = (hy > ymax) ? hy : ymax;
+    m_hazard_labels.push_back(p->first);
+    m_hazard_x.push_back(hx);
+    m_hazard_y.push_back(hy);
+  }
   
-  string vname = m_node_records[vix].getName();
-
-  if(m_map_swath_width.count(vname) == 0) {
-    reportRunWarning("No sensor setting for: " + vname);
-    return(false);
+  double max_wid = m_swath_len;
+  unsigned int i, hsize = m_hazard_labels.size();
+  for(i=0; i<m_sensor_prop_width.size(); i++) {
+    if(m_sensor_prop_width[i] > max_wid)
+      max_wid = m_sensor_prop_width[i];
+  }
+  m_bin_size = 2 * max_wid;
+  if(m_bin_size <= 0)
+    m_bin_size = 50;
+
+  unsigned int max_cells = 4 * hsize;
+  if(max_cells < 1024)
+    max_cells = 1024;
+  while(true) {
+    m_bin_cols = (unsigned int)((xmax - xmin) / m_bin_size) + 1;
+    m_bin_rows = (unsigned int)((ymax - ymin) / m_bin_size) + 1;
+    if(((double)(m_bin_cols) * m_bin_rows) <= max_cells)
+      break;
+    m_bin_size *= 2;
+  }
+  m_bin_xmin = xmin;
+  m_bin_ymin = ymin;
+
+  // Hazards are added in index order, so each bin is ascending
+  m_bins.resize(m_bin_cols * m_bin_rows);
+  for(i=0; i<hsize; i++) {
+    unsigned int col = (unsigned int)((m_hazard_x[i] - xmin) / m_bin_size);
+    unsigned int row = (unsigned int)((m_hazard_y[i] - ymin) / m_bin_size);
+    m_bins[(row * m_bin_cols) + col].push_back(i);
   }
 
-  // Part 2: Determine the hazard status (whether or not the hazard is in the
-  //         sensor swath of the vehicle given by vix.
-  XYHazard hazard = m_map_hazards[hazard_label];
-
-  string tag    = vname + "_" + hazard_label;
-  double haz_x  = hazard.getX();
-  double haz_y  = hazard.getY();
-  bool   new_contained_status = m_node_polygons[vix].contains(haz_x, haz_y);
-
-  // Part 3: Update the new status and determine if the hazard has just now
-  // entered the swath
-  bool previous_contained_status = m_map_hv_status[tag];
+  m_index_valid = true;
+}
 
-  m_map_hv_status[tag] = new_contained_status;
+//------------------------------------------------------------
+// Procedure: getHazardsInPolygon
+//   Purpose: Fill hazards with the ascending indices of all hazards
+//            contained in the given polygon. Only the hazards in the
+//            grid cells overlapping the polygon bounding box are
+//            checked.
+
+void HazardSensor_MOOSApp::getHazardsInPolygon(const XYPolygon& poly,
+					       vector<unsigned int>& hazards) const
+{
+  hazards.clear();
+  if(!m_index_valid || (m_bins.size() == 0) || (poly.size() == 0))
+    return;
 
-  if((new_contained_status == true) && (previous_contained_status == false))
-    return(true);
+  double cx_lo = (poly.get_min_x() - m_bin_xmin) / m_bin_size;
+  double cx_hi = (poly.get_max_x() - m_bin_xmin) / m_bin_size;
+  double cy_lo = (poly.get_min_y() - m_bin_ymin) / m_bin_size;
+  double cy_hi = (poly.get_max_y() - m_bin_ymin) / m_bin_size;
+  if((cx_hi < 0) || (cy_hi < 0) || (cx_lo >= m_bin_cols) || (cy_lo >= m_bin_rows))
+    return;
 
-  return(false);
+  unsigned int col_lo = (cx_lo < 0) ? 0 : (unsigned int)(cx_lo);
+  unsigned int row_lo = (cy_lo < 0) ? 0 : (unsigned int)(cy_lo);
+  unsigned int col_hi = (unsigned int)(cx_hi);
+  unsigned int row_hi = (unsigned int)(cy_hi);
+  if(col_hi >= m_bin_cols)
+    col_hi = m_bin_cols - 1;
+  if(row_hi >= m_bin_rows)
+    row_hi = m_bin_rows - 1;
+
+  unsigned int row, col, i;
+  for(row=row_lo; row<=row_hi; row++) {
+    for(col=col_lo; col<=col_hi; col++) {
+      const vector<unsigned int>& bin = m_bins[(row * m_bin_cols) + col];
+      for(i=0; i<bin.size(); i++) {
+	unsigned int hix = bin[i];
+	if(poly.contains(m_hazard_x[hix], m_hazard_y[hix]))
+	  hazards.push_back(hix);
+      }
+    }
+  }
+  sort(hazards.begin(), hazards.end());
 }
 
 //------------------------------------------------------------
@@ -54,6 +54,7 @@ class HazardSensor_MOOSApp : public AppCastingMOOSApp
   void perhapsSeedRandom();
   void sortSensorProperties();
   void postVisuals();
+  void buildHazardIndex();
 
  protected: // Configuration utility
   bool    addHazard(std::string);
@@ -76,7 +77,8 @@ class HazardSensor_MOOSApp : public AppCastingMOOSApp
   void    postHazardDetectionAspect(std::string hlabel);
 
  protected: // Utilities
-  bool    updateVehicleHazardStatus(unsigned int vix, std::string);
+  void    getHazardsInPolygon(const XYPolygon&, 
+			      std::vector<unsigned int>&) const;
   bool    rollDetectionDiceNormal(unsigned int vix, std::string, double);
   bool    rollDetectionDiceAspect(unsigned int vix, std::string, double);
 
@@ -107,9 +109,23 @@ class HazardSensor_MOOSApp : public AppCastingMOOSApp
   unsigned int m_hazard_file_hazard_cnt;
   unsigned int m_hazard_file_benign_cnt;
   
-  // Map from tag=<vehiname_hazardindex> to Boolean 
-  // True if hazard is currently within the sensor scope of the vehicle.
-  std::map<std::string, bool>  m_map_hv_status;
+  // Map from vehicle name to the hazards currently within the sensor
+  // swath of the vehicle, as ascending indices into m_hazard_labels.
+  std::map<std::string, std::vector<unsigned int> > m_map_hv_inside;
+
+  // Spatial index over the hazards. Hazards are numbered in label
+  // order and binned in a uniform grid of square cells, so a swath
+  // query need only check the hazards in the cells it overlaps.
+  std::vector<std::string>  m_hazard_labels;
+  std::vector<double>       m_hazard_x;
+  std::vector<double>       m_hazard_y;
+  std::vector<std::vector<unsigned int> > m_bins;
+  double       m_bin_size;
+  double       m_bin_xmin;
+  double       m_bin_ymin;
+  unsigned int m_bin_cols;
+  unsigned int m_bin_rows;
+  bool         m_index_valid;
 
   // Vector of vehicles. Index between vectors match to same vehicle.
   std::vector<NodeRecord>      m_node_records;
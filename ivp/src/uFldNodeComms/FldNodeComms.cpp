@@ -23,6 +23,7 @@
 
 #include <cmath>
 #include <set>
+#include <algorithm>
 #include <iterator>
 #include "FldNodeComms.h"
 #include "MBUtils.h"
@@ -74,6 +75,8 @@ FldNodeComms::FldNodeComms()
   m_blk_msg_tooquick  = 0;
   m_blk_msg_toolong   = 0;
   m_blk_msg_toofar    = 0;
+
+  m_grid_size = 0;
 }
 
 //---------------------------------------------------------
@@ -130,12 +133,13 @@ bool FldNodeComms::Iterate()
 {
   AppCastingMOOSApp::Iterate();
 
-  map<string, bool>::iterator p;
-  for(p=m_map_newrecord.begin(); p!=m_map_newrecord.end(); p++) {
-    string uname   = p->first;    
-    bool   newinfo = p->second;
-    if(newinfo)
-      distributeNodeReportInfo(uname);
+  buildVehicleTable();
+
+  unsigned int i, vsize = m_vnames.size();
+  for(i=0; i<vsize; i++) {
+    map<string, bool>::iterator p = m_map_newrecord.find(m_vnames[i]);
+    if((p != m_map_newrecord.end()) && p->second)
+      distributeNodeReportInfo(i);
   }
 
   map<string, bool>::iterator p2;
@@ -257,6 +261,7 @@ bool FldNodeComms::handleMailNodeReport(const string& str, string& whynot)
 
   m_map_record[upp_name] = new_record;
   m_map_newrecord[upp_name] = true;
+  m_map_binrecord[upp_name] = isBinaryNodeReport(str);
   m_map_time_nreport[upp_name] = m_curr_time;
   m_map_vgroup[upp_name]  = grp_name;
 
@@ -379,31 +384,140 @@ bool FldNodeComms::handleEarange(const string& str)
 }
 
 
+//------------------------------------------------------------
+// Procedure: buildVehicleTable
+//   Purpose: Flatten the per-vehicle state held in the various maps
+//            into dense arrays, and bin vehicles into a spatial grid
+//            so that report distribution need only consider vehicles
+//            that could possibly be in range.
+
+void FldNodeComms::buildVehicleTable()
+{
+  m_vnames.clear();
+  m_vreport_vars.clear();
+  m_vvalid.clear();
+  m_vx.clear();
+  m_vy.clear();
+  m_vtime_nreport.clear();
+  m_vstealth.clear();
+  m_vearange.clear();
+  m_vgroup.clear();
+  m_grid.clear();
+
+  double max_earange = 1.0;
+
+  map<string, NodeRecord>::iterator p;
+  for(p=m_map_record.begin(); p!=m_map_record.end(); p++) {
+    string vname = p->first;
+    m_vnames.push_back(vname);
+    m_vreport_vars.push_back("NODE_REPORT_" + vname);
+    m_vvalid.push_back(p->second.valid());
+    m_vx.push_back(p->second.getX());
+    m_vy.push_back(p->second.getY());
+    m_vtime_nreport.push_back(m_map_time_nreport[vname]);
+    m_vgroup.push_back(m_map_vgroup[vname]);
+
+    double stealth = 1.0;
+    map<string, double>::iterator q = m_map_stealth.find(vname);
+    if(q != m_map_stealth.end())
+      stealth = q->second;
+    m_vstealth.push_back(stealth);
+
+    double earange = 1.0;
+    q = m_map_earange.find(vname);
+    if(q != m_map_earange.end())
+      earange = q->second;
+    m_vearange.push_back(earange);
+    if(earange > max_earange)
+      max_earange = earange;
+  }
+
+  // Stealth is at most 1.0, so the farthest any report may travel is
+  // the comms range at max earange, or the critical range.
+  m_grid_size = m_comms_range * max_earange;
+  if(m_critical_range > m_grid_size)
+    m_grid_size = m_critical_range;
+  if(m_grid_size <= 0) {
+    m_grid_size = 0;
+    return;
+  }
+
+  unsigned int i, vsize = m_vnames.size();
+  for(i=0; i<vsize; i++) {
+    int cx = (int)(floor(m_vx[i] / m_grid_size));
+    int cy = (int)(floor(m_vy[i] / m_grid_size));
+    m_grid[make_pair(cx, cy)].push_back(i);
+  }
+}
+
+//------------------------------------------------------------
+// Procedure: getNearbyVehicles
+//   Purpose: Fill the given vector with the indices, in ascending 
+//            order, of all vehicles in the same or adjacent grid 
+//            cells as vehicle ix. If there is no grid, all vehicles.
+
+void FldNodeComms::getNearbyVehicles(unsigned int ix, 
+				     vector<unsigned int>& nearby)
+{
+  nearby.clear();
+  unsigned int i, vsize = m_vnames.size();
+  if(m_grid_size <= 0) {
+    for(i=0; i<vsize; i++)
+      nearby.push_back(i);
+    return;
+  }
+
+  int cx = (int)(floor(m_vx[ix] / m_grid_size));
+  int cy = (int)(floor(m_vy[ix] / m_grid_size));
+  for(int dx=-1; dx<=1; dx++) {
+    for(int dy=-1; dy<=1; dy++) {
+      map<pair<int,int>, vector<unsigned int> >::iterator p;
+      p = m_grid.find(make_pair(cx+dx, cy+dy));
+      if(p != m_grid.end())
+	nearby.insert(nearby.end(), p->second.begin(), p->second.end());
+    }
+  }
+  sort(nearby.begin(), nearby.end());
+}
+
 //------------------------------------------------------------
 // Procedure: distributeNodeReportInfo
-//   Purpose: Post the node report for vehicle <uname> to all 
+//   Purpose: Post the node report for vehicle <uix> to all 
 //            other vehicles as NODE_REPORT_VNAME where <uname>
 //            is not equal to VNAME (no need to report to self).
 //     Notes: Inter-vehicle node reports must pass certain criteria
 //            based on inter-vehicle range, group, and the respective
 //            stealth and earange of the senting and receiving nodes.
+//     Notes: Only vehicles in nearby grid cells are considered. Any
+//            vehicle outside is beyond both the comms range and the
+//            critical range and would not pass the criteria below.
 
-void FldNodeComms::distributeNodeReportInfo(const string& uname)
+void FldNodeComms::distributeNodeReportInfo(unsigned int uix)
 {
   // First check if the latest record for the given vehicle is valid.
-  NodeRecord record = m_map_record[uname];
-  if(!record.valid())
+  if(!m_vvalid[uix])
     return;
+  const string& uname = m_vnames[uix];
+
+  // We'll need the same node report sent out to all vehicles, passed
+  // along in the same form (text or binary) as it was received.
+  bool   binary = m_map_binrecord[uname];
+  string node_report;
+  if(binary)
+    node_report = m_map_record[uname].getBinarySpec();
+  else
+    node_report = m_map_record[uname].getSpec();
 
-  // We'll need the same node report sent out to all vehicles.
-  string node_report = record.getSpec();
+  vector<unsigned int> nearby;
+  getNearbyVehicles(uix, nearby);
 
-  map<string, NodeRecord>::iterator p;
-  for(p=m_map_record.begin(); p!=m_map_record.end(); p++) {
-    string vname = p->first;
+  unsigned int i, vsize = nearby.size();
+  for(i=0; i<vsize; i++) {
+    unsigned int vix = nearby[i];
+    const string& vname = m_vnames[vix];
 
     // Criteria #1: vehicles different
-    if(vname == uname)
+    if(vix == uix)
       continue;
 
     if(m_verbose) 
@@ -414,35 +528,43 @@ void FldNodeComms::distributeNodeReportInfo(const string& uname)
     // Criteria #2: receiving vehicle has been heard from recently.
     // Freshness is enforced to disallow messages to a vehicle that may in
     // fact be much farther away than a stale node report would indicate
-    double vname_time_since_update = m_curr_time - m_map_time_nreport[vname];
+    double vname_time_since_update = m_curr_time - m_vtime_nreport[vix];
     if(vname_time_since_update > m_stale_time)
       msg_send = false;
     
-    // Criteria #3: the range between vehicles is not too large.
-    if(msg_send && !meetsRangeThresh(uname, vname))
-      msg_send = false;
-    
+    // Criteria #3: the range between vehicles is not too large, given
+    // the stealth of the sender and the earange of the receiver.
+    double range = 0;
+    if(m_vvalid[vix])
+      range = hypot((m_vx[uix]-m_vx[vix]), (m_vy[uix]-m_vy[vix]));
+    if(msg_send) {
+      double comms_range = m_comms_range * m_vstealth[uix] * m_vearange[vix];
+      if(!m_vvalid[vix] || (range > comms_range))
+	msg_send = false;
+    }
     
     // Criteria #4: if groups considered, check for same group
     if(msg_send && m_apply_groups) {
       if(m_verbose) {
-	cout << "  uname group:" << m_map_vgroup[uname] << endl;
-	cout << "  vname group:" << m_map_vgroup[vname] << endl;
+	cout << "  uname group:" << m_vgroup[uix] << endl;
+	cout << "  vname group:" << m_vgroup[vix] << endl;
       }
-      if(m_map_vgroup[uname] != m_map_vgroup[vname])
+      if(m_vgroup[uix] != m_vgroup[vix])
 	msg_send = false;
     }
     
     // Extra Criteria: If otherwise not sending, check to see if nodes
     // are within "critical" range. If so send report regardless of 
     // anything else - in the spirit of safety!
-    if(!msg_send && meetsCriticalRangeThresh(uname, vname))
+    if(!msg_send && m_vvalid[vix] && (range <= m_critical_range))
       msg_send = true;
 
-      
     if(msg_send) {
-      string moos_var = "NODE_REPORT_" + vname;
-      Notify(moos_var, node_report);
+      if(binary)
+	Notify(m_vreport_vars[vix], (void*)(node_report.c_str()),
+	       node_report.length());
+      else
+	Notify(m_vreport_vars[vix], node_report);
       if(m_view_node_rpt_pulses)
 	postViewCommsPulse(uname, vname);
       m_total_reports_sent++;
@@ -53,7 +53,9 @@ class FldNodeComms : public AppCastingMOOSApp
   bool handleStealth(const std::string&);
   bool handleEarange(const std::string&);
 
-  void distributeNodeReportInfo(const std::string& uname);
+  void buildVehicleTable();
+  void getNearbyVehicles(unsigned int, std::vector<unsigned int>&);
+  void distributeNodeReportInfo(unsigned int uix);
   void distributeNodeMessageInfo(const std::string& uname);
   
   bool meetsRangeThresh(const std::string& v1, const std::string& v2);
@@ -102,6 +104,8 @@ class FldNodeComms : public AppCastingMOOSApp
   std::map<std::string, NodeMessage>  m_map_message;    
   // True if last node report for vehicle vname has not been sent out
   std::map<std::string, bool>         m_map_newrecord;  
+  // True if last node report for vehicle vname arrived in binary form
+  std::map<std::string, bool>         m_map_binrecord;  
   // True if last node message for vehicle vname has not been sent out
   std::map<std::string, bool>         m_map_newmessage; 
 
@@ -116,6 +120,23 @@ class FldNodeComms : public AppCastingMOOSApp
 
   std::vector<std::string> m_colors;
 
+  // Dense per-vehicle state, rebuilt each iteration from the maps 
+  // above, indexed in alphabetical order of vehicle name.
+  std::vector<std::string> m_vnames;
+  std::vector<std::string> m_vreport_vars;  // NODE_REPORT_VNAME
+  std::vector<bool>        m_vvalid;
+  std::vector<double>      m_vx;
+  std::vector<double>      m_vy;
+  std::vector<double>      m_vtime_nreport;
+  std::vector<double>      m_vstealth;
+  std::vector<double>      m_vearange;
+  std::vector<std::string> m_vgroup;
+
+  // Spatial grid over vehicle positions. Cell size is the largest
+  // range at which any report could be sent. Zero means no grid.
+  double m_grid_size;
+  std::map<std::pair<int,int>, std::vector<unsigned int> > m_grid;
+
  protected: // State (statistics) variables
 
   unsigned int   m_total_reports_rcvd;
@@ -42,6 +42,7 @@ AppCastMonitor::AppCastMonitor()
   m_term_report_interval = 0.6;
 
   m_terse_mode     = false;
+  m_appcast_deltas = false;
   m_update_pending = true;
   m_refresh_mode   = "events";
 
@@ -68,7 +69,7 @@ bool AppCastMonitor::OnNewMail(MOOSMSG_LIST &NewMail)
     bool   mstr  = msg.IsString();
 #endif
 
-    if(key == "APPCAST") 
+    if((key == "APPCAST") || (key == "APPCAST_DELTA"))
       handleMailAppCast(sval);
   }
 	
@@ -153,9 +154,8 @@ bool AppCastMonitor::OnStartUp()
       string param = stripBlankEnds(toupper(biteString(*p, '=')));
       string value = stripBlankEnds(*p);
       
-      if(param == "FOO") {
-        //handled
-      }
+      if(param == "APPCAST_DELTAS")
+        setBooleanOnString(m_appcast_deltas, value);
     }
   }
   
@@ -174,6 +174,7 @@ bool AppCastMonitor::OnStartUp()
 void AppCastMonitor::RegisterVariables()
 {
   m_Comms.Register("APPCAST", 0);
+  m_Comms.Register("APPCAST_DELTA", 0);
 }
 
 //---------------------------------------------------------
@@ -181,6 +182,7 @@ void AppCastMonitor::RegisterVariables()
 
 bool AppCastMonitor::handleMailAppCast(const string& str)
 {
+  // The node name is in the header of both full appcasts and deltas
   AppCast appcast   = string2AppCast(str);
   string  node_name = appcast.getNodeName();
 
@@ -192,7 +194,7 @@ bool AppCastMonitor::handleMailAppCast(const string& str)
   unsigned int old_node_count = m_repo.getNodeCount();
   bool new_node_name = false;
 
-  m_repo.addAppCast(appcast);
+  m_repo.addAppCast(str);
   unsigned int new_node_count = m_repo.getNodeCount();
   if(new_node_count > old_node_count)
     new_node_name = true;
@@ -358,6 +360,8 @@ void AppCastMonitor::postAppCastRequest(const string& channel_node,
   str += ",duration=" + doubleToString(duration, 1);
   str += ",key=" + key;
   str += ",thresh=" + threshold;
+  if(m_appcast_deltas)
+    str += ",deltas=true";
 
   Notify("APPCAST_REQ", str);
   Notify("APPCAST_REQ_"+toupper(channel_node), str);
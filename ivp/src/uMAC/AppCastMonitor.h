@@ -37,6 +37,7 @@ class AppCastMonitor : public CMOOSApp
   
   void handleCommand(char);
   void setTerseMode(bool v) {m_terse_mode=v;}
+  void setAppCastDeltas(bool v) {m_appcast_deltas=v;}
   
  protected:
   bool OnNewMail(MOOSMSG_LIST &NewMail);
@@ -75,6 +76,7 @@ class AppCastMonitor : public CMOOSApp
   std::string  m_content_mode_prev;
 
   bool         m_terse_mode;
+  bool         m_appcast_deltas;
   
  private: // State variables
   unsigned int m_term_reports;
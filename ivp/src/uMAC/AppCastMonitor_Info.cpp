@@ -64,6 +64,9 @@ void showHelpAndExit()
   blk("Options:                                                        ");
   mag("  --alias","=<ProcessName>                                      ");
   blk("      Launch uMAC with the given process name rather than uMAC. ");
+  mag("  --deltas                                                      ");
+  blk("      Ask apps for appcast deltas between full appcasts. Same   ");
+  blk("      as appcast_deltas=true in the uMAC config block.          ");
   mag("  --example, -e                                                 ");
   blk("      Display example MOOS configuration block.                 ");
   mag("  --help, -h                                                    ");
@@ -97,7 +100,9 @@ void showExampleConfigAndExit()
   blk("  AppTick   = 4                                                 ");
   blk("  CommsTick = 4                                                 ");
   blk("                                                                ");
-  blk("  // No parameters defined specific to uMAC                     ");
+  blk("  // Ask apps to post only the changed lines (APPCAST_DELTA)    ");
+  blk("  // between full appcasts. Off by default.                     ");
+  blk("  appcast_deltas = false     // {true, FALSE}                   ");
   blk("}                                                               ");
   blk("                                                                ");
   exit(0);
@@ -120,6 +125,8 @@ void showInterfaceAndExit()
   blk("------------------------------------                            ");
   blk("  APPCAST = proc=pHostInfo!@#iter=48!@#node=shoreside!@#        ");
   blk("            iter=48!@#messages=...                              ");
+  blk("  APPCAST_DELTA = changed lines since the last appcast, sent    ");
+  blk("                  only if appcast_deltas is true               ");
   blk("                                                                ");
   blk("PUBLICATIONS:                                                   ");
   blk("------------------------------------                            ");
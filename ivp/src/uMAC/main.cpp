@@ -36,6 +36,7 @@ int main(int argc, char *argv[])
   string mission_file;
   string run_command = argv[0];
   bool   terse_mode = false;
+  bool   deltas     = false;
   
   for(int i=1; i<argc; i++) {
     string argi = argv[i];
@@ -49,6 +50,8 @@ int main(int argc, char *argv[])
       showInterfaceAndExit();
     else if((argi == "-t") || (argi == "--terse"))
       terse_mode = true;
+    else if(argi == "--deltas")
+      deltas = true;
     else if(strEnds(argi, ".moos") || strEnds(argi, ".moos++"))
       mission_file = argv[i];
     else if(strBegins(argi, "--alias="))
@@ -72,6 +75,8 @@ int main(int argc, char *argv[])
 
   AppCastMonitor UMAC;
   UMAC.setTerseMode(terse_mode);
+  if(deltas)
+    UMAC.setAppCastDeltas(true);
   // start the UMAC in its own thread
   MOOSAppRunnerThread appRunner(&UMAC, (char*)(run_command.c_str()), 
 				mission_file.c_str(), argc, argv);
@@ -98,6 +98,7 @@ void showExampleConfigAndExit()
   blk("  appcast_color_scheme = default  // {default, indigo, beige}   ");
   blk("  appcast_height       = 70       // [30,35,40,...,85,90]       ");
   blk("  refresh_mode         = events   // {paused, events, streaming}");
+  blk("  appcast_deltas       = false    // {true, FALSE}              ");
   blk("}                                                               ");
   blk("                                                                ");
   exit(0);
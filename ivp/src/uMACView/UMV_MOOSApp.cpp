@@ -38,6 +38,7 @@ UMV_MOOSApp::UMV_MOOSApp()
   m_appcast_repo             = 0;
   m_appcast_last_req_time    = 0;
   m_appcast_request_interval = 1.0;  // seconds
+  m_appcast_deltas           = false;
 }
 
 //----------------------------------------------------------------
@@ -138,6 +139,7 @@ void UMV_MOOSApp::registerVariables()
   AppCastingMOOSApp::RegisterVariables();
   m_Comms.Register("DB_UPTIME", 0);
   m_Comms.Register("APPCAST", 0);
+  m_Comms.Register("APPCAST_DELTA", 0);
 }
 
 //----------------------------------------------------------------------
@@ -164,7 +166,7 @@ void UMV_MOOSApp::handleNewMail(const MOOS_event & e)
     string community = msg.GetCommunity();
     string source = msg.GetSource();
 
-    if(key == "APPCAST") {
+    if((key == "APPCAST") || (key == "APPCAST_DELTA")) {
       m_appcast_repo->addAppCast(sval);
       handled_appcast = true;
     }
@@ -244,7 +246,11 @@ void UMV_MOOSApp::handleStartUp(const MOOS_event & e)
     string value = line;
 
     // Handle all appcast attributes, e.g. "refresh_mode", "true"
-    bool handled = m_gui->setRadioCastAttrib(param, value);
+    bool handled = false;
+    if(param == "appcast_deltas")
+      handled = setBooleanOnString(m_appcast_deltas, value);
+    else
+      handled = m_gui->setRadioCastAttrib(param, value);
 
     if(!handled)
       reportUnhandledConfigWarning(orig);
@@ -287,6 +293,8 @@ void UMV_MOOSApp::postAppCastRequest(string channel_node,
   str += ",duration=" + doubleToString(duration, 1);
   str += ",key=" + key;
   str += ",thresh=" + threshold;
+  if(m_appcast_deltas)
+    str += ",deltas=true";
 
   Notify("APPCAST_REQ", str);
   Notify("APPCAST_REQ_"+toupper(channel_node), str);
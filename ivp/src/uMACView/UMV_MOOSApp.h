@@ -70,6 +70,7 @@ class UMV_MOOSApp : public AppCastingMOOSApp
   AppCastRepo *m_appcast_repo;
   double       m_appcast_last_req_time;
   double       m_appcast_request_interval;
+  bool         m_appcast_deltas;
 };
 
 #endif 
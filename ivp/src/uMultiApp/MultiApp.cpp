@@ -0,0 +1,267 @@
+/*****************************************************************/
+/*    NAME: MOOS-IvP contributors                                */
+/*    ORGN: Dept of Mechanical Eng / CSAIL, MIT Cambridge MA     */
+/*    FILE: MultiApp.cpp                                         */
+/*    DATE: Oct 18th 2026                                        */
+/*                                                               */
+/* This file is part of MOOS-IvP                                 */
+/*                                                               */
+/* MOOS-IvP is free software: you can redistribute it and/or     */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation, either version  */
+/* 3 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* MOOS-IvP is distributed in the hope that it will be useful,   */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty   */
+/* of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See  */
+/* the GNU General Public License for more details.              */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with MOOS-IvP.  If not, see                     */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+#include <iostream>
+#include "MBUtils.h"
+#include "ColorParse.h"
+#include "MultiApp.h"
+#include "USM_MOOSApp.h"
+#include "HelmIvP.h"
+#include "MarinePID.h"
+#include "NodeReporter.h"
+#include "BasicContactMgr.h"
+#include "ProcessWatch.h"
+#include "TS_MOOSApp.h"
+
+using namespace std;
+
+//----------------------------------------------------------------
+// Constructor
+
+MultiApp::MultiApp()
+{
+  m_verbose       = false;
+  m_launch_gap_ms = 100;
+}
+
+//----------------------------------------------------------------
+// Destructor
+
+MultiApp::~MultiApp()
+{
+  quitApps();
+
+  unsigned int i;
+  for(i=0; i<m_threads.size(); i++)
+    delete(m_threads[i]);
+  for(i=0; i<m_apps.size(); i++)
+    delete(m_apps[i]);
+  for(i=0; i<m_dbs.size(); i++)
+    delete(m_dbs[i]);
+}
+
+//----------------------------------------------------------------
+// Procedure: addMissionFile
+
+bool MultiApp::addMissionFile(const string& filename)
+{
+  if(!okFileToRead(filename))
+    return(false);
+
+  m_mission_files.push_back(filename);
+  return(true);
+}
+
+//----------------------------------------------------------------
+// Procedure: isHostable
+//      Note: These are the apps built into this executable. Any other
+//            app named in an Antler block is left to be launched in
+//            its own process in the usual way.
+
+bool MultiApp::isHostable(const string& app_type)
+{
+  return((app_type == "uSimMarine")       ||
+	 (app_type == "pHelmIvP")         ||
+	 (app_type == "pMarinePID")       ||
+	 (app_type == "pNodeReporter")    ||
+	 (app_type == "pBasicContactMgr") ||
+	 (app_type == "uProcessWatch")    ||
+	 (app_type == "uTimerScript"));
+}
+
+//----------------------------------------------------------------
+// Procedure: newApp
+
+CMOOSApp* MultiApp::newApp(const string& app_type) const
+{
+  if(app_type == "uSimMarine")
+    return(new USM_MOOSApp);
+  else if(app_type == "pHelmIvP")
+    return(new HelmIvP);
+  else if(app_type == "pMarinePID")
+    return(new MarinePID);
+  else if(app_type == "pNodeReporter")
+    return(new NodeReporter);
+  else if(app_type == "pBasicContactMgr")
+    return(new BasicContactMgr);
+  else if(app_type == "uProcessWatch")
+    return(new ProcessWatch);
+  else if(app_type == "uTimerScript")
+    return(new TS_MOOSApp);
+
+  return(0);
+}
+
+//----------------------------------------------------------------
+// Procedure: launch
+//      Note: The DBs of all communities are launched first so that
+//            each app finds its DB already serving from within this
+//            process and connects in-process rather than over TCP.
+
+bool MultiApp::launch()
+{
+  unsigned int i, vsize = m_mission_files.size();
+  for(i=0; i<vsize; i++) {
+    if(!launchMission(m_mission_files[i]))
+      return(false);
+  }
+
+  vsize = m_app_types.size();
+  for(i=0; i<vsize; i++) {
+    launchApp(m_app_types[i], m_app_names[i], m_app_missions[i]);
+    if(m_launch_gap_ms > 0)
+      MOOSPause(m_launch_gap_ms);
+  }
+
+  cout << termColor("green");
+  cout << "uMultiApp hosting " << m_dbs.size() << " MOOSDB(s) and ";
+  cout << m_threads.size() << " app(s)" << endl;
+  cout << termColor();
+  return(true);
+}
+
+//----------------------------------------------------------------
+// Procedure: launchMission
+//   Purpose: Read the Antler block of the given mission, launch its
+//            MOOSDB (if it runs one) and note the apps to be launched
+//            once all DBs are up.
+
+bool MultiApp::launchMission(const string& mission_file)
+{
+  CProcessConfigReader reader;
+  reader.SetFile(mission_file);
+  reader.SetAppName("ANTLER");
+
+  STRING_LIST sParams;
+  if(!reader.GetConfiguration("ANTLER", sParams)) {
+    cout << "No Antler block found in " << mission_file << endl;
+    return(false);
+  }
+  sParams.reverse();
+
+  STRING_LIST::iterator p;
+  for(p=sParams.begin(); p!=sParams.end(); p++) {
+    string line  = *p;
+    string param = tolower(biteStringX(line, '='));
+    string value = stripBlankEnds(line);
+    if(param != "run")
+      continue;
+
+    string app_type = biteStringX(value, '@');
+    biteStringX(value, '~');
+    string app_name = biteStringX(value, ' ');
+    if(app_name == "")
+      app_name = app_type;
+
+    if(app_type == "MOOSDB") {
+      if(!launchDB(mission_file))
+	return(false);
+    }
+    else if(isHostable(app_type)) {
+      m_app_types.push_back(app_type);
+      m_app_names.push_back(app_name);
+      m_app_missions.push_back(mission_file);
+    }
+    else {
+      cout << termColor("magenta");
+      cout << "Not hosted: " << app_name << " (" << mission_file << ")";
+      cout << " - launch it separately" << endl;
+      cout << termColor();
+    }
+  }
+  return(true);
+}
+
+//----------------------------------------------------------------
+// Procedure: launchDB
+
+bool MultiApp::launchDB(const string& mission_file)
+{
+  // The DB parses its own command line. The suicide channel is
+  // disabled since one community's suicide would take down the
+  // whole fleet hosted here.
+  string arg0 = "MOOSDB";
+  string arg1 = mission_file;
+  string arg2 = "--moos_suicide_disable";
+  char *argv[3];
+  argv[0] = (char*)(arg0.c_str());
+  argv[1] = (char*)(arg1.c_str());
+  argv[2] = (char*)(arg2.c_str());
+
+  CMOOSDB *db = new CMOOSDB;
+  db->SetQuiet(!m_verbose);
+  if(!db->Run(3, argv)) {
+    delete(db);
+    return(false);
+  }
+
+  m_dbs.push_back(db);
+  return(true);
+}
+
+//----------------------------------------------------------------
+// Procedure: launchApp
+
+bool MultiApp::launchApp(const string& app_type, const string& app_name,
+			 const string& mission_file)
+{
+  CMOOSApp *app = newApp(app_type);
+  if(!app)
+    return(false);
+
+  MOOSAppRunnerThread *thread;
+  thread = new MOOSAppRunnerThread(app, app_name.c_str(), 
+				   mission_file.c_str());
+  m_apps.push_back(app);
+  m_threads.push_back(thread);
+  return(true);
+}
+
+//----------------------------------------------------------------
+// Procedure: waitForApps
+//   Purpose: Block until every hosted app has returned from Run()
+
+void MultiApp::waitForApps()
+{
+  bool running = true;
+  while(running) {
+    running = false;
+    unsigned int i, vsize = m_threads.size();
+    for(i=0; (i<vsize) && !running; i++)
+      running = m_threads[i]->isRunning();
+    if(running)
+      MOOSPause(500);
+  }
+}
+
+//----------------------------------------------------------------
+// Procedure: quitApps
+
+void MultiApp::quitApps()
+{
+  unsigned int i, vsize = m_threads.size();
+  for(i=0; i<vsize; i++) {
+    if(m_threads[i]->isRunning())
+      m_threads[i]->quit();
+  }
+}
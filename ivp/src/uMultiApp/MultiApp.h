@@ -0,0 +1,85 @@
+/*****************************************************************/
+/*    NAME: MOOS-IvP contributors                                */
+/*    ORGN: Dept of Mechanical Eng / CSAIL, MIT Cambridge MA     */
+/*    FILE: MultiApp.h                                           */
+/*    DATE: Oct 18th 2026                                        */
+/*                                                               */
+/* This file is part of MOOS-IvP                                 */
+/*                                                               */
+/* MOOS-IvP is free software: you can redistribute it and/or     */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation, either version  */
+/* 3 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* MOOS-IvP is distributed in the hope that it will be useful,   */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty   */
+/* of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See  */
+/* the GNU General Public License for more details.              */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with MOOS-IvP.  If not, see                     */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+#ifndef MULTI_APP_HEADER
+#define MULTI_APP_HEADER
+
+#include <string>
+#include <vector>
+#include "MOOS/libMOOS/MOOSLib.h"
+#include "MOOS/libMOOS/DB/MOOSDB.h"
+#include "MOOSAppRunnerThread.h"
+
+//---------------------------------------------------------------
+// MultiApp hosts the MOOSDB and a set of MOOS apps for one or
+// more communities inside a single process. Apps find their DB
+// living in the same process and talk to it over an in-process
+// link rather than a socket, so messages are handed across by
+// pointer with no serialization. Clients outside the process
+// (uXMS, pMarineViewer, ...) connect to the same DBs over TCP
+// as usual.
+
+class MultiApp
+{
+public:
+  MultiApp();
+  ~MultiApp();
+
+  bool addMissionFile(const std::string&);
+  void setVerbose(bool v)           {m_verbose=v;}
+  void setLaunchGap(unsigned int v) {m_launch_gap_ms=v;}
+
+  bool launch();
+  void waitForApps();
+  void quitApps();
+
+  unsigned int getAppCount() const {return(m_threads.size());}
+  unsigned int getDBCount() const  {return(m_dbs.size());}
+
+  static bool isHostable(const std::string&);
+
+protected:
+  bool launchMission(const std::string&);
+  bool launchDB(const std::string&);
+  bool launchApp(const std::string& app_type, const std::string& app_name,
+		 const std::string& mission_file);
+
+  CMOOSApp* newApp(const std::string&) const;
+
+protected: // Configuration variables
+  std::vector<std::string>  m_mission_files;
+  bool                      m_verbose;
+  unsigned int              m_launch_gap_ms;
+
+protected: // State variables
+  // Apps noted in the Antler blocks, launched once all DBs are up
+  std::vector<std::string>  m_app_types;
+  std::vector<std::string>  m_app_names;
+  std::vector<std::string>  m_app_missions;
+
+  std::vector<CMOOSDB*>              m_dbs;
+  std::vector<CMOOSApp*>             m_apps;
+  std::vector<MOOSAppRunnerThread*>  m_threads;
+};
+
+#endif
@@ -0,0 +1,118 @@
+/*****************************************************************/
+/*    NAME: MOOS-IvP contributors                                */
+/*    ORGN: Dept of Mechanical Eng / CSAIL, MIT Cambridge MA     */
+/*    FILE: MultiApp_Info.cpp                                    */
+/*    DATE: Oct 18th 2026                                        */
+/*                                                               */
+/* This file is part of MOOS-IvP                                 */
+/*                                                               */
+/* MOOS-IvP is free software: you can redistribute it and/or     */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation, either version  */
+/* 3 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* MOOS-IvP is distributed in the hope that it will be useful,   */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty   */
+/* of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See  */
+/* the GNU General Public License for more details.              */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with MOOS-IvP.  If not, see                     */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+ 
+#include <cstdlib>
+#include <iostream>
+#include "ColorParse.h"
+#include "ReleaseInfo.h"
+#include "MultiApp_Info.h"
+
+using namespace std;
+
+//----------------------------------------------------------------
+// Procedure: showSynopsis
+
+void showSynopsis()
+{
+  blk("SYNOPSIS:                                                       ");
+  blk("------------------------------------                            ");
+  blk("  The uMultiApp application launches the MOOSDB and the MOOS    ");
+  blk("  apps named in the Antler block of one or more mission files,  ");
+  blk("  all within a single process. Each app runs in its own thread  ");
+  blk("  and talks to its DB over an in-process link rather than a     ");
+  blk("  socket, so mail is handed across without serialization.       ");
+  blk("  Several vehicle communities may be hosted at once by giving   ");
+  blk("  one mission file per community. Apps that uMultiApp does not  ");
+  blk("  know how to host are reported and should be launched as usual");
+  blk("  with pAntler. Clients outside the process connect to the      ");
+  blk("  hosted DBs over TCP as they would to any MOOSDB.              ");
+  blk("                                                                ");
+  blk("  Hosted apps: uSimMarine, pHelmIvP, pMarinePID, pNodeReporter, ");
+  blk("               pBasicContactMgr, uProcessWatch, uTimerScript    ");
+}
+
+//----------------------------------------------------------------
+// Procedure: showHelpAndExit
+
+void showHelpAndExit()
+{
+  blk("                                                                ");
+  blu("=============================================================== ");
+  blu("Usage: uMultiApp file.moos [file.moos ...] [OPTIONS]            ");
+  blu("=============================================================== ");
+  blk("                                                                ");
+  showSynopsis();
+  blk("                                                                ");
+  blk("Options:                                                        ");
+  mag("  --example, -e                                                 ");
+  blk("      Display example Antler configuration block.               ");
+  mag("  --gap","=<msecs>                                              ");
+  blk("      Pause between launching apps. The default is 100.         ");
+  mag("  --help, -h                                                    ");
+  blk("      Display this help message.                                ");
+  mag("  --verbose                                                     ");
+  blk("      Do not silence the output of the hosted MOOSDBs.          ");
+  mag("  --version,-v                                                  ");
+  blk("      Display the release version of uMultiApp.                 ");
+  blk("                                                                ");
+  exit(0);
+}
+
+//----------------------------------------------------------------
+// Procedure: showExampleConfigAndExit
+
+void showExampleConfigAndExit()
+{
+  blu("=============================================================== ");
+  blu("uMultiApp Example Antler Configuration                          ");
+  blu("=============================================================== ");
+  blk("                                                                ");
+  blk("ServerHost = localhost                                          ");
+  blk("ServerPort = 9001                                               ");
+  blk("Community  = alpha                                              ");
+  blk("                                                                ");
+  blk("ProcessConfig = ANTLER                                          ");
+  blk("{                                                               ");
+  blk("  Run = MOOSDB          @ NewConsole = false                    ");
+  blk("  Run = uSimMarine      @ NewConsole = false                    ");
+  blk("  Run = pMarinePID      @ NewConsole = false                    ");
+  blk("  Run = pHelmIvP        @ NewConsole = false                    ");
+  blk("  Run = pNodeReporter   @ NewConsole = false ~ pNodeReporter_A  ");
+  blk("  Run = pMarineViewer   @ NewConsole = false  // Not hosted     ");
+  blk("}                                                               ");
+  blk("                                                                ");
+  blk("  The ServerHost must name this machine for the apps to use the ");
+  blk("  in-process link. Otherwise they connect over TCP as usual.    ");
+  blk("                                                                ");
+  exit(0);
+}
+
+//----------------------------------------------------------------
+// Procedure: showReleaseInfoAndExit
+
+void showReleaseInfoAndExit()
+{
+  showReleaseInfo("uMultiApp", "gpl");
+  exit(0);
+}
+
@@ -0,0 +1,76 @@
+/*****************************************************************/
+/*    NAME: MOOS-IvP contributors                                */
+/*    ORGN: Dept of Mechanical Eng / CSAIL, MIT Cambridge MA     */
+/*    FILE: main.cpp                                             */
+/*    DATE: Oct 18th 2026                                        */
+/*                                                               */
+/* This file is part of MOOS-IvP                                 */
+/*                                                               */
+/* MOOS-IvP is free software: you can redistribute it and/or     */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation, either version  */
+/* 3 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* MOOS-IvP is distributed in the hope that it will be useful,   */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty   */
+/* of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See  */
+/* the GNU General Public License for more details.              */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with MOOS-IvP.  If not, see                     */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+#include <iostream>
+#include <cstdlib>
+#include "MBUtils.h"
+#include "ColorParse.h"
+#include "MultiApp.h"
+#include "MultiApp_Info.h"
+
+using namespace std;
+
+int main(int argc, char *argv[])
+{
+  MultiApp multi_app;
+
+  bool files_given = false;
+  for(int i=1; i<argc; i++) {
+    string argi = argv[i];
+    if((argi=="-v") || (argi=="--version") || (argi=="-version"))
+      showReleaseInfoAndExit();
+    else if((argi=="-e") || (argi=="--example") || (argi=="-example"))
+      showExampleConfigAndExit();
+    else if((argi == "-h") || (argi == "--help") || (argi=="-help"))
+      showHelpAndExit();
+    else if(argi == "--verbose")
+      multi_app.setVerbose(true);
+    else if(strBegins(argi, "--gap=") && isNumber(argi.substr(6)))
+      multi_app.setLaunchGap(atoi(argi.substr(6).c_str()));
+    else if(strEnds(argi, ".moos") || strEnds(argi, ".moos++")) {
+      if(!multi_app.addMissionFile(argi)) {
+	cout << "Unable to read mission file: " << argi << endl;
+	return(1);
+      }
+      files_given = true;
+    }
+    else {
+      cout << "Unhandled argument: " << argi << endl;
+      return(1);
+    }
+  }
+  
+  if(!files_given)
+    showHelpAndExit();
+
+  cout << termColor("green");
+  cout << "uMultiApp launching" << endl;
+  cout << termColor() << endl;
+
+  if(!multi_app.launch())
+    return(1);
+
+  multi_app.waitForApps();
+  return(0);
+}
+
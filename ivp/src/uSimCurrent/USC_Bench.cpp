@@ -0,0 +1,187 @@
+/*****************************************************************/
+/*    NAME: MOOS-IvP contributors                                */
+/*    ORGN: Dept of Mechanical Eng / CSAIL, MIT Cambridge MA     */
+/*    FILE: USC_Bench.cpp                                        */
+/*    DATE: Oct 19th 2026                                        */
+/*                                                               */
+/* This file is part of MOOS-IvP                                 */
+/*                                                               */
+/* MOOS-IvP is free software: you can redistribute it and/or     */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation, either version  */
+/* 3 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* MOOS-IvP is distributed in the hope that it will be useful,   */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty   */
+/* of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See  */
+/* the GNU General Public License for more details.              */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with MOOS-IvP.  If not, see                     */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+
+
+#ifndef _WIN32
+#include <sys/time.h>
+#else
+#include <ctime>
+#endif
+#include <cstdlib>
+#include <cmath>
+#include <vector>
+#include <iostream>
+#include "USC_Bench.h"
+#include "CurrentField.h"
+#include "MBUtils.h"
+
+using namespace std;
+
+//--------------------------------------------------------
+// Procedure: wallTime
+
+static double wallTime()
+{
+#ifndef _WIN32
+  struct timeval tv;
+  gettimeofday(&tv, 0);
+  return((double)(tv.tv_sec) + ((double)(tv.tv_usec) / 1000000.0));
+#else
+  return((double)(clock()) / CLOCKS_PER_SEC);
+#endif
+}
+
+//--------------------------------------------------------
+// Procedure: timeQueries
+//   Purpose: Query the field at each point, returning the seconds
+//            taken and leaving the forces in fx, fy.
+
+static double timeQueries(const CurrentField& field,
+			  const vector<double>& qx, const vector<double>& qy,
+			  vector<double>& fx, vector<double>& fy)
+{
+  unsigned int i, qsize = qx.size();
+  fx.assign(qsize, 0);
+  fy.assign(qsize, 0);
+
+  double start_time = wallTime();
+  for(i=0; i<qsize; i++)
+    field.getLocalForce(qx[i], qy[i], fx[i], fy[i]);
+  return(wallTime() - start_time);
+}
+
+//--------------------------------------------------------
+// Procedure: maxDiff
+//   Purpose: Largest magnitude of the difference between two sets
+//            of forces.
+
+static double maxDiff(const vector<double>& ax, const vector<double>& ay,
+		      const vector<double>& bx, const vector<double>& by)
+{
+  double max_diff = 0;
+  for(unsigned int i=0; i<ax.size(); i++) {
+    double dx = ax[i] - bx[i];
+    double dy = ay[i] - by[i];
+    double diff = sqrt((dx*dx) + (dy*dy));
+    if(diff > max_diff)
+      max_diff = diff;
+  }
+  return(max_diff);
+}
+
+//--------------------------------------------------------
+// Procedure: printRow
+
+static void printRow(const string& mode, double secs, unsigned int queries,
+		     double build_secs, double max_diff)
+{
+  double ns_per_query = 0;
+  if(queries > 0)
+    ns_per_query = (secs * 1000000000.0) / (double)(queries);
+
+  cout << padString(mode, 8, false);
+  cout << padString(doubleToString(ns_per_query, 1), 14);
+  cout << padString(doubleToString(build_secs * 1000, 2), 12);
+  cout << padString(doubleToStringX(max_diff, 6), 14) << endl;
+}
+
+//--------------------------------------------------------
+// Procedure: benchCurrentField
+
+bool benchCurrentField(const string& cfd_file, unsigned int queries,
+		       double raster_size)
+{
+  CurrentField field;
+  if(!field.populate(cfd_file) || (field.size() == 0)) {
+    cout << "No current field vectors in " << cfd_file << endl;
+    return(false);
+  }
+
+  // Query points are spread over the field and the radius around it
+  double xmin = field.getXPos(0);
+  double xmax = xmin;
+  double ymin = field.getYPos(0);
+  double ymax = ymin;
+  for(unsigned int i=1; i<field.size(); i++) {
+    double x = field.getXPos(i);
+    double y = field.getYPos(i);
+    if(x < xmin)  xmin = x;
+    if(x > xmax)  xmax = x;
+    if(y < ymin)  ymin = y;
+    if(y > ymax)  ymax = y;
+  }
+  double radius = field.getRadius();
+  xmin -= radius;
+  xmax += radius;
+  ymin -= radius;
+  ymax += radius;
+
+  srand(1);
+  vector<double> qx(queries), qy(queries);
+  for(unsigned int i=0; i<queries; i++) {
+    qx[i] = xmin + (xmax - xmin) * ((double)(rand()) / (double)(RAND_MAX));
+    qy[i] = ymin + (ymax - ymin) * ((double)(rand()) / (double)(RAND_MAX));
+  }
+
+  if(raster_size <= 0)
+    raster_size = radius / 4;
+
+  cout << endl;
+  cout << "Current Field Benchmark: " << cfd_file << endl;
+  cout << "  vectors: " << field.size() << ", radius: " << radius;
+  cout << ", queries: " << queries << ", raster: " << raster_size << endl;
+  cout << endl;
+  cout << padString("mode", 8, false) << padString("ns/query", 14);
+  cout << padString("build_ms", 12) << padString("max_diff", 14) << endl;
+
+  vector<double> scan_fx, scan_fy, fx, fy;
+
+  field.clearIndex();
+  double secs = timeQueries(field, qx, qy, scan_fx, scan_fy);
+  printRow("scan", secs, queries, 0, 0);
+
+  double start_time = wallTime();
+  field.buildIndex();
+  double build_secs = wallTime() - start_time;
+  if(!field.indexed())
+    cout << "index   not built for this field" << endl;
+  else {
+    secs = timeQueries(field, qx, qy, fx, fy);
+    printRow("index", secs, queries, build_secs, 
+	     maxDiff(scan_fx, scan_fy, fx, fy));
+  }
+
+  start_time = wallTime();
+  bool ok = field.buildRaster(raster_size);
+  build_secs = wallTime() - start_time;
+  if(!ok)
+    cout << "raster  not built with cell size " << raster_size << endl;
+  else {
+    secs = timeQueries(field, qx, qy, fx, fy);
+    printRow("raster", secs, queries, build_secs, 
+	     maxDiff(scan_fx, scan_fy, fx, fy));
+  }
+  cout << endl;
+  return(true);
+}
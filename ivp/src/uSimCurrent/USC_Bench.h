@@ -0,0 +1,41 @@
+/*****************************************************************/
+/*    NAME: MOOS-IvP contributors                                */
+/*    ORGN: Dept of Mechanical Eng / CSAIL, MIT Cambridge MA     */
+/*    FILE: USC_Bench.h                                          */
+/*    DATE: Oct 19th 2026                                        */
+/*                                                               */
+/* This file is part of MOOS-IvP                                 */
+/*                                                               */
+/* MOOS-IvP is free software: you can redistribute it and/or     */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation, either version  */
+/* 3 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* MOOS-IvP is distributed in the hope that it will be useful,   */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty   */
+/* of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See  */
+/* the GNU General Public License for more details.              */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with MOOS-IvP.  If not, see                     */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+
+
+#ifndef USC_BENCH_HEADER
+#define USC_BENCH_HEADER
+
+#include <string>
+
+//--------------------------------------------------------
+// Time CurrentField::getLocalForce() over the given field file in 
+// each of its lookup modes: a scan of all vectors, the spatial 
+// index, and the raster with the given cell size. The same random 
+// query points are used for each, and the largest difference from
+// the scan is reported. Returns false if the field has no vectors.
+
+bool benchCurrentField(const std::string& cfd_file, 
+		       unsigned int queries, double raster_size);
+
+#endif
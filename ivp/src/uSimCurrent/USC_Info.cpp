@@ -58,6 +58,11 @@ void showHelpAndExit()
   mag("  --alias","=<ProcessName>                                      ");
   blk("      Launch uSimCurrent with the given process name rather     ");
   blk("      than uSimCurrent.                                         ");
+  mag("  --bench","=<file.cfd>                                        ");
+  blk("      Time the current field lookup modes (scan of all vectors,  ");
+  blk("      spatial index, raster) over the given field and exit.     ");
+  blk("      Sizes are set with --queries=<N> (default 100000) and     ");
+  blk("      --raster=<cell> (default a quarter of the field radius).  ");
   mag("  --example, -e                                                 ");
   blk("      Display example MOOS configuration block.                 ");
   mag("  --help, -h                                                    ");
@@ -90,6 +95,10 @@ void showExampleConfigAndExit()
   blk("  CommsTick = 4                                                 ");
   blk("                                                                ");
   blk("  CURRENT_FIELD = bravo.cfd                                     ");
+  blk("                                                                ");
+  blk("  // If > 0, precompute the field on a grid of this cell size   ");
+  blk("  // (meters) for constant-time lookups. Default is 0 (off).    ");
+  blk("  CURRENT_FIELD_RASTER = 0                                      ");
   blk("}                                                               ");
   blk("                                                                ");
   exit(0);
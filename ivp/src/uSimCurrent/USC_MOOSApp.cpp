@@ -37,6 +37,7 @@ USC_MOOSApp::USC_MOOSApp()
 {
   m_pending_cfield = false;
   m_post_var = "USM_FORCE_VECTOR";
+  m_raster_size = 0;
   m_posx     = 0;
   m_posy     = 0;
   
@@ -100,6 +101,17 @@ bool USC_MOOSApp::OnStartUp()
     }
     else if(param == "CURRENT_FIELD_ACTIVE")
       m_cfield_active = (tolower(value) == "true");
+    else if(param == "CURRENT_FIELD_RASTER") {
+      if(!setNonNegDoubleOnString(m_raster_size, value))
+	cout << "Bad current_field_raster: " << value << endl;
+    }
+  }
+
+  // Optionally trade memory for constant-time force lookups
+  if(m_raster_size > 0) {
+    bool ok = m_current_field.buildRaster(m_raster_size);
+    if(!ok)
+      cout << "Unable to build current field raster" << endl;
   }
 
   // look for latitude, longitude global variables
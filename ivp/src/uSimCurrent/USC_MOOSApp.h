@@ -49,6 +49,7 @@ public:
 
  protected: // Configuration variables
   std::string  m_post_var;
+  double       m_raster_size;
 
  protected: // State variables
   CurrentField m_current_field;
@@ -22,10 +22,12 @@
 /*****************************************************************/
 
 #include <iostream>
+#include <cstdlib>
 #include "MBUtils.h"
 #include "ColorParse.h"
 #include "USC_MOOSApp.h"
 #include "USC_Info.h"
+#include "USC_Bench.h"
 
 using namespace std;
 
@@ -37,6 +39,10 @@ int main(int argc ,char * argv[])
   string mission_file;
   string run_command = argv[0];
 
+  string bench_file;
+  unsigned int bench_queries = 100000;
+  double bench_raster = 0;
+
   for(int i=1; i<argc; i++) {
     string argi = argv[i];
     if((argi=="-v") || (argi=="--version") || (argi=="-version"))
@@ -51,10 +57,22 @@ int main(int argc ,char * argv[])
       mission_file = argv[i];
     else if(strBegins(argi, "--alias="))
       run_command = argi.substr(8);
+    else if(strBegins(argi, "--bench="))
+      bench_file = argi.substr(8);
+    else if(strBegins(argi, "--queries="))
+      bench_queries = atoi(argi.substr(10).c_str());
+    else if(strBegins(argi, "--raster="))
+      bench_raster = atof(argi.substr(9).c_str());
     else if(i==2)
       run_command = argi;
   }
   
+  // Benchmark the current field lookup modes, no MOOS needed
+  if(bench_file != "") {
+    bool ok = benchCurrentField(bench_file, bench_queries, bench_raster);
+    return(ok ? 0 : 1);
+  }
+
   if(mission_file == "")
     showHelpAndExit();
 
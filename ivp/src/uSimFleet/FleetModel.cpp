@@ -0,0 +1,458 @@
+/*****************************************************************/
+/*    NAME: MOOS-IvP contributors                                */
+/*    ORGN: Dept of Mechanical Eng / CSAIL, MIT Cambridge MA     */
+/*    FILE: FleetModel.cpp                                       */
+/*    DATE: Oct 18th 2026                                        */
+/*                                                               */
+/* This file is part of MOOS-IvP                                 */
+/*                                                               */
+/* MOOS-IvP is free software: you can redistribute it and/or     */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation, either version  */
+/* 3 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* MOOS-IvP is distributed in the hope that it will be useful,   */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty   */
+/* of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See  */
+/* the GNU General Public License for more details.              */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with MOOS-IvP.  If not, see                     */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+#include <cmath>
+#include <cstdlib>
+#include "FleetModel.h"
+#include "MBUtils.h"
+#include "AngleUtils.h"
+
+using namespace std;
+
+//------------------------------------------------------------------------
+// Constructor
+//      Note: Defaults are those of the USM_Model
+
+FleetModel::FleetModel()
+{
+  m_turn_rate            = 70;
+  m_rotate_speed         = 0;
+  m_buoyancy_rate        = 0.025;  // positively buoyant
+  m_max_depth_rate       = 0.5;    // meters per second
+  m_max_depth_rate_speed = 2.0;    // meters per second
+  m_max_acceleration     = 0;
+  m_max_deceleration     = 0.5;
+  m_water_depth          = 0;      // zero means nothing known
+  m_drift_x              = 0;
+  m_drift_y              = 0;
+
+  m_max_rudder_degs_per_sec = 0;
+
+  m_thrust_map.setThrustFactor(20);
+
+  m_cfield_set = false;
+  m_time       = 0;
+}
+
+//------------------------------------------------------------------------
+// Procedure: addVehicle
+//   Returns: The index of the vehicle, new or existing
+
+unsigned int FleetModel::addVehicle(const string& name)
+{
+  int ix = getIndex(name);
+  if(ix >= 0)
+    return((unsigned int)(ix));
+
+  m_name.push_back(name);
+  m_x.push_back(0);
+  m_y.push_back(0);
+  m_hdg.push_back(0);
+  m_spd.push_back(0);
+  m_dep.push_back(0);
+  m_pitch.push_back(0);
+  m_thrust.push_back(0);
+  m_rudder.push_back(0);
+  m_rudder_tstamp.push_back(0);
+  m_elevator.push_back(0);
+  m_spd_cmd.push_back(0);
+  m_prior_hdg.push_back(0);
+  m_prior_spd.push_back(0);
+  m_force_x.push_back(0);
+  m_force_y.push_back(0);
+
+  return(m_name.size() - 1);
+}
+
+//------------------------------------------------------------------------
+// Procedure: getIndex
+//   Returns: The index of the named vehicle, or -1 if unknown
+
+int FleetModel::getIndex(const string& name) const
+{
+  for(unsigned int i=0; i<m_name.size(); i++) {
+    if(m_name[i] == name)
+      return((int)(i));
+  }
+  return(-1);
+}
+
+//------------------------------------------------------------------------
+// Procedure: resetTime
+
+void FleetModel::resetTime(double curr_time)
+{
+  m_time = curr_time;
+}
+
+//------------------------------------------------------------------------
+// Procedure: setParam
+
+bool FleetModel::setParam(string param, double value)
+{
+  param = stripBlankEnds(tolower(param));
+  if(param == "buoyancy_rate")
+    m_buoyancy_rate = value;
+  else if(param == "turn_rate")
+    m_turn_rate = vclip(value, 0, 100);
+  else if(param == "drift_x")
+    m_drift_x = value;
+  else if(param == "drift_y")
+    m_drift_y = value;
+  else if(param == "rotate_speed")
+    m_rotate_speed = value;
+  else if(param == "max_acceleration") {
+    if(value < 0)
+      return(false);
+    m_max_acceleration = value;
+  }
+  else if(param == "max_deceleration") {
+    if(value < 0)
+      return(false);
+    m_max_deceleration = value;
+  }
+  else if(param == "max_depth_rate")
+    m_max_depth_rate = value;
+  else if(param == "max_depth_rate_speed")
+    m_max_depth_rate_speed = value;
+  else if(param == "water_depth") {
+    if(value < 0)
+      return(false);
+    m_water_depth = value;
+  }
+  else
+    return(false);
+  return(true);
+}
+
+//------------------------------------------------------------------------
+// Procedure: setMaxRudderDegreesPerSec
+
+bool FleetModel::setMaxRudderDegreesPerSec(double v)
+{
+  if(v < 0)
+    return(false);
+  m_max_rudder_degs_per_sec = v;
+  return(true);
+}
+
+//--------------------------------------------------------------------
+// Procedure: setDriftVector
+//   Purpose: Set, or add to, the drift of the whole fleet given as
+//            "heading,magnitude".
+
+bool FleetModel::setDriftVector(string str, bool add_new_drift)
+{
+  string left  = biteStringX(str, ',');
+  string right = str;
+
+  if(!isNumber(left) || !isNumber(right))
+    return(false);
+
+  double ang  = angle360(atof(left.c_str()));
+  double mag  = atof(right.c_str());
+  double rads = headingToRadians(ang);
+
+  double xmps = cos(rads) * mag;
+  double ymps = sin(rads) * mag;
+
+  if(add_new_drift) {
+    m_drift_x += xmps;
+    m_drift_y += ymps;
+  }
+  else {
+    m_drift_x = xmps;
+    m_drift_y = ymps;
+  }
+  return(true);
+}
+
+//---------------------------------------------------------------------
+// Procedure: addThrustMapping
+
+bool FleetModel::addThrustMapping(double thrust, double speed)
+{
+  bool result = m_thrust_map.addPair(thrust, speed);
+  updateSpeedCommands();
+  return(result);
+}
+
+//------------------------------------------------------------------------
+// Procedure: setThrustFactor
+
+void FleetModel::setThrustFactor(double value)
+{
+  m_thrust_map.setThrustFactor(value);
+  updateSpeedCommands();
+}
+
+//------------------------------------------------------------------------
+// Procedure: setThrustReflect
+
+void FleetModel::setThrustReflect(bool value)
+{
+  m_thrust_map.setReflect(value);
+  updateSpeedCommands();
+}
+
+//------------------------------------------------------------------------
+// Procedure: setCurrentField
+//      Note: The force of the field at each vehicle position is added
+//            to the drift of the fleet.
+
+void FleetModel::setCurrentField(const CurrentField& cfield)
+{
+  m_cfield = cfield;
+  m_cfield_set = true;
+}
+
+//------------------------------------------------------------------------
+// Procedure: initPosition
+//
+//  "x=20, y=-35, speed=2.2, heading=180, depth=20"
+
+bool FleetModel::initPosition(unsigned int ix, const string& str)
+{
+  if(ix >= m_name.size())
+    return(false);
+
+  vector<string> svector = parseString(str, ',');
+  unsigned int i, vsize = svector.size();
+  for(i=0; i<vsize; i++) {
+    string param = tolower(biteStringX(svector[i], '='));
+    string value = svector[i];
+    if(!isNumber(value))
+      return(false);
+
+    double dval = atof(value.c_str());
+    if(param == "x")
+      m_x[ix] = dval;
+    else if(param == "y")
+      m_y[ix] = dval;
+    else if((param == "heading") || (param=="deg") || (param=="hdg"))
+      m_hdg[ix] = dval;
+    else if((param == "speed") || (param == "spd"))
+      m_spd[ix] = dval;
+    else if((param == "depth") || (param == "dep"))
+      m_dep[ix] = dval;
+    else
+      return(false);
+  }
+  return(true);
+}
+
+//------------------------------------------------------------------------
+// Procedure: setThrust
+
+void FleetModel::setThrust(unsigned int ix, double thrust)
+{
+  m_thrust[ix]  = thrust;
+  m_spd_cmd[ix] = m_thrust_map.getSpeedValue(thrust);
+}
+
+//------------------------------------------------------------------------
+// Procedure: setRudder
+//      Note: Limits the rate of change as in USM_Model::setRudder()
+
+void FleetModel::setRudder(unsigned int ix, double desired_rudder,
+			   double tstamp)
+{
+  double max_rudder_change = 100;
+  if(m_max_rudder_degs_per_sec > 0) {
+    double delta_time = tstamp - m_rudder_tstamp[ix];
+    max_rudder_change = (delta_time * m_max_rudder_degs_per_sec);
+  }
+
+  double change = desired_rudder - m_rudder[ix];
+  if(change > max_rudder_change)
+    change = max_rudder_change;
+  else if(-change > max_rudder_change)
+    change = -max_rudder_change;
+
+  m_rudder[ix] += change;
+  m_rudder_tstamp[ix] = tstamp;
+}
+
+//------------------------------------------------------------------------
+// Procedure: getAltitude
+//      Note: Zero if nothing is known of the water depth
+
+double FleetModel::getAltitude(unsigned int ix) const
+{
+  if(m_water_depth <= 0)
+    return(0);
+  double altitude = m_water_depth - m_dep[ix];
+  if(altitude < 0)
+    altitude = 0;
+  return(altitude);
+}
+
+//------------------------------------------------------------------------
+// Procedure: updateSpeedCommands
+//      Note: Called when the thrust map changes
+
+void FleetModel::updateSpeedCommands()
+{
+  for(unsigned int i=0; i<m_name.size(); i++)
+    m_spd_cmd[i] = m_thrust_map.getSpeedValue(m_thrust[i]);
+}
+
+//------------------------------------------------------------------------
+// Procedure: propagate
+//   Purpose: Advance every vehicle to the given time. Each pass below
+//            is the fleet-wide form of one SimEngine step, applied in
+//            the order of USM_Model::propagateNodeRecord(), and
+//            yields the same state.
+
+void FleetModel::propagate(double curr_time)
+{
+  double dt = curr_time - m_time;
+  if(dt <= 0)
+    return;
+  m_time = curr_time;
+
+  unsigned int i, vsize = m_name.size();
+  if(vsize == 0)
+    return;
+
+  double*       x     = &m_x[0];
+  double*       y     = &m_y[0];
+  double*       hdg   = &m_hdg[0];
+  double*       spd   = &m_spd[0];
+  double*       dep   = &m_dep[0];
+  double*       pitch = &m_pitch[0];
+  double*       phdg  = &m_prior_hdg[0];
+  double*       pspd  = &m_prior_spd[0];
+  double*       fx    = &m_force_x[0];
+  double*       fy    = &m_force_y[0];
+  const double* thrust   = &m_thrust[0];
+  const double* rudder   = &m_rudder[0];
+  const double* elevator = &m_elevator[0];
+  const double* spd_cmd  = &m_spd_cmd[0];
+
+  // Pass 1: Speed, as SimEngine::propagateSpeed()
+  for(i=0; i<vsize; i++) {
+    phdg[i] = hdg[i];
+    pspd[i] = spd[i];
+
+    double rudder_magnitude = fabs(vclip(rudder[i], -100, 100));
+    double vpct = (rudder_magnitude / 100) * 0.85;
+    double next_speed = spd_cmd[i] * (1.0 - vpct);
+    double prev_speed = spd[i];
+
+    if(next_speed > prev_speed) {
+      double acceleration = (next_speed - prev_speed) / dt;
+      if((m_max_acceleration > 0) && (acceleration > m_max_acceleration))
+	next_speed = (m_max_acceleration * dt) + prev_speed;
+    }
+    if(next_speed < prev_speed) {
+      double deceleration = (prev_speed - next_speed) / dt;
+      if((m_max_deceleration > 0) && (deceleration > m_max_deceleration))
+	next_speed = (m_max_deceleration * dt * -1) + prev_speed;
+    }
+    spd[i] = next_speed;
+  }
+
+  // Pass 2: Heading, as SimEngine::propagateHeading()
+  double turn_pct = m_turn_rate / 100;
+  for(i=0; i<vsize; i++) {
+    double rud = 0;
+    if(spd[i] != 0)
+      rud = vclip(rudder[i], -100, 100);
+    double delta_deg = rud * turn_pct * dt;
+    delta_deg = (1 + ((thrust[i]-50)/50)) * delta_deg;
+    delta_deg += (dt * m_rotate_speed);
+    hdg[i] = angle360(delta_deg + hdg[i]);
+  }
+
+  // Pass 3: Depth and pitch, as SimEngine::propagateDepth()
+  for(i=0; i<vsize; i++) {
+    double speed = spd[i];
+    if(speed <= 0) {
+      dep[i] = dep[i] + (-1 * m_buoyancy_rate * dt);
+      pitch[i] = 0;
+    }
+    else {
+      double pct = 1.0;
+      if(m_max_depth_rate_speed > 0) {
+	pct = (speed / m_max_depth_rate_speed);
+	if(pct > 1.0)
+	  pct = 1.0;
+      }
+      if(pct < 0)
+	pct = -1 * sqrt(-1 * pct);
+      else
+	pct = sqrt(pct);
+      double depth_rate = pct * m_max_depth_rate;
+      double pitch_depth_rate = - sin(pitch[i]) * speed;
+      double elevator_angle = vclip(elevator[i], -100, 100);
+      double actuator_depth_rate = (elevator_angle/100) * depth_rate;
+      double total_depth_rate = (-m_buoyancy_rate) + pitch_depth_rate +
+	actuator_depth_rate;
+      dep[i] = dep[i] + (1 * total_depth_rate * dt);
+
+      double new_pitch = 0;
+      double rate = pitch_depth_rate + actuator_depth_rate;
+      if(fabs(rate) <= speed)
+	new_pitch = - asin(rate / speed);
+      pitch[i] = new_pitch;
+    }
+    if(dep[i] < 0)
+      dep[i] = 0;
+  }
+
+  // Pass 4: External forces on each vehicle
+  for(i=0; i<vsize; i++) {
+    fx[i] = m_drift_x;
+    fy[i] = m_drift_y;
+  }
+  if(m_cfield_set) {
+    for(i=0; i<vsize; i++) {
+      double cfx = 0;
+      double cfy = 0;
+      m_cfield.getLocalForce(x[i], y[i], cfx, cfy);
+      fx[i] += cfx;
+      fy[i] += cfy;
+    }
+  }
+
+  // Pass 5: Position, as SimEngine::propagate()
+  for(i=0; i<vsize; i++) {
+    double speed = (spd[i] + pspd[i]) / 2;
+
+    double s = sin(degToRadians(phdg[i])) + sin(degToRadians(hdg[i]));
+    double c = cos(degToRadians(phdg[i])) + cos(degToRadians(hdg[i]));
+    double hdg_rad = atan2(s, c);
+
+    double xdot = (sin(hdg_rad) * speed);
+    double ydot = (cos(hdg_rad) * speed);
+
+    double new_speed = hypot(xdot, ydot);
+    if(speed < 0)
+      new_speed = -new_speed;
+
+    x[i] = x[i] + (xdot * dt) + (fx[i] * dt);
+    y[i] = y[i] + (ydot * dt) + (fy[i] * dt);
+    spd[i] = new_speed;
+  }
+}
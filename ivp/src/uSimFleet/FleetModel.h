@@ -0,0 +1,137 @@
+/*****************************************************************/
+/*    NAME: MOOS-IvP contributors                                */
+/*    ORGN: Dept of Mechanical Eng / CSAIL, MIT Cambridge MA     */
+/*    FILE: FleetModel.h                                         */
+/*    DATE: Oct 18th 2026                                        */
+/*                                                               */
+/* This file is part of MOOS-IvP                                 */
+/*                                                               */
+/* MOOS-IvP is free software: you can redistribute it and/or     */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation, either version  */
+/* 3 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* MOOS-IvP is distributed in the hope that it will be useful,   */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty   */
+/* of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See  */
+/* the GNU General Public License for more details.              */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with MOOS-IvP.  If not, see                     */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+#ifndef FLEET_MODEL_HEADER
+#define FLEET_MODEL_HEADER
+
+#include <string>
+#include <vector>
+#include "ThrustMap.h"
+#include "CurrentField.h"
+
+//---------------------------------------------------------------
+// FleetModel simulates a set of vehicles sharing one set of
+// vehicle characteristics. The state of the fleet is held as one
+// array per state variable, and each step of the propagation is
+// a pass over all vehicles. Vehicles are propagated as by the
+// USM_Model in normal (rudder and thrust) mode and single state.
+
+class FleetModel
+{
+public:
+  FleetModel();
+  ~FleetModel() {}
+
+  unsigned int addVehicle(const std::string& name);
+
+  void   propagate(double time);
+  void   resetTime(double time);
+
+  // Setters for the whole fleet
+  bool   setParam(std::string, double);
+  bool   setMaxRudderDegreesPerSec(double);
+  bool   setDriftVector(std::string, bool add=false);
+  bool   addThrustMapping(double, double);
+  void   setThrustFactor(double);
+  void   setThrustReflect(bool);
+  void   setCurrentField(const CurrentField&);
+
+  // Setters for one vehicle
+  bool   initPosition(unsigned int ix, const std::string&);
+  void   setThrust(unsigned int ix, double);
+  void   setRudder(unsigned int ix, double, double tstamp);
+  void   setElevator(unsigned int ix, double v) {m_elevator[ix] = v;}
+
+  // Getters
+  unsigned int size() const         {return(m_name.size());}
+  int    getIndex(const std::string&) const;
+
+  std::string getName(unsigned int ix) const {return(m_name[ix]);}
+
+  double getX(unsigned int ix) const        {return(m_x[ix]);}
+  double getY(unsigned int ix) const        {return(m_y[ix]);}
+  double getHeading(unsigned int ix) const  {return(m_hdg[ix]);}
+  double getSpeed(unsigned int ix) const    {return(m_spd[ix]);}
+  double getDepth(unsigned int ix) const    {return(m_dep[ix]);}
+  double getAltitude(unsigned int ix) const;
+  double getThrust(unsigned int ix) const   {return(m_thrust[ix]);}
+  double getRudder(unsigned int ix) const   {return(m_rudder[ix]);}
+  double getElevator(unsigned int ix) const {return(m_elevator[ix]);}
+
+  double getDriftX() const       {return(m_drift_x);}
+  double getDriftY() const       {return(m_drift_y);}
+  double getWaterDepth() const   {return(m_water_depth);}
+  bool   usingCurrentField() const {return(m_cfield_set);}
+
+  std::string getThrustMapPos() const {return(m_thrust_map.getMapPos());}
+  std::string getThrustMapNeg() const {return(m_thrust_map.getMapNeg());}
+
+ protected:
+  void   updateSpeedCommands();
+
+ protected: // Vehicle characteristics, shared by the fleet
+  double     m_turn_rate;
+  double     m_rotate_speed;
+  double     m_buoyancy_rate;
+  double     m_max_depth_rate;
+  double     m_max_depth_rate_speed;
+  double     m_max_acceleration;
+  double     m_max_deceleration;
+  double     m_max_rudder_degs_per_sec;
+  double     m_water_depth;
+  double     m_drift_x;
+  double     m_drift_y;
+
+  ThrustMap    m_thrust_map;
+  CurrentField m_cfield;
+  bool         m_cfield_set;
+
+  double     m_time;
+
+ protected: // Per-vehicle state, one entry per vehicle
+  std::vector<std::string> m_name;
+
+  std::vector<double> m_x;
+  std::vector<double> m_y;
+  std::vector<double> m_hdg;
+  std::vector<double> m_spd;
+  std::vector<double> m_dep;
+  std::vector<double> m_pitch;
+
+  std::vector<double> m_thrust;
+  std::vector<double> m_rudder;
+  std::vector<double> m_rudder_tstamp;
+  std::vector<double> m_elevator;
+
+  // The thrust map speed for the present thrust, found when the
+  // thrust is set rather than on each propagation.
+  std::vector<double> m_spd_cmd;
+
+  // Scratch values of one propagation
+  std::vector<double> m_prior_hdg;
+  std::vector<double> m_prior_spd;
+  std::vector<double> m_force_x;
+  std::vector<double> m_force_y;
+};
+
+#endif
@@ -0,0 +1,178 @@
+/*****************************************************************/
+/*    NAME: MOOS-IvP contributors                                */
+/*    ORGN: Dept of Mechanical Eng / CSAIL, MIT Cambridge MA     */
+/*    FILE: USF_Info.cpp                                         */
+/*    DATE: Oct 18th 2026                                        */
+/*                                                               */
+/* This file is part of MOOS-IvP                                 */
+/*                                                               */
+/* MOOS-IvP is free software: you can redistribute it and/or     */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation, either version  */
+/* 3 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* MOOS-IvP is distributed in the hope that it will be useful,   */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty   */
+/* of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See  */
+/* the GNU General Public License for more details.              */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with MOOS-IvP.  If not, see                     */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+ 
+#include <cstdlib>
+#include <iostream>
+#include "USF_Info.h"
+#include "ColorParse.h"
+#include "ReleaseInfo.h"
+
+using namespace std;
+
+//----------------------------------------------------------------
+// Procedure: showSynopsis
+
+void showSynopsis()
+{
+  blk("SYNOPSIS:                                                       ");
+  blk("------------------------------------                            ");
+  blk("  The uSimFleet application simulates a fleet of vehicles in a ");
+  blk("  single process. Each vehicle is propagated as by uSimMarine,  ");
+  blk("  in normal (rudder and thrust) mode, from its own DESIRED_*    ");
+  blk("  inputs. All vehicles share one set of vehicle characteristics.");
+  blk("  Inputs and outputs are the uSimMarine variables suffixed with ");
+  blk("  the upper case vehicle name, e.g., DESIRED_THRUST_ABE and     ");
+  blk("  NAV_X_ABE.                                                    ");
+}
+
+//----------------------------------------------------------------
+// Procedure: showHelpAndExit
+
+void showHelpAndExit()
+{
+  blk("                                                                ");
+  blu("=============================================================== ");
+  blu("Usage: uSimFleet file.moos [OPTIONS]                            ");
+  blu("=============================================================== ");
+  blk("                                                                ");
+  showSynopsis();
+  blk("                                                                ");
+  blk("Options:                                                        ");
+  mag("  --alias","=<ProcessName>                                      ");
+  blk("      Launch uSimFleet with the given process name rather       ");
+  blk("      than uSimFleet.                                           ");
+  mag("  --example, -e                                                 ");
+  blk("      Display example MOOS configuration block.                 ");
+  mag("  --help, -h                                                    ");
+  blk("      Display this help message.                                ");
+  mag("  --interface, -i                                               ");
+  blk("      Display MOOS publications and subscriptions.              ");
+  mag("  --version,-v                                                  ");
+  blk("      Display the release version of uSimFleet.                 ");
+  blk("                                                                ");
+  blk("Note: If argv[2] does not otherwise match a known option,       ");
+  blk("      then it will be interpreted as a run alias. This is       ");
+  blk("      to support pAntler launching conventions.                 ");
+  blk("                                                                ");
+  exit(0);
+}
+
+//----------------------------------------------------------------
+// Procedure: showExampleConfigAndExit
+
+void showExampleConfigAndExit()
+{
+  blk("                                                                ");
+  blu("=============================================================== ");
+  blu("uSimFleet Example MOOS Configuration                            ");
+  blu("=============================================================== ");
+  blk("                                                                ");
+  blk("ProcessConfig = uSimFleet                                       ");
+  blk("{                                                               ");
+  blk("  AppTick   = 4                                                 ");
+  blk("  CommsTick = 4                                                 ");
+  blk("                                                                ");
+  blk("  // One line per vehicle, with its starting position          ");
+  blk("  vehicle = name=abe, x=0, y=0, heading=180, speed=0, depth=0   ");
+  blk("  vehicle = name=ben, x=20, y=0, heading=180                    ");
+  blk("                                                                ");
+  blk("  drift_x       = 0                                             ");
+  blk("  drift_y       = 0                                             ");
+  blk("  rotate_speed  = 0                                             ");
+  blk("  drift_vector  = 0,0     "," // heading, magnitude             ");
+  blk("                                                                ");
+  blk("  // A current field applied at each vehicle position           ");
+  blk("  current_field        = field.cfd                              ");
+  blk("  current_field_raster = 0     ","// cell size, 0 for no raster ");
+  blk("                                                                ");
+  blk("  buoyancy_rate        = 0.025 ","// meters/sec                 ");
+  blk("  max_acceleration     = 0     ","// meters/sec^2               ");
+  blk("  max_deceleration     = 0.5   ","// meters/sec^2               ");
+  blk("  max_depth_rate       = 0.5   ","// meters/sec                 ");
+  blk("  max_depth_rate_speed = 2.0   ","// meters/sec                 ");
+  blk("  max_rudder_degs_per_sec = 0  ","// 0 for no limit             ");
+  blk("  default_water_depth  = 0     ","// meters, 0 for unknown      ");
+  blk("                                                                ");
+  blk("  thrust_reflect       = false ","// or {true}                  ");
+  blk("  thrust_factor        = 20    ","// range [0,inf)              ");
+  blk("  turn_rate            = 70    ","// range [0,100]              ");
+  blk("  thrust_map           = 0:0, 20:1, 40:2, 60:3, 80:5, 100:5     ");
+  blk("                                                                ");
+  blk("  prefix               = NAV   ","// default is NAV             ");
+  blk("}                                                               ");
+  blk("                                                                ");
+  exit(0);
+}
+
+
+//----------------------------------------------------------------
+// Procedure: showInterfaceAndExit
+
+void showInterfaceAndExit()
+{
+  blk("                                                                ");
+  blu("=============================================================== ");
+  blu("uSimFleet INTERFACE                                             ");
+  blu("=============================================================== ");
+  blk("                                                                ");
+  showSynopsis();
+  blk("                                                                ");
+  blk("SUBSCRIPTIONS:                                                  ");
+  blk("------------------------------------                            ");
+  blk("  For each vehicle, e.g., abe:                                  ");
+  blk("  DESIRED_THRUST_ABE   = [-100,100]                             ");
+  blk("  DESIRED_RUDDER_ABE   = [-100,100]                             ");
+  blk("  DESIRED_ELEVATOR_ABE = [-100,100]                             ");
+  blk("                                                                ");
+  blk("  For the whole fleet:                                          ");
+  blk("  BUOYANCY_RATE      = [-inf,+inf] m/s                          ");
+  blk("  DRIFT_X/CURRENT_X  = [-inf,+inf] m/s                          ");
+  blk("  DRIFT_Y/CURRENT_Y  = [-inf,+inf] m/s                          ");
+  blk("  DRIFT_VECTOR       = [0,360),[0,+inf]                         ");
+  blk("  DRIFT_VECTOR_ADD   = [0,360),[0,+inf]                         ");
+  blk("  ROTATE_SPEED       = [0,inf] m/s                              ");
+  blk("  WATER_DEPTH        = [0,+inf]                                 ");
+  blk("                                                                ");
+  blk("PUBLICATIONS:                                                   ");
+  blk("------------------------------------                            ");
+  blk("  For each vehicle, e.g., abe:                                  ");
+  blk("  NAV_ALTITUDE_ABE   = 100  (if the water depth is known)       ");
+  blk("  NAV_DEPTH_ABE      = 45                                       ");
+  blk("  NAV_HEADING_ABE    = 197                                      ");
+  blk("  NAV_LAT_ABE        = 42.1293844                               ");
+  blk("  NAV_LONG_ABE       = -73.2398311                              ");
+  blk("  NAV_SPEED_ABE      = 1.33                                     ");
+  blk("  NAV_X_ABE          = 34.9                                     ");
+  blk("  NAV_Y_ABE          = 442.5                                    ");
+  blk("                                                                ");
+  exit(0);
+}
+
+//----------------------------------------------------------------
+// Procedure: showReleaseInfoAndExit
+
+void showReleaseInfoAndExit()
+{
+  showReleaseInfo("uSimFleet    ", "gpl");
+  exit(0);
+}
@@ -0,0 +1,425 @@
+/*****************************************************************/
+/*    NAME: MOOS-IvP contributors                                */
+/*    ORGN: Dept of Mechanical Eng / CSAIL, MIT Cambridge MA     */
+/*    FILE: USF_MOOSApp.cpp                                      */
+/*    DATE: Oct 18th 2026                                        */
+/*                                                               */
+/* This file is part of MOOS-IvP                                 */
+/*                                                               */
+/* MOOS-IvP is free software: you can redistribute it and/or     */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation, either version  */
+/* 3 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* MOOS-IvP is distributed in the hope that it will be useful,   */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty   */
+/* of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See  */
+/* the GNU General Public License for more details.              */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with MOOS-IvP.  If not, see                     */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+#include <iostream>
+#include <cstdlib>
+#include "USF_MOOSApp.h"
+#include "MBUtils.h"
+#include "ACTable.h"
+
+using namespace std;
+
+//------------------------------------------------------------------------
+// Constructor
+
+USF_MOOSApp::USF_MOOSApp()
+{
+  m_sim_prefix  = "NAV";
+  m_raster_size = 0;
+  m_geo_ok      = false;
+
+  m_total_desired = 0;
+}
+
+//------------------------------------------------------------------------
+// Procedure: OnNewMail
+
+bool USF_MOOSApp::OnNewMail(MOOSMSG_LIST &NewMail)
+{
+  AppCastingMOOSApp::OnNewMail(NewMail);
+
+  MOOSMSG_LIST::iterator p;
+  for(p=NewMail.begin(); p!=NewMail.end(); p++) {
+    CMOOSMsg &msg = *p;
+    string key = msg.GetKey();
+    double dval = msg.GetDouble();
+    string sval = msg.GetString();
+
+    map<string, unsigned int>::iterator q;
+    if(strBegins(key, "DESIRED_")) {
+      q = m_map_thrust_ix.find(key);
+      if(q != m_map_thrust_ix.end())
+	m_model.setThrust(q->second, dval);
+      else {
+	q = m_map_rudder_ix.find(key);
+	if(q != m_map_rudder_ix.end())
+	  m_model.setRudder(q->second, dval, MOOSTime());
+	else {
+	  q = m_map_elevator_ix.find(key);
+	  if(q != m_map_elevator_ix.end())
+	    m_model.setElevator(q->second, dval);
+	}
+      }
+      m_total_desired++;
+    }
+    else if((key == "CURRENT_X") || (key == "DRIFT_X"))
+      m_model.setParam("drift_x", dval);
+    else if((key == "CURRENT_Y") || (key == "DRIFT_Y"))
+      m_model.setParam("drift_y", dval);
+    else if(key == "DRIFT_VECTOR")
+      m_model.setDriftVector(sval, false);
+    else if(key == "DRIFT_VECTOR_ADD")
+      m_model.setDriftVector(sval, true);
+    else if(key == "ROTATE_SPEED")
+      m_model.setParam("rotate_speed", dval);
+    else if(key == "BUOYANCY_RATE")
+      m_model.setParam("buoyancy_rate", dval);
+    else if(key == "WATER_DEPTH")
+      m_model.setParam("water_depth", dval);
+    else if(key != "APPCAST_REQ")
+      reportRunWarning("Unhandled mail: " + key);
+  }
+
+  return(true);
+}
+
+//------------------------------------------------------------------------
+// Procedure: OnStartUp
+
+bool USF_MOOSApp::OnStartUp()
+{
+  AppCastingMOOSApp::OnStartUp();
+
+  STRING_LIST sParams;
+  if(!m_MissionReader.GetConfiguration(GetAppName(), sParams))
+    reportConfigWarning("No config block found for " + GetAppName());
+
+  STRING_LIST::iterator p;
+  for(p = sParams.begin();p!=sParams.end();p++) {
+    string orig  = *p;
+    string line  = *p;
+    string param = toupper(biteStringX(line, '='));
+    string value = line;
+    double dval  = atof(value.c_str());
+
+    bool handled = false;
+    if(param == "VEHICLE")
+      handled = handleConfigVehicle(value);
+    else if((param == "BUOYANCY_RATE") && isNumber(value))
+      handled = m_model.setParam("buoyancy_rate", dval);
+    else if((param == "DRIFT_X") && isNumber(value))
+      handled = m_model.setParam("drift_x", dval);
+    else if((param == "DRIFT_Y") && isNumber(value))
+      handled = m_model.setParam("drift_y", dval);
+    else if(param == "DRIFT_VECTOR")
+      handled = m_model.setDriftVector(value);
+    else if((param == "ROTATE_SPEED") && isNumber(value))
+      handled = m_model.setParam("rotate_speed", dval);
+    else if((param == "MAX_ACCELERATION") && isNumber(value))
+      handled = m_model.setParam("max_acceleration", dval);
+    else if((param == "MAX_DECELERATION") && isNumber(value))
+      handled = m_model.setParam("max_deceleration", dval);
+    else if((param == "MAX_DEPTH_RATE") && isNumber(value))
+      handled = m_model.setParam("max_depth_rate", dval);
+    else if((param == "MAX_DEPTH_RATE_SPEED") && isNumber(value))
+      handled = m_model.setParam("max_depth_rate_speed", dval);
+    else if((param == "MAX_RUDDER_DEGS_PER_SEC") && isNumber(value))
+      handled = m_model.setMaxRudderDegreesPerSec(dval);
+    else if((param == "TURN_RATE") && isNumber(value))
+      handled = m_model.setParam("turn_rate", dval);
+    else if((param == "DEFAULT_WATER_DEPTH") && isNumber(value))
+      handled = m_model.setParam("water_depth", dval);
+    else if((param == "THRUST_REFLECT") && isBoolean(value)) {
+      m_model.setThrustReflect(tolower(value)=="true");
+      handled = true;
+    }
+    else if((param == "THRUST_FACTOR") && isNumber(value)) {
+      m_model.setThrustFactor(dval);
+      handled = true;
+    }
+    else if(param == "THRUST_MAP")
+      handled = handleThrustMapping(value);
+    else if((param == "PREFIX") && !strContainsWhite(value)) {
+      m_sim_prefix = value;
+      handled = true;
+    }
+    else if(param == "CURRENT_FIELD") {
+      m_cfield_file = value;
+      handled = (value != "");
+    }
+    else if(param == "CURRENT_FIELD_RASTER")
+      handled = setNonNegDoubleOnString(m_raster_size, value);
+
+    if(!handled)
+      reportUnhandledConfigWarning(orig);
+  }
+
+  // Build the per-vehicle variable names once the prefix is known
+  for(unsigned int i=0; i<m_model.size(); i++) {
+    string vname = toupper(m_model.getName(i));
+    m_var_x.push_back(m_sim_prefix + "_X_" + vname);
+    m_var_y.push_back(m_sim_prefix + "_Y_" + vname);
+    m_var_lat.push_back(m_sim_prefix + "_LAT_" + vname);
+    m_var_lon.push_back(m_sim_prefix + "_LONG_" + vname);
+    m_var_hdg.push_back(m_sim_prefix + "_HEADING_" + vname);
+    m_var_spd.push_back(m_sim_prefix + "_SPEED_" + vname);
+    m_var_dep.push_back(m_sim_prefix + "_DEPTH_" + vname);
+    m_var_alt.push_back(m_sim_prefix + "_ALTITUDE_" + vname);
+
+    m_map_thrust_ix["DESIRED_THRUST_" + vname] = i;
+    m_map_rudder_ix["DESIRED_RUDDER_" + vname] = i;
+    m_map_elevator_ix["DESIRED_ELEVATOR_" + vname] = i;
+  }
+  if(m_model.size() == 0)
+    reportConfigWarning("No vehicles configured");
+
+  // look for latitude, longitude global variables
+  double lat_origin, lon_origin;
+  if(!m_MissionReader.GetValue("LatOrigin", lat_origin))
+    reportConfigWarning("LatOrigin not set in *.moos file.");
+  else if(!m_MissionReader.GetValue("LongOrigin", lon_origin))
+    reportConfigWarning("LongOrigin not set in *.moos file.");
+  else {
+    m_geo_ok = m_geodesy.Initialise(lat_origin, lon_origin);
+    if(!m_geo_ok)
+      reportConfigWarning("Geodesy init failed.");
+  }
+
+  if(m_cfield_file != "") {
+    bool ok = handleCurrentField(m_cfield_file);
+    if(!ok)
+      reportConfigWarning("Unable to use current field: " + m_cfield_file);
+  }
+
+  m_model.resetTime(m_curr_time);
+
+  registerVariables();
+  return(true);
+}
+
+//------------------------------------------------------------------------
+// Procedure: OnConnectToServer
+
+bool USF_MOOSApp::OnConnectToServer()
+{
+  registerVariables();
+  return(true);
+}
+
+//------------------------------------------------------------------------
+// Procedure: registerVariables
+
+void USF_MOOSApp::registerVariables()
+{
+  AppCastingMOOSApp::RegisterVariables();
+
+  map<string, unsigned int>::iterator p;
+  for(p=m_map_thrust_ix.begin(); p!=m_map_thrust_ix.end(); p++)
+    m_Comms.Register(p->first, 0);
+  for(p=m_map_rudder_ix.begin(); p!=m_map_rudder_ix.end(); p++)
+    m_Comms.Register(p->first, 0);
+  for(p=m_map_elevator_ix.begin(); p!=m_map_elevator_ix.end(); p++)
+    m_Comms.Register(p->first, 0);
+
+  m_Comms.Register("CURRENT_X", 0);
+  m_Comms.Register("CURRENT_Y", 0);
+  m_Comms.Register("DRIFT_X", 0);
+  m_Comms.Register("DRIFT_Y", 0);
+  m_Comms.Register("DRIFT_VECTOR", 0);
+  m_Comms.Register("DRIFT_VECTOR_ADD", 0);
+  m_Comms.Register("ROTATE_SPEED", 0);
+  m_Comms.Register("BUOYANCY_RATE", 0);
+  m_Comms.Register("WATER_DEPTH", 0);
+}
+
+//------------------------------------------------------------------------
+// Procedure: Iterate
+
+bool USF_MOOSApp::Iterate()
+{
+  AppCastingMOOSApp::Iterate();
+
+  m_model.propagate(m_curr_time);
+  postNavUpdates();
+
+  AppCastingMOOSApp::PostReport();
+  return(true);
+}
+
+//------------------------------------------------------------------------
+// Procedure: postNavUpdates
+//      Note: The postings of all vehicles are queued together and go
+//            to the MOOSDB in the same comms cycle.
+
+void USF_MOOSApp::postNavUpdates()
+{
+  bool post_alt = (m_model.getWaterDepth() > 0);
+
+  unsigned int i, vsize = m_model.size();
+  for(i=0; i<vsize; i++) {
+    double nav_x = m_model.getX(i);
+    double nav_y = m_model.getY(i);
+    Notify(m_var_x[i], nav_x, m_curr_time);
+    Notify(m_var_y[i], nav_y, m_curr_time);
+
+    if(m_geo_ok) {
+      double lat, lon;
+#ifdef USE_UTM
+      m_geodesy.UTM2LatLong(nav_x, nav_y, lat, lon);
+#else
+      m_geodesy.LocalGrid2LatLong(nav_x, nav_y, lat, lon);
+#endif
+      Notify(m_var_lat[i], lat, m_curr_time);
+      Notify(m_var_lon[i], lon, m_curr_time);
+    }
+
+    double speed = snapToStep(m_model.getSpeed(i), 0.01);
+    Notify(m_var_hdg[i], m_model.getHeading(i), m_curr_time);
+    Notify(m_var_spd[i], speed, m_curr_time);
+    Notify(m_var_dep[i], m_model.getDepth(i), m_curr_time);
+    if(post_alt)
+      Notify(m_var_alt[i], m_model.getAltitude(i), m_curr_time);
+  }
+}
+
+//------------------------------------------------------------------------
+// Procedure: handleConfigVehicle
+//   Example: vehicle = name=abe, x=0, y=-20, heading=180, speed=0
+
+bool USF_MOOSApp::handleConfigVehicle(string str)
+{
+  string vname;
+  string pos_str;
+  vector<string> svector = parseString(str, ',');
+  for(unsigned int i=0; i<svector.size(); i++) {
+    string param = tolower(biteStringX(svector[i], '='));
+    string value = svector[i];
+    if(param == "name")
+      vname = value;
+    else {
+      if(pos_str != "")
+	pos_str += ",";
+      pos_str += param + "=" + value;
+    }
+  }
+
+  if((vname == "") || strContainsWhite(vname))
+    return(false);
+  if(m_model.getIndex(vname) >= 0) {
+    reportConfigWarning("Vehicle configured twice: " + vname);
+    return(false);
+  }
+
+  unsigned int ix = m_model.addVehicle(vname);
+  return(m_model.initPosition(ix, pos_str));
+}
+
+//--------------------------------------------------------------------
+// Procedure: handleThrustMapping
+
+bool USF_MOOSApp::handleThrustMapping(string mapping)
+{
+  if(mapping == "")
+    return(false);
+  vector<string> svector = parseString(mapping, ',');
+  unsigned int i, vsize = svector.size();
+  for(i=0; i<vsize; i++) {
+    string thrust = biteStringX(svector[i], ':');
+    string speed  = svector[i];
+    if(!isNumber(thrust) || !isNumber(speed))
+      return(false);
+    double dthrust = atof(thrust.c_str());
+    double dspeed  = atof(speed.c_str());
+    bool ok = m_model.addThrustMapping(dthrust, dspeed);
+    if(!ok)
+      return(false);
+  }
+  return(true);
+}
+
+//--------------------------------------------------------------------
+// Procedure: handleCurrentField
+//      Note: The field is applied to every vehicle directly, in place
+//            of a uSimCurrent per vehicle posting DRIFT_VECTOR.
+
+bool USF_MOOSApp::handleCurrentField(string filename)
+{
+  CurrentField cfield;
+  if(!cfield.populate(filename) || (cfield.size() == 0))
+    return(false);
+
+  if(m_geo_ok)
+    cfield.initGeodesy(m_geodesy.GetOriginLatitude(),
+		       m_geodesy.GetOriginLongitude());
+  if(m_raster_size > 0) {
+    if(!cfield.buildRaster(m_raster_size))
+      reportConfigWarning("Unable to build current field raster");
+  }
+  m_model.setCurrentField(cfield);
+  return(true);
+}
+
+//------------------------------------------------------------------------
+// Procedure: buildReport
+//      Note: A virtual function of the AppCastingMOOSApp superclass,
+//            conditionally invoked if either a terminal or appcast
+//            report is needed.
+//
+//  Vehicles: 3    Desired mail: 1204
+//  Drift (x,y): 0,0   Current field: none
+//  Positive Thrust Map: n/a
+//  Negative Thrust Map: n/a
+//
+//  Vehicle  X       Y       Hdg    Spd   Dep  Thrust  Rudder  Elev
+//  -------  ------  ------  -----  ----  ---  ------  ------  ----
+//  abe      12.4    -88.2   181.2  1.5   0    30      -2.1    0
+//  ben      40.1    -71.9   90.4   2.1   0    42      0       0
+
+bool USF_MOOSApp::buildReport()
+{
+  string cfield = "none";
+  if(m_model.usingCurrentField())
+    cfield = m_cfield_file;
+  string posmap = m_model.getThrustMapPos();
+  string negmap = m_model.getThrustMapNeg();
+  if(posmap == "")
+    posmap = "n/a";
+  if(negmap == "")
+    negmap = "n/a";
+
+  m_msgs << "Vehicles: " << m_model.size();
+  m_msgs << "    Desired mail: " << m_total_desired << endl;
+  m_msgs << "Drift (x,y): " << doubleToStringX(m_model.getDriftX(),3);
+  m_msgs << "," << doubleToStringX(m_model.getDriftY(),3);
+  m_msgs << "   Current field: " << cfield << endl;
+  m_msgs << "Positive Thrust Map: " << posmap << endl;
+  m_msgs << "Negative Thrust Map: " << negmap << endl << endl;
+
+  ACTable actab(9);
+  actab << "Vehicle | X | Y | Hdg | Spd | Dep | Thrust | Rudder | Elev";
+  actab.addHeaderLines();
+  for(unsigned int i=0; i<m_model.size(); i++) {
+    actab << m_model.getName(i);
+    actab << doubleToStringX(m_model.getX(i),1);
+    actab << doubleToStringX(m_model.getY(i),1);
+    actab << doubleToStringX(m_model.getHeading(i),1);
+    actab << doubleToStringX(m_model.getSpeed(i),2);
+    actab << doubleToStringX(m_model.getDepth(i),1);
+    actab << doubleToStringX(m_model.getThrust(i),1);
+    actab << doubleToStringX(m_model.getRudder(i),1);
+    actab << doubleToStringX(m_model.getElevator(i),1);
+  }
+  m_msgs << actab.getFormattedString();
+
+  return(true);
+}
@@ -0,0 +1,85 @@
+/*****************************************************************/
+/*    NAME: MOOS-IvP contributors                                */
+/*    ORGN: Dept of Mechanical Eng / CSAIL, MIT Cambridge MA     */
+/*    FILE: USF_MOOSApp.h                                        */
+/*    DATE: Oct 18th 2026                                        */
+/*                                                               */
+/* This file is part of MOOS-IvP                                 */
+/*                                                               */
+/* MOOS-IvP is free software: you can redistribute it and/or     */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation, either version  */
+/* 3 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* MOOS-IvP is distributed in the hope that it will be useful,   */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty   */
+/* of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See  */
+/* the GNU General Public License for more details.              */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with MOOS-IvP.  If not, see                     */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+#ifndef USF_MOOSAPP_HEADER
+#define USF_MOOSAPP_HEADER
+
+#include <string>
+#include <vector>
+#include <map>
+#include "MOOS/libMOOS/Thirdparty/AppCasting/AppCastingMOOSApp.h"
+#include "MOOS/libMOOSGeodesy/MOOSGeodesy.h"
+#include "FleetModel.h"
+
+class USF_MOOSApp : public AppCastingMOOSApp
+{
+public:
+  USF_MOOSApp();
+  virtual ~USF_MOOSApp() {}
+
+ public: // Standard MOOSApp functions to overload
+  bool OnNewMail(MOOSMSG_LIST &NewMail);
+  bool OnStartUp();
+  bool Iterate();
+  bool OnConnectToServer();
+
+ protected: // Standard AppCastingMOOSApp function to overload
+  bool buildReport();
+
+ protected:
+  void registerVariables();
+  void postNavUpdates();
+  bool handleConfigVehicle(std::string);
+  bool handleThrustMapping(std::string);
+  bool handleCurrentField(std::string);
+
+protected: // Configuration variables
+  std::string  m_sim_prefix;
+  double       m_raster_size;
+  std::string  m_cfield_file;
+
+protected: // State variables
+  FleetModel   m_model;
+
+  CMOOSGeodesy m_geodesy;
+  bool         m_geo_ok;
+
+  // Per-vehicle variable names, built once as vehicles are added
+  std::vector<std::string> m_var_x;
+  std::vector<std::string> m_var_y;
+  std::vector<std::string> m_var_lat;
+  std::vector<std::string> m_var_lon;
+  std::vector<std::string> m_var_hdg;
+  std::vector<std::string> m_var_spd;
+  std::vector<std::string> m_var_dep;
+  std::vector<std::string> m_var_alt;
+
+  // Map from DESIRED_* variable name to vehicle index
+  std::map<std::string, unsigned int> m_map_thrust_ix;
+  std::map<std::string, unsigned int> m_map_rudder_ix;
+  std::map<std::string, unsigned int> m_map_elevator_ix;
+
+  unsigned int m_total_desired;
+};
+
+#endif